@@ -22,10 +22,13 @@ with the 3D Data Visualizer; if not, write to the Free Software
 Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 ***********************************************************************/
 
+#include <string>
+#include <iostream>
 #include <Misc/ThrowStdErr.h>
 #include <Cluster/MulticastPipe.h>
 
 #include <Abstract/Parameters.h>
+#include <Templatized/Profiler.h>
 
 #include <Abstract/Algorithm.h>
 
@@ -40,8 +43,13 @@ Methods of class Algortithm:
 Algorithm::Algorithm(VariableManager* sVariableManager,Cluster::MulticastPipe* sPipe)
 	:variableManager(sVariableManager),pipe(sPipe),
 	 master(pipe==0||pipe->isMaster()),
-	 busyFunction(0)
+	 busyFunction(0),busyProbe(~0U),
+	 requestGeneration(0),elementGeneration(0)
 	{
+	/* Reset the culling statistics: */
+	clipStatistics.numElements=0;
+	clipStatistics.numCellsSkipped=0;
+	clipStatistics.numTrianglesSaved=0;
 	}
 
 Algorithm::~Algorithm(void)
@@ -53,6 +61,22 @@ Algorithm::~Algorithm(void)
 	delete busyFunction;
 	}
 
+void Algorithm::recordProgress(float completionPercentage)
+	{
+	if(!Templatized::Profiler::isEnabled())
+		return;
+	
+	/* Register the algorithm's progress counter on first use: */
+	if(busyProbe==~0U)
+		{
+		std::string probeName=getName();
+		probeName.append(" progress (%)");
+		busyProbe=Templatized::Profiler::registerCounter(probeName.c_str(),Templatized::Profiler::EXTRACTION);
+		}
+	
+	Templatized::Profiler::recordCounter(busyProbe,completionPercentage);
+	}
+
 void Algorithm::setBusyFunction(Algorithm::BusyFunction* newBusyFunction)
 	{
 	/* Delete the previous busy function: */
@@ -62,6 +86,38 @@ void Algorithm::setBusyFunction(Algorithm::BusyFunction* newBusyFunction)
 	busyFunction=newBusyFunction;
 	}
 
+void Algorithm::setClipPlanes(const Algorithm::ClipPlaneList& newClipPlanes)
+	{
+	Threads::Mutex::Lock clipLock(clipMutex);
+	clipPlanes=newClipPlanes;
+	}
+
+Algorithm::ClipPlaneList Algorithm::getClipPlanes(void) const
+	{
+	Threads::Mutex::Lock clipLock(clipMutex);
+	return clipPlanes;
+	}
+
+void Algorithm::addClipStatistics(size_t numCellsSkipped,size_t numTrianglesSaved)
+	{
+	Threads::Mutex::Lock clipLock(clipMutex);
+	++clipStatistics.numElements;
+	clipStatistics.numCellsSkipped+=numCellsSkipped;
+	clipStatistics.numTrianglesSaved+=numTrianglesSaved;
+	}
+
+Algorithm::ClipStatistics Algorithm::getClipStatistics(void) const
+	{
+	Threads::Mutex::Lock clipLock(clipMutex);
+	return clipStatistics;
+	}
+
+void Algorithm::printClipStatistics(std::ostream& os) const
+	{
+	ClipStatistics s=getClipStatistics();
+	os<<getName()<<" extractor: "<<s.numCellsSkipped<<" cells outside of cutting planes skipped, "<<s.numTrianglesSaved<<" triangles saved over "<<s.numElements<<" clipped elements"<<std::endl;
+	}
+
 bool Algorithm::hasGlobalCreator(void) const
 	{
 	return false;
@@ -124,6 +180,21 @@ void Algorithm::continueSlaveElement(void)
 	/* Just don't do anything */
 	}
 
+bool Algorithm::hasElementReader(void) const
+	{
+	return false;
+	}
+
+Element* Algorithm::readElement(Parameters* extractParameters,IO::File& file)
+	{
+	/* Inherit the parameters object: */
+	delete extractParameters;
+	
+	/* Signal an error: */
+	Misc::throwStdErr("Algorithm: No element reader defined");
+	return 0;
+	}
+
 }
 
 }
@@ -25,7 +25,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_ABSTRACT_ALGORITHM_INCLUDED
 #define VISUALIZATION_ABSTRACT_ALGORITHM_INCLUDED
 
+#include <stddef.h>
+#include <iosfwd>
+#include <vector>
 #include <Misc/FunctionCalls.h>
+#include <Threads/Mutex.h>
+#include <Geometry/Plane.h>
 
 #include <Abstract/DataSet.h>
 
@@ -36,6 +41,9 @@ class AlarmTimer;
 namespace Cluster {
 class MulticastPipe;
 }
+namespace IO {
+class File;
+}
 namespace GLMotif {
 class WidgetManager;
 class Widget;
@@ -58,6 +66,17 @@ class Algorithm
 	/* Embedded classes: */
 	public:
 	typedef Misc::FunctionCall<float> BusyFunction; // Type for functions called during long-running operations
+	typedef Geometry::Plane<DataSet::Scalar,3> ClipPlane; // Type for cutting planes in the data set's domain; the visible side is the positive half-space
+	typedef std::vector<ClipPlane> ClipPlaneList; // Type for lists of cutting planes
+	
+	struct ClipStatistics // Structure to report how much work was culled by cutting planes
+		{
+		/* Elements: */
+		public:
+		size_t numElements; // Number of elements extracted while cutting planes were active
+		size_t numCellsSkipped; // Total number of cells skipped because they lay entirely outside of a cutting plane
+		size_t numTrianglesSaved; // Total number of triangles that were not extracted from skipped cells
+		};
 	
 	/* Elements: */
 	private:
@@ -65,6 +84,15 @@ class Algorithm
 	Cluster::MulticastPipe* pipe; // Multicast pipe to synchronize element extraction in a cluster-based environment; created externally but owned by Algorithm object
 	bool master; // Flag if this instance of the algorithm runs on the master node of a visualization cluster
 	BusyFunction* busyFunction; // Function called at regular intervals during a long-running operation
+	unsigned int busyProbe; // Profiler counter probe recording completion percentages, or ~0U if not yet registered
+	const volatile unsigned int* requestGeneration; // Pointer to a counter advanced by every new extraction request, or 0 if elements cannot be cancelled
+	unsigned int elementGeneration; // Value of the request counter at the time the current element was requested
+	mutable Threads::Mutex clipMutex; // Mutex serializing access to the cutting planes and culling statistics
+	ClipPlaneList clipPlanes; // Cutting planes to be honored by the next extracted element
+	ClipStatistics clipStatistics; // Accumulated culling statistics
+	
+	/* Private methods: */
+	void recordProgress(float completionPercentage); // Records a completion percentage with the profiler if it is enabled
 	
 	/* Constructors and destructors: */
 	public:
@@ -91,9 +119,24 @@ class Algorithm
 	void setBusyFunction(BusyFunction* newBusyFunction); // Sets the busy function; object inherits function call object
 	void callBusyFunction(float completionPercentage) // Calls the busy function with a new percentage value
 		{
+		recordProgress(completionPercentage);
 		if(busyFunction!=0)
 			(*busyFunction)(completionPercentage);
 		}
+	void setRequestGeneration(const volatile unsigned int* newRequestGeneration,unsigned int newElementGeneration) // Sets the request counter to be monitored during extraction of the next element
+		{
+		requestGeneration=newRequestGeneration;
+		elementGeneration=newElementGeneration;
+		}
+	bool isCancelled(void) const // Returns true if the element currently being extracted was superseded by a newer extraction request
+		{
+		return requestGeneration!=0&&*requestGeneration!=elementGeneration;
+		}
+	void setClipPlanes(const ClipPlaneList& newClipPlanes); // Sets the cutting planes outside of which subsequently extracted elements may skip cells; called from the main thread
+	ClipPlaneList getClipPlanes(void) const; // Returns a snapshot of the current cutting planes; called from the extraction thread
+	void addClipStatistics(size_t numCellsSkipped,size_t numTrianglesSaved); // Adds the culling results of one extracted element to the statistics
+	ClipStatistics getClipStatistics(void) const; // Returns a snapshot of the accumulated culling statistics
+	void printClipStatistics(std::ostream& os) const; // Prints a summary of the culling statistics to the given stream
 	virtual const char* getName(void) const =0; // Returns the algorithm's name
 	virtual bool hasGlobalCreator(void) const; // Returns true if the algorithm has a global creation method
 	virtual bool hasSeededCreator(void) const; // Returns true if the algorithm has a seeded creation method
@@ -108,6 +151,8 @@ class Algorithm
 	virtual void finishElement(void); // Cleans up after an element has been created
 	virtual Element* startSlaveElement(Parameters* extractParameters) =0; // Starts creating a visualization element on the slave node(s) of a cluster environment; inherits parameter object
 	virtual void continueSlaveElement(void); // Receives a fragment of a visualization element on the slave node(s) of a cluster environment
+	virtual bool hasElementReader(void) const; // Returns true if the algorithm can recreate visualization elements from geometry written by Element::writeGeometry
+	virtual Element* readElement(Parameters* extractParameters,IO::File& file); // Recreates a visualization element from geometry written by Element::writeGeometry without extracting it; inherits parameter object
 	};
 
 }
@@ -23,6 +23,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Abstract/DataSet.h>
 
+#include <limits>
 #include <Misc/ThrowStdErr.h>
 
 namespace Visualization {
@@ -61,6 +62,47 @@ bool DataSet::Locator::setOrientation(const DataSet::Orientation& newOrientation
 	return result;
 	}
 
+size_t DataSet::Locator::calcScalars(const ScalarExtractor* scalarExtractor,size_t numPoints,const DataSet::Point points[],DataSet::VScalar values[])
+	{
+	/* Evaluate the samples one at a time by default: */
+	size_t numValid=0;
+	for(size_t i=0;i<numPoints;++i)
+		{
+		setPosition(points[i]);
+		if(isValid())
+			{
+			values[i]=calcScalar(scalarExtractor);
+			++numValid;
+			}
+		else
+			values[i]=std::numeric_limits<VScalar>::quiet_NaN();
+		}
+	
+	return numValid;
+	}
+
+size_t DataSet::Locator::calcVectors(const VectorExtractor* vectorExtractor,size_t numPoints,const DataSet::Point points[],DataSet::VVector values[])
+	{
+	/* Evaluate the samples one at a time by default: */
+	size_t numValid=0;
+	for(size_t i=0;i<numPoints;++i)
+		{
+		setPosition(points[i]);
+		if(isValid())
+			{
+			values[i]=calcVector(vectorExtractor);
+			++numValid;
+			}
+		else
+			{
+			for(int j=0;j<3;++j)
+				values[i][j]=std::numeric_limits<VVector::Scalar>::quiet_NaN();
+			}
+		}
+	
+	return numValid;
+	}
+
 /************************
 Methods of class DataSet:
 ************************/
@@ -88,6 +130,29 @@ ScalarExtractor* DataSet::getScalarExtractor(int scalarVariableIndex) const
 	return 0;
 	}
 
+void DataSet::addDerivedVariables(const char* definitions)
+	{
+	Misc::throwStdErr("DataSet::addDerivedVariables: Data set does not support derived variables");
+	}
+
+void DataSet::encodeSlices(const char* codecName)
+	{
+	Misc::throwStdErr("DataSet::encodeSlices: Data set does not support encoded slices");
+	}
+
+size_t DataSet::materializeScalarExtractor(ScalarExtractor* scalarExtractor) const
+	{
+	/* Data sets do not support materialization by default: */
+	return 0;
+	}
+
+void DataSet::materializeScalarExtractors(int numScalarExtractors,ScalarExtractor* const scalarExtractors[],size_t sliceSizes[]) const
+	{
+	/* Materialize the extractors one at a time by default: */
+	for(int i=0;i<numScalarExtractors;++i)
+		sliceSizes[i]=materializeScalarExtractor(scalarExtractors[i]);
+	}
+
 int DataSet::getNumVectorVariables(void) const
 	{
 	return 0;
@@ -89,6 +89,8 @@ class DataSet
 		virtual bool isValid(void) const =0; // Returns true if the locator is inside the data set's domain
 		virtual VScalar calcScalar(const ScalarExtractor* scalarExtractor) const =0; // Calculates scalar value at current locator position (locator must be valid)
 		virtual VVector calcVector(const VectorExtractor* vectorExtractor) const =0; // Calculates vector value at current locator position (locator must be valid)
+		virtual size_t calcScalars(const ScalarExtractor* scalarExtractor,size_t numPoints,const Point points[],VScalar values[]); // Moves the locator along the given sequence of positions and stores the scalar value at each, or NaN outside the domain; returns the number of valid samples
+		virtual size_t calcVectors(const VectorExtractor* vectorExtractor,size_t numPoints,const Point points[],VVector values[]); // Moves the locator along the given sequence of positions and stores the vector value at each, or NaN vectors outside the domain; returns the number of valid samples
 		};
 	
 	/* Constructors and destructors: */
@@ -113,6 +115,10 @@ class DataSet
 	virtual const char* getScalarVariableName(int scalarVariableIndex) const; // Returns descriptive name of a scalar variable
 	virtual ScalarExtractor* getScalarExtractor(int scalarVariableIndex) const; // Returns scalar extractor for a scalar variable
 	virtual VScalarRange calcScalarValueRange(const ScalarExtractor* scalarExtractor) const =0; // Calculates the range of scalar values extracted by the given extractor
+	virtual void addDerivedVariables(const char* definitions); // Adds scalar and vector variables defined by a semicolon-separated list of name=expression or name=(expression,...) definitions; throws exception if the data set does not support derived variables
+	virtual void encodeSlices(const char* codecName); // Replaces the data set's value slices with copies encoded by the codec of the given name; must be called before creating extractors; throws exception if the data set does not support encoded slices
+	virtual size_t materializeScalarExtractor(ScalarExtractor* scalarExtractor) const; // Precomputes the values of the given extractor into a slice the extractor reads from afterwards; returns the slice's size in bytes, or 0 if materialization is not supported
+	virtual void materializeScalarExtractors(int numScalarExtractors,ScalarExtractor* const scalarExtractors[],size_t sliceSizes[]) const; // Transposes the data set's values into one slice per given extractor in a single pass; stores each slice's size in bytes, or 0 if the extractor was not materialized
 	virtual int getNumVectorVariables(void) const; // Returns number of vector variables contained in the data set
 	virtual const char* getVectorVariableName(int vectorVariableIndex) const; // Returns descriptive name of a vector variable
 	virtual VectorExtractor* getVectorExtractor(int vectorVariableIndex) const; // Returns vector extractor for a vector variable
@@ -25,6 +25,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Abstract/Element.h>
 
+#include <Misc/ThrowStdErr.h>
+
 #include <Abstract/Parameters.h>
 
 namespace Visualization {
@@ -51,6 +53,26 @@ GLMotif::Widget* Element::createSettingsDialog(GLMotif::WidgetManager* widgetMan
 	return 0;
 	}
 
+int Element::getColorScalarVariable(void) const
+	{
+	return -1;
+	}
+
+void Element::setColorScalarVariable(int newColorScalarVariableIndex)
+	{
+	Misc::throwStdErr("Element::setColorScalarVariable: %s elements cannot be recolored",getName().c_str());
+	}
+
+size_t Element::getGeometrySize(void) const
+	{
+	return 0;
+	}
+
+void Element::writeGeometry(IO::File& file) const
+	{
+	Misc::throwStdErr("Element::writeGeometry: %s elements cannot be written",getName().c_str());
+	}
+
 }
 
 }
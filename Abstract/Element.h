@@ -33,6 +33,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 namespace Misc {
 class File;
 }
+namespace IO {
+class File;
+}
 namespace GLMotif {
 class WidgetManager;
 class Widget;
@@ -81,6 +84,10 @@ class Element:public Threads::RefCounted
 	virtual size_t getSize(void) const =0; // Returns some size value for the visualization element to compare it to other elements of the same type (number of triangles, points, etc.)
 	virtual bool usesTransparency(void) const; // Returns true if the visualization element uses transparency (and needs to be rendered last)
 	virtual GLMotif::Widget* createSettingsDialog(GLMotif::WidgetManager* widgetManager); // Returns a new UI widget to change internal settings of the element
+	virtual int getColorScalarVariable(void) const; // Returns the index of the scalar variable used to color the element, or -1 if the element's colors cannot be changed after extraction
+	virtual void setColorScalarVariable(int newColorScalarVariableIndex); // Re-evaluates the element's colors for the given scalar variable without re-extracting its geometry
+	virtual size_t getGeometrySize(void) const; // Returns the number of bytes written by writeGeometry
+	virtual void writeGeometry(IO::File& file) const; // Writes the element's extracted geometry in a compact binary format to be read by Algorithm::readElement
 	virtual void glRenderAction(GLRenderState& renderState) const =0; // Renders a visualization element into the given OpenGL context
 	};
 
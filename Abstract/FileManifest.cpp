@@ -0,0 +1,303 @@
+/***********************************************************************
+FileManifest - Class for block checksum manifests verifying that copies
+of data files on different cluster nodes are identical.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Abstract/FileManifest.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <stdexcept>
+#include <string>
+#include <Misc/ThrowStdErr.h>
+#include <Misc/File.h>
+#include <Cluster/MulticastPipe.h>
+
+namespace Visualization {
+
+namespace Abstract {
+
+namespace {
+
+/*************************************************
+Helper functions for manifests and checksum words:
+*************************************************/
+
+const char manifestFileMagic[16]="FileManifest"; // Identifier at the beginning of manifest cache files
+
+inline
+Misc::UInt64
+getTime(
+	const struct timespec& time)
+	{
+	/* Use nanosecond resolution to notice files that are modified within the same second they were checksummed: */
+	return Misc::UInt64(time.tv_sec)*1000000000ULL+Misc::UInt64(time.tv_nsec);
+	}
+
+inline
+Misc::UInt64
+mixWord(
+	Misc::UInt64 hash,
+	Misc::UInt64 word)
+	{
+	hash^=word*0xc2b2ae3d27d4eb4fULL;
+	hash=(hash<<31)|(hash>>33);
+	return hash*0x9e3779b97f4a7c15ULL;
+	}
+
+}
+
+/*****************************
+Methods of class FileManifest:
+*****************************/
+
+bool FileManifest::loadCache(const char* manifestFileName,const FileManifest::FileState& fileState)
+	{
+	try
+		{
+		Misc::File manifestFile(manifestFileName,"rb",Misc::File::LittleEndian);
+		
+		/* Check the cache file's header against the current state of the described file: */
+		char magic[16];
+		manifestFile.read(magic,sizeof(magic));
+		if(memcmp(magic,manifestFileMagic,sizeof(magic))!=0)
+			return false;
+		if(manifestFile.read<Misc::UInt32>()!=manifestFileVersion)
+			return false;
+		if(manifestFile.read<Misc::UInt64>()!=fileSize)
+			return false;
+		if(manifestFile.read<Misc::UInt64>()!=fileState.device)
+			return false;
+		if(manifestFile.read<Misc::UInt64>()!=fileState.inode)
+			return false;
+		if(manifestFile.read<Misc::UInt64>()!=fileState.modTime)
+			return false;
+		if(manifestFile.read<Misc::UInt64>()!=fileState.changeTime)
+			return false;
+		if(manifestFile.read<Misc::UInt64>()!=blockSize)
+			return false;
+		
+		/* Read the block checksums: */
+		size_t numBlocks=size_t((fileSize+blockSize-1)/blockSize);
+		blockChecksums.resize(numBlocks);
+		if(numBlocks>0)
+			manifestFile.read(&blockChecksums[0],numBlocks);
+		
+		return true;
+		}
+	catch(std::runtime_error err)
+		{
+		/* Treat unreadable cache files as missing: */
+		return false;
+		}
+	}
+
+void FileManifest::saveCache(const char* manifestFileName,const FileManifest::FileState& fileState) const
+	{
+	/* Write into a temporary file first, as several processes might cache the same manifest concurrently: */
+	char tempFileName[2048];
+	snprintf(tempFileName,sizeof(tempFileName),"%s.%d.tmp",manifestFileName,int(getpid()));
+		{
+		/* Open the temporary file; it is closed at the end of this block: */
+		Misc::File manifestFile(tempFileName,"wb",Misc::File::LittleEndian);
+		
+		/* Write the cache file's header: */
+		manifestFile.write(manifestFileMagic,sizeof(manifestFileMagic));
+		manifestFile.write<Misc::UInt32>(Misc::UInt32(manifestFileVersion));
+		manifestFile.write<Misc::UInt64>(fileSize);
+		manifestFile.write<Misc::UInt64>(fileState.device);
+		manifestFile.write<Misc::UInt64>(fileState.inode);
+		manifestFile.write<Misc::UInt64>(fileState.modTime);
+		manifestFile.write<Misc::UInt64>(fileState.changeTime);
+		manifestFile.write<Misc::UInt64>(blockSize);
+		
+		/* Write the block checksums: */
+		if(!blockChecksums.empty())
+			manifestFile.write(&blockChecksums[0],blockChecksums.size());
+		}
+	
+	/* Replace the cache file: */
+	if(rename(tempFileName,manifestFileName)!=0)
+		{
+		remove(tempFileName);
+		Misc::throwStdErr("FileManifest::saveCache: Unable to create manifest file \"%s\"",manifestFileName);
+		}
+	}
+
+FileManifest::FileManifest(void)
+	:fileSize(0),blockSize(defaultBlockSize)
+	{
+	}
+
+Misc::UInt64 FileManifest::calcChecksum(const void* data,size_t size,Misc::UInt64 seed)
+	{
+	/* Include the data size in the initial hash so that trailing zeros are significant: */
+	Misc::UInt64 hash=mixWord(seed,Misc::UInt64(size));
+	
+	/* Process the data in 64-bit words: */
+	const unsigned char* dPtr=static_cast<const unsigned char*>(data);
+	for(;size>=sizeof(Misc::UInt64);size-=sizeof(Misc::UInt64),dPtr+=sizeof(Misc::UInt64))
+		{
+		Misc::UInt64 word;
+		memcpy(&word,dPtr,sizeof(Misc::UInt64));
+		hash=mixWord(hash,word);
+		}
+	
+	/* Process the remaining bytes as a zero-padded word: */
+	if(size>0)
+		{
+		Misc::UInt64 word=0;
+		memcpy(&word,dPtr,size);
+		hash=mixWord(hash,word);
+		}
+	
+	/* Avalanche the final hash value: */
+	hash^=hash>>33;
+	hash*=0xff51afd7ed558ccdULL;
+	hash^=hash>>33;
+	hash*=0xc4ceb9fe1a85ec53ULL;
+	hash^=hash>>33;
+	return hash;
+	}
+
+void FileManifest::compute(const char* fileName,size_t newBlockSize)
+	{
+	/* Open the file: */
+	int fd=open(fileName,O_RDONLY);
+	if(fd<0)
+		Misc::throwStdErr("FileManifest::compute: Unable to open file \"%s\" due to error %s",fileName,strerror(errno));
+	
+	/* Read the file one block at a time: */
+	blockSize=newBlockSize;
+	fileSize=0;
+	blockChecksums.clear();
+	std::vector<unsigned char> buffer(blockSize);
+	while(true)
+		{
+		/* Fill the block buffer: */
+		size_t blockFill=0;
+		while(blockFill<blockSize)
+			{
+			ssize_t readSize=::read(fd,&buffer[blockFill],blockSize-blockFill);
+			if(readSize<0&&errno!=EINTR)
+				{
+				int error=errno;
+				close(fd);
+				Misc::throwStdErr("FileManifest::compute: Error %s while reading file \"%s\"",strerror(error),fileName);
+				}
+			if(readSize==0)
+				break;
+			if(readSize>0)
+				blockFill+=size_t(readSize);
+			}
+		if(blockFill==0)
+			break;
+		
+		/* Checksum the block, seeded by its index to detect reordered blocks: */
+		blockChecksums.push_back(calcChecksum(&buffer[0],blockFill,Misc::UInt64(blockChecksums.size())));
+		fileSize+=blockFill;
+		if(blockFill<blockSize)
+			break;
+		}
+	
+	close(fd);
+	}
+
+void FileManifest::get(const char* fileName,size_t newBlockSize)
+	{
+	/* Get the file's size and identity; the modification time alone does not tell a copy with preserved time stamps from the original: */
+	struct stat fileStats;
+	if(stat(fileName,&fileStats)!=0)
+		Misc::throwStdErr("FileManifest::get: Unable to access file \"%s\" due to error %s",fileName,strerror(errno));
+	FileState fileState;
+	fileState.device=Misc::UInt64(fileStats.st_dev);
+	fileState.inode=Misc::UInt64(fileStats.st_ino);
+	#ifdef __APPLE__
+	fileState.modTime=getTime(fileStats.st_mtimespec);
+	fileState.changeTime=getTime(fileStats.st_ctimespec);
+	#else
+	fileState.modTime=getTime(fileStats.st_mtim);
+	fileState.changeTime=getTime(fileStats.st_ctim);
+	#endif
+	
+	/* Try loading a current manifest from the cache file: */
+	std::string manifestFileName=fileName;
+	manifestFileName.append(".manifest");
+	fileSize=Misc::UInt64(fileStats.st_size);
+	blockSize=newBlockSize;
+	if(loadCache(manifestFileName.c_str(),fileState))
+		return;
+	
+	/* Compute the manifest and cache it if the file's directory is writable: */
+	compute(fileName,newBlockSize);
+	try
+		{
+		saveCache(manifestFileName.c_str(),fileState);
+		}
+	catch(std::runtime_error err)
+		{
+		/* Caching is optional; ignore the error */
+		}
+	}
+
+bool FileManifest::operator==(const FileManifest& other) const
+	{
+	return fileSize==other.fileSize&&blockSize==other.blockSize&&blockChecksums==other.blockChecksums;
+	}
+
+size_t FileManifest::findMismatch(const FileManifest& other) const
+	{
+	if(fileSize!=other.fileSize||blockSize!=other.blockSize)
+		return 0;
+	
+	size_t numBlocks=blockChecksums.size();
+	for(size_t i=0;i<numBlocks;++i)
+		if(blockChecksums[i]!=other.blockChecksums[i])
+			return i;
+	return numBlocks;
+	}
+
+void FileManifest::write(Cluster::MulticastPipe& pipe) const
+	{
+	pipe.write<Misc::UInt64>(fileSize);
+	pipe.write<Misc::UInt64>(blockSize);
+	pipe.write<Misc::UInt64>(Misc::UInt64(blockChecksums.size()));
+	if(!blockChecksums.empty())
+		pipe.write<Misc::UInt64>(&blockChecksums[0],blockChecksums.size());
+	pipe.flush();
+	}
+
+void FileManifest::read(Cluster::MulticastPipe& pipe)
+	{
+	fileSize=pipe.read<Misc::UInt64>();
+	blockSize=pipe.read<Misc::UInt64>();
+	size_t numBlocks=size_t(pipe.read<Misc::UInt64>());
+	blockChecksums.resize(numBlocks);
+	if(numBlocks>0)
+		pipe.read<Misc::UInt64>(&blockChecksums[0],numBlocks);
+	}
+
+}
+
+}
@@ -0,0 +1,91 @@
+/***********************************************************************
+FileManifest - Class for block checksum manifests verifying that copies
+of data files on different cluster nodes are identical.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_ABSTRACT_FILEMANIFEST_INCLUDED
+#define VISUALIZATION_ABSTRACT_FILEMANIFEST_INCLUDED
+
+#include <stddef.h>
+#include <vector>
+#include <Misc/SizedTypes.h>
+
+/* Forward declarations: */
+namespace Cluster {
+class MulticastPipe;
+}
+
+namespace Visualization {
+
+namespace Abstract {
+
+class FileManifest
+	{
+	/* Embedded classes: */
+	private:
+	struct FileState // Structure identifying the state of a described file to validate manifest cache files
+		{
+		/* Elements: */
+		public:
+		Misc::UInt64 device,inode; // Device and inode numbers of the file; a copy of a file is a different inode
+		Misc::UInt64 modTime; // Modification time of the file in nanoseconds; can be preserved or reset when copying
+		Misc::UInt64 changeTime; // Status change time of the file in nanoseconds; cannot be set by applications
+		};
+	
+	/* Elements: */
+	public:
+	static const size_t defaultBlockSize=16*1024*1024; // Default size of checksummed file blocks in bytes
+	private:
+	static const Misc::UInt32 manifestFileVersion=2; // Version number of the manifest cache file format
+	Misc::UInt64 fileSize; // Size of the described file in bytes
+	Misc::UInt64 blockSize; // Size of checksummed file blocks in bytes
+	std::vector<Misc::UInt64> blockChecksums; // Checksums of all file blocks; the last block may be partial
+	
+	/* Private methods: */
+	bool loadCache(const char* manifestFileName,const FileState& fileState); // Loads a manifest cache file if it describes the current state of the file
+	void saveCache(const char* manifestFileName,const FileState& fileState) const; // Saves the manifest to a cache file
+	
+	/* Constructors and destructors: */
+	public:
+	FileManifest(void); // Creates an empty manifest
+	
+	/* Methods: */
+	static Misc::UInt64 calcChecksum(const void* data,size_t size,Misc::UInt64 seed); // Calculates a 64-bit checksum of the given data
+	void compute(const char* fileName,size_t newBlockSize =defaultBlockSize); // Computes the manifest by reading the entire file
+	void get(const char* fileName,size_t newBlockSize =defaultBlockSize); // Loads the manifest from the file's cache file "<fileName>.manifest" if it is current, or computes the manifest and tries to cache it
+	Misc::UInt64 getFileSize(void) const // Returns the size of the described file
+		{
+		return fileSize;
+		}
+	size_t getNumBlocks(void) const // Returns the number of checksummed blocks
+		{
+		return blockChecksums.size();
+		}
+	bool operator==(const FileManifest& other) const; // Returns true if the two manifests describe identical files
+	size_t findMismatch(const FileManifest& other) const; // Returns the index of the first block that differs from the other manifest, for diagnostics; differing file or block sizes mismatch at block 0
+	void write(Cluster::MulticastPipe& pipe) const; // Sends the manifest across the given pipe
+	void read(Cluster::MulticastPipe& pipe); // Receives a manifest from the given pipe
+	};
+
+}
+
+}
+
+#endif
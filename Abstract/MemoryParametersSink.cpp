@@ -0,0 +1,69 @@
+/***********************************************************************
+MemoryParametersSink - Class for parameter sinks writing into an
+in-memory list of encoded values.
+Part of the abstract interface to the templatized visualization
+components.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Abstract/MemoryParametersSink.h>
+
+#include <Misc/StandardValueCoders.h>
+
+namespace Visualization {
+
+namespace Abstract {
+
+/*************************************
+Methods of class MemoryParametersSink:
+*************************************/
+
+MemoryParametersSink::MemoryParametersSink(const VariableManager* sVariableManager,MemoryParametersSink::ValueList& sValues)
+	:ParametersSink(sVariableManager),
+	 values(sValues)
+	{
+	}
+
+void MemoryParametersSink::write(const char* name,const WriterBase& value)
+	{
+	/* Encode the value into a new list entry: */
+	values.push_back(Value());
+	values.back().name=name;
+	value.write(values.back().value);
+	}
+
+void MemoryParametersSink::writeScalarVariable(const char* name,int scalarVariableIndex)
+	{
+	/* Write the variable index directly; the list never leaves the variable manager that created it: */
+	values.push_back(Value());
+	values.back().name=name;
+	values.back().value=Misc::ValueCoder<int>::encode(scalarVariableIndex);
+	}
+
+void MemoryParametersSink::writeVectorVariable(const char* name,int vectorVariableIndex)
+	{
+	/* Write the variable index directly: */
+	values.push_back(Value());
+	values.back().name=name;
+	values.back().value=Misc::ValueCoder<int>::encode(vectorVariableIndex);
+	}
+
+}
+
+}
@@ -0,0 +1,78 @@
+/***********************************************************************
+MemoryParametersSource - Class for parameter sources reading from an
+in-memory list of encoded values.
+Part of the abstract interface to the templatized visualization
+components.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Abstract/MemoryParametersSource.h>
+
+#include <string.h>
+#include <Misc/ThrowStdErr.h>
+#include <Misc/StandardValueCoders.h>
+
+namespace Visualization {
+
+namespace Abstract {
+
+/***************************************
+Methods of class MemoryParametersSource:
+***************************************/
+
+const std::string& MemoryParametersSource::getNextValue(const char* name)
+	{
+	/* Check that the next value is the requested one: */
+	if(nextValue==values.end())
+		Misc::throwStdErr("MemoryParametersSource::read: Attempt to read past end of value list while reading %s",name);
+	if(strcmp(nextValue->name.c_str(),name)!=0)
+		Misc::throwStdErr("MemoryParametersSource::read: Expected value %s, got %s",name,nextValue->name.c_str());
+	
+	/* Return the value's encoding and advance: */
+	const std::string& result=nextValue->value;
+	++nextValue;
+	return result;
+	}
+
+MemoryParametersSource::MemoryParametersSource(VariableManager* sVariableManager,const MemoryParametersSource::ValueList& sValues)
+	:ParametersSource(sVariableManager),
+	 values(sValues),nextValue(values.begin())
+	{
+	}
+
+void MemoryParametersSource::read(const char* name,const ReaderBase& value)
+	{
+	value.read(getNextValue(name));
+	}
+
+void MemoryParametersSource::readScalarVariable(const char* name,int& scalarVariableIndex)
+	{
+	const std::string& valueString=getNextValue(name);
+	scalarVariableIndex=Misc::ValueCoder<int>::decode(valueString.data(),valueString.data()+valueString.length());
+	}
+
+void MemoryParametersSource::readVectorVariable(const char* name,int& vectorVariableIndex)
+	{
+	const std::string& valueString=getNextValue(name);
+	vectorVariableIndex=Misc::ValueCoder<int>::decode(valueString.data(),valueString.data()+valueString.length());
+	}
+
+}
+
+}
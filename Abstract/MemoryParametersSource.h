@@ -0,0 +1,65 @@
+/***********************************************************************
+MemoryParametersSource - Class for parameter sources reading from an
+in-memory list of encoded values.
+Part of the abstract interface to the templatized visualization
+components.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_ABSTRACT_MEMORYPARAMETERSSOURCE_INCLUDED
+#define VISUALIZATION_ABSTRACT_MEMORYPARAMETERSSOURCE_INCLUDED
+
+#include <Abstract/VariableManager.h>
+#include <Abstract/ParametersSource.h>
+#include <Abstract/MemoryParametersSink.h>
+
+namespace Visualization {
+
+namespace Abstract {
+
+class MemoryParametersSource:public ParametersSource
+	{
+	/* Embedded classes: */
+	public:
+	typedef MemoryParametersSink::Value Value; // Type for named values in encoded form
+	typedef MemoryParametersSink::ValueList ValueList; // Type for lists of encoded values
+	
+	/* Elements: */
+	private:
+	const ValueList& values; // The list of encoded values
+	ValueList::const_iterator nextValue; // The next value to be read
+	
+	/* Private methods: */
+	const std::string& getNextValue(const char* name); // Returns the next value's encoding after checking its name
+	
+	/* Constructors and destructors: */
+	public:
+	MemoryParametersSource(VariableManager* sVariableManager,const ValueList& sValues);
+	
+	/* Methods from ParametersSource: */
+	virtual void read(const char* name,const ReaderBase& value);
+	virtual void readScalarVariable(const char* name,int& scalarVariableIndex);
+	virtual void readVectorVariable(const char* name,int& vectorVariableIndex);
+	};
+
+}
+
+}
+
+#endif
@@ -25,12 +25,18 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Abstract/Module.h>
 
+#include <stdio.h>
 #include <string.h>
+#include <iostream>
+#include <stdexcept>
 #include <Misc/ThrowStdErr.h>
 #include <IO/OpenFile.h>
+#include <Cluster/GatherOperation.h>
 #include <Cluster/MulticastPipe.h>
 #include <Cluster/OpenFile.h>
 
+#include <Abstract/FileManifest.h>
+
 namespace Visualization {
 
 namespace Abstract {
@@ -39,6 +45,80 @@ namespace Abstract {
 Methods of class Module:
 ***********************/
 
+std::string Module::getNodePath(std::string fileName,unsigned int nodeIndex) const
+	{
+	/* Use the same path as the master node if there are no replicas, or the file name is fully-qualified: */
+	if(replicaDirectory.empty()||fileName.empty()||fileName[0]=='/')
+		return getFullPath(fileName);
+	
+	/* Replace the node index placeholder in the replica directory: */
+	std::string result;
+	for(std::string::const_iterator rdIt=replicaDirectory.begin();rdIt!=replicaDirectory.end();++rdIt)
+		{
+		if(*rdIt=='%'&&rdIt+1!=replicaDirectory.end()&&rdIt[1]=='d')
+			{
+			char indexBuffer[16];
+			snprintf(indexBuffer,sizeof(indexBuffer),"%u",nodeIndex);
+			result.append(indexBuffer);
+			++rdIt;
+			}
+		else
+			result.push_back(*rdIt);
+		}
+	
+	/* Concatenate the file name to the replica directory: */
+	if(result[result.length()-1]!='/')
+		result.push_back('/');
+	result.append(fileName);
+	return result;
+	}
+
+bool Module::verifyNodeFiles(const std::string& nodePath,Cluster::MulticastPipe* pipe)
+	{
+	/* Get the manifest of this node's copy of the file: */
+	FileManifest nodeManifest;
+	bool ok=true;
+	try
+		{
+		nodeManifest.get(nodePath.c_str());
+		}
+	catch(std::runtime_error err)
+		{
+		std::cerr<<"Module::verifyNodeFiles: Node "<<pipe->getNodeIndex()<<" cannot read its copy of file "<<nodePath<<" due to exception "<<err.what()<<std::endl;
+		ok=false;
+		}
+	
+	if(pipe->isMaster())
+		{
+		/* Send the master node's manifest to the slave nodes: */
+		pipe->write<unsigned int>(ok?1U:0U);
+		if(ok)
+			nodeManifest.write(*pipe);
+		else
+			pipe->flush();
+		}
+	else
+		{
+		/* Compare this node's manifest to the master node's: */
+		bool masterOk=pipe->read<unsigned int>()!=0;
+		if(masterOk)
+			{
+			FileManifest masterManifest;
+			masterManifest.read(*pipe);
+			if(ok&&!(nodeManifest==masterManifest))
+				{
+				std::cerr<<"Module::verifyNodeFiles: Node "<<pipe->getNodeIndex()<<"'s copy of file "<<nodePath<<" differs from the master node's starting at block "<<masterManifest.findMismatch(nodeManifest)<<std::endl;
+				ok=false;
+				}
+			}
+		else
+			ok=false;
+		}
+	
+	/* Use direct access only if all nodes agree: */
+	return pipe->gather(ok?1U:0U,Cluster::GatherOperation::AND)!=0;
+	}
+
 std::string Module::makeVectorSliceName(std::string vectorName,int sliceIndex)
 	{
 	std::string result=vectorName;
@@ -74,7 +154,20 @@ std::string Module::getFullPath(std::string fileName) const
 IO::FilePtr Module::openFile(std::string fileName,Cluster::MulticastPipe* pipe) const
 	{
 	if(pipe!=0)
+		{
+		if(directFileAccess)
+			{
+			/* Let each node read its own copy of the file if all copies match: */
+			std::string nodePath=getNodePath(fileName,pipe->getNodeIndex());
+			if(verifyNodeFiles(nodePath,pipe))
+				return IO::openFile(nodePath.c_str());
+			
+			if(pipe->isMaster())
+				std::cerr<<"Module::openFile: Falling back to broadcasting file "<<getFullPath(fileName)<<" from the master node"<<std::endl;
+			}
+		
 		return Cluster::openFile(pipe->getMultiplexer(),getFullPath(fileName).c_str());
+		}
 	else
 		return IO::openFile(getFullPath(fileName).c_str());
 	}
@@ -82,14 +175,28 @@ IO::FilePtr Module::openFile(std::string fileName,Cluster::MulticastPipe* pipe)
 IO::SeekableFilePtr Module::openSeekableFile(std::string fileName,Cluster::MulticastPipe* pipe) const
 	{
 	if(pipe!=0)
+		{
+		if(directFileAccess)
+			{
+			/* Let each node read its own copy of the file if all copies match: */
+			std::string nodePath=getNodePath(fileName,pipe->getNodeIndex());
+			if(verifyNodeFiles(nodePath,pipe))
+				return IO::openSeekableFile(nodePath.c_str());
+			
+			if(pipe->isMaster())
+				std::cerr<<"Module::openSeekableFile: Falling back to broadcasting file "<<getFullPath(fileName)<<" from the master node"<<std::endl;
+			}
+		
 		return Cluster::openSeekableFile(pipe->getMultiplexer(),getFullPath(fileName).c_str());
+		}
 	else
 		return IO::openSeekableFile(getFullPath(fileName).c_str());
 	}
 
 Module::Module(const char* sClassName)
 	:Plugins::Factory(sClassName),
-	 baseDirectory("")
+	 baseDirectory(""),
+	 directFileAccess(false)
 	{
 	}
 
@@ -107,6 +214,12 @@ void Module::setBaseDirectory(std::string newBaseDirectory)
 		baseDirectory.push_back('/');
 	}
 
+void Module::setDirectFileAccess(bool newDirectFileAccess,std::string newReplicaDirectory)
+	{
+	directFileAccess=newDirectFileAccess;
+	replicaDirectory=newReplicaDirectory;
+	}
+
 int Module::getNumScalarAlgorithms(void) const
 	{
 	return 0;
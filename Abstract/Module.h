@@ -57,12 +57,18 @@ class Module:public Plugins::Factory
 	/* Elements: */
 	private:
 	std::string baseDirectory; // Base directory for all input files
+	bool directFileAccess; // Flag whether all cluster nodes read input files directly instead of receiving them from the master node
+	std::string replicaDirectory; // Base directory of node-local replicas of input files in direct access mode; "%d" is replaced by the node index; empty to use base directory
+	
+	/* Private methods: */
+	std::string getNodePath(std::string fileName,unsigned int nodeIndex) const; // Returns the path under which the given cluster node reads the given file in direct access mode
+	static bool verifyNodeFiles(const std::string& nodePath,Cluster::MulticastPipe* pipe); // Checks whether all cluster nodes' copies of a file match the master node's; must be called on all nodes
 	
 	/* Protected methods: */
 	protected:
 	static std::string makeVectorSliceName(std::string vectorName,int sliceIndex); // Creates a scalar slice name for a vector component
 	std::string getFullPath(std::string fileName) const; // Returns the full path name of the given file relative to the base directory
-	IO::FilePtr openFile(std::string fileName,Cluster::MulticastPipe* pipe) const; // Opens the given file relative to the base directory
+	IO::FilePtr openFile(std::string fileName,Cluster::MulticastPipe* pipe) const; // Opens the given file relative to the base directory; in a cluster, all nodes read the file directly if direct access is enabled and all copies match, or the master node reads and broadcasts it
 	IO::SeekableFilePtr openSeekableFile(std::string fileName,Cluster::MulticastPipe* pipe) const; // Ditto, for seekable files
 	
 	/* Constructors and destructors: */
@@ -76,6 +82,7 @@ class Module:public Plugins::Factory
 	
 	/* Methods: */
 	void setBaseDirectory(std::string newBaseDirectory); // Sets the base directory for all following file operations
+	void setDirectFileAccess(bool newDirectFileAccess,std::string newReplicaDirectory); // Enables or disables direct file access by all cluster nodes, with an optional node-local replica directory
 	virtual DataSet* load(const std::vector<std::string>& args,Cluster::MulticastPipe* pipe) const =0; // Loads a data set from the given list of arguments
 	virtual DataSetRenderer* getRenderer(const DataSet* dataSet) const =0; // Creates a renderer for the given data set
 	virtual int getNumScalarAlgorithms(void) const; // Returns number of available visualization algorithms
@@ -52,6 +52,10 @@ class Parameters
 	virtual Parameters* clone(void) const =0; // Returns an exact copy of the parameter object
 	virtual void write(ParametersSink& sink) const =0; // Writes parameters to a parameter sink
 	virtual void read(ParametersSource& source) =0; // Reads parameters from a parameter source
+	virtual bool setColorScalarVariable(int newColorScalarVariableIndex) // Changes the scalar variable used to color the extracted element; returns false if the parameters do not define a color variable
+		{
+		return false;
+		}
 	};
 
 }
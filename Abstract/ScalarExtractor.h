@@ -52,6 +52,13 @@ class ScalarExtractor
 	
 	/* Methods: */
 	virtual ScalarExtractor* clone(void) const =0; // Returns an identical copy of the scalar extractor object
+	virtual bool isMaterialized(void) const // Returns true if the extractor reads precomputed values instead of evaluating data values
+		{
+		return false;
+		}
+	virtual void dematerialize(void) // Makes the extractor evaluate data values again; copies made earlier keep their precomputed values
+		{
+		}
 	};
 
 }
@@ -25,6 +25,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <string.h>
 #include <stdio.h>
 #include <stdexcept>
+#include <vector>
+#include <Misc/ThrowStdErr.h>
 #include <Misc/CreateNumberedFileName.h>
 #include <GL/gl.h>
 #include <GL/GLContextData.h>
@@ -53,7 +55,8 @@ VariableManager::ScalarVariable::ScalarVariable(void)
 	:scalarExtractor(0),
 	 colorMap(0),
 	 colorMapVersion(0),
-	 palette(0)
+	 palette(0),
+	 materializedSize(0),lastUse(0)
 	{
 	}
 
@@ -87,18 +90,131 @@ VariableManager::DataItem::~DataItem(void)
 	delete[] colorMapVersions;
 	}
 
+/*************************************************
+Methods of class VariableManager::SliceUpdateLock:
+*************************************************/
+
+VariableManager::SliceUpdateLock::SliceUpdateLock(VariableManager* sVariableManager)
+	:variableManager(sVariableManager)
+	{
+	Threads::Mutex::Lock extractorUseLock(variableManager->extractorUseMutex);
+	
+	/* Block new readers, and wait until all current readers are done: */
+	if(variableManager->sliceUpdateDepth++==0)
+		{
+		while(variableManager->numExtractorUsers!=0)
+			variableManager->extractorUseCond.wait(variableManager->extractorUseMutex);
+		}
+	}
+
+VariableManager::SliceUpdateLock::~SliceUpdateLock(void)
+	{
+	Threads::Mutex::Lock extractorUseLock(variableManager->extractorUseMutex);
+	
+	/* Let blocked readers continue: */
+	if(--variableManager->sliceUpdateDepth==0)
+		variableManager->extractorUseCond.broadcast();
+	}
+
 /********************************
 Methods of class VariableManager:
 ********************************/
 
+void VariableManager::touchScalarVariable(int scalarVariableIndex)
+	{
+	scalarVariables[scalarVariableIndex].lastUse=++useCounter;
+	}
+
+bool VariableManager::evictMaterializedScalarVariable(int keepScalarVariableIndex)
+	{
+	/* Find the least recently used materialized scalar variable: */
+	int evictIndex=-1;
+	for(int i=0;i<numScalarVariables;++i)
+		{
+		const ScalarVariable& sv=scalarVariables[i];
+		if(sv.materializedSize!=0&&i!=keepScalarVariableIndex&&i!=currentScalarVariableIndex&&(evictIndex<0||sv.lastUse<scalarVariables[evictIndex].lastUse))
+			evictIndex=i;
+		}
+	if(evictIndex<0)
+		return false;
+	
+	/* Make the scalar variable's extractor evaluate data values again: */
+	ScalarVariable& sv=scalarVariables[evictIndex];
+	sv.scalarExtractor->dematerialize();
+	materializedSize-=sv.materializedSize;
+	sv.materializedSize=0;
+	
+	return true;
+	}
+
+void VariableManager::materializeScalarVariable(int scalarVariableIndex)
+	{
+	ScalarVariable& sv=scalarVariables[scalarVariableIndex];
+	if(materializationBudget==0||scalarVariableIndex>=numScalarVariables||sv.materializedSize!=0)
+		return;
+	
+	/* Leave the extractor alone if requested from a background thread, which might be reading from other extractors itself: */
+	if(!pthread_equal(pthread_self(),mainThread))
+		return;
+	
+	/* Wait until no background thread reads from any scalar extractor: */
+	SliceUpdateLock sliceUpdateLock(this);
+	
+	/* Materialize the scalar variable's extractor: */
+	sv.materializedSize=dataSet->materializeScalarExtractor(sv.scalarExtractor);
+	materializedSize+=sv.materializedSize;
+	
+	/* Dematerialize least recently used scalar variables until the budget is met again: */
+	while(materializedSize>materializationBudget&&evictMaterializedScalarVariable(scalarVariableIndex))
+		;
+	
+	/* Dematerialize the new scalar variable itself if it does not fit: */
+	if(materializedSize>materializationBudget)
+		{
+		sv.scalarExtractor->dematerialize();
+		materializedSize-=sv.materializedSize;
+		sv.materializedSize=0;
+		}
+	}
+
+void VariableManager::materializeScalarVariables(int numScalarVariableIndices,const int scalarVariableIndices[])
+	{
+	if(materializationBudget==0||numScalarVariableIndices<=0||!pthread_equal(pthread_self(),mainThread))
+		return;
+	
+	/* Wait until no background thread reads from any scalar extractor: */
+	SliceUpdateLock sliceUpdateLock(this);
+	
+	/* Transpose the scalar variables' values in a single pass: */
+	std::vector<ScalarExtractor*> scalarExtractors(numScalarVariableIndices);
+	for(int i=0;i<numScalarVariableIndices;++i)
+		scalarExtractors[i]=scalarVariables[scalarVariableIndices[i]].scalarExtractor;
+	std::vector<size_t> sliceSizes(numScalarVariableIndices);
+	dataSet->materializeScalarExtractors(numScalarVariableIndices,&scalarExtractors[0],&sliceSizes[0]);
+	for(int i=0;i<numScalarVariableIndices;++i)
+		{
+		scalarVariables[scalarVariableIndices[i]].materializedSize=sliceSizes[i];
+		materializedSize+=sliceSizes[i];
+		}
+	
+	/* Dematerialize least recently used scalar variables until the budget is met again: */
+	while(materializedSize>materializationBudget&&evictMaterializedScalarVariable(-1))
+		;
+	}
+
 void VariableManager::prepareScalarVariable(int scalarVariableIndex)
 	{
 	ScalarVariable& sv=scalarVariables[scalarVariableIndex];
 	
         if(scalarVariableIndex < numScalarVariables)
                 {
-                /* Get a new scalar extractor: */
-                sv.scalarExtractor=dataSet->getScalarExtractor(scalarVariableIndex);
+                /* Get a new scalar extractor unless it was already created during bulk materialization: */
+                if(sv.scalarExtractor==0)
+                        {
+                        sv.scalarExtractor=dataSet->getScalarExtractor(scalarVariableIndex);
+                        materializeScalarVariable(scalarVariableIndex);
+                        }
+                touchScalarVariable(scalarVariableIndex);
 
                 /* Calculate the scalar extractor's value range: */
                 sv.valueRange=dataSet->calcScalarValueRange(sv.scalarExtractor);
@@ -158,7 +274,11 @@ VariableManager::VariableManager(const DataSet* sDataSet,const char* sDefaultCol
 	 colorBarDialogPopup(0),colorBar(0),
 	 paletteEditor(0),
 	 vectorExtractors(0), colorMapLIC(0),
-	 currentScalarVariableIndex(-1),currentVectorVariableIndex(-1)
+	 currentScalarVariableIndex(-1),currentVectorVariableIndex(-1),
+	 mask(0),
+	 materializationBudget(0),materializedSize(0),useCounter(0),
+	 mainThread(pthread_self()),
+	 numExtractorUsers(0),sliceUpdateDepth(0)
 	{
 	if(sDefaultColorMapName!=0)
 		{
@@ -230,6 +350,68 @@ void VariableManager::initContext(GLContextData& contextData) const
 	contextData.addDataItem(this,dataItem);
 	}
 
+void VariableManager::setDataSet(const DataSet* newDataSet)
+	{
+	/* Check that the new data set has the same variables: */
+	if(newDataSet->getNumScalarVariables()!=numScalarVariables||newDataSet->getNumVectorVariables()!=numVectorVariables)
+		Misc::throwStdErr("VariableManager::setDataSet: New data set has different variables");
+	
+	dataSet=newDataSet;
+	
+	/* Re-create the extractors of all scalar variables that have been requested before: */
+	std::vector<int> rematerializeIndices;
+	for(int i=0;i<numScalarVariables;++i)
+		{
+		ScalarVariable& sv=scalarVariables[i];
+		if(sv.scalarExtractor!=0)
+			{
+			delete sv.scalarExtractor;
+			sv.scalarExtractor=dataSet->getScalarExtractor(i);
+			
+			/* Remember to re-materialize the scalar variable if it was materialized before: */
+			if(sv.materializedSize!=0)
+				{
+				materializedSize-=sv.materializedSize;
+				sv.materializedSize=0;
+				rematerializeIndices.push_back(i);
+				}
+			}
+		}
+	
+	/* Transpose the new data set's values for all previously materialized scalar variables in a single pass: */
+	if(!rematerializeIndices.empty())
+		materializeScalarVariables(int(rematerializeIndices.size()),&rematerializeIndices[0]);
+	
+	for(int i=0;i<numScalarVariables;++i)
+		{
+		ScalarVariable& sv=scalarVariables[i];
+		if(sv.scalarExtractor!=0)
+			{
+			/* Grow the variable's value range to include the new data set, but leave the color map range alone: */
+			DataSet::VScalarRange newRange=dataSet->calcScalarValueRange(sv.scalarExtractor);
+			if(sv.valueRange.first>newRange.first)
+				sv.valueRange.first=newRange.first;
+			if(sv.valueRange.second<newRange.second)
+				sv.valueRange.second=newRange.second;
+			}
+		}
+	
+	/* Re-create the extractors of all vector variables that have been requested before: */
+	for(int i=0;i<numVectorVariables;++i)
+		if(vectorExtractors[i]!=0)
+			{
+			delete vectorExtractors[i];
+			vectorExtractors[i]=dataSet->getVectorExtractor(i);
+			}
+	
+	/* Update the color bar's value range: */
+	if(currentScalarVariableIndex>=0&&currentScalarVariableIndex<numScalarVariables)
+		{
+		const ScalarVariable& sv=scalarVariables[currentScalarVariableIndex];
+		colorBar->setValueRange(sv.valueRange.first,sv.valueRange.second);
+		}
+	}
+
 const DataSet* VariableManager::getDataSetByScalarVariable(int scalarVariableIndex) const
 	{
 	if(scalarVariableIndex<0||scalarVariableIndex>=numScalarVariables)
@@ -274,6 +456,8 @@ void VariableManager::setCurrentScalarVariable(int newCurrentScalarVariableIndex
 	ScalarVariable& sv=scalarVariables[newCurrentScalarVariableIndex];
 	if(sv.scalarExtractor==0)
 		prepareScalarVariable(newCurrentScalarVariableIndex);
+	else if(newCurrentScalarVariableIndex<numScalarVariables)
+		touchScalarVariable(newCurrentScalarVariableIndex);
 	
 	/* Save the palette editor's current palette: */
 	if(currentScalarVariableIndex>=0)
@@ -342,6 +526,86 @@ void VariableManager::setCurrentVectorVariable(int newCurrentVectorVariableIndex
 	currentVectorVariableIndex=newCurrentVectorVariableIndex;
 	}
 
+void VariableManager::setMaterializationBudget(size_t newMaterializationBudget)
+	{
+	materializationBudget=newMaterializationBudget;
+	
+	/* Wait until no background thread reads from any scalar extractor: */
+	SliceUpdateLock sliceUpdateLock(this);
+	
+	/* Dematerialize scalar variables until the new budget is met: */
+	if(materializationBudget==0)
+		{
+		for(int i=0;i<numScalarVariables;++i)
+			{
+			ScalarVariable& sv=scalarVariables[i];
+			if(sv.materializedSize!=0)
+				{
+				sv.scalarExtractor->dematerialize();
+				sv.materializedSize=0;
+				}
+			}
+		materializedSize=0;
+		}
+	else
+		{
+		while(materializedSize>materializationBudget&&evictMaterializedScalarVariable(-1))
+			;
+		}
+	
+	/* Materialize the current scalar variable if it is not yet: */
+	if(currentScalarVariableIndex>=0&&currentScalarVariableIndex<numScalarVariables)
+		materializeScalarVariable(currentScalarVariableIndex);
+	}
+
+void VariableManager::lockScalarExtractors(void)
+	{
+	Threads::Mutex::Lock extractorUseLock(extractorUseMutex);
+	
+	/* Wait until the main thread is done changing materialized slices: */
+	while(sliceUpdateDepth!=0)
+		extractorUseCond.wait(extractorUseMutex);
+	++numExtractorUsers;
+	}
+
+void VariableManager::unlockScalarExtractors(void)
+	{
+	Threads::Mutex::Lock extractorUseLock(extractorUseMutex);
+	
+	/* Wake up the main thread if it is waiting for the last reader: */
+	if(--numExtractorUsers==0)
+		extractorUseCond.broadcast();
+	}
+
+void VariableManager::materializeAllScalarVariables(void)
+	{
+	/* Keep all scalar variables materialized regardless of their total size: */
+	materializationBudget=~size_t(0);
+	
+	/* Create the extractors of all scalar variables that have not been requested before, and collect all non-materialized scalar variables: */
+	std::vector<int> newIndices;
+	std::vector<int> materializeIndices;
+	for(int i=0;i<numScalarVariables;++i)
+		{
+		ScalarVariable& sv=scalarVariables[i];
+		if(sv.scalarExtractor==0)
+			{
+			sv.scalarExtractor=dataSet->getScalarExtractor(i);
+			newIndices.push_back(i);
+			}
+		if(sv.materializedSize==0)
+			materializeIndices.push_back(i);
+		}
+	
+	/* Transpose the data set's values: */
+	if(!materializeIndices.empty())
+		materializeScalarVariables(int(materializeIndices.size()),&materializeIndices[0]);
+	
+	/* Calculate value ranges and create color maps for the new scalar variables from their slices: */
+	for(std::vector<int>::iterator niIt=newIndices.begin();niIt!=newIndices.end();++niIt)
+		prepareScalarVariable(*niIt);
+	}
+
 const ScalarExtractor* VariableManager::getScalarExtractor(int scalarVariableIndex)
 	{
 	if(scalarVariableIndex<0||scalarVariableIndex>=numScalarVariables)
@@ -350,6 +614,8 @@ const ScalarExtractor* VariableManager::getScalarExtractor(int scalarVariableInd
 	/* Check if the scalar variable has not been requested before: */
 	if(scalarVariables[scalarVariableIndex].scalarExtractor==0)
 		prepareScalarVariable(scalarVariableIndex);
+	else
+		touchScalarVariable(scalarVariableIndex);
 	
 	return scalarVariables[scalarVariableIndex].scalarExtractor;
 	}
@@ -388,6 +654,20 @@ const GLColorMap* VariableManager::getColorMap(int scalarVariableIndex)
 	return scalarVariables[scalarVariableIndex].colorMap;
 	}
 
+bool VariableManager::isColorMapTransparent(int scalarVariableIndex)
+	{
+	const GLColorMap* colorMap=getColorMap(scalarVariableIndex);
+	if(colorMap==0)
+		return false;
+	
+	/* Check all color map entries' opacities: */
+	const GLColorMap::Color* colors=colorMap->getColors();
+	for(GLsizei i=0;i<colorMap->getNumEntries();++i)
+		if(colors[i][3]<1.0f)
+			return true;
+	return false;
+	}
+
 const DataSet::VScalarRange& VariableManager::getScalarColorMapRange(int scalarVariableIndex)
 	{
 	if(scalarVariableIndex<0||scalarVariableIndex>numScalarVariables)
@@ -23,6 +23,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_ABSTRACT_VARIABLEMANAGER_INCLUDED
 #define VISUALIZATION_ABSTRACT_VARIABLEMANAGER_INCLUDED
 
+#include <pthread.h>
+#include <Threads/Mutex.h>
+#include <Threads/Cond.h>
 #include <GL/gl.h>
 #include <GL/GLObject.h>
 #include <Abstract/DataSet.h>
@@ -61,7 +64,40 @@ class VariableManager:public GLObject
 		RAINBOW
 		};
 	
+	class ScalarExtractorLock // Class to keep the materialized slices of all scalar extractors unchanged while a background thread reads from them
+		{
+		/* Elements: */
+		private:
+		VariableManager* variableManager; // The locked variable manager
+		
+		/* Constructors and destructors: */
+		public:
+		ScalarExtractorLock(VariableManager* sVariableManager)
+			:variableManager(sVariableManager)
+			{
+			variableManager->lockScalarExtractors();
+			}
+		~ScalarExtractorLock(void)
+			{
+			variableManager->unlockScalarExtractors();
+			}
+		};
+	
 	private:
+	class SliceUpdateLock // Class to wait until no background thread reads from scalar extractors before changing their materialized slices
+		{
+		/* Elements: */
+		private:
+		VariableManager* variableManager; // The locked variable manager
+		
+		/* Constructors and destructors: */
+		public:
+		SliceUpdateLock(VariableManager* sVariableManager);
+		~SliceUpdateLock(void);
+		};
+	
+	friend class SliceUpdateLock;
+	
 	struct ScalarVariable // Structure containing state of a scalar variable
 		{
 		/* Elements: */
@@ -72,6 +108,8 @@ class VariableManager:public GLObject
 		unsigned int colorMapVersion; // Version number of the color map
 		DataSet::VScalarRange colorMapRange; // Scalar variable range that is mapped to the full extent of the color map
 		PaletteEditor::Storage* palette; // Pointer to palette editor state for the scalar variable
+		size_t materializedSize; // Size of the scalar extractor's materialized slice in bytes, or 0 if not materialized
+		unsigned int lastUse; // Value of the variable manager's use counter when the scalar variable was last requested
 		
 		/* Constructors and destructors: */
 		ScalarVariable(void);
@@ -107,8 +145,20 @@ class VariableManager:public GLObject
 	int currentScalarVariableIndex; // The index of the currently selected scalar variable
 	int currentVectorVariableIndex; // The index of the currently selected vector variable
         LICBrushMask* mask;
+	size_t materializationBudget; // Maximum total size of materialized scalar variables in bytes; 0 disables materialization
+	size_t materializedSize; // Current total size of materialized scalar variables in bytes
+	unsigned int useCounter; // Counter to track the order in which scalar variables were requested
+	pthread_t mainThread; // The thread that created the variable manager; only this thread changes materialized slices
+	Threads::Mutex extractorUseMutex; // Mutex protecting the scalar extractor use counts
+	Threads::Cond extractorUseCond; // Condition variable signalled when the scalar extractor use counts change
+	unsigned int numExtractorUsers; // Number of background threads currently reading from scalar extractors
+	unsigned int sliceUpdateDepth; // Nesting depth of materialized slice changes in progress on the main thread
 	
 	/* Private methods: */
+	void touchScalarVariable(int scalarVariableIndex); // Marks the given scalar variable as most recently used
+	bool evictMaterializedScalarVariable(int keepScalarVariableIndex); // Dematerializes the least recently used materialized scalar variable other than the given one and the current one; returns false if there was none; caller must hold a slice update lock
+	void materializeScalarVariable(int scalarVariableIndex); // Materializes the given scalar variable if it fits into the materialization budget
+	void materializeScalarVariables(int numScalarVariableIndices,const int scalarVariableIndices[]); // Materializes the given non-materialized scalar variables in a single pass over the data set's values, then restores the materialization budget
 	void prepareScalarVariable(int scalarVariableIndex);
 	void colorMapChangedCallback(Misc::CallbackData* cbData);
 	void savePaletteCallback(Misc::CallbackData* cbData);
@@ -122,6 +172,11 @@ class VariableManager:public GLObject
 	virtual void initContext(GLContextData& contextData) const;
 	
 	/* New methods: */
+	const DataSet* getDataSet(void) const // Returns the data set containing the scalar and vector variables
+		{
+		return dataSet;
+		}
+	void setDataSet(const DataSet* newDataSet); // Replaces the data set with one of identical layout, e.g., another time step; keeps color maps and palettes, but invalidates all extractors previously returned
 	int getNumScalarVariables(void) const // Returns the number of scalar variables in the data set
 		{
 		return numScalarVariables;
@@ -152,10 +207,25 @@ class VariableManager:public GLObject
 		}
 	void setCurrentScalarVariable(int newCurrentScalarVariable); // Sets the currently selected scalar variable
 	void setCurrentVectorVariable(int newCurrentVectorVariable); // Sets the currently selected vector variable
+	size_t getMaterializationBudget(void) const // Returns the maximum total size of materialized scalar variables in bytes
+		{
+		return materializationBudget;
+		}
+	void setMaterializationBudget(size_t newMaterializationBudget); // Sets the maximum total size of materialized scalar variables in bytes; 0 disables materialization and dematerializes all scalar variables
+	void lockScalarExtractors(void); // Blocks changes to scalar extractors' materialized slices until unlocked; called by background threads before reading from scalar extractors
+	void unlockScalarExtractors(void); // Allows changes to scalar extractors' materialized slices again
+	template <class ScalarExtractorParam>
+	ScalarExtractorParam pinScalarExtractor(const ScalarExtractorParam& scalarExtractor) // Returns a copy of the given templatized scalar extractor made while no materialized slices change; the copy keeps its slice alive, so background threads can read from it without holding the lock
+		{
+		ScalarExtractorLock scalarExtractorLock(this);
+		return scalarExtractor;
+		}
+	void materializeAllScalarVariables(void); // Transposes the data set's values into one slice per scalar variable in a single pass, and lifts the materialization budget to keep all slices
 	const ScalarExtractor* getScalarExtractor(int scalarVariableIndex); // Returns a new scalar extractor for the given scalar variable
 	int getScalarVariable(const ScalarExtractor* scalarExtractor) const; // Returns the index of the given scalar extractor
 	const DataSet::VScalarRange& getScalarValueRange(int scalarVariableIndex); // Returns the value range of the given scalar variable
 	const GLColorMap* getColorMap(int scalarVariableIndex); // Returns the color map for the given scalar variable
+	bool isColorMapTransparent(int scalarVariableIndex); // Returns true if any entry of the given scalar variable's color map is not fully opaque
 	const DataSet::VScalarRange& getScalarColorMapRange(int scalarVariableIndex); // Returns the value range of the given scalar variable that is mapped to the full extent of the color map
 	const VectorExtractor* getVectorExtractor(int vectorVariableIndex); // Returns a new vector extractor for the given vector variable
 	int getVectorVariable(const VectorExtractor* vectorExtractor) const; // Returns the index of the given vector extractor
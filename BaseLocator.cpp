@@ -45,3 +45,13 @@ void BaseLocator::renderLocatorTransparent(GLRenderState& renderState) const
 	{
 	/* Render nothing */
 	}
+
+void BaseLocator::prepareDataSetChange(void)
+	{
+	/* Do nothing */
+	}
+
+void BaseLocator::dataSetChanged(void)
+	{
+	/* Do nothing */
+	}
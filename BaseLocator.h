@@ -42,6 +42,8 @@ class BaseLocator:public Vrui::LocatorToolAdapter
 	virtual void highlightLocator(GLRenderState& renderState) const; // Renders the locator itself
 	virtual void renderLocator(GLRenderState& renderState) const; // Renders opaque elements and other objects controlled by the locator
 	virtual void renderLocatorTransparent(GLRenderState& renderState) const; // Renders transparent elements and other objects controlled by the locator
+	virtual void prepareDataSetChange(void); // Called before the application replaces its data set; locator must stop using any state derived from the current data set
+	virtual void dataSetChanged(void); // Called after the application replaced its data set; locator must re-create any state derived from the data set
 	};
 
 #endif
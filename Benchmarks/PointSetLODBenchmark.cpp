@@ -0,0 +1,231 @@
+/***********************************************************************
+PointSetLODBenchmark - Headless benchmark measuring the per-frame cost
+of view-dependent point selection in point set octrees.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <string.h>
+#include <stdlib.h>
+#include <iostream>
+#include <vector>
+#include <Misc/Timer.h>
+#include <Math/Math.h>
+#include <Math/Constants.h>
+
+#include <Concrete/PointOctree.h>
+
+using Visualization::Concrete::PointOctree;
+
+namespace {
+
+/*****************************************************************
+Helper functions to create synthetic catalogs and camera matrices:
+*****************************************************************/
+
+double
+randUniform(
+	void)
+	{
+	return double(rand())/double(RAND_MAX);
+	}
+
+void
+createCatalog(
+	size_t numPoints,
+	int numClusters,
+	std::vector<PointOctree::Point>& points)
+	{
+	/* Earth's radius in km, matching the units of point sets loaded by the Earth data set renderer: */
+	const double earthRadius=6378.14;
+	const double pi=Math::Constants<double>::pi;
+	
+	/* Place the cluster centers randomly on the sphere: */
+	std::vector<double> centers(numClusters*2);
+	for(int i=0;i<numClusters;++i)
+		{
+		centers[i*2+0]=Math::acos(2.0*randUniform()-1.0)-0.5*pi;
+		centers[i*2+1]=2.0*pi*randUniform();
+		}
+	
+	/* Create hypocenters clustered around the centers, down to 700km depth: */
+	points.resize(numPoints);
+	for(size_t i=0;i<numPoints;++i)
+		{
+		int cluster=rand()%numClusters;
+		double lat=centers[cluster*2+0]+0.1*(randUniform()-0.5);
+		double lng=centers[cluster*2+1]+0.1*(randUniform()-0.5);
+		double r=earthRadius-700.0*randUniform()*randUniform();
+		points[i].position[0]=float(r*Math::cos(lat)*Math::cos(lng));
+		points[i].position[1]=float(r*Math::cos(lat)*Math::sin(lng));
+		points[i].position[2]=float(r*Math::sin(lat));
+		}
+	}
+
+void
+calcClipMatrix(
+	double eyeDistance,
+	double azimuth,
+	double elevation,
+	double clip[16])
+	{
+	/* Calculate a perspective projection with a 60 degree vertical field of view: */
+	const double near=10.0;
+	const double far=eyeDistance*2.0;
+	double f=1.0/Math::tan(Math::rad(30.0));
+	double projection[16];
+	for(int i=0;i<16;++i)
+		projection[i]=0.0;
+	projection[0]=f;
+	projection[5]=f;
+	projection[10]=-(far+near)/(far-near);
+	projection[11]=-1.0;
+	projection[14]=-2.0*far*near/(far-near);
+	
+	/* Calculate a modelview matrix looking at the origin from the given direction: */
+	double z[3]={Math::cos(elevation)*Math::cos(azimuth),Math::cos(elevation)*Math::sin(azimuth),Math::sin(elevation)};
+	double x[3]={-Math::sin(azimuth),Math::cos(azimuth),0.0};
+	double y[3]={z[1]*x[2]-z[2]*x[1],z[2]*x[0]-z[0]*x[2],z[0]*x[1]-z[1]*x[0]};
+	double modelview[16];
+	for(int j=0;j<3;++j)
+		{
+		modelview[j*4+0]=x[j];
+		modelview[j*4+1]=y[j];
+		modelview[j*4+2]=z[j];
+		modelview[j*4+3]=0.0;
+		}
+	modelview[12]=0.0;
+	modelview[13]=0.0;
+	modelview[14]=-eyeDistance;
+	modelview[15]=1.0;
+	
+	/* Combine the matrices (both in column-major order): */
+	for(int i=0;i<4;++i)
+		for(int j=0;j<4;++j)
+			{
+			clip[j*4+i]=0.0;
+			for(int k=0;k<4;++k)
+				clip[j*4+i]+=projection[k*4+i]*modelview[j*4+k];
+			}
+	}
+
+}
+
+int main(int argc,char* argv[])
+	{
+	/* Parse the command line: */
+	size_t numPoints=10000000;
+	int numClusters=200;
+	size_t pointBudget=1000000;
+	int numFrames=200;
+	for(int i=1;i<argc;++i)
+		{
+		if(argv[i][0]=='-')
+			{
+			if(strcasecmp(argv[i]+1,"numPoints")==0&&i+1<argc)
+				numPoints=size_t(atol(argv[++i]));
+			else if(strcasecmp(argv[i]+1,"numClusters")==0&&i+1<argc)
+				numClusters=atoi(argv[++i]);
+			else if(strcasecmp(argv[i]+1,"budget")==0&&i+1<argc)
+				pointBudget=size_t(atol(argv[++i]));
+			else if(strcasecmp(argv[i]+1,"frames")==0&&i+1<argc)
+				numFrames=atoi(argv[++i]);
+			else
+				{
+				std::cerr<<"Usage: "<<argv[0]<<" [-numPoints <n>] [-numClusters <n>] [-budget <n>] [-frames <n>]"<<std::endl;
+				return 1;
+				}
+			}
+		}
+	if(numClusters<1)
+		numClusters=1;
+	
+	/* Create and index the synthetic catalog: */
+	Misc::Timer buildTimer;
+	std::vector<PointOctree::Point> points;
+	srand(1);
+	createCatalog(numPoints,numClusters,points);
+	buildTimer.elapse();
+	double createTime=buildTimer.getTime();
+	PointOctree octree;
+	octree.build(points);
+	buildTimer.elapse();
+	std::cout<<"Created "<<numPoints<<" points in "<<createTime*1000.0<<" ms; built "<<octree.getNumNodes()<<" octree nodes in "<<buildTimer.getTime()*1000.0<<" ms"<<std::endl;
+	
+	/* Select points for a camera orbiting the Earth, alternating between global and close-up views: */
+	std::vector<PointOctree::Run> runs;
+	double totalTime=0.0;
+	double maxTime=0.0;
+	size_t totalSelected=0;
+	size_t totalRuns=0;
+	int numFailedFrames=0;
+	for(int frame=0;frame<numFrames;++frame)
+		{
+		double azimuth=2.0*Math::Constants<double>::pi*double(frame)/double(numFrames);
+		double elevation=0.5*Math::sin(3.0*azimuth);
+		double eyeDistance=frame%2==0?20000.0:8000.0;
+		double clip[16];
+		calcClipMatrix(eyeDistance,azimuth,elevation,clip);
+		
+		Misc::Timer selectTimer;
+		size_t numSelected=octree.select(clip,pointBudget,runs);
+		selectTimer.elapse();
+		totalSelected+=numSelected;
+		totalRuns+=runs.size();
+		totalTime+=selectTimer.getTime();
+		if(maxTime<selectTimer.getTime())
+			maxTime=selectTimer.getTime();
+		
+		/* Check that the selection is consistent with its runs and respects the budget: */
+		size_t numRunPoints=0;
+		for(std::vector<PointOctree::Run>::const_iterator rIt=runs.begin();rIt!=runs.end();++rIt)
+			numRunPoints+=rIt->numPoints;
+		std::vector<PointOctree::Run> allRuns;
+		size_t numVisible=octree.select(clip,0,allRuns);
+		bool failed=numRunPoints!=numSelected||numSelected>numVisible;
+		if(pointBudget>0)
+			{
+			/* A budgeted selection must be non-empty if anything is visible, and all visible points if they fit: */
+			if(numSelected>pointBudget)
+				failed=true;
+			if(numVisible>0&&numSelected==0)
+				failed=true;
+			if(numVisible<=pointBudget&&numSelected!=numVisible)
+				failed=true;
+			}
+		if(failed)
+			{
+			std::cerr<<"Frame "<<frame<<": selected "<<numSelected<<" of "<<numVisible<<" visible points with budget "<<pointBudget<<std::endl;
+			++numFailedFrames;
+			}
+		}
+	
+	/* Report the selection statistics: */
+	if(numFrames>0)
+		{
+		std::cout<<"Point budget "<<pointBudget<<": "<<totalSelected/numFrames<<" points in "<<totalRuns/numFrames<<" runs per frame"<<std::endl;
+		std::cout<<"Selection time per frame: "<<totalTime*1000.0/double(numFrames)<<" ms average, "<<maxTime*1000.0<<" ms maximum"<<std::endl;
+		}
+	if(numFailedFrames>0)
+		{
+		std::cerr<<"Selection check failed in "<<numFailedFrames<<" of "<<numFrames<<" frames"<<std::endl;
+		return 1;
+		}
+	
+	return 0;
+	}
@@ -0,0 +1,1373 @@
+/***********************************************************************
+TemplatizedBenchmark - Headless benchmark measuring point location,
+evaluation, and extraction throughput of templatized data sets on
+synthetic analytic fields.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <Misc/Timer.h>
+#include <Math/Math.h>
+#include <Math/Constants.h>
+#include <Geometry/Point.h>
+#include <Geometry/Vector.h>
+#include <Geometry/Box.h>
+#include <Geometry/Plane.h>
+
+#include <Templatized/SlicedCartesian.h>
+#include <Templatized/SlicedCurvilinear.h>
+#include <Templatized/Curvilinear.h>
+#include <Templatized/SlicedHypercubic.h>
+#include <Templatized/Simplical.h>
+#include <Templatized/ScalarExtractor.h>
+#include <Templatized/SlicedScalarExtractor.h>
+#include <Templatized/VectorScalarExtractor.h>
+#include <Templatized/VectorExtractor.h>
+#include <Templatized/SlicedVectorExtractor.h>
+#include <Templatized/IsosurfaceExtractor.h>
+#include <Templatized/SliceExtractor.h>
+#include <Templatized/StreamlineExtractor.h>
+#include <Templatized/MultiStreamlineExtractor.h>
+#include <Templatized/StreamsurfaceExtractor.h>
+#include <Templatized/MaterializedScalarSlice.h>
+#include <Templatized/EncodedSlice.h>
+#include <Templatized/GridFinalizer.h>
+#include <Templatized/VolumeRenderingSampler.h>
+#include <Concrete/CSConvectionValue.h>
+
+namespace {
+
+/**********************************************
+Data set and extractor types under measurement:
+**********************************************/
+
+typedef double Scalar;
+typedef float VScalar;
+typedef Geometry::Point<Scalar,3> Point;
+typedef Geometry::Vector<Scalar,3> Vector;
+typedef Geometry::Box<Scalar,3> Box;
+typedef Geometry::Plane<Scalar,3> Plane;
+typedef Geometry::Vector<VScalar,3> VVector;
+
+typedef Visualization::Templatized::SlicedCartesian<Scalar,3,VScalar> CartesianDS; // Regular grid storing three vector component slices and one magnitude slice
+typedef Visualization::Templatized::SlicedCurvilinear<Scalar,3,VScalar> ShellDS; // Spherical shell grid storing the same slices
+typedef Visualization::Templatized::SlicedHypercubic<Scalar,3,VScalar> HexahedralDS; // Unstructured hexahedral grid storing the same slices
+typedef Visualization::Templatized::Simplical<Scalar,3,VVector> TetrahedralDS; // Tetrahedralized volume storing vector values
+typedef Visualization::Concrete::CSConvectionValue Record; // Multi-field vertex record as stored by the convection simulation reader
+typedef Visualization::Templatized::Curvilinear<Scalar,3,Record> RecordDS; // Curvilinear grid storing one record per vertex
+typedef Visualization::Templatized::ScalarExtractor<VScalar,Visualization::Templatized::SlicedDataValue<VScalar> > SlicedScalarExtractor;
+typedef Visualization::Templatized::VectorExtractor<VVector,Visualization::Templatized::SlicedDataValue<VScalar> > SlicedVectorExtractor;
+typedef Visualization::Templatized::ScalarExtractor<VScalar,VVector> MagnitudeExtractor;
+typedef Visualization::Templatized::VectorExtractor<VVector,VVector> VectorExtractor;
+typedef Visualization::Templatized::ScalarExtractor<VScalar,Record> RecordScalarExtractor;
+typedef Visualization::Templatized::VectorExtractor<VVector,Record> RecordVectorExtractor;
+
+/*********************************************************************
+Minimal vertex and geometry containers standing in for the OpenGL
+representations used by the visualization modules:
+*********************************************************************/
+
+struct Components // Three-component vertex position or normal vector
+	{
+	/* Elements: */
+	public:
+	float components[3];
+	
+	/* Constructors and destructors: */
+	Components(void)
+		{
+		}
+	template <class SourceScalarParam>
+	Components(const SourceScalarParam* sComponents)
+		{
+		for(int i=0;i<3;++i)
+			components[i]=float(sComponents[i]);
+		}
+	};
+
+struct BenchmarkVertex // Vertex type for isosurfaces, slices, and streamlines
+	{
+	/* Embedded classes: */
+	public:
+	typedef Components Normal;
+	typedef Components Position;
+	
+	/* Elements: */
+	float texCoord[1];
+	Normal normal;
+	Position position;
+	};
+
+class VertexBuffer // Stores extracted triangles or polyline vertices in a growing array
+	{
+	/* Embedded classes: */
+	public:
+	typedef BenchmarkVertex Vertex;
+	
+	/* Elements: */
+	private:
+	std::vector<Vertex> vertices; // Vertex storage, retained between extractions
+	size_t numVertices; // Number of vertices stored by the current extraction
+	
+	/* Constructors and destructors: */
+	public:
+	VertexBuffer(void)
+		:numVertices(0)
+		{
+		}
+	
+	/* Methods: */
+	void clear(void) // Discards all stored vertices, but keeps allocated storage
+		{
+		numVertices=0;
+		}
+	size_t getNumVertices(void) const // Returns the number of stored vertices
+		{
+		return numVertices;
+		}
+	Vertex* getNextTriangleVertices(void) // Returns storage for the next triangle
+		{
+		if(vertices.size()<numVertices+3)
+			vertices.resize(numVertices+3);
+		return &vertices[numVertices];
+		}
+	void addTriangle(void) // Stores the next triangle
+		{
+		numVertices+=3;
+		}
+	Vertex* getNextVertex(void) // Returns storage for the next polyline vertex
+		{
+		if(vertices.size()<numVertices+1)
+			vertices.resize(numVertices+1);
+		return &vertices[numVertices];
+		}
+	void addVertex(void) // Stores the next polyline vertex
+		{
+		++numVertices;
+		}
+	void flush(void) // Finishes a batch of geometry; nothing to do without a rendering pipe
+		{
+		}
+	};
+
+class PolylineSetBuffer // Stores the vertices of a set of polylines extracted in lockstep
+	{
+	/* Embedded classes: */
+	public:
+	typedef BenchmarkVertex Vertex;
+	
+	/* Elements: */
+	private:
+	std::vector<VertexBuffer> polylines; // One vertex buffer per polyline
+	
+	/* Constructors and destructors: */
+	public:
+	PolylineSetBuffer(unsigned int sNumPolylines)
+		:polylines(sNumPolylines)
+		{
+		}
+	
+	/* Methods: */
+	void clear(void) // Discards all stored vertices, but keeps allocated storage
+		{
+		for(std::vector<VertexBuffer>::iterator pIt=polylines.begin();pIt!=polylines.end();++pIt)
+			pIt->clear();
+		}
+	unsigned int getNumPolylines(void) const // Returns the number of polylines
+		{
+		return (unsigned int)(polylines.size());
+		}
+	size_t getNumVertices(void) const // Returns the total number of stored vertices in all polylines
+		{
+		size_t result=0;
+		for(std::vector<VertexBuffer>::const_iterator pIt=polylines.begin();pIt!=polylines.end();++pIt)
+			result+=pIt->getNumVertices();
+		return result;
+		}
+	Vertex* getNextVertex(unsigned int polylineIndex) // Returns storage for the next vertex of the given polyline
+		{
+		return polylines[polylineIndex].getNextVertex();
+		}
+	void addVertex(unsigned int polylineIndex) // Stores the next vertex of the given polyline
+		{
+		polylines[polylineIndex].addVertex();
+		}
+	void flush(void) // Finishes a batch of geometry; nothing to do without a rendering pipe
+		{
+		}
+	};
+
+class StripBuffer // Stores extracted stream surfaces as indexed triangle strips
+	{
+	/* Embedded classes: */
+	public:
+	typedef BenchmarkVertex Vertex;
+	typedef unsigned int Index;
+	
+	/* Elements: */
+	private:
+	std::vector<Vertex> vertices; // Vertex storage, retained between extractions
+	std::vector<Index> indices; // Vertex indices of all triangle strips
+	size_t stripStart; // Position of the first index of the current triangle strip
+	size_t numTriangles; // Number of triangles in all finished strips
+	Vertex nextVertex; // Storage for the next vertex
+	
+	/* Constructors and destructors: */
+	public:
+	StripBuffer(void)
+		:stripStart(0),numTriangles(0)
+		{
+		}
+	
+	/* Methods: */
+	void clear(void) // Discards all stored vertices and strips, but keeps allocated storage
+		{
+		vertices.clear();
+		indices.clear();
+		stripStart=0;
+		numTriangles=0;
+		}
+	size_t getNumVertices(void) const // Returns the number of stored vertices
+		{
+		return vertices.size();
+		}
+	size_t getNumTriangles(void) const // Returns the number of triangles in all finished strips
+		{
+		return numTriangles;
+		}
+	Vertex* getNextVertex(void) // Returns storage for the next vertex
+		{
+		return &nextVertex;
+		}
+	Index addVertex(void) // Stores the next vertex and returns its index
+		{
+		vertices.push_back(nextVertex);
+		return Index(vertices.size()-1);
+		}
+	void addIndex(Index index) // Adds a vertex index to the current triangle strip
+		{
+		indices.push_back(index);
+		}
+	void addStrip(void) // Finishes the current triangle strip
+		{
+		if(indices.size()>=stripStart+3)
+			numTriangles+=indices.size()-stripStart-2;
+		stripStart=indices.size();
+		}
+	};
+
+class StepCounter // Functor to stop stream surface integration after a maximum number of steps
+	{
+	/* Elements: */
+	private:
+	mutable size_t numSteps; // Number of steps taken so far
+	size_t maxNumSteps; // Number of steps after which to stop integration
+	
+	/* Constructors and destructors: */
+	public:
+	StepCounter(size_t sMaxNumSteps)
+		:numSteps(0),maxNumSteps(sMaxNumSteps)
+		{
+		}
+	
+	/* Methods: */
+	bool operator()(void) const
+		{
+		return ++numSteps<maxNumSteps;
+		}
+	};
+
+class StepLimit // Functor to stop streamline integration after a maximum number of vertices
+	{
+	/* Elements: */
+	private:
+	const VertexBuffer& buffer; // Buffer receiving the streamline's vertices
+	size_t maxNumVertices; // Number of buffer vertices at which to stop integration
+	
+	/* Constructors and destructors: */
+	public:
+	StepLimit(const VertexBuffer& sBuffer,size_t sMaxNumVertices)
+		:buffer(sBuffer),maxNumVertices(sMaxNumVertices)
+		{
+		}
+	
+	/* Methods: */
+	bool operator()(void) const
+		{
+		return buffer.getNumVertices()<maxNumVertices;
+		}
+	};
+
+/*********************************************************************
+Smooth analytic vortex field, evaluated in coordinates normalized to
+the extent of the data set's domain. Isosurfaces of the field's
+magnitude are warped cylinders around the vortex axis.
+*********************************************************************/
+
+class AnalyticField
+	{
+	/* Elements: */
+	private:
+	Point center; // Center of the normalized coordinate system
+	Scalar scale; // Extent of one normalized unit
+	
+	/* Constructors and destructors: */
+	public:
+	AnalyticField(const Point& sCenter,Scalar sScale)
+		:center(sCenter),scale(sScale)
+		{
+		}
+	
+	/* Methods: */
+	VVector operator()(const Point& p) const
+		{
+		Vector q=(p-center)/scale;
+		VVector result;
+		result[0]=VScalar(-q[1]+0.2*Math::sin(3.0*q[2]));
+		result[1]=VScalar(q[0]+0.2*Math::cos(3.0*q[2]));
+		result[2]=VScalar(0.3*Math::sin(3.0*(q[0]+q[1])));
+		return result;
+		}
+	};
+
+/**********************************************
+Helper functions to create synthetic data sets:
+**********************************************/
+
+double
+randUniform(
+	void)
+	{
+	return double(rand())/double(RAND_MAX);
+	}
+
+template <class DataSetParam>
+void
+setSliceValues(
+	DataSetParam& dataSet,
+	const typename DataSetParam::Index& index,
+	const VVector& value)
+	{
+	/* Store the vector components in slices 0-2, and the vector magnitude in slice 3: */
+	for(int i=0;i<3;++i)
+		dataSet.getVertexValue(i,index)=value[i];
+	dataSet.getVertexValue(3,index)=VScalar(Geometry::mag(value));
+	}
+
+CartesianDS*
+createCartesian(
+	int size)
+	{
+	/* Create a grid covering the unit cube: */
+	CartesianDS::Size cellSize(Scalar(1)/Scalar(size-1));
+	CartesianDS* result=new CartesianDS(CartesianDS::Index(size,size,size),cellSize,4);
+	
+	/* Sample the analytic field: */
+	AnalyticField field(Point(0.5,0.5,0.5),Scalar(0.5));
+	CartesianDS::Index index;
+	for(index[0]=0;index[0]<size;++index[0])
+		for(index[1]=0;index[1]<size;++index[1])
+			for(index[2]=0;index[2]<size;++index[2])
+				{
+				Point p;
+				for(int i=0;i<3;++i)
+					p[i]=Scalar(index[i])*cellSize[i];
+				setSliceValues(*result,index,field(p));
+				}
+	
+	return result;
+	}
+
+ShellDS*
+createShell(
+	int size)
+	{
+	const double pi=Math::Constants<double>::pi;
+	
+	/* Create a regional spherical shell grid with warped radial and colatitude spacing: */
+	ShellDS* result=new ShellDS(ShellDS::Index(size,size,size),4);
+	AnalyticField field(Point::origin,Scalar(1));
+	ShellDS::Index index;
+	for(index[0]=0;index[0]<size;++index[0])
+		{
+		/* Compress radial layers toward the outer surface: */
+		double u=double(index[0])/double(size-1);
+		double r=0.55+0.45*Math::sqrt(u);
+		for(index[1]=0;index[1]<size;++index[1])
+			{
+			/* Warp colatitudes sinusoidally between 18 and 162 degrees: */
+			double v=double(index[1])/double(size-1);
+			double colat=pi*(0.1+0.8*(v+0.05*Math::sin(2.0*pi*v)));
+			for(index[2]=0;index[2]<size;++index[2])
+				{
+				/* Cover three quarters of the full longitude range: */
+				double lng=1.5*pi*double(index[2])/double(size-1);
+				Point& p=result->getVertexPosition(index);
+				p[0]=Scalar(r*Math::sin(colat)*Math::cos(lng));
+				p[1]=Scalar(r*Math::sin(colat)*Math::sin(lng));
+				p[2]=Scalar(r*Math::cos(colat));
+				setSliceValues(*result,index,field(p));
+				}
+			}
+		}
+	result->finalizeGrid();
+	
+	return result;
+	}
+
+HexahedralDS*
+createHexahedral(
+	int size)
+	{
+	HexahedralDS* result=new HexahedralDS;
+	
+	/* Add three vector component slices and one magnitude slice: */
+	for(int i=0;i<4;++i)
+		result->addSlice();
+	
+	/* Create a lattice of vertices covering the unit cube, jittering interior vertices to break the lattice's regularity: */
+	AnalyticField field(Point(0.5,0.5,0.5),Scalar(0.5));
+	Scalar cellSize=Scalar(1)/Scalar(size-1);
+	size_t numVertices=size_t(size)*size_t(size)*size_t(size);
+	result->reserveVertices(numVertices);
+	int index[3];
+	for(index[0]=0;index[0]<size;++index[0])
+		for(index[1]=0;index[1]<size;++index[1])
+			for(index[2]=0;index[2]<size;++index[2])
+				{
+				Point p;
+				for(int i=0;i<3;++i)
+					{
+					p[i]=Scalar(index[i])*cellSize;
+					if(index[i]>0&&index[i]<size-1)
+						p[i]+=Scalar(0.3*(randUniform()-0.5))*cellSize;
+					}
+				HexahedralDS::VertexIndex vertexIndex=result->addVertex(p).getIndex();
+				VVector value=field(p);
+				for(int i=0;i<3;++i)
+					result->setVertexValue(i,vertexIndex,value[i]);
+				result->setVertexValue(3,vertexIndex,VScalar(Geometry::mag(value)));
+				}
+	
+	/* Turn each lattice cube into a hexahedron; bit i of a cell vertex's index selects the cube's upper side along axis i: */
+	size_t strides[3]={size_t(size)*size_t(size),size_t(size),1};
+	result->reserveCells(size_t(size-1)*size_t(size-1)*size_t(size-1));
+	for(index[0]=0;index[0]<size-1;++index[0])
+		for(index[1]=0;index[1]<size-1;++index[1])
+			for(index[2]=0;index[2]<size-1;++index[2])
+				{
+				size_t base=size_t(index[0])*strides[0]+size_t(index[1])*strides[1]+size_t(index[2]);
+				HexahedralDS::VertexID cellVertices[8];
+				for(int v=0;v<8;++v)
+					{
+					size_t vertexIndex=base;
+					for(int i=0;i<3;++i)
+						if(v&(1<<i))
+							vertexIndex+=strides[i];
+					cellVertices[v]=HexahedralDS::VertexID(HexahedralDS::VertexIndex(vertexIndex));
+					}
+				result->addCell(cellVertices);
+				}
+	result->finalizeGrid();
+	
+	return result;
+	}
+
+TetrahedralDS*
+createTetrahedral(
+	int size)
+	{
+	TetrahedralDS* result=new TetrahedralDS;
+	
+	/* Create a lattice of vertices covering the unit cube, jittering interior vertices to break the lattice's regularity: */
+	AnalyticField field(Point(0.5,0.5,0.5),Scalar(0.5));
+	Scalar cellSize=Scalar(1)/Scalar(size-1);
+	std::vector<TetrahedralDS::GridVertexIterator> vertices;
+	vertices.reserve(size_t(size)*size_t(size)*size_t(size));
+	int index[3];
+	for(index[0]=0;index[0]<size;++index[0])
+		for(index[1]=0;index[1]<size;++index[1])
+			for(index[2]=0;index[2]<size;++index[2])
+				{
+				Point p;
+				for(int i=0;i<3;++i)
+					{
+					p[i]=Scalar(index[i])*cellSize;
+					if(index[i]>0&&index[i]<size-1)
+						p[i]+=Scalar(0.3*(randUniform()-0.5))*cellSize;
+					}
+				vertices.push_back(result->addVertex(p,field(p)));
+				}
+	
+	/* Split each lattice cube into six tetrahedra sharing the cube's main diagonal: */
+	static const int axisPermutations[6][3]={{0,1,2},{0,2,1},{1,0,2},{1,2,0},{2,0,1},{2,1,0}};
+	size_t strides[3]={size_t(size)*size_t(size),size_t(size),1};
+	for(index[0]=0;index[0]<size-1;++index[0])
+		for(index[1]=0;index[1]<size-1;++index[1])
+			for(index[2]=0;index[2]<size-1;++index[2])
+				{
+				size_t base=size_t(index[0])*strides[0]+size_t(index[1])*strides[1]+size_t(index[2]);
+				for(int tet=0;tet<6;++tet)
+					{
+					TetrahedralDS::GridVertexIterator cellVertices[4];
+					size_t vertexIndex=base;
+					cellVertices[0]=vertices[vertexIndex];
+					for(int i=0;i<3;++i)
+						{
+						vertexIndex+=strides[axisPermutations[tet][i]];
+						cellVertices[i+1]=vertices[vertexIndex];
+						}
+					result->addCell(cellVertices);
+					}
+				}
+	result->finalizeGrid();
+	
+	return result;
+	}
+
+RecordDS*
+createRecords(
+	int size)
+	{
+	/* Create a grid covering the unit cube: */
+	RecordDS* result=new RecordDS(RecordDS::Index(size,size,size));
+	
+	/* Sample the analytic field into the velocity and derive the other record fields: */
+	AnalyticField field(Point(0.5,0.5,0.5),Scalar(0.5));
+	Scalar cellSize=Scalar(1)/Scalar(size-1);
+	RecordDS::Index index;
+	for(index[0]=0;index[0]<size;++index[0])
+		for(index[1]=0;index[1]<size;++index[1])
+			for(index[2]=0;index[2]<size;++index[2])
+				{
+				Point& p=result->getVertexPosition(index);
+				for(int i=0;i<3;++i)
+					p[i]=Scalar(index[i])*cellSize;
+				Record& record=result->getVertexValue(index);
+				record.velocity=field(p);
+				record.temperature=VScalar(p[2]);
+				record.viscosity=VScalar(Geometry::sqrDist(p,Point(0.5,0.5,0.5)));
+				}
+	result->finalizeGrid();
+	
+	return result;
+	}
+
+/****************************************
+Helper functions to query process memory:
+****************************************/
+
+size_t
+readProcessStatus(
+	const char* key)
+	{
+	/* Find the given key in the process' status file and return its value in bytes: */
+	size_t result=0;
+	FILE* statusFile=fopen("/proc/self/status","r");
+	if(statusFile!=0)
+		{
+		size_t keyLen=strlen(key);
+		char line[256];
+		while(fgets(line,sizeof(line),statusFile)!=0)
+			if(strncmp(line,key,keyLen)==0&&line[keyLen]==':')
+				{
+				result=size_t(atol(line+keyLen+1))*1024;
+				break;
+				}
+		fclose(statusFile);
+		}
+	
+	return result;
+	}
+
+void
+resetPeakMemory(
+	void)
+	{
+	/* Reset the process' resident set high-water mark; silently ignored on kernels not supporting it: */
+	FILE* clearRefsFile=fopen("/proc/self/clear_refs","w");
+	if(clearRefsFile!=0)
+		{
+		fputs("5",clearRefsFile);
+		fclose(clearRefsFile);
+		}
+	}
+
+/***********************************************
+Benchmark parameters, results, and measurements:
+***********************************************/
+
+struct BenchmarkParameters
+	{
+	/* Elements: */
+	public:
+	size_t numQueries; // Number of random and traced point location queries
+	size_t numSeeds; // Number of streamlines to integrate
+	size_t maxNumSteps; // Maximum number of integration steps per streamline
+	size_t numSurfaceLines; // Number of seed streamlines on the stream surface rake
+	double epsilon; // Per-step accuracy threshold for streamline integration
+	double isovalue; // Field magnitude at which to extract isosurfaces
+	std::vector<std::string> codecs; // Names of the slice codecs to compare on sliced grids
+	};
+
+struct CodecResult
+	{
+	/* Elements: */
+	public:
+	std::string codec; // Name of the slice codec
+	double encodeTime; // Time to encode all value slices in seconds
+	size_t rawSize; // Size of all value slices stored as value arrays in bytes
+	size_t encodedSize; // Size of all encoded value slices in bytes
+	double maxError; // Maximum absolute error of decoded magnitude values
+	double rmsError; // Root mean square error of decoded magnitude values
+	double evaluateRate; // Random point locations followed by scalar and vector evaluation per second
+	double isosurfaceRate; // Isosurface triangles per second
+	double sliceRate; // Slice triangles per second
+	double streamlineRate; // Streamline integration steps per second
+	};
+
+struct Result
+	{
+	/* Elements: */
+	public:
+	std::string gridType; // Name of the synthetic data set type
+	int size; // Number of vertices along each grid axis
+	size_t numVertices,numCells; // Size of the data set
+	double buildTime; // Time to create and finalize the data set in seconds
+	size_t dataSetMemory; // Growth of the resident set while creating the data set in bytes
+	size_t peakMemory; // Resident set high-water mark during the data set's measurements in bytes
+	size_t numHits; // Number of random queries located inside the domain
+	double locateRate; // Random point locations per second
+	double evaluateRate; // Random point locations followed by scalar and vector evaluation per second
+	double traceRate; // Coherent point locations along a path per second
+	bool hasSphericalGridIndex; // Flag if the data set was located via a spherical grid index
+	double kdTreeLocateRate; // Random point locations per second with the spherical grid index disabled
+	size_t numIsosurfaceTriangles;
+	double isosurfaceRate; // Isosurface triangles per second
+	size_t numSliceTriangles;
+	double sliceRate; // Slice triangles per second
+	size_t numStreamlines,numStreamlineSteps;
+	double streamlineRate; // Streamline integration steps per second, integrating one streamline at a time
+	size_t numMultiStreamlineSteps;
+	double multiStreamlineRate; // Streamline integration steps per second, integrating all streamlines from the same seeds in lockstep
+	size_t numStreamsurfaceVertices,numStreamsurfaceTriangles;
+	double streamsurfaceRate; // Stream surface vertices per second using all CPUs
+	double serialStreamsurfaceRate; // Stream surface vertices per second using a single thread
+	double transposeTime; // Time to transpose all record fields into slices in seconds, or negative if not measured
+	double slicedIsosurfaceRate; // Isosurface triangles per second after transposing record fields into slices
+	size_t numVoxels; // Number of voxels produced by the volume rendering sampler
+	double samplerRate; // Sampled voxels per second
+	double slicedSamplerRate; // Sampled voxels per second after transposing record fields into slices
+	std::vector<CodecResult> codecResults; // Measurements with encoded value slices, one per compared codec
+	};
+
+volatile double valueSink; // Receives evaluation results to keep them from being optimized away
+
+double
+calcRate(
+	size_t count,
+	double time)
+	{
+	return time>0.0?double(count)/time:0.0;
+	}
+
+template <class DataSetParam>
+void
+createQueries(
+	const DataSetParam& dataSet,
+	size_t numQueries,
+	std::vector<Point>& queries)
+	{
+	/* Distribute query points uniformly over the domain's bounding box: */
+	const Box& box=dataSet.getDomainBox();
+	queries.resize(numQueries);
+	for(size_t i=0;i<numQueries;++i)
+		for(int j=0;j<3;++j)
+			queries[i][j]=box.min[j]+(box.max[j]-box.min[j])*Scalar(randUniform());
+	}
+
+template <class DataSetParam>
+double
+measureLocation(
+	const DataSetParam& dataSet,
+	const std::vector<Point>& queries,
+	size_t& numHits)
+	{
+	typename DataSetParam::Locator locator=dataSet.getLocator();
+	numHits=0;
+	Misc::Timer locateTimer;
+	for(std::vector<Point>::const_iterator qIt=queries.begin();qIt!=queries.end();++qIt)
+		if(locator.locatePoint(*qIt,false))
+			++numHits;
+	locateTimer.elapse();
+	
+	return calcRate(queries.size(),locateTimer.getTime());
+	}
+
+template <class DataSetParam,class ScalarExtractorParam>
+double
+measureIsosurface(
+	const DataSetParam& dataSet,
+	const ScalarExtractorParam& scalarExtractor,
+	VScalar isovalue,
+	VertexBuffer& buffer,
+	size_t& numTriangles)
+	{
+	typedef Visualization::Templatized::IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,VertexBuffer> IsosurfaceExtractor;
+	
+	/* Measure global isosurface extraction after a warm-up run allocating the vertex buffer: */
+	IsosurfaceExtractor ie(&dataSet,scalarExtractor);
+	ie.setExtractionMode(IsosurfaceExtractor::SMOOTH);
+	buffer.clear();
+	ie.extractIsosurface(isovalue,buffer,0);
+	buffer.clear();
+	Misc::Timer isosurfaceTimer;
+	ie.extractIsosurface(isovalue,buffer,0);
+	isosurfaceTimer.elapse();
+	numTriangles=buffer.getNumVertices()/3;
+	
+	return calcRate(numTriangles,isosurfaceTimer.getTime());
+	}
+
+template <class DataSetParam,class ScalarExtractorParam>
+double
+measureSampler(
+	const DataSetParam& dataSet,
+	const ScalarExtractorParam& scalarExtractor,
+	size_t& numVoxels)
+	{
+	/* Resample the data set onto its optimal Cartesian volume: */
+	Visualization::Templatized::VolumeRenderingSampler<DataSetParam> sampler(dataSet);
+	const unsigned int* size=sampler.getSamplerSize();
+	numVoxels=size_t(size[0])*size_t(size[1])*size_t(size[2]);
+	std::vector<unsigned char> voxels(numVoxels);
+	ptrdiff_t voxelStrides[3];
+	voxelStrides[0]=1;
+	voxelStrides[1]=ptrdiff_t(size[0]);
+	voxelStrides[2]=ptrdiff_t(size[0])*ptrdiff_t(size[1]);
+	Misc::Timer samplerTimer;
+	sampler.sample(scalarExtractor,VScalar(0),VScalar(2),VScalar(0),&voxels[0],voxelStrides,0,100.0f,0.0f,0);
+	samplerTimer.elapse();
+	valueSink=double(voxels[numVoxels/2]);
+	
+	return calcRate(numVoxels,samplerTimer.getTime());
+	}
+
+template <class DataSetParam,class ScalarExtractorParam,class VectorExtractorParam>
+void
+measureDataSet(
+	const DataSetParam& dataSet,
+	const ScalarExtractorParam& scalarExtractor,
+	const VectorExtractorParam& vectorExtractor,
+	const BenchmarkParameters& parameters,
+	Result& result)
+	{
+	typedef typename DataSetParam::Locator Locator;
+	typedef Visualization::Templatized::SliceExtractor<DataSetParam,ScalarExtractorParam,VertexBuffer> SliceExtractor;
+	typedef Visualization::Templatized::StreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,VertexBuffer> StreamlineExtractor;
+	typedef Visualization::Templatized::MultiStreamlineExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,PolylineSetBuffer> MultiStreamlineExtractor;
+	typedef Visualization::Templatized::StreamsurfaceExtractor<DataSetParam,VectorExtractorParam,ScalarExtractorParam,StripBuffer> StreamsurfaceExtractor;
+	
+	result.numVertices=dataSet.getTotalNumVertices();
+	result.numCells=dataSet.getTotalNumCells();
+	
+	/* Measure random point location: */
+	std::vector<Point> queries;
+	createQueries(dataSet,parameters.numQueries,queries);
+	result.locateRate=measureLocation(dataSet,queries,result.numHits);
+	
+	/* Measure random point location followed by evaluation: */
+		{
+		Locator locator=dataSet.getLocator();
+		double valueSum=0.0;
+		Misc::Timer evaluateTimer;
+		for(std::vector<Point>::const_iterator qIt=queries.begin();qIt!=queries.end();++qIt)
+			if(locator.locatePoint(*qIt,false))
+				{
+				valueSum+=double(locator.calcValue(scalarExtractor));
+				valueSum+=double(locator.calcValue(vectorExtractor)[0]);
+				}
+		evaluateTimer.elapse();
+		valueSink=valueSum;
+		result.evaluateRate=calcRate(queries.size(),evaluateTimer.getTime());
+		}
+	
+	/* Measure coherent point location along a helix around the domain's center: */
+		{
+		const Box& box=dataSet.getDomainBox();
+		Point center=Geometry::mid(box.min,box.max);
+		Scalar extent=box.max[0]-box.min[0];
+		for(int i=1;i<3;++i)
+			if(extent>box.max[i]-box.min[i])
+				extent=box.max[i]-box.min[i];
+		Scalar radius=extent*Scalar(0.3);
+		Scalar angleStep=dataSet.calcAverageCellSize()*Scalar(0.25)/radius;
+		Locator locator=dataSet.getLocator();
+		size_t numTraceHits=0;
+		Misc::Timer traceTimer;
+		for(size_t i=0;i<parameters.numQueries;++i)
+			{
+			Scalar angle=Scalar(i)*angleStep;
+			Point p=center+Vector(radius*Math::cos(angle),radius*Math::sin(angle),extent*Scalar(0.2)*Math::sin(angle*Scalar(0.25)));
+			if(locator.locatePoint(p,true))
+				++numTraceHits;
+			}
+		traceTimer.elapse();
+		valueSink=double(numTraceHits);
+		result.traceRate=calcRate(parameters.numQueries,traceTimer.getTime());
+		}
+	
+	VertexBuffer buffer;
+	
+	/* Measure global isosurface extraction: */
+	result.isosurfaceRate=measureIsosurface(dataSet,scalarExtractor,VScalar(parameters.isovalue),buffer,result.numIsosurfaceTriangles);
+	
+	/* Measure global slice extraction through the domain's center: */
+		{
+		const Box& box=dataSet.getDomainBox();
+		Vector normal(1,2,3);
+		normal.normalize();
+		Plane plane(normal,Geometry::mid(box.min,box.max));
+		SliceExtractor se(&dataSet,scalarExtractor);
+		buffer.clear();
+		se.extractSlice(plane,buffer);
+		buffer.clear();
+		Misc::Timer sliceTimer;
+		se.extractSlice(plane,buffer);
+		sliceTimer.elapse();
+		result.numSliceTriangles=buffer.getNumVertices()/3;
+		result.sliceRate=calcRate(result.numSliceTriangles,sliceTimer.getTime());
+		}
+	
+	/* Locate random streamline seeds inside the domain: */
+	std::vector<Point> seeds;
+	std::vector<Locator> seedLocators;
+	for(size_t attempt=0;seeds.size()<parameters.numSeeds&&attempt<parameters.numSeeds*10;++attempt)
+		{
+		std::vector<Point> seed;
+		createQueries(dataSet,1,seed);
+		Locator seedLocator=dataSet.getLocator();
+		if(seedLocator.locatePoint(seed[0],false))
+			{
+			seeds.push_back(seed[0]);
+			seedLocators.push_back(seedLocator);
+			}
+		}
+	
+	/* Measure streamline integration: */
+		{
+		StreamlineExtractor sle(&dataSet,vectorExtractor,scalarExtractor);
+		sle.setEpsilon(Scalar(parameters.epsilon));
+		Scalar startStepSize=dataSet.calcAverageCellSize()*Scalar(0.1);
+		buffer.clear();
+		Misc::Timer streamlineTimer;
+		for(size_t i=0;i<seeds.size();++i)
+			{
+			sle.startStreamline(seeds[i],seedLocators[i],startStepSize,buffer);
+			sle.continueStreamline(StepLimit(buffer,buffer.getNumVertices()+parameters.maxNumSteps));
+			sle.finishStreamline();
+			}
+		streamlineTimer.elapse();
+		result.numStreamlines=seeds.size();
+		result.numStreamlineSteps=buffer.getNumVertices();
+		result.streamlineRate=calcRate(result.numStreamlineSteps,streamlineTimer.getTime());
+		}
+	
+	/* Measure lockstep integration of streamlines from the same seeds with the same accuracy and step limit: */
+	result.numMultiStreamlineSteps=0;
+	result.multiStreamlineRate=0.0;
+	if(!seeds.empty())
+		{
+		MultiStreamlineExtractor msle(&dataSet,vectorExtractor,scalarExtractor);
+		msle.setEpsilon(Scalar(parameters.epsilon));
+		Scalar startStepSize=dataSet.calcAverageCellSize()*Scalar(0.1);
+		PolylineSetBuffer polylines((unsigned int)(seeds.size()));
+		Misc::Timer multiStreamlineTimer;
+		msle.setMultiStreamline(polylines);
+		for(size_t i=0;i<seeds.size();++i)
+			msle.initializeStreamline((unsigned int)(i),seeds[i],seedLocators[i],startStepSize);
+		msle.startStreamlines();
+		msle.continueStreamlines(StepCounter(parameters.maxNumSteps));
+		msle.finishStreamlines();
+		multiStreamlineTimer.elapse();
+		result.numMultiStreamlineSteps=polylines.getNumVertices();
+		result.multiStreamlineRate=calcRate(result.numMultiStreamlineSteps,multiStreamlineTimer.getTime());
+		}
+	
+	/* Measure stream surface extraction from a rake through the first streamline seed: */
+	result.numStreamsurfaceVertices=0;
+	result.numStreamsurfaceTriangles=0;
+	result.streamsurfaceRate=0.0;
+	result.serialStreamsurfaceRate=0.0;
+	if(!seeds.empty()&&parameters.numSurfaceLines>=2)
+		{
+		Scalar cellSize=dataSet.calcAverageCellSize();
+		Vector rakeDir(1,1,0);
+		rakeDir*=Scalar(10)*cellSize/Geometry::mag(rakeDir);
+		StreamsurfaceExtractor sse(&dataSet,vectorExtractor,scalarExtractor);
+		sse.setStepSize(cellSize*Scalar(0.1));
+		sse.setNumStreamlines(int(parameters.numSurfaceLines));
+		for(size_t i=0;i<parameters.numSurfaceLines;++i)
+			{
+			Point p=seeds[0]+rakeDir*(Scalar(i)/Scalar(parameters.numSurfaceLines-1)-Scalar(0.5));
+			Locator seedLocator=seedLocators[0];
+			seedLocator.locatePoint(p,true);
+			sse.initializeStreamline(int(i),p,seedLocator);
+			}
+		
+		/* Extract the same stream surface with a single thread and with all CPUs: */
+		StripBuffer surface;
+		for(int pass=0;pass<2;++pass)
+			{
+			sse.setNumThreads(pass==0?1:0);
+			surface.clear();
+			Misc::Timer streamsurfaceTimer;
+			sse.startStreamsurface(surface);
+			sse.continueStreamsurface(StepCounter(parameters.maxNumSteps));
+			sse.finishStreamsurface();
+			streamsurfaceTimer.elapse();
+			double rate=calcRate(surface.getNumVertices(),streamsurfaceTimer.getTime());
+			if(pass==0)
+				result.serialStreamsurfaceRate=rate;
+			else
+				result.streamsurfaceRate=rate;
+			}
+		result.numStreamsurfaceVertices=surface.getNumVertices();
+		result.numStreamsurfaceTriangles=surface.getNumTriangles();
+		}
+	}
+
+template <class DataSetParam>
+void
+measureCodecs(
+	DataSetParam* (*createDataSet)(int),
+	int size,
+	const BenchmarkParameters& parameters,
+	std::vector<CodecResult>& codecResults)
+	{
+	for(std::vector<std::string>::const_iterator cIt=parameters.codecs.begin();cIt!=parameters.codecs.end();++cIt)
+		{
+		CodecResult cr;
+		cr.codec=*cIt;
+		Visualization::Templatized::EncodedSliceBase::Codec codec=Visualization::Templatized::EncodedSliceBase::parseCodecName(cIt->c_str());
+		
+		/* Create a fresh data set and keep a copy of its magnitude slice to measure decoding errors: */
+		DataSetParam* dataSet=createDataSet(size);
+		size_t numValues=dataSet->getTotalNumVertices();
+		std::vector<VScalar> magnitudes(dataSet->getSliceArray(3),dataSet->getSliceArray(3)+numValues);
+		
+		/* Encode all value slices: */
+		Misc::Timer encodeTimer;
+		for(int i=0;i<dataSet->getNumSlices();++i)
+			dataSet->encodeSlice(i,codec);
+		encodeTimer.elapse();
+		cr.encodeTime=encodeTimer.getTime();
+		cr.rawSize=0;
+		cr.encodedSize=0;
+		for(int i=0;i<dataSet->getNumSlices();++i)
+			{
+			cr.rawSize+=numValues*sizeof(VScalar);
+			cr.encodedSize+=dataSet->getEncodedSlice(i)->getEncodedSize();
+			}
+		
+		/* Compare the decoded magnitude values against the originals: */
+		const Visualization::Templatized::EncodedSlice<VScalar>* magnitudeSlice=dataSet->getEncodedSlice(3);
+		cr.maxError=0.0;
+		double sqrErrorSum=0.0;
+		for(size_t i=0;i<numValues;++i)
+			{
+			double error=Math::abs(double(magnitudeSlice->getValue(i))-double(magnitudes[i]));
+			if(cr.maxError<error)
+				cr.maxError=error;
+			sqrErrorSum+=error*error;
+			}
+		cr.rmsError=numValues>0?Math::sqrt(sqrErrorSum/double(numValues)):0.0;
+		
+		/* Measure all operations reading through the decoded brick caches: */
+		SlicedScalarExtractor scalarExtractor(3,0,magnitudeSlice);
+		SlicedVectorExtractor vectorExtractor;
+		for(int i=0;i<3;++i)
+			vectorExtractor.setSlice(i,0,dataSet->getEncodedSlice(i));
+		Result result;
+		measureDataSet(*dataSet,scalarExtractor,vectorExtractor,parameters,result);
+		cr.evaluateRate=result.evaluateRate;
+		cr.isosurfaceRate=result.isosurfaceRate;
+		cr.sliceRate=result.sliceRate;
+		cr.streamlineRate=result.streamlineRate;
+		delete dataSet;
+		
+		codecResults.push_back(cr);
+		}
+	}
+
+bool
+runBenchmark(
+	const std::string& gridType,
+	int size,
+	const BenchmarkParameters& parameters,
+	Result& result)
+	{
+	result.gridType=gridType;
+	result.size=size;
+	result.hasSphericalGridIndex=false;
+	result.kdTreeLocateRate=-1.0;
+	result.transposeTime=-1.0;
+	
+	/* Create the data set and measure its memory footprint: */
+	resetPeakMemory();
+	size_t baseMemory=readProcessStatus("VmRSS");
+	Misc::Timer buildTimer;
+	if(gridType=="cartesian")
+		{
+		CartesianDS* dataSet=createCartesian(size);
+		buildTimer.elapse();
+		result.buildTime=buildTimer.getTime();
+		size_t memory=readProcessStatus("VmRSS");
+		result.dataSetMemory=memory>baseMemory?memory-baseMemory:0;
+		
+		/* Create extractors for the magnitude slice and the vector component slices: */
+		SlicedScalarExtractor scalarExtractor(3,dataSet->getSliceArray(3));
+		SlicedVectorExtractor vectorExtractor;
+		for(int i=0;i<3;++i)
+			vectorExtractor.setSlice(i,dataSet->getSliceArray(i));
+		measureDataSet(*dataSet,scalarExtractor,vectorExtractor,parameters,result);
+		result.peakMemory=readProcessStatus("VmHWM");
+		delete dataSet;
+		
+		/* Compare the value slice codecs: */
+		measureCodecs(createCartesian,size,parameters,result.codecResults);
+		}
+	else if(gridType=="shell")
+		{
+		ShellDS* dataSet=createShell(size);
+		buildTimer.elapse();
+		result.buildTime=buildTimer.getTime();
+		size_t memory=readProcessStatus("VmRSS");
+		result.dataSetMemory=memory>baseMemory?memory-baseMemory:0;
+		
+		SlicedScalarExtractor scalarExtractor(3,dataSet->getSliceArray(3));
+		SlicedVectorExtractor vectorExtractor;
+		for(int i=0;i<3;++i)
+			vectorExtractor.setSlice(i,dataSet->getSliceArray(i));
+		dataSet->setUseSphericalGridIndex(true);
+		result.hasSphericalGridIndex=dataSet->hasSphericalGridIndex();
+		measureDataSet(*dataSet,scalarExtractor,vectorExtractor,parameters,result);
+		
+		/* Compare against point location via the cell center kd-tree: */
+		if(result.hasSphericalGridIndex)
+			{
+			dataSet->setUseSphericalGridIndex(false);
+			std::vector<Point> queries;
+			createQueries(*dataSet,parameters.numQueries,queries);
+			size_t numHits;
+			result.kdTreeLocateRate=measureLocation(*dataSet,queries,numHits);
+			dataSet->setUseSphericalGridIndex(true);
+			}
+		result.peakMemory=readProcessStatus("VmHWM");
+		delete dataSet;
+		
+		/* Compare the value slice codecs: */
+		measureCodecs(createShell,size,parameters,result.codecResults);
+		}
+	else if(gridType=="hexahedral")
+		{
+		HexahedralDS* dataSet=createHexahedral(size);
+		buildTimer.elapse();
+		result.buildTime=buildTimer.getTime();
+		size_t memory=readProcessStatus("VmRSS");
+		result.dataSetMemory=memory>baseMemory?memory-baseMemory:0;
+		
+		SlicedScalarExtractor scalarExtractor(3,dataSet->getSliceArray(3));
+		SlicedVectorExtractor vectorExtractor;
+		for(int i=0;i<3;++i)
+			vectorExtractor.setSlice(i,dataSet->getSliceArray(i));
+		measureDataSet(*dataSet,scalarExtractor,vectorExtractor,parameters,result);
+		result.peakMemory=readProcessStatus("VmHWM");
+		delete dataSet;
+		}
+	else if(gridType=="tetrahedral")
+		{
+		TetrahedralDS* dataSet=createTetrahedral(size);
+		buildTimer.elapse();
+		result.buildTime=buildTimer.getTime();
+		size_t memory=readProcessStatus("VmRSS");
+		result.dataSetMemory=memory>baseMemory?memory-baseMemory:0;
+		
+		MagnitudeExtractor scalarExtractor;
+		VectorExtractor vectorExtractor;
+		measureDataSet(*dataSet,scalarExtractor,vectorExtractor,parameters,result);
+		result.peakMemory=readProcessStatus("VmHWM");
+		delete dataSet;
+		}
+	else if(gridType=="records")
+		{
+		RecordDS* dataSet=createRecords(size);
+		buildTimer.elapse();
+		result.buildTime=buildTimer.getTime();
+		size_t memory=readProcessStatus("VmRSS");
+		result.dataSetMemory=memory>baseMemory?memory-baseMemory:0;
+		
+		/* Measure all operations reading the velocity magnitude directly from the vertex records: */
+		RecordScalarExtractor scalarExtractor(RecordScalarExtractor::VELOCITY_MAG);
+		RecordVectorExtractor vectorExtractor;
+		measureDataSet(*dataSet,scalarExtractor,vectorExtractor,parameters,result);
+		result.samplerRate=measureSampler(*dataSet,scalarExtractor,result.numVoxels);
+		
+		/* Transpose all scalar variables of the records into slices in a single pass: */
+		const int numFields=RecordScalarExtractor::VELOCITY_MAG+1;
+		std::vector<RecordScalarExtractor> fieldExtractors;
+		for(int i=0;i<numFields;++i)
+			fieldExtractors.push_back(RecordScalarExtractor(i));
+		std::vector<size_t> sliceSizes(numFields);
+		Misc::Timer transposeTimer;
+		Visualization::Templatized::DataSetScalarMaterializer<RecordDS,RecordScalarExtractor>::materialize(*dataSet,numFields,&fieldExtractors[0],&sliceSizes[0]);
+		transposeTimer.elapse();
+		result.transposeTime=transposeTimer.getTime();
+		
+		/* Measure isosurface extraction and sampling again, reading from the velocity magnitude slice: */
+		VertexBuffer buffer;
+		size_t numTriangles;
+		result.slicedIsosurfaceRate=measureIsosurface(*dataSet,fieldExtractors[RecordScalarExtractor::VELOCITY_MAG],VScalar(parameters.isovalue),buffer,numTriangles);
+		result.slicedSamplerRate=measureSampler(*dataSet,fieldExtractors[RecordScalarExtractor::VELOCITY_MAG],result.numVoxels);
+		result.peakMemory=readProcessStatus("VmHWM");
+		delete dataSet;
+		}
+	else
+		return false;
+	
+	return true;
+	}
+
+void
+writeJson(
+	std::ostream& os,
+	const BenchmarkParameters& parameters,
+	const std::vector<Result>& results)
+	{
+	os<<"{"<<std::endl;
+	os<<"\t\"benchmark\": \"TemplatizedBenchmark\","<<std::endl;
+	os<<"\t\"numQueries\": "<<parameters.numQueries<<","<<std::endl;
+	os<<"\t\"numSeeds\": "<<parameters.numSeeds<<","<<std::endl;
+	os<<"\t\"maxNumSteps\": "<<parameters.maxNumSteps<<","<<std::endl;
+	os<<"\t\"numSurfaceLines\": "<<parameters.numSurfaceLines<<","<<std::endl;
+	os<<"\t\"epsilon\": "<<parameters.epsilon<<","<<std::endl;
+	os<<"\t\"isovalue\": "<<parameters.isovalue<<","<<std::endl;
+	os<<"\t\"results\": ["<<std::endl;
+	for(size_t i=0;i<results.size();++i)
+		{
+		const Result& r=results[i];
+		os<<"\t\t{"<<std::endl;
+		os<<"\t\t\"gridType\": \""<<r.gridType<<"\","<<std::endl;
+		os<<"\t\t\"size\": "<<r.size<<","<<std::endl;
+		os<<"\t\t\"numVertices\": "<<r.numVertices<<","<<std::endl;
+		os<<"\t\t\"numCells\": "<<r.numCells<<","<<std::endl;
+		os<<"\t\t\"buildTime\": "<<r.buildTime<<","<<std::endl;
+		os<<"\t\t\"dataSetMemory\": "<<r.dataSetMemory<<","<<std::endl;
+		os<<"\t\t\"peakMemory\": "<<r.peakMemory<<","<<std::endl;
+		os<<"\t\t\"numHits\": "<<r.numHits<<","<<std::endl;
+		os<<"\t\t\"locateRate\": "<<r.locateRate<<","<<std::endl;
+		os<<"\t\t\"evaluateRate\": "<<r.evaluateRate<<","<<std::endl;
+		os<<"\t\t\"traceRate\": "<<r.traceRate<<","<<std::endl;
+		if(r.gridType=="shell")
+			{
+			os<<"\t\t\"sphericalGridIndex\": "<<(r.hasSphericalGridIndex?"true":"false")<<","<<std::endl;
+			if(r.kdTreeLocateRate>=0.0)
+				os<<"\t\t\"kdTreeLocateRate\": "<<r.kdTreeLocateRate<<","<<std::endl;
+			}
+		os<<"\t\t\"numIsosurfaceTriangles\": "<<r.numIsosurfaceTriangles<<","<<std::endl;
+		os<<"\t\t\"isosurfaceRate\": "<<r.isosurfaceRate<<","<<std::endl;
+		os<<"\t\t\"numSliceTriangles\": "<<r.numSliceTriangles<<","<<std::endl;
+		os<<"\t\t\"sliceRate\": "<<r.sliceRate<<","<<std::endl;
+		os<<"\t\t\"numStreamlines\": "<<r.numStreamlines<<","<<std::endl;
+		os<<"\t\t\"numStreamlineSteps\": "<<r.numStreamlineSteps<<","<<std::endl;
+		os<<"\t\t\"streamlineRate\": "<<r.streamlineRate<<","<<std::endl;
+		os<<"\t\t\"numMultiStreamlineSteps\": "<<r.numMultiStreamlineSteps<<","<<std::endl;
+		os<<"\t\t\"multiStreamlineRate\": "<<r.multiStreamlineRate<<","<<std::endl;
+		os<<"\t\t\"numStreamsurfaceVertices\": "<<r.numStreamsurfaceVertices<<","<<std::endl;
+		os<<"\t\t\"numStreamsurfaceTriangles\": "<<r.numStreamsurfaceTriangles<<","<<std::endl;
+		os<<"\t\t\"serialStreamsurfaceRate\": "<<r.serialStreamsurfaceRate<<","<<std::endl;
+		os<<"\t\t\"streamsurfaceRate\": "<<r.streamsurfaceRate;
+		if(r.transposeTime>=0.0)
+			{
+			os<<","<<std::endl<<"\t\t\"transposeTime\": "<<r.transposeTime;
+			os<<","<<std::endl<<"\t\t\"slicedIsosurfaceRate\": "<<r.slicedIsosurfaceRate;
+			os<<","<<std::endl<<"\t\t\"numVoxels\": "<<r.numVoxels;
+			os<<","<<std::endl<<"\t\t\"samplerRate\": "<<r.samplerRate;
+			os<<","<<std::endl<<"\t\t\"slicedSamplerRate\": "<<r.slicedSamplerRate;
+			}
+		if(!r.codecResults.empty())
+			{
+			os<<","<<std::endl<<"\t\t\"codecs\": ["<<std::endl;
+			for(size_t j=0;j<r.codecResults.size();++j)
+				{
+				const CodecResult& cr=r.codecResults[j];
+				os<<"\t\t\t{\"codec\": \""<<cr.codec<<"\", \"encodeTime\": "<<cr.encodeTime<<", \"rawSize\": "<<cr.rawSize<<", \"encodedSize\": "<<cr.encodedSize;
+				os<<", \"maxError\": "<<cr.maxError<<", \"rmsError\": "<<cr.rmsError;
+				os<<", \"evaluateRate\": "<<cr.evaluateRate<<", \"isosurfaceRate\": "<<cr.isosurfaceRate<<", \"sliceRate\": "<<cr.sliceRate<<", \"streamlineRate\": "<<cr.streamlineRate<<"}";
+				os<<(j+1<r.codecResults.size()?",":"")<<std::endl;
+				}
+			os<<"\t\t]";
+			}
+		os<<std::endl;
+		os<<"\t\t}"<<(i+1<results.size()?",":"")<<std::endl;
+		}
+	os<<"\t]"<<std::endl;
+	os<<"}"<<std::endl;
+	}
+
+void
+splitList(
+	const char* list,
+	std::vector<std::string>& items)
+	{
+	/* Split the comma-separated list: */
+	items.clear();
+	const char* itemStart=list;
+	for(const char* lPtr=list;;++lPtr)
+		if(*lPtr==','||*lPtr=='\0')
+			{
+			if(lPtr!=itemStart)
+				items.push_back(std::string(itemStart,lPtr));
+			if(*lPtr=='\0')
+				break;
+			itemStart=lPtr+1;
+			}
+	}
+
+}
+
+int main(int argc,char* argv[])
+	{
+	/* Parse the command line: */
+	BenchmarkParameters parameters;
+	parameters.numQueries=200000;
+	parameters.numSeeds=100;
+	parameters.maxNumSteps=1000;
+	parameters.numSurfaceLines=256;
+	parameters.epsilon=1.0e-6;
+	parameters.isovalue=0.5;
+	std::vector<std::string> gridTypes;
+	splitList("cartesian,shell,hexahedral,tetrahedral,records",gridTypes);
+	std::vector<std::string> sizeNames;
+	splitList("16,32,64",sizeNames);
+	splitList("float16,quantized8,quantized16,lossless",parameters.codecs);
+	const char* jsonFileName=0;
+	for(int i=1;i<argc;++i)
+		{
+		if(argv[i][0]=='-')
+			{
+			if(strcasecmp(argv[i]+1,"grids")==0&&i+1<argc)
+				splitList(argv[++i],gridTypes);
+			else if(strcasecmp(argv[i]+1,"sizes")==0&&i+1<argc)
+				splitList(argv[++i],sizeNames);
+			else if(strcasecmp(argv[i]+1,"queries")==0&&i+1<argc)
+				parameters.numQueries=size_t(atol(argv[++i]));
+			else if(strcasecmp(argv[i]+1,"seeds")==0&&i+1<argc)
+				parameters.numSeeds=size_t(atol(argv[++i]));
+			else if(strcasecmp(argv[i]+1,"steps")==0&&i+1<argc)
+				parameters.maxNumSteps=size_t(atol(argv[++i]));
+			else if(strcasecmp(argv[i]+1,"surfaceLines")==0&&i+1<argc)
+				parameters.numSurfaceLines=size_t(atol(argv[++i]));
+			else if(strcasecmp(argv[i]+1,"epsilon")==0&&i+1<argc)
+				parameters.epsilon=atof(argv[++i]);
+			else if(strcasecmp(argv[i]+1,"isovalue")==0&&i+1<argc)
+				parameters.isovalue=atof(argv[++i]);
+			else if(strcasecmp(argv[i]+1,"codecs")==0&&i+1<argc)
+				{
+				splitList(argv[++i],parameters.codecs);
+				if(parameters.codecs.size()==1&&strcasecmp(parameters.codecs[0].c_str(),"none")==0)
+					parameters.codecs.clear();
+				}
+			else if(strcasecmp(argv[i]+1,"finalizeThreads")==0&&i+1<argc)
+				Visualization::Templatized::GridFinalizer::setNumThreads((unsigned int)(atoi(argv[++i])));
+			else if(strcasecmp(argv[i]+1,"json")==0&&i+1<argc)
+				jsonFileName=argv[++i];
+			else
+				{
+				std::cerr<<"Usage: "<<argv[0]<<" [-grids cartesian,shell,hexahedral,tetrahedral,records] [-sizes <n>,...] [-queries <n>] [-seeds <n>] [-steps <n>] [-surfaceLines <n>] [-epsilon <e>] [-isovalue <v>] [-codecs float16,quantized8,quantized16,lossless|none] [-finalizeThreads <n>] [-json <file name>]"<<std::endl;
+				return 1;
+				}
+			}
+		}
+	
+	/* Check the requested slice codecs: */
+	for(std::vector<std::string>::iterator cIt=parameters.codecs.begin();cIt!=parameters.codecs.end();++cIt)
+		{
+		try
+			{
+			Visualization::Templatized::EncodedSliceBase::parseCodecName(cIt->c_str());
+			}
+		catch(std::runtime_error err)
+			{
+			std::cerr<<err.what()<<std::endl;
+			return 1;
+			}
+		}
+	
+	/* Run all requested benchmarks: */
+	std::vector<Result> results;
+	srand(1);
+	for(std::vector<std::string>::iterator gtIt=gridTypes.begin();gtIt!=gridTypes.end();++gtIt)
+		for(std::vector<std::string>::iterator sIt=sizeNames.begin();sIt!=sizeNames.end();++sIt)
+			{
+			int size=atoi(sIt->c_str());
+			if(size<2)
+				{
+				std::cerr<<"Ignoring invalid grid size "<<*sIt<<std::endl;
+				continue;
+				}
+			
+			Result result;
+			if(!runBenchmark(*gtIt,size,parameters,result))
+				{
+				std::cerr<<"Ignoring unknown grid type "<<*gtIt<<std::endl;
+				break;
+				}
+			std::cerr<<result.gridType<<" "<<size<<"^3: "<<result.numCells<<" cells built in "<<result.buildTime*1000.0<<" ms; ";
+			std::cerr<<result.locateRate<<" locates/s, "<<result.isosurfaceRate<<" isosurface triangles/s, "<<result.sliceRate<<" slice triangles/s, "<<result.streamlineRate<<" -> "<<result.multiStreamlineRate<<" streamline steps/s, "<<result.serialStreamsurfaceRate<<" -> "<<result.streamsurfaceRate<<" stream surface vertices/s"<<std::endl;
+			if(result.transposeTime>=0.0)
+				std::cerr<<"\ttransposed in "<<result.transposeTime*1000.0<<" ms; isosurface "<<result.isosurfaceRate<<" -> "<<result.slicedIsosurfaceRate<<" triangles/s, sampler "<<result.samplerRate<<" -> "<<result.slicedSamplerRate<<" voxels/s"<<std::endl;
+			for(std::vector<CodecResult>::iterator crIt=result.codecResults.begin();crIt!=result.codecResults.end();++crIt)
+				std::cerr<<"\t"<<crIt->codec<<": "<<double(crIt->encodedSize)*100.0/double(crIt->rawSize)<<"% of "<<crIt->rawSize<<" bytes, encoded in "<<crIt->encodeTime*1000.0<<" ms, max error "<<crIt->maxError<<"; "<<crIt->evaluateRate<<" evaluations/s, "<<crIt->isosurfaceRate<<" isosurface triangles/s"<<std::endl;
+			results.push_back(result);
+			}
+	
+	/* Write the results: */
+	if(jsonFileName!=0)
+		{
+		std::ofstream jsonFile(jsonFileName);
+		if(!jsonFile)
+			{
+			std::cerr<<"Unable to write results to "<<jsonFileName<<std::endl;
+			return 1;
+			}
+		writeJson(jsonFile,parameters,results);
+		}
+	else
+		writeJson(std::cout,parameters,results);
+	
+	return 0;
+	}
@@ -59,6 +59,7 @@ class EarthDataSet:public DataSetBaseParam // Data set class
 	double flatteningFactor; // Flattening factor to be used by the Earth renderer
 	SphericalCoordinateTransformer* coordinateTransformer; // Coordinate transformer object for this Earth data set
 	std::vector<std::string> pointSetFileNames; // List of point set files to load for the Earth data set renderer
+	size_t pointBudget; // Maximum number of points to render per point set and frame; 0 renders all visible points
 	
 	/* Constructors and destructors: */
 	public:
@@ -87,6 +88,10 @@ class EarthDataSet:public DataSetBaseParam // Data set class
 		{
 		return pointSetFileNames;
 		}
+	size_t getPointBudget(void) const // Returns the per-frame point budget for point sets
+		{
+		return pointBudget;
+		}
 	};
 
 template <class DataSetBaseParam,class DataSetRendererBaseParam>
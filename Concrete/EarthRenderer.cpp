@@ -22,12 +22,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Concrete/EarthRenderer.h>
 
-#include <Math/Math.h>
-#include <Math/Constants.h>
+#include <stddef.h>
 #include <GL/gl.h>
 #include <GL/GLColorTemplates.h>
 #include <GL/GLContextData.h>
-#include <GL/GLModels.h>
+#include <GL/GLExtensionManager.h>
+#include <GL/Extensions/GLARBVertexBufferObject.h>
 #include <Images/Config.h>
 #include <Images/RGBImage.h>
 #include <Images/ReadImageFile.h>
@@ -44,14 +44,22 @@ Methods of class EarthRenderer::DataItem:
 
 EarthRenderer::DataItem::DataItem(void)
 	:surfaceTextureObjectId(0),
-	 displayListIdBase(0),
+	 hasVertexBufferObjectExtension(GLARBVertexBufferObject::isSupported()),
 	 surfaceVersion(0),gridVersion(0),outerCoreVersion(0),innerCoreVersion(0)
 	{
 	/* Generate a texture object for the Earth's surface texture: */
 	glGenTextures(1,&surfaceTextureObjectId);
 	
-	/* Generate display lists for the Earth model components: */
-	displayListIdBase=glGenLists(4);
+	for(int i=0;i<8;++i)
+		bufferObjectIds[i]=0;
+	if(hasVertexBufferObjectExtension)
+		{
+		/* Initialize the vertex buffer object extension: */
+		GLARBVertexBufferObject::initExtension();
+		
+		/* Generate vertex and index buffers for the Earth model components: */
+		glGenBuffersARB(8,bufferObjectIds);
+		}
 	}
 
 EarthRenderer::DataItem::~DataItem(void)
@@ -59,8 +67,9 @@ EarthRenderer::DataItem::~DataItem(void)
 	/* Delete the Earth surface texture object: */
 	glDeleteTextures(1,&surfaceTextureObjectId);
 	
-	/* Delete the Earth model components display lists: */
-	glDeleteLists(displayListIdBase,4);
+	/* Delete the Earth model components' vertex and index buffers: */
+	if(hasVertexBufferObjectExtension)
+		glDeleteBuffersARB(8,bufferObjectIds);
 	}
 
 /**************************************
@@ -74,191 +83,118 @@ const double EarthRenderer::flatteningFactor=1.0/298.257;
 Methods of class EarthRenderer:
 ******************************/
 
-void EarthRenderer::renderSurface(EarthRenderer::DataItem* dataItem) const
+void EarthRenderer::updateSurfaceTessellation(void)
 	{
-	/* Check if the Earth surface display list is up-to-date: */
-	if(dataItem->surfaceVersion==surfaceVersion)
-		{
-		/* Call the Earth surface display list: */
-		glCallList(dataItem->displayListIdBase+0);
-		}
-	else
+	const int baseNumStrips=18; // Number of circles of constant latitude for lowest-detail model
+	const int baseNumQuads=36; // Number of meridians for lowest-detail model
+	
+	surfaceTessellation=EllipsoidTessellation::get(EllipsoidTessellation::SURFACE,baseNumStrips*surfaceDetail,baseNumQuads*surfaceDetail,a*scaleFactor,f);
+	++surfaceVersion;
+	}
+
+void EarthRenderer::updateGridTessellation(void)
+	{
+	const int baseNumStrips=18; // Number of circles of constant latitude for lowest-detail model
+	const int baseNumQuads=36; // Number of meridians for lowest-detail model
+	
+	gridTessellation=EllipsoidTessellation::get(EllipsoidTessellation::GRID,baseNumStrips*gridDetail,baseNumQuads*gridDetail,a*scaleFactor,f);
+	++gridVersion;
+	}
+
+void EarthRenderer::updateOuterCoreTessellation(void)
+	{
+	int numStrips,numQuads;
+	EllipsoidTessellation::calcSphereSubdivision(outerCoreDetail,numStrips,numQuads);
+	outerCoreTessellation=EllipsoidTessellation::get(EllipsoidTessellation::SURFACE,numStrips,numQuads,3480.0e3*scaleFactor,0.0);
+	++outerCoreVersion;
+	}
+
+void EarthRenderer::updateInnerCoreTessellation(void)
+	{
+	int numStrips,numQuads;
+	EllipsoidTessellation::calcSphereSubdivision(innerCoreDetail,numStrips,numQuads);
+	innerCoreTessellation=EllipsoidTessellation::get(EllipsoidTessellation::SURFACE,numStrips,numQuads,1221.0e3*scaleFactor,0.0);
+	++innerCoreVersion;
+	}
+
+void EarthRenderer::renderTessellation(EarthRenderer::DataItem* dataItem,int component,const EllipsoidTessellation& tessellation,unsigned int& dataItemVersion,unsigned int version,bool texCoords,bool normals)
+	{
+	typedef EllipsoidTessellation::Vertex Vertex;
+	typedef EllipsoidTessellation::Index Index;
+	
+	const GLubyte* vertexBase;
+	const Index* indexBase;
+	if(dataItem->hasVertexBufferObjectExtension)
 		{
-		/* Update the Earth surface display list: */
-		glNewList(dataItem->displayListIdBase+0,GL_COMPILE_AND_EXECUTE);
-		
-		const double pi=Math::Constants<double>::pi;
-		const int baseNumStrips=18; // Number of circles of constant latitude for lowest-detail model
-		const int baseNumQuads=36; // Number of meridians for lowest-detail model
-		
-		int numStrips=baseNumStrips*surfaceDetail;
-		int numQuads=baseNumQuads*surfaceDetail;
+		/* Bind the component's vertex and index buffers: */
+		glBindBufferARB(GL_ARRAY_BUFFER_ARB,dataItem->bufferObjectIds[component*2+0]);
+		glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB,dataItem->bufferObjectIds[component*2+1]);
 		
-		float texY1=float(0)/float(numStrips);
-		double lat1=(pi*double(0))/double(numStrips)-0.5*pi;
-		double s1=Math::sin(lat1);
-		double c1=Math::cos(lat1);
-		double r1=a*(1.0-f*s1*s1)*scaleFactor;
-		double xy1=r1*c1;
-		double z1=r1*s1;
-		
-		/* Draw latitude quad strips: */
-		for(int i=1;i<numStrips+1;++i)
+		/* Check if the buffers are up-to-date: */
+		if(dataItemVersion!=version)
 			{
-			float texY0=texY1;
-			double s0=s1;
-			double c0=c1;
-			double xy0=xy1;
-			double z0=z1;
-			texY1=float(i)/float(numStrips);
-			lat1=(pi*double(i))/double(numStrips)-0.5*pi;
-			s1=Math::sin(lat1);
-			c1=Math::cos(lat1);
-			r1=a*(1.0-f*s1*s1)*scaleFactor;
-			xy1=r1*c1;
-			z1=r1*s1;
-			
-			glBegin(GL_QUAD_STRIP);
-			for(int j=0;j<=numQuads;++j)
-				{
-				float texX=float(j)/float(numQuads)+0.5f;
-				glTexCoord2f(texX,texY1);
-				double lng=(2.0*pi*double(j))/double(numQuads);
-				double cl=Math::cos(lng);
-				double sl=Math::sin(lng);
-				double nx1=(1.0-3.0*f*s1*s1)*c1*cl;
-				double ny1=(1.0-3.0*f*s1*s1)*c1*sl;
-				double nz1=(1.0+3.0*f*c1*c1-f)*s1;
-				double nl1=Math::sqrt(nx1*nx1+ny1*ny1+nz1*nz1);
-				glNormal3f(float(nx1/nl1),float(ny1/nl1),float(nz1/nl1));
-				double x1=xy1*cl;
-				double y1=xy1*sl;
-				glVertex3f(float(x1),float(y1),float(z1));
-				glTexCoord2f(texX,texY0);
-				double nx0=(1.0-3.0*f*s0*s0)*c0*cl;
-				double ny0=(1.0-3.0*f*s0*s0)*c0*sl;
-				double nz0=(1.0+3.0*f*c0*c0-f)*s0;
-				double nl0=Math::sqrt(nx0*nx0+ny0*ny0+nz0*nz0);
-				glNormal3f(float(nx0/nl0),float(ny0/nl0),float(nz0/nl0));
-				double x0=xy0*cl;
-				double y0=xy0*sl;
-				glVertex3f(float(x0),float(y0),float(z0));
-				}
-			glEnd();
+			/* Upload the tessellation in one go: */
+			glBufferDataARB(GL_ARRAY_BUFFER_ARB,tessellation.getNumVertices()*sizeof(Vertex),tessellation.getVertices(),GL_STATIC_DRAW_ARB);
+			glBufferDataARB(GL_ELEMENT_ARRAY_BUFFER_ARB,tessellation.getNumIndices()*sizeof(Index),tessellation.getIndices(),GL_STATIC_DRAW_ARB);
+			dataItemVersion=version;
 			}
 		
-		glEndList();
-		dataItem->surfaceVersion=surfaceVersion;
+		/* Render from the buffers: */
+		vertexBase=0;
+		indexBase=0;
 		}
-	}
-
-void EarthRenderer::renderGrid(EarthRenderer::DataItem* dataItem) const
-	{
-	/* Check if the latitude/longitude grid display list is up-to-date: */
-	if(dataItem->gridVersion==gridVersion)
+	else
 		{
-		/* Call the latitude/longitude grid display list: */
-		glCallList(dataItem->displayListIdBase+1);
+		/* Render from client-side arrays: */
+		vertexBase=reinterpret_cast<const GLubyte*>(tessellation.getVertices());
+		indexBase=tessellation.getIndices();
 		}
-	else
+	
+	/* Set up the vertex arrays: */
+	glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+	if(texCoords)
 		{
-		/* Create the latitude/longitude grid display list: */
-		glNewList(dataItem->displayListIdBase+1,GL_COMPILE_AND_EXECUTE);
-		
-		const double pi=Math::Constants<double>::pi;
-		const int baseNumStrips=18; // Number of circles of constant latitude for lowest-detail model
-		const int baseNumQuads=36; // Number of meridians for lowest-detail model
-		
-		int numStrips=baseNumStrips*gridDetail;
-		int numQuads=baseNumQuads*gridDetail;
-		
-		/* Draw circles of constant latitude (what are they called?): */
-		for(int i=1;i<baseNumStrips;++i)
-			{
-			double lat=(pi*double(i))/double(baseNumStrips)-0.5*pi;
-			double s=Math::sin(lat);
-			double c=Math::cos(lat);
-			double r=a*(1.0-f*s*s)*scaleFactor;
-			double xy=r*c;
-			double z=r*s;
-			
-			glBegin(GL_LINE_LOOP);
-			for(int j=0;j<numQuads;++j)
-				{
-				double lng=(2.0*pi*double(j))/double(numQuads);
-				double cl=Math::cos(lng);
-				double sl=Math::sin(lng);
-				double x=xy*cl;
-				double y=xy*sl;
-				glVertex3f(float(x),float(y),float(z));
-				}
-			glEnd();
-			}
-		
-		/* Draw meridians: */
-		for(int i=0;i<baseNumQuads;++i)
-			{
-			double lng=(2.0*pi*double(i))/double(baseNumQuads);
-			double cl=Math::cos(lng);
-			double sl=Math::sin(lng);
-			
-			glBegin(GL_LINE_STRIP);
-			glVertex3f(0.0f,0.0f,-a*(1.0-f)*scaleFactor);
-			for(int j=1;j<numStrips;++j)
-				{
-				double lat=(pi*double(j))/double(numStrips)-0.5*pi;
-				double s=Math::sin(lat);
-				double c=Math::cos(lat);
-				double r=a*(1.0-f*s*s)*scaleFactor;
-				double xy=r*c;
-				double x=xy*cl;
-				double y=xy*sl;
-				double z=r*s;
-				glVertex3f(float(x),float(y),float(z));
-				}
-			glVertex3f(0.0f,0.0f,a*(1.0-f)*scaleFactor);
-			glEnd();
-			}
-		
-		glEndList();
-		dataItem->gridVersion=gridVersion;
+		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+		glTexCoordPointer(2,GL_FLOAT,sizeof(Vertex),vertexBase+offsetof(Vertex,texCoord));
 		}
-	}
-
-void EarthRenderer::renderOuterCore(EarthRenderer::DataItem* dataItem) const
-	{
-	/* Check if the outer core display list is up-to-date: */
-	if(dataItem->outerCoreVersion==outerCoreVersion)
+	if(normals)
 		{
-		/* Call the outer core display list: */
-		glCallList(dataItem->displayListIdBase+2);
+		glEnableClientState(GL_NORMAL_ARRAY);
+		glNormalPointer(GL_FLOAT,sizeof(Vertex),vertexBase+offsetof(Vertex,normal));
 		}
-	else
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glVertexPointer(3,GL_FLOAT,sizeof(Vertex),vertexBase+offsetof(Vertex,position));
+	
+	/* Render the tessellation: */
+	glDrawElements(tessellation.getPrimitiveType(),GLsizei(tessellation.getNumIndices()),GL_UNSIGNED_INT,indexBase);
+	
+	glPopClientAttrib();
+	if(dataItem->hasVertexBufferObjectExtension)
 		{
-		/* Create the outer core display list: */
-		glNewList(dataItem->displayListIdBase+2,GL_COMPILE_AND_EXECUTE);
-		glDrawSphereIcosahedron(float(3480.0e3*scaleFactor),outerCoreDetail);
-		glEndList();
-		dataItem->outerCoreVersion=outerCoreVersion;
+		/* Protect the buffers: */
+		glBindBufferARB(GL_ARRAY_BUFFER_ARB,0);
+		glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB,0);
 		}
 	}
 
+void EarthRenderer::renderSurface(EarthRenderer::DataItem* dataItem) const
+	{
+	renderTessellation(dataItem,0,*surfaceTessellation,dataItem->surfaceVersion,surfaceVersion,true,true);
+	}
+
+void EarthRenderer::renderGrid(EarthRenderer::DataItem* dataItem) const
+	{
+	renderTessellation(dataItem,1,*gridTessellation,dataItem->gridVersion,gridVersion,false,false);
+	}
+
+void EarthRenderer::renderOuterCore(EarthRenderer::DataItem* dataItem) const
+	{
+	renderTessellation(dataItem,2,*outerCoreTessellation,dataItem->outerCoreVersion,outerCoreVersion,false,true);
+	}
+
 void EarthRenderer::renderInnerCore(EarthRenderer::DataItem* dataItem) const
 	{
-	/* Check if the inner core display list is up-to-date: */
-	if(dataItem->innerCoreVersion==innerCoreVersion)
-		{
-		/* Call the inner core display list: */
-		glCallList(dataItem->displayListIdBase+3);
-		}
-	else
-		{
-		/* Create the inner core display list: */
-		glNewList(dataItem->displayListIdBase+3,GL_COMPILE_AND_EXECUTE);
-		glDrawSphereIcosahedron(float(1221.0e3*scaleFactor),innerCoreDetail);
-		glEndList();
-		dataItem->innerCoreVersion=innerCoreVersion;
-		}
+	renderTessellation(dataItem,3,*innerCoreTessellation,dataItem->innerCoreVersion,innerCoreVersion,false,true);
 	}
 
 EarthRenderer::EarthRenderer(double sScaleFactor)
@@ -267,21 +203,26 @@ EarthRenderer::EarthRenderer(double sScaleFactor)
 	 surfaceDetail(2),
 	 surfaceMaterial(GLMaterial::Color(1.0f,1.0f,1.0f,0.333f),GLMaterial::Color(0.333f,0.333f,0.333f),10.0f),
 	 surfaceOpacity(0.333f),
-	 surfaceVersion(1),
+	 surfaceVersion(0),
 	 gridDetail(10),
 	 gridLineWidth(1.0f),
 	 gridColor(0.0f,1.0f,0.0f,0.1f),
 	 gridOpacity(0.1f),
-	 gridVersion(1),
+	 gridVersion(0),
 	 outerCoreDetail(8),
 	 outerCoreMaterial(GLMaterial::Color(1.0f,0.5f,0.0f,0.333f),GLMaterial::Color(1.0f,1.0f,1.0f),50.0f),
 	 outerCoreOpacity(0.333f),
-	 outerCoreVersion(1),
+	 outerCoreVersion(0),
 	 innerCoreDetail(8),
 	 innerCoreMaterial(GLMaterial::Color(1.0f,0.0f,0.0f,0.333f),GLMaterial::Color(1.0f,1.0f,1.0f),50.0f),
 	 innerCoreOpacity(0.333f),
-	 innerCoreVersion(1)
+	 innerCoreVersion(0)
 	{
+	/* Create the initial tessellations: */
+	updateSurfaceTessellation();
+	updateGridTessellation();
+	updateOuterCoreTessellation();
+	updateInnerCoreTessellation();
 	}
 
 void EarthRenderer::initContext(GLContextData& contextData) const
@@ -320,23 +261,23 @@ void EarthRenderer::initContext(GLContextData& contextData) const
 void EarthRenderer::setScaleFactor(double newScaleFactor)
 	{
 	scaleFactor=newScaleFactor;
-	++surfaceVersion;
-	++gridVersion;
-	++outerCoreVersion;
-	++innerCoreVersion;
+	updateSurfaceTessellation();
+	updateGridTessellation();
+	updateOuterCoreTessellation();
+	updateInnerCoreTessellation();
 	}
 
 void EarthRenderer::setFlatteningFactor(double newF)
 	{
 	f=newF;
-	++surfaceVersion;
-	++gridVersion;
+	updateSurfaceTessellation();
+	updateGridTessellation();
 	}
 
 void EarthRenderer::setSurfaceDetail(int newSurfaceDetail)
 	{
 	surfaceDetail=newSurfaceDetail;
-	++surfaceVersion;
+	updateSurfaceTessellation();
 	}
 
 void EarthRenderer::setSurfaceMaterial(const GLMaterial& newSurfaceMaterial)
@@ -354,7 +295,7 @@ void EarthRenderer::setSurfaceOpacity(float newSurfaceOpacity)
 void EarthRenderer::setGridDetail(int newGridDetail)
 	{
 	gridDetail=newGridDetail;
-	++gridVersion;
+	updateGridTessellation();
 	}
 
 void EarthRenderer::setGridLineWidth(float newGridLineWidth)
@@ -377,7 +318,7 @@ void EarthRenderer::setGridOpacity(float newGridOpacity)
 void EarthRenderer::setOuterCoreDetail(int newOuterCoreDetail)
 	{
 	outerCoreDetail=newOuterCoreDetail;
-	++outerCoreVersion;
+	updateOuterCoreTessellation();
 	}
 
 void EarthRenderer::setOuterCoreMaterial(const GLMaterial& newOuterCoreMaterial)
@@ -395,7 +336,7 @@ void EarthRenderer::setOuterCoreOpacity(float newOuterCoreOpacity)
 void EarthRenderer::setInnerCoreDetail(int newInnerCoreDetail)
 	{
 	innerCoreDetail=newInnerCoreDetail;
-	++innerCoreVersion;
+	updateInnerCoreTessellation();
 	}
 
 void EarthRenderer::setInnerCoreMaterial(const GLMaterial& newInnerCoreMaterial)
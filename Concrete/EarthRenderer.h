@@ -29,6 +29,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <GL/GLMaterial.h>
 #include <GL/GLObject.h>
 
+#include <Concrete/EllipsoidTessellation.h>
+
 /* Forward declarations: */
 class GLRenderState;
 
@@ -48,11 +50,12 @@ class EarthRenderer:public GLObject
 		/* Elements: */
 		public:
 		GLuint surfaceTextureObjectId; // Texture object ID for Earth surface texture
-		GLuint displayListIdBase; // Base ID of set of display lists for Earth model components
-		unsigned int surfaceVersion; // Version number of surface display list
-		unsigned int gridVersion; // Version number of longitude/latitude grid display list
-		unsigned int outerCoreVersion; // Version number of outer core display list
-		unsigned int innerCoreVersion; // Version number of inner core display list
+		bool hasVertexBufferObjectExtension; // Flag whether the OpenGL context supports vertex buffer objects
+		GLuint bufferObjectIds[8]; // Vertex and index buffer object IDs for the surface, grid, outer core, and inner core tessellations
+		unsigned int surfaceVersion; // Version number of surface buffers
+		unsigned int gridVersion; // Version number of longitude/latitude grid buffers
+		unsigned int outerCoreVersion; // Version number of outer core buffers
+		unsigned int innerCoreVersion; // Version number of inner core buffers
 		
 		/* Constructors and destructors: */
 		DataItem(void);
@@ -67,22 +70,31 @@ class EarthRenderer:public GLObject
 	int surfaceDetail; // Subdivision level of surface sphere
 	GLMaterial surfaceMaterial; // Material property for surface
 	float surfaceOpacity; // Transparenct for surface (0.0: invisible, 1.0: fully opaque)
-	unsigned int surfaceVersion; // Version number of surface display list
+	EllipsoidTessellation::TessellationPtr surfaceTessellation; // Tessellation of the surface ellipsoid
+	unsigned int surfaceVersion; // Version number of surface tessellation
 	int gridDetail; // Subdivision level of longitude/latitude grid
 	float gridLineWidth; // Line width of longitude/latitude grid
 	Color gridColor; // Color of longitude/latitude grid
 	float gridOpacity; // Opacity of longitude/latitude grid (0.0: invisible, 1.0: fully opaque)
-	unsigned int gridVersion; // Version number of longitude/latitude grid display list
+	EllipsoidTessellation::TessellationPtr gridTessellation; // Tessellation of the longitude/latitude grid
+	unsigned int gridVersion; // Version number of longitude/latitude grid tessellation
 	int outerCoreDetail; // Subdivision level of outer core sphere
 	GLMaterial outerCoreMaterial; // Material property for outer core
 	float outerCoreOpacity; // Transparenct for outer core (0.0: invisible, 1.0: fully opaque)
-	unsigned int outerCoreVersion; // Version number of outer core display list
+	EllipsoidTessellation::TessellationPtr outerCoreTessellation; // Tessellation of the outer core sphere
+	unsigned int outerCoreVersion; // Version number of outer core tessellation
 	int innerCoreDetail; // Subdivision level of inner core sphere
 	GLMaterial innerCoreMaterial; // Material property for inner core
 	float innerCoreOpacity; // Transparenct for inner core (0.0: invisible, 1.0: fully opaque)
-	unsigned int innerCoreVersion; // Version number of inner core display list
+	EllipsoidTessellation::TessellationPtr innerCoreTessellation; // Tessellation of the inner core sphere
+	unsigned int innerCoreVersion; // Version number of inner core tessellation
 	
 	/* Private methods: */
+	void updateSurfaceTessellation(void);
+	void updateGridTessellation(void);
+	void updateOuterCoreTessellation(void);
+	void updateInnerCoreTessellation(void);
+	static void renderTessellation(DataItem* dataItem,int component,const EllipsoidTessellation& tessellation,unsigned int& dataItemVersion,unsigned int version,bool texCoords,bool normals); // Renders a tessellation from the data item's buffers, uploading it first if the buffers are outdated
 	void renderSurface(DataItem* dataItem) const;
 	void renderGrid(DataItem* dataItem) const;
 	void renderOuterCore(DataItem* dataItem) const;
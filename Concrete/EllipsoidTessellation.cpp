@@ -0,0 +1,241 @@
+/***********************************************************************
+EllipsoidTessellation - Class for indexed tessellations of ellipsoids of
+revolution and their latitude/longitude grids, memoized per detail
+level, radius, and flattening factor.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Concrete/EllipsoidTessellation.h>
+
+#include <Math/Math.h>
+#include <Math/Constants.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+/**********************************************
+Static elements of class EllipsoidTessellation:
+**********************************************/
+
+Threads::Mutex EllipsoidTessellation::cacheMutex;
+std::vector<EllipsoidTessellation::CacheEntry> EllipsoidTessellation::cache;
+unsigned int EllipsoidTessellation::cacheUseCounter=0;
+
+/**************************************
+Methods of class EllipsoidTessellation:
+**************************************/
+
+EllipsoidTessellation::Vertex EllipsoidTessellation::calcVertex(int strip,int quad,int numStrips,int numQuads,double radius,double flatteningFactor)
+	{
+	const double pi=Math::Constants<double>::pi;
+	const double f=flatteningFactor;
+	
+	Vertex result;
+	result.texCoord[0]=float(quad)/float(numQuads)+0.5f;
+	result.texCoord[1]=float(strip)/float(numStrips);
+	
+	/* Calculate the point on the ellipsoid: */
+	double lat=(pi*double(strip))/double(numStrips)-0.5*pi;
+	double s=Math::sin(lat);
+	double c=Math::cos(lat);
+	double r=radius*(1.0-f*s*s);
+	double xy=r*c;
+	double lng=(2.0*pi*double(quad))/double(numQuads);
+	double cl=Math::cos(lng);
+	double sl=Math::sin(lng);
+	result.position[0]=float(xy*cl);
+	result.position[1]=float(xy*sl);
+	result.position[2]=float(r*s);
+	
+	/* Calculate the ellipsoid's normal vector: */
+	double nx=(1.0-3.0*f*s*s)*c*cl;
+	double ny=(1.0-3.0*f*s*s)*c*sl;
+	double nz=(1.0+3.0*f*c*c-f)*s;
+	double nl=Math::sqrt(nx*nx+ny*ny+nz*nz);
+	result.normal[0]=float(nx/nl);
+	result.normal[1]=float(ny/nl);
+	result.normal[2]=float(nz/nl);
+	
+	return result;
+	}
+
+void EllipsoidTessellation::createSurface(int numStrips,int numQuads,double radius,double flatteningFactor)
+	{
+	primitiveType=GL_TRIANGLE_STRIP;
+	
+	/* Map from latitude/longitude grid positions to vertex indices, assigned in order of first use: */
+	int rowLength=numQuads+1;
+	std::vector<int> vertexIndices((numStrips+1)*rowLength,-1);
+	
+	/*********************************************************************
+	Traverse the surface in blocks of a few longitude quads, and each block
+	from south to north. The previous band's top row of a block is still in
+	the vertex cache when the next band reuses it as its bottom row, which
+	is not the case for strips spanning the full circle of latitude.
+	*********************************************************************/
+	
+	for(int quad0=0;quad0<numQuads;quad0+=blockWidth)
+		{
+		int quad1=quad0+blockWidth;
+		if(quad1>numQuads)
+			quad1=numQuads;
+		for(int strip=1;strip<=numStrips;++strip)
+			{
+			for(int quad=quad0;quad<=quad1;++quad)
+				{
+				/* Emit the band's top vertex first, then its bottom vertex, to keep the original quad strips' winding order: */
+				for(int row=0;row<2;++row)
+					{
+					int s=strip-row;
+					int& vi=vertexIndices[s*rowLength+quad];
+					if(vi<0)
+						{
+						vi=int(vertices.size());
+						vertices.push_back(calcVertex(s,quad,numStrips,numQuads,radius,flatteningFactor));
+						}
+					
+					/* Join with the previous strip by a pair of degenerate triangles; all strips have even length: */
+					if(quad==quad0&&row==0&&!indices.empty())
+						{
+						Index last=indices.back();
+						indices.push_back(last);
+						indices.push_back(Index(vi));
+						}
+					
+					indices.push_back(Index(vi));
+					}
+				}
+			}
+		}
+	}
+
+void EllipsoidTessellation::createGrid(int numStrips,int numQuads,double radius,double flatteningFactor)
+	{
+	const int baseNumStrips=18; // Number of circles of constant latitude for lowest-detail model
+	const int baseNumQuads=36; // Number of meridians for lowest-detail model
+	
+	primitiveType=GL_LINES;
+	int stripStep=numStrips/baseNumStrips;
+	int quadStep=numQuads/baseNumQuads;
+	
+	/* Map from latitude/longitude grid positions to vertex indices; all meridians share the pole vertices: */
+	int rowLength=numQuads+1;
+	std::vector<int> vertexIndices((numStrips+1)*rowLength,-1);
+	for(int pole=0;pole<2;++pole)
+		{
+		int s=pole*numStrips;
+		for(int quad=0;quad<=numQuads;++quad)
+			vertexIndices[s*rowLength+quad]=int(vertices.size());
+		Vertex v=calcVertex(s,0,numStrips,numQuads,radius,flatteningFactor);
+		v.position[0]=v.position[1]=0.0f;
+		v.position[2]=float((pole==0?-radius:radius)*(1.0-flatteningFactor));
+		vertices.push_back(v);
+		}
+	
+	/* Create the vertices of all circles of constant latitude and all meridians: */
+	for(int strip=1;strip<numStrips;++strip)
+		for(int quad=0;quad<numQuads;++quad)
+			if(strip%stripStep==0||quad%quadStep==0)
+				{
+				vertexIndices[strip*rowLength+quad]=int(vertices.size());
+				vertices.push_back(calcVertex(strip,quad,numStrips,numQuads,radius,flatteningFactor));
+				}
+	
+	/* Draw circles of constant latitude: */
+	for(int i=1;i<baseNumStrips;++i)
+		{
+		int strip=i*stripStep;
+		for(int quad=0;quad<numQuads;++quad)
+			{
+			indices.push_back(Index(vertexIndices[strip*rowLength+quad]));
+			indices.push_back(Index(vertexIndices[strip*rowLength+(quad+1)%numQuads]));
+			}
+		}
+	
+	/* Draw meridians: */
+	for(int i=0;i<baseNumQuads;++i)
+		{
+		int quad=i*quadStep;
+		for(int strip=0;strip<numStrips;++strip)
+			{
+			indices.push_back(Index(vertexIndices[strip*rowLength+quad]));
+			indices.push_back(Index(vertexIndices[(strip+1)*rowLength+quad]));
+			}
+		}
+	}
+
+EllipsoidTessellation::EllipsoidTessellation(EllipsoidTessellation::Kind sKind,int numStrips,int numQuads,double radius,double flatteningFactor)
+	:kind(sKind)
+	{
+	if(kind==SURFACE)
+		createSurface(numStrips,numQuads,radius,flatteningFactor);
+	else
+		createGrid(numStrips,numQuads,radius,flatteningFactor);
+	}
+
+EllipsoidTessellation::TessellationPtr EllipsoidTessellation::get(EllipsoidTessellation::Kind kind,int numStrips,int numQuads,double radius,double flatteningFactor)
+	{
+	Threads::Mutex::Lock cacheLock(cacheMutex);
+	++cacheUseCounter;
+	
+	/* Check if the requested tessellation is memoized: */
+	for(std::vector<CacheEntry>::iterator cIt=cache.begin();cIt!=cache.end();++cIt)
+		if(cIt->kind==kind&&cIt->numStrips==numStrips&&cIt->numQuads==numQuads&&cIt->radius==radius&&cIt->flatteningFactor==flatteningFactor)
+			{
+			cIt->lastUse=cacheUseCounter;
+			return cIt->tessellation;
+			}
+	
+	/* Evict the least recently requested tessellation if the cache is full; renderers still using it keep their references: */
+	if(cache.size()>=maxCacheSize)
+		{
+		std::vector<CacheEntry>::iterator evictIt=cache.begin();
+		for(std::vector<CacheEntry>::iterator cIt=cache.begin();cIt!=cache.end();++cIt)
+			if(evictIt->lastUse>cIt->lastUse)
+				evictIt=cIt;
+		cache.erase(evictIt);
+		}
+	
+	/* Create and memoize the tessellation: */
+	CacheEntry entry;
+	entry.kind=kind;
+	entry.numStrips=numStrips;
+	entry.numQuads=numQuads;
+	entry.radius=radius;
+	entry.flatteningFactor=flatteningFactor;
+	entry.lastUse=cacheUseCounter;
+	entry.tessellation=new EllipsoidTessellation(kind,numStrips,numQuads,radius,flatteningFactor);
+	cache.push_back(entry);
+	
+	return entry.tessellation;
+	}
+
+void EllipsoidTessellation::calcSphereSubdivision(int detail,int& numStrips,int& numQuads)
+	{
+	/* An icosahedron sphere has 20*detail^2 triangles; a latitude/longitude sphere has 4*numStrips^2: */
+	numStrips=int(Math::ceil(Math::sqrt(5.0)*double(detail)));
+	if(numStrips<2)
+		numStrips=2;
+	numQuads=2*numStrips;
+	}
+
+}
+
+}
@@ -0,0 +1,125 @@
+/***********************************************************************
+EllipsoidTessellation - Class for indexed tessellations of ellipsoids of
+revolution and their latitude/longitude grids, memoized per detail
+level, radius, and flattening factor.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_CONCRETE_ELLIPSOIDTESSELLATION_INCLUDED
+#define VISUALIZATION_CONCRETE_ELLIPSOIDTESSELLATION_INCLUDED
+
+#include <vector>
+#include <Misc/Autopointer.h>
+#include <Threads/Mutex.h>
+#include <Threads/RefCounted.h>
+#include <GL/gl.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+class EllipsoidTessellation:public Threads::RefCounted
+	{
+	/* Embedded classes: */
+	public:
+	enum Kind // Enumerated type for kinds of tessellations
+		{
+		SURFACE,GRID
+		};
+	
+	struct Vertex // Structure for vertices; layout matches GL_T2F_N3F_V3F interleaved arrays
+		{
+		/* Elements: */
+		public:
+		GLfloat texCoord[2]; // Texture coordinate in longitude/latitude texture space
+		GLfloat normal[3]; // Surface normal vector
+		GLfloat position[3]; // Vertex position
+		};
+	
+	typedef GLuint Index; // Type for vertex indices
+	typedef Misc::Autopointer<EllipsoidTessellation> TessellationPtr; // Type for pointers to shared tessellations
+	
+	private:
+	struct CacheEntry // Structure for memoized tessellations
+		{
+		/* Elements: */
+		public:
+		Kind kind; // Kind of the tessellation
+		int numStrips,numQuads; // Number of latitude strips and longitude quads
+		double radius; // Equatorial radius
+		double flatteningFactor; // Flattening factor
+		unsigned int lastUse; // Value of the use counter when the entry was last requested
+		TessellationPtr tessellation; // The memoized tessellation
+		};
+	
+	static const int blockWidth=8; // Number of quads in the longitude blocks traversed by surface strips
+	static const size_t maxCacheSize=16; // Maximum number of memoized tessellations
+	static Threads::Mutex cacheMutex; // Mutex serializing access to the tessellation cache
+	static std::vector<CacheEntry> cache; // List of memoized tessellations
+	static unsigned int cacheUseCounter; // Counter to track the order in which tessellations were requested
+	
+	/* Elements: */
+	Kind kind; // Kind of this tessellation
+	GLenum primitiveType; // OpenGL primitive type to render the index array
+	std::vector<Vertex> vertices; // Array of vertices, in order of first use
+	std::vector<Index> indices; // Index array; a single triangle strip joined by degenerate triangles for surfaces, or line segments for grids
+	
+	/* Private methods: */
+	static Vertex calcVertex(int strip,int quad,int numStrips,int numQuads,double radius,double flatteningFactor); // Calculates the vertex at the given latitude/longitude grid position
+	void createSurface(int numStrips,int numQuads,double radius,double flatteningFactor); // Creates a surface tessellation
+	void createGrid(int numStrips,int numQuads,double radius,double flatteningFactor); // Creates a latitude/longitude grid
+	
+	/* Constructors and destructors: */
+	EllipsoidTessellation(Kind sKind,int numStrips,int numQuads,double radius,double flatteningFactor); // Creates a tessellation of the given kind
+	
+	/* Methods: */
+	public:
+	static TessellationPtr get(Kind kind,int numStrips,int numQuads,double radius,double flatteningFactor); // Returns the shared tessellation of the given kind and parameters, creating it if it is not memoized yet
+	static void calcSphereSubdivision(int detail,int& numStrips,int& numQuads); // Calculates latitude/longitude subdivisions yielding about as many triangles as an icosahedron sphere of the given subdivision level
+	Kind getKind(void) const // Returns the kind of this tessellation
+		{
+		return kind;
+		}
+	GLenum getPrimitiveType(void) const // Returns the OpenGL primitive type to render the index array
+		{
+		return primitiveType;
+		}
+	size_t getNumVertices(void) const // Returns the number of vertices
+		{
+		return vertices.size();
+		}
+	const Vertex* getVertices(void) const // Returns the vertex array
+		{
+		return &vertices[0];
+		}
+	size_t getNumIndices(void) const // Returns the number of indices
+		{
+		return indices.size();
+		}
+	const Index* getIndices(void) const // Returns the index array
+		{
+		return &indices[0];
+		}
+	};
+
+}
+
+}
+
+#endif
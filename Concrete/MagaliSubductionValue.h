@@ -28,6 +28,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/Endianness.h>
 
 #include <Templatized/ScalarExtractor.h>
+#include <Templatized/MaterializedScalarSlice.h>
 #include <Templatized/VectorExtractor.h>
 #include <Wrappers/DataValue.h>
 
@@ -106,6 +107,7 @@ Specialized value extractor classes for MagaliSubductionValue objects:
 
 template <class ScalarParam>
 class ScalarExtractor<ScalarParam,Visualization::Concrete::MagaliSubductionValue>
+	:public MaterializedScalarExtractorBase<ScalarParam>
 	{
 	/* Embedded classes: */
 	public:
@@ -142,9 +144,13 @@ class ScalarExtractor<ScalarParam,Visualization::Concrete::MagaliSubductionValue
 	void setScalarType(int newScalarType) // Sets scalar type of extractor
 		{
 		scalarType=newScalarType;
+		this->materializedSlice=MaterializedScalarSlice<ScalarParam>();
 		}
 	DestValue getValue(const SourceValue& source) const // Extracts scalar from source value
 		{
+		if(this->materializedSlice.isMaterialized())
+			return DestValue(this->materializedSlice.getValue(source));
+		
 		switch(scalarType)
 			{
 			case TEMPERATURE:
@@ -27,6 +27,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/Vector.h>
 
 #include <Templatized/ScalarExtractor.h>
+#include <Templatized/MaterializedScalarSlice.h>
 #include <Wrappers/DataValue.h>
 
 namespace Visualization {
@@ -90,6 +91,7 @@ Specialized value extractor classes for MargareteSubductionValue objects:
 
 template <class ScalarParam>
 class ScalarExtractor<ScalarParam,Visualization::Concrete::MargareteSubductionValue>
+	:public MaterializedScalarExtractorBase<ScalarParam>
 	{
 	/* Embedded classes: */
 	public:
@@ -121,9 +123,13 @@ class ScalarExtractor<ScalarParam,Visualization::Concrete::MargareteSubductionVa
 	void setScalarType(int newScalarType) // Sets scalar type of extractor
 		{
 		scalarType=newScalarType;
+		this->materializedSlice=MaterializedScalarSlice<ScalarParam>();
 		}
 	DestValue getValue(const SourceValue& source) const // Extracts scalar from source value
 		{
+		if(this->materializedSlice.isMaterialized())
+			return DestValue(this->materializedSlice.getValue(source));
+		
 		switch(scalarType)
 			{
 			case TEMPERATURE:
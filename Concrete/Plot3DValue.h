@@ -28,6 +28,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/Endianness.h>
 
 #include <Templatized/ScalarExtractor.h>
+#include <Templatized/MaterializedScalarSlice.h>
 #include <Templatized/VectorExtractor.h>
 #include <Wrappers/DataValue.h>
 
@@ -96,6 +97,7 @@ Specialized value extractor classes for Plot3DValue objects:
 
 template <class ScalarParam>
 class ScalarExtractor<ScalarParam,Visualization::Concrete::Plot3DValue>
+	:public MaterializedScalarExtractorBase<ScalarParam>
 	{
 	/* Embedded classes: */
 	public:
@@ -127,9 +129,13 @@ class ScalarExtractor<ScalarParam,Visualization::Concrete::Plot3DValue>
 	void setScalarType(int newScalarType) // Sets scalar type of extractor
 		{
 		scalarType=newScalarType;
+		this->materializedSlice=MaterializedScalarSlice<ScalarParam>();
 		}
 	DestValue getValue(const SourceValue& source) const // Returns scalar value from data value
 		{
+		if(this->materializedSlice.isMaterialized())
+			return DestValue(this->materializedSlice.getValue(source));
+		
 		switch(scalarType)
 			{
 			case DENSITY:
@@ -0,0 +1,512 @@
+/***********************************************************************
+PointOctree - Class for octrees over Morton-sorted point sets supporting
+view-dependent selection of point subsets under a point budget.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Concrete/PointOctree.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <stdexcept>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <Misc/ThrowStdErr.h>
+#include <Misc/File.h>
+#include <Math/Math.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+namespace {
+
+/*****************************************************
+Helper functions for Morton codes and sample ordering:
+*****************************************************/
+
+inline
+Misc::UInt64
+spreadMortonBits(
+	unsigned int value)
+	{
+	/* Insert two zero bits between each of the lower 21 bits of the value: */
+	Misc::UInt64 result=Misc::UInt64(value&0x1fffffU);
+	result=(result|(result<<32))&0x1f00000000ffffULL;
+	result=(result|(result<<16))&0x1f0000ff0000ffULL;
+	result=(result|(result<<8))&0x100f00f00f00f00fULL;
+	result=(result|(result<<4))&0x10c30c30c30c30c3ULL;
+	result=(result|(result<<2))&0x1249249249249249ULL;
+	return result;
+	}
+
+inline
+size_t
+reverseBits(
+	size_t value,
+	int numBits)
+	{
+	size_t result=0;
+	for(int i=0;i<numBits;++i,value>>=1)
+		result=(result<<1)|(value&0x1U);
+	return result;
+	}
+
+const char cacheFileMagic[16]="PointOctree"; // Identifier at the beginning of cache files
+
+}
+
+/****************************
+Methods of class PointOctree:
+****************************/
+
+void PointOctree::buildNode(unsigned int nodeIndex,std::vector<PointOctree::MortonKey>& keys,size_t first,size_t last,int level)
+	{
+	nodes[nodeIndex].first=(unsigned int)first;
+	nodes[nodeIndex].numPoints=(unsigned int)(last-first);
+	
+	if(last-first<=leafSize||level==21)
+		{
+		/* Make the node a leaf: */
+		nodes[nodeIndex].firstChild=0;
+		nodes[nodeIndex].numChildren=0;
+		
+		/* Calculate the leaf's bounding box: */
+		Node& node=nodes[nodeIndex];
+		for(int i=0;i<3;++i)
+			node.min[i]=node.max[i]=points[keys[first].index].position[i];
+		for(size_t ki=first+1;ki<last;++ki)
+			{
+			const Scalar* pos=points[keys[ki].index].position;
+			for(int i=0;i<3;++i)
+				{
+				if(node.min[i]>pos[i])
+					node.min[i]=pos[i];
+				if(node.max[i]<pos[i])
+					node.max[i]=pos[i];
+				}
+			}
+		
+		/*****************************************************************
+		Reorder the leaf's points by bit-reversed position along the Morton
+		curve, so that every prefix of the leaf is a spatially stratified
+		sample of all its points.
+		*****************************************************************/
+		
+		size_t numPoints=last-first;
+		int numBits=0;
+		while((size_t(1)<<numBits)<numPoints)
+			++numBits;
+		std::vector<size_t> order;
+		order.reserve(numPoints);
+		for(size_t r=0;r<(size_t(1)<<numBits);++r)
+			{
+			size_t j=reverseBits(r,numBits);
+			if(j<numPoints)
+				order.push_back(keys[first+j].index);
+			}
+		for(size_t i=0;i<numPoints;++i)
+			keys[first+i].index=order[i];
+		
+		return;
+		}
+	
+	/* Split the key range into octants by the next three bits of the Morton codes: */
+	int shift=3*(20-level);
+	size_t octantEnds[8];
+	size_t octantBegin=first;
+	unsigned int numChildren=0;
+	for(int octant=0;octant<8;++octant)
+		{
+		/* Find the end of the octant's range by binary search: */
+		size_t l=octantBegin;
+		size_t r=last;
+		while(l<r)
+			{
+			size_t m=(l+r)>>1;
+			if(int((keys[m].code>>shift)&0x7U)<=octant)
+				l=m+1;
+			else
+				r=m;
+			}
+		octantEnds[octant]=l;
+		if(l>octantBegin)
+			++numChildren;
+		octantBegin=l;
+		}
+	
+	/* Allocate the node's children consecutively: */
+	unsigned int firstChild=(unsigned int)nodes.size();
+	nodes[nodeIndex].firstChild=firstChild;
+	nodes[nodeIndex].numChildren=numChildren;
+	nodes.resize(nodes.size()+numChildren);
+	
+	/* Build all non-empty children: */
+	unsigned int childIndex=firstChild;
+	octantBegin=first;
+	for(int octant=0;octant<8;++octant)
+		{
+		if(octantEnds[octant]>octantBegin)
+			{
+			buildNode(childIndex,keys,octantBegin,octantEnds[octant],level+1);
+			++childIndex;
+			}
+		octantBegin=octantEnds[octant];
+		}
+	
+	/* Calculate the node's bounding box as the union of its children's: */
+	Node& node=nodes[nodeIndex];
+	for(int i=0;i<3;++i)
+		{
+		node.min[i]=nodes[firstChild].min[i];
+		node.max[i]=nodes[firstChild].max[i];
+		}
+	for(unsigned int ci=firstChild+1;ci<firstChild+numChildren;++ci)
+		for(int i=0;i<3;++i)
+			{
+			if(node.min[i]>nodes[ci].min[i])
+				node.min[i]=nodes[ci].min[i];
+			if(node.max[i]<nodes[ci].max[i])
+				node.max[i]=nodes[ci].max[i];
+			}
+	}
+
+PointOctree::PointOctree(void)
+	{
+	}
+
+void PointOctree::build(std::vector<PointOctree::Point>& sPoints)
+	{
+	/* Take over the given points: */
+	points.clear();
+	points.swap(sPoints);
+	nodes.clear();
+	size_t numPoints=points.size();
+	if(numPoints==0)
+		return;
+	
+	/* Calculate the point set's bounding box: */
+	Scalar min[3],max[3];
+	for(int i=0;i<3;++i)
+		min[i]=max[i]=points[0].position[i];
+	for(std::vector<Point>::const_iterator pIt=points.begin();pIt!=points.end();++pIt)
+		for(int i=0;i<3;++i)
+			{
+			if(min[i]>pIt->position[i])
+				min[i]=pIt->position[i];
+			if(max[i]<pIt->position[i])
+				max[i]=pIt->position[i];
+			}
+	
+	/* Quantize all points to 21 bits per coordinate and calculate their Morton codes: */
+	double scale[3];
+	for(int i=0;i<3;++i)
+		scale[i]=max[i]>min[i]?double(0x1fffffU)/(double(max[i])-double(min[i])):0.0;
+	std::vector<MortonKey> keys(numPoints);
+	for(size_t pi=0;pi<numPoints;++pi)
+		{
+		keys[pi].code=0;
+		for(int i=0;i<3;++i)
+			{
+			unsigned int q=(unsigned int)((double(points[pi].position[i])-double(min[i]))*scale[i]);
+			keys[pi].code|=spreadMortonBits(q)<<i;
+			}
+		keys[pi].index=pi;
+		}
+	std::sort(keys.begin(),keys.end());
+	
+	/* Build the octree: */
+	nodes.resize(1);
+	buildNode(0,keys,0,numPoints,0);
+	
+	/* Reorder the points: */
+	std::vector<Point> sortedPoints;
+	sortedPoints.reserve(numPoints);
+	for(std::vector<MortonKey>::const_iterator kIt=keys.begin();kIt!=keys.end();++kIt)
+		sortedPoints.push_back(points[kIt->index]);
+	points.swap(sortedPoints);
+	}
+
+bool PointOctree::load(const char* cacheFileName,Misc::UInt64 sourceStamp)
+	{
+	try
+		{
+		Misc::File cacheFile(cacheFileName,"rb",Misc::File::LittleEndian);
+		
+		/* Check the cache file's header: */
+		char magic[16];
+		cacheFile.read(magic,sizeof(magic));
+		if(memcmp(magic,cacheFileMagic,sizeof(magic))!=0)
+			return false;
+		if(cacheFile.read<Misc::UInt32>()!=cacheFileVersion)
+			return false;
+		if(cacheFile.read<Misc::UInt64>()!=sourceStamp)
+			return false;
+		if(cacheFile.read<Misc::UInt32>()!=leafSize)
+			return false;
+		
+		/* Read the points: */
+		size_t numPoints=size_t(cacheFile.read<Misc::UInt64>());
+		size_t numNodes=size_t(cacheFile.read<Misc::UInt64>());
+		std::vector<Point> newPoints(numPoints);
+		if(numPoints>0)
+			cacheFile.read(newPoints[0].position,numPoints*3);
+		
+		/* Read the octree nodes: */
+		std::vector<Node> newNodes(numNodes);
+		for(std::vector<Node>::iterator nIt=newNodes.begin();nIt!=newNodes.end();++nIt)
+			{
+			cacheFile.read(nIt->min,3);
+			cacheFile.read(nIt->max,3);
+			nIt->first=cacheFile.read<Misc::UInt32>();
+			nIt->numPoints=cacheFile.read<Misc::UInt32>();
+			nIt->firstChild=cacheFile.read<Misc::UInt32>();
+			nIt->numChildren=cacheFile.read<Misc::UInt32>();
+			if(size_t(nIt->first)+size_t(nIt->numPoints)>numPoints||size_t(nIt->firstChild)+size_t(nIt->numChildren)>numNodes)
+				return false;
+			}
+		
+		/* Install the loaded octree: */
+		points.swap(newPoints);
+		nodes.swap(newNodes);
+		return true;
+		}
+	catch(std::runtime_error err)
+		{
+		/* Treat unreadable cache files as missing: */
+		return false;
+		}
+	}
+
+void PointOctree::save(const char* cacheFileName,Misc::UInt64 sourceStamp) const
+	{
+	/* Write into a temporary file first so that readers never see partial cache files: */
+	std::string tempFileName=cacheFileName;
+	tempFileName.append(".tmp");
+		{
+		/* Open the temporary file; it is closed at the end of this block: */
+		Misc::File cacheFile(tempFileName.c_str(),"wb",Misc::File::LittleEndian);
+		
+		/* Write the cache file's header: */
+		cacheFile.write(cacheFileMagic,sizeof(cacheFileMagic));
+		cacheFile.write<Misc::UInt32>(Misc::UInt32(cacheFileVersion));
+		cacheFile.write<Misc::UInt64>(sourceStamp);
+		cacheFile.write<Misc::UInt32>(Misc::UInt32(leafSize));
+		cacheFile.write<Misc::UInt64>(points.size());
+		cacheFile.write<Misc::UInt64>(nodes.size());
+		
+		/* Write the points: */
+		if(!points.empty())
+			cacheFile.write(points[0].position,points.size()*3);
+		
+		/* Write the octree nodes: */
+		for(std::vector<Node>::const_iterator nIt=nodes.begin();nIt!=nodes.end();++nIt)
+			{
+			cacheFile.write(nIt->min,3);
+			cacheFile.write(nIt->max,3);
+			cacheFile.write<Misc::UInt32>(nIt->first);
+			cacheFile.write<Misc::UInt32>(nIt->numPoints);
+			cacheFile.write<Misc::UInt32>(nIt->firstChild);
+			cacheFile.write<Misc::UInt32>(nIt->numChildren);
+			}
+		}
+	
+	/* Replace the cache file: */
+	if(rename(tempFileName.c_str(),cacheFileName)!=0)
+		{
+		remove(tempFileName.c_str());
+		Misc::throwStdErr("PointOctree::save: Unable to create cache file \"%s\"",cacheFileName);
+		}
+	}
+
+size_t PointOctree::select(const double clip[16],size_t pointBudget,std::vector<PointOctree::Run>& runs) const
+	{
+	runs.clear();
+	if(nodes.empty())
+		return 0;
+	
+	/* Extract the left/right, bottom/top, and near/far frustum planes from the clip matrix: */
+	double planes[6][4];
+	for(int i=0;i<3;++i)
+		for(int j=0;j<4;++j)
+			{
+			planes[i*2+0][j]=clip[j*4+3]+clip[j*4+i];
+			planes[i*2+1][j]=clip[j*4+3]-clip[j*4+i];
+			}
+	
+	/* Traverse the octree and collect all leaves intersecting the view frustum: */
+	std::vector<VisibleLeaf> leaves;
+	size_t totalNumPoints=0;
+	double minWeight=1.0;
+	double maxWeight=0.0;
+	unsigned int maxLeafPoints=0;
+	
+	/* Floor leaf sizes at the finest Morton cell, so that leaves of coincident points keep a finite weight: */
+	double minRadius2=0.0;
+	for(int j=0;j<3;++j)
+		minRadius2+=Math::sqr((double(nodes[0].max[j])-double(nodes[0].min[j]))*0.5/double(1U<<21));
+	if(minRadius2==0.0)
+		minRadius2=1.0;
+	
+	std::vector<std::pair<unsigned int,bool> > traversalStack; // Stack of nodes to visit, with flags whether they are known to be entirely inside the frustum
+	traversalStack.push_back(std::pair<unsigned int,bool>(0,false));
+	while(!traversalStack.empty())
+		{
+		unsigned int nodeIndex=traversalStack.back().first;
+		bool inside=traversalStack.back().second;
+		traversalStack.pop_back();
+		const Node& node=nodes[nodeIndex];
+		
+		if(!inside)
+			{
+			/* Test the node's bounding box against all frustum planes: */
+			inside=true;
+			bool outside=false;
+			for(int i=0;i<6&&!outside;++i)
+				{
+				/* Test the box corners farthest along and against the plane normal: */
+				double maxDist=planes[i][3];
+				double minDist=planes[i][3];
+				for(int j=0;j<3;++j)
+					{
+					if(planes[i][j]>=0.0)
+						{
+						maxDist+=planes[i][j]*node.max[j];
+						minDist+=planes[i][j]*node.min[j];
+						}
+					else
+						{
+						maxDist+=planes[i][j]*node.min[j];
+						minDist+=planes[i][j]*node.max[j];
+						}
+					}
+				if(maxDist<0.0)
+					outside=true;
+				else if(minDist<0.0)
+					inside=false;
+				}
+			if(outside)
+				continue;
+			}
+		
+		if(node.numChildren==0)
+			{
+			/* Weight the leaf by the squared ratio of its size to its projected depth: */
+			double center[3];
+			double radius2=0.0;
+			for(int j=0;j<3;++j)
+				{
+				center[j]=(double(node.min[j])+double(node.max[j]))*0.5;
+				radius2+=Math::sqr((double(node.max[j])-double(node.min[j]))*0.5);
+				}
+			double w=clip[15];
+			for(int j=0;j<3;++j)
+				w+=clip[j*4+3]*center[j];
+			double w2=Math::sqr(w);
+			if(radius2<minRadius2)
+				radius2=minRadius2;
+			VisibleLeaf leaf;
+			leaf.nodeIndex=nodeIndex;
+			leaf.weight=w2>radius2?radius2/w2:1.0;
+			if(minWeight>leaf.weight)
+				minWeight=leaf.weight;
+			if(maxWeight<leaf.weight)
+				maxWeight=leaf.weight;
+			if(maxLeafPoints<node.numPoints)
+				maxLeafPoints=node.numPoints;
+			leaves.push_back(leaf);
+			totalNumPoints+=node.numPoints;
+			}
+		else
+			{
+			/* Visit the node's children in reverse order, so they are popped in point order: */
+			for(unsigned int ci=node.numChildren;ci>0;--ci)
+				traversalStack.push_back(std::pair<unsigned int,bool>(node.firstChild+ci-1,inside));
+			}
+		}
+	
+	/*********************************************************************
+	If the visible points exceed the budget, select a prefix of each leaf
+	proportional to the leaf's weight times a common detail factor, and
+	find the largest detail factor that stays within the budget by
+	bisection. Leaf weights span many orders of magnitude, so bisect the
+	logarithm of the detail factor between a value selecting no points
+	and one selecting all points. Since leaves are stratified, prefixes
+	are even subsamples.
+	*********************************************************************/
+	
+	double detail=0.0;
+	bool selectAll=pointBudget==0||totalNumPoints<=pointBudget;
+	if(!selectAll)
+		{
+		double logDetailMin=-Math::log(maxWeight*(double(maxLeafPoints)+1.0));
+		double logDetailMax=-Math::log(minWeight);
+		for(int iteration=0;iteration<48;++iteration)
+			{
+			double logDetailMid=(logDetailMin+logDetailMax)*0.5;
+			double detailMid=Math::exp(logDetailMid);
+			size_t numSelected=0;
+			for(std::vector<VisibleLeaf>::const_iterator lIt=leaves.begin();lIt!=leaves.end();++lIt)
+				{
+				double fraction=detailMid*lIt->weight;
+				unsigned int numLeafPoints=nodes[lIt->nodeIndex].numPoints;
+				numSelected+=fraction<1.0?size_t(fraction*double(numLeafPoints)):numLeafPoints;
+				}
+			if(numSelected<=pointBudget)
+				logDetailMin=logDetailMid;
+			else
+				logDetailMax=logDetailMid;
+			}
+		detail=Math::exp(logDetailMin);
+		}
+	
+	/* Create runs of selected points, merging adjacent runs: */
+	size_t numSelected=0;
+	for(std::vector<VisibleLeaf>::const_iterator lIt=leaves.begin();lIt!=leaves.end();++lIt)
+		{
+		const Node& leaf=nodes[lIt->nodeIndex];
+		unsigned int numLeafPoints=leaf.numPoints;
+		if(!selectAll)
+			{
+			double fraction=detail*lIt->weight;
+			if(fraction<1.0)
+				numLeafPoints=(unsigned int)(fraction*double(numLeafPoints));
+			}
+		if(numLeafPoints==0)
+			continue;
+		
+		if(!runs.empty()&&runs.back().first+runs.back().numPoints==leaf.first)
+			runs.back().numPoints+=numLeafPoints;
+		else
+			{
+			Run run;
+			run.first=leaf.first;
+			run.numPoints=numLeafPoints;
+			runs.push_back(run);
+			}
+		numSelected+=numLeafPoints;
+		}
+	
+	return numSelected;
+	}
+
+}
+
+}
@@ -0,0 +1,125 @@
+/***********************************************************************
+PointOctree - Class for octrees over Morton-sorted point sets supporting
+view-dependent selection of point subsets under a point budget.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_CONCRETE_POINTOCTREE_INCLUDED
+#define VISUALIZATION_CONCRETE_POINTOCTREE_INCLUDED
+
+#include <stddef.h>
+#include <vector>
+#include <Misc/SizedTypes.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+class PointOctree
+	{
+	/* Embedded classes: */
+	public:
+	typedef float Scalar; // Scalar type for point coordinates
+	
+	struct Point // Structure for points; layout matches a GL_V3F vertex array
+		{
+		/* Elements: */
+		public:
+		Scalar position[3]; // Point position
+		};
+	
+	struct Run // Structure for runs of consecutive points selected for rendering
+		{
+		/* Elements: */
+		public:
+		unsigned int first; // Index of first point in the run
+		unsigned int numPoints; // Number of points in the run
+		};
+	
+	private:
+	struct Node // Structure for octree nodes
+		{
+		/* Elements: */
+		public:
+		Scalar min[3],max[3]; // Bounding box of the points contained in the node
+		unsigned int first; // Index of the node's first point
+		unsigned int numPoints; // Number of points contained in the node
+		unsigned int firstChild; // Index of the node's first child node; children are stored consecutively
+		unsigned int numChildren; // Number of non-empty children; 0 for leaf nodes
+		};
+	
+	struct MortonKey // Structure associating points with their Morton codes during construction
+		{
+		/* Elements: */
+		public:
+		Misc::UInt64 code; // Interleaved 21-bit quantized coordinates
+		size_t index; // Index of the point in the unsorted point array
+		
+		/* Methods: */
+		bool operator<(const MortonKey& other) const
+			{
+			return code<other.code;
+			}
+		};
+	
+	struct VisibleLeaf // Structure for leaf nodes found visible during selection
+		{
+		/* Elements: */
+		public:
+		unsigned int nodeIndex; // Index of the leaf node
+		double weight; // Fraction of the leaf's points to select per unit of the detail factor
+		};
+	
+	/* Elements: */
+	static const unsigned int leafSize=4096; // Maximum number of points in a leaf node above the finest octree level
+	static const Misc::UInt32 cacheFileVersion=1; // Version number of the binary cache file format
+	std::vector<Point> points; // Array of points; each leaf's points form a stratified sample sequence
+	std::vector<Node> nodes; // Array of octree nodes; root node first
+	
+	/* Private methods: */
+	void buildNode(unsigned int nodeIndex,std::vector<MortonKey>& keys,size_t first,size_t last,int level); // Recursively builds the subtree rooted at the given node from a range of sorted Morton keys
+	
+	/* Constructors and destructors: */
+	public:
+	PointOctree(void); // Creates an empty octree
+	
+	/* Methods: */
+	void build(std::vector<Point>& sPoints); // Builds the octree from the given point array, which is swapped out in the process
+	bool load(const char* cacheFileName,Misc::UInt64 sourceStamp); // Loads the octree from a binary cache file; returns false if the file is missing, stale, or damaged
+	void save(const char* cacheFileName,Misc::UInt64 sourceStamp) const; // Saves the octree to a binary cache file, tagged with a stamp identifying the source data
+	size_t getNumPoints(void) const // Returns the total number of points
+		{
+		return points.size();
+		}
+	const Point* getPoints(void) const // Returns the point array
+		{
+		return points.empty()?0:&points[0];
+		}
+	size_t getNumNodes(void) const // Returns the number of octree nodes
+		{
+		return nodes.size();
+		}
+	size_t select(const double clip[16],size_t pointBudget,std::vector<Run>& runs) const; // Selects point runs visible under the given column-major projection*modelview matrix, at most pointBudget points if budget is non-zero; returns number of selected points
+	};
+
+}
+
+}
+
+#endif
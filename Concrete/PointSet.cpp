@@ -25,13 +25,15 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <math.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
 #include <string>
+#include <stdexcept>
 #include <iostream>
 #include <Misc/ThrowStdErr.h>
 #include <Misc/File.h>
 #include <Math/Math.h>
 #include <GL/gl.h>
-#include <GL/GLVertexArrayParts.h>
 #include <GL/GLContextData.h>
 #include <GL/Extensions/GLARBVertexBufferObject.h>
 
@@ -167,48 +169,36 @@ calcDepthPos(
 	pos[2]=float(r*s0);
 	}
 
-/**********************************************
-Helper classes to upload and render point sets:
-**********************************************/
+/***************************************************************
+Helper function to identify the source data of octree cache files:
+***************************************************************/
 
-template <class VertexParam>
-class PointChunkUploader
+Misc::UInt64
+calcSourceStamp(
+	const char* pointFileName,
+	double flatteningFactor,
+	double scaleFactor)
 	{
-	/* Elements: */
-	private:
-	GLintptrARB offset; // Current offset into the vertex buffer object
-	
-	/* Constructors and destructors: */
-	public:
-	PointChunkUploader(void)
-		:offset(0)
-		{
-		}
+	/* Collect the point file's size and modification time, and the conversion parameters: */
+	struct stat pointFileStats;
+	if(stat(pointFileName,&pointFileStats)!=0)
+		return 0;
+	Misc::UInt64 values[4];
+	values[0]=Misc::UInt64(pointFileStats.st_size);
+	values[1]=Misc::UInt64(pointFileStats.st_mtime);
+	memcpy(&values[2],&flatteningFactor,sizeof(double));
+	memcpy(&values[3],&scaleFactor,sizeof(double));
 	
-	/* Methods: */
-	void operator()(const VertexParam* chunkVertices,size_t numChunkVertices)
+	/* Hash the values using 64-bit FNV-1a: */
+	Misc::UInt64 result=0xcbf29ce484222325ULL;
+	const unsigned char* vPtr=reinterpret_cast<const unsigned char*>(values);
+	for(size_t i=0;i<sizeof(values);++i,++vPtr)
 		{
-		/* Upload the current chunk of vertices: */
-		GLsizeiptrARB size=numChunkVertices*sizeof(VertexParam);
-		glBufferSubDataARB(GL_ARRAY_BUFFER_ARB,offset,size,chunkVertices);
-		
-		/* Prepare to upload the next chunk: */
-		offset+=size;
+		result^=Misc::UInt64(*vPtr);
+		result*=0x100000001b3ULL;
 		}
-	};
-
-template <class VertexParam>
-class PointChunkRenderer
-	{
-	/* Methods: */
-	public:
-	void operator()(const VertexParam* chunkVertices,size_t numChunkVertices)
-		{
-		/* Render the current chunk of vertices: */
-		glVertexPointer(chunkVertices);
-		glDrawArrays(GL_POINTS,0,numChunkVertices);
-		}
-	};
+	return result;
+	}
 
 }
 
@@ -245,7 +235,18 @@ Methods of class PointSet:
 *************************/
 
 PointSet::PointSet(const char* pointFileName,double flatteningFactor,double scaleFactor)
+	:pointBudget(0)
 	{
+	/* Try loading the point set's octree from its cache file: */
+	std::string cacheFileName=pointFileName;
+	cacheFileName.append(".octree");
+	Misc::UInt64 sourceStamp=calcSourceStamp(pointFileName,flatteningFactor,scaleFactor);
+	if(sourceStamp!=0&&octree.load(cacheFileName.c_str(),sourceStamp))
+		{
+		std::cout<<octree.getNumPoints()<<" points loaded from cache file "<<cacheFileName<<std::endl;
+		return;
+		}
+	
 	/* Open the point file: */
 	Misc::File pointFile(pointFileName,"rt");
 	
@@ -293,6 +294,7 @@ PointSet::PointSet(const char* pointFileName,double flatteningFactor,double scal
 		Misc::throwStdErr("PointSet::PointSet: Missing point components in input file \"%s\"",pointFileName);
 	
 	/* Read all point positions from the point file: */
+	std::vector<Point> points;
 	bool finished=false;
 	while(!finished)
 		{
@@ -333,20 +335,21 @@ PointSet::PointSet(const char* pointFileName,double flatteningFactor,double scal
 		if(parsedComponentsMask==0x7&&!isnan(sphericalCoordinates[2]))
 			{
 			/* Convert the read spherical coordinates to Cartesian coordinates: */
-			Vertex p;
-			p.position=Vertex::Position(0,0,0); // To shut up gcc
+			Point p;
+			for(int i=0;i<3;++i)
+				p.position[i]=0.0f; // To shut up gcc
 			switch(radiusMode)
 				{
 				case RADIUS:
-					calcRadiusPos(sphericalCoordinates[0],sphericalCoordinates[1],sphericalCoordinates[2]*1000.0f,scaleFactor,p.position.getXyzw());
+					calcRadiusPos(sphericalCoordinates[0],sphericalCoordinates[1],sphericalCoordinates[2]*1000.0f,scaleFactor,p.position);
 					break;
 				
 				case DEPTH:
-					calcDepthPos(sphericalCoordinates[0],sphericalCoordinates[1],sphericalCoordinates[2]*1000.0f,flatteningFactor,scaleFactor,p.position.getXyzw());
+					calcDepthPos(sphericalCoordinates[0],sphericalCoordinates[1],sphericalCoordinates[2]*1000.0f,flatteningFactor,scaleFactor,p.position);
 					break;
 				
 				case NEGDEPTH:
-					calcDepthPos(sphericalCoordinates[0],sphericalCoordinates[1],-sphericalCoordinates[2]*1000.0f,flatteningFactor,scaleFactor,p.position.getXyzw());
+					calcDepthPos(sphericalCoordinates[0],sphericalCoordinates[1],-sphericalCoordinates[2]*1000.0f,flatteningFactor,scaleFactor,p.position);
 					break;
 				}
 			
@@ -355,6 +358,23 @@ PointSet::PointSet(const char* pointFileName,double flatteningFactor,double scal
 			}
 		}
 	std::cout<<points.size()<<" points parsed from "<<pointFileName<<std::endl;
+	
+	/* Build the point set's octree: */
+	octree.build(points);
+	
+	/* Save the octree to speed up loading the point set next time: */
+	if(sourceStamp!=0)
+		{
+		try
+			{
+			octree.save(cacheFileName.c_str(),sourceStamp);
+			}
+		catch(std::runtime_error err)
+			{
+			/* Caching is optional; print a warning and carry on: */
+			std::cerr<<"PointSet::PointSet: Unable to save cache file "<<cacheFileName<<" due to exception "<<err.what()<<std::endl;
+			}
+		}
 	}
 
 PointSet::~PointSet(void)
@@ -371,48 +391,72 @@ void PointSet::initContext(GLContextData& contextData) const
 	/* Check if the vertex buffer object extension is supported: */
 	if(dataItem->vertexBufferObjectId>0)
 		{
-		/* Create a vertex buffer object to store the points' coordinates: */
+		/* Upload all points into a vertex buffer object in one go: */
 		glBindBufferARB(GL_ARRAY_BUFFER_ARB,dataItem->vertexBufferObjectId);
-		glBufferDataARB(GL_ARRAY_BUFFER_ARB,points.size()*sizeof(Vertex),0,GL_STATIC_DRAW_ARB);
-		
-		/* Copy all points: */
-		PointChunkUploader<Vertex> pcu;
-		points.forEachChunk(pcu);
+		glBufferDataARB(GL_ARRAY_BUFFER_ARB,octree.getNumPoints()*sizeof(Point),octree.getPoints(),GL_STATIC_DRAW_ARB);
 		
 		/* Protect the vertex buffer object: */
 		glBindBufferARB(GL_ARRAY_BUFFER_ARB,0);
 		}
 	}
 
+void PointSet::setPointBudget(size_t newPointBudget)
+	{
+	pointBudget=newPointBudget;
+	}
+
 void PointSet::glRenderAction(GLContextData& contextData) const
 	{
 	/* Get a pointer to the data item: */
 	DataItem* dataItem=contextData.retrieveDataItem<DataItem>(this);
 	
-	GLVertexArrayParts::enable(Vertex::getPartsMask());
+	if(octree.getNumPoints()==0)
+		return;
+	
+	/* Calculate the combined projection and modelview matrix (both in column-major order): */
+	GLdouble modelview[16],projection[16];
+	glGetDoublev(GL_MODELVIEW_MATRIX,modelview);
+	glGetDoublev(GL_PROJECTION_MATRIX,projection);
+	double clip[16];
+	for(int i=0;i<4;++i)
+		for(int j=0;j<4;++j)
+			{
+			clip[j*4+i]=0.0;
+			for(int k=0;k<4;++k)
+				clip[j*4+i]+=projection[k*4+i]*modelview[j*4+k];
+			}
+	
+	/* Select the visible points within the point budget: */
+	octree.select(clip,pointBudget,dataItem->runs);
+	
+	glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+	glEnableClientState(GL_VERTEX_ARRAY);
 	
 	/* Check if the vertex buffer object extension is supported: */
 	if(dataItem->vertexBufferObjectId!=0)
 		{
 		/* Bind the point set's vertex buffer object: */
 		glBindBufferARB(GL_ARRAY_BUFFER_ARB,dataItem->vertexBufferObjectId);
-		
-		/* Render the point set as a vertex buffer of points: */
-		glVertexPointer(static_cast<const Vertex*>(0));
-		glDrawArrays(GL_POINTS,0,points.size());
-		
-		/* Protect the vertex buffer object: */
-		glBindBufferARB(GL_ARRAY_BUFFER_ARB,0);
+		glVertexPointer(3,GL_FLOAT,sizeof(Point),0);
 		}
 	else
 		{
-		/* Render the point set as a set of regular vertex arrays of points: */
-		PointChunkRenderer<Vertex> pcr;
-		points.forEachChunk(pcr);
+		/* Render the point set from a regular vertex array: */
+		glVertexPointer(3,GL_FLOAT,sizeof(Point),octree.getPoints());
+		}
+	
+	/* Render all selected runs of points: */
+	for(std::vector<PointOctree::Run>::const_iterator rIt=dataItem->runs.begin();rIt!=dataItem->runs.end();++rIt)
+		glDrawArrays(GL_POINTS,GLint(rIt->first),GLsizei(rIt->numPoints));
+	
+	if(dataItem->vertexBufferObjectId!=0)
+		{
+		/* Protect the vertex buffer object: */
+		glBindBufferARB(GL_ARRAY_BUFFER_ARB,0);
 		}
 	
 	/* Restore OpenGL state: */
-	GLVertexArrayParts::disable(Vertex::getPartsMask());
+	glPopClientAttrib();
 	}
 
 }
@@ -22,17 +22,11 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_CONCRETE_POINTSET_INCLUDED
 #define VISUALIZATION_CONCRETE_POINTSET_INCLUDED
 
-#include <Misc/ChunkedArray.h>
+#include <vector>
 #include <GL/gl.h>
-#define GLVERTEX_NONSTANDARD_TEMPLATES
-#include <GL/GLVertex.h>
 #include <GL/GLObject.h>
 
-#if 0
-/* Forward declarations: */
-template <class T1,int i1,class T2,int i2,class T3,class T4,int i4>
-class GLVertex;
-#endif
+#include <Concrete/PointOctree.h>
 
 namespace Visualization {
 
@@ -42,14 +36,14 @@ class PointSet:public GLObject
 	{
 	/* Embedded classes: */
 	private:
-	typedef float Scalar; // Scalar type for point coordinates
-	typedef GLVertex<void,0,void,0,void,GLfloat,3> Vertex; // Vertex type for points (position only)
+	typedef PointOctree::Point Point; // Type for points (position only)
 	
 	struct DataItem:public GLObject::DataItem
 		{
 		/* Elements: */
 		public:
 		GLuint vertexBufferObjectId; // ID of vertex buffer object that contains the point set (0 if extension not supported)
+		std::vector<PointOctree::Run> runs; // Runs of points selected for the most recent frame, kept to avoid reallocation
 		
 		/* Constructors and destructors: */
 		public:
@@ -58,7 +52,8 @@ class PointSet:public GLObject
 		};
 	
 	/* Elements: */
-	Misc::ChunkedArray<Vertex> points; // Array of points
+	PointOctree octree; // Octree over the point set, which owns the points in octree order
+	size_t pointBudget; // Maximum number of points to render per frame; 0 renders all visible points
 	
 	/* Constructors and destructors: */
 	public:
@@ -69,6 +64,11 @@ class PointSet:public GLObject
 	virtual void initContext(GLContextData& contextData) const;
 	
 	/* New methods: */
+	size_t getPointBudget(void) const // Returns the per-frame point budget
+		{
+		return pointBudget;
+		}
+	void setPointBudget(size_t newPointBudget); // Sets the per-frame point budget; 0 renders all visible points
 	void glRenderAction(GLContextData& contextData) const; // Renders point set into the current OpenGL context
 	};
 
@@ -0,0 +1,212 @@
+/***********************************************************************
+DirtyBoxSet - Class to track which axis-aligned regions of a voxel grid
+changed since some version, to update GPU copies of the grid partially.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include "DirtyBoxSet.h"
+
+/****************************
+Methods of class DirtyBoxSet:
+****************************/
+
+size_t DirtyBoxSet::getMergeCost(const DirtyBoxSet::Box& box1,const DirtyBoxSet::Box& box2)
+	{
+	/* Calculate the volume of the two boxes' bounding box: */
+	Box merged=box1;
+	merged.addBox(box2);
+	size_t mergedVolume=merged.getVolume();
+	
+	/* Subtract the voxels covered by either box, counting their overlap only once: */
+	Box overlap=box1;
+	overlap.intersectBox(box2);
+	size_t coveredVolume=box1.getVolume()+box2.getVolume()-overlap.getVolume();
+	
+	return mergedVolume-coveredVolume;
+	}
+
+void DirtyBoxSet::pruneEntries(void)
+	{
+	if(clients.empty())
+		return;
+	
+	/* Find the oldest version held by any registered client: */
+	unsigned int minVersion=clients.front().version;
+	for(std::vector<Client>::iterator cIt=clients.begin();cIt!=clients.end();++cIt)
+		if(minVersion>cIt->version)
+			minVersion=cIt->version;
+	
+	/* Drop all boxes that were changed no later than that version: */
+	for(size_t i=0;i<entries.size();)
+		{
+		if(entries[i].version<=minVersion)
+			{
+			entries[i]=entries.back();
+			entries.pop_back();
+			}
+		else
+			++i;
+		}
+	
+	/* Clients older than all registered clients can no longer be updated partially: */
+	if(baseVersion<minVersion)
+		baseVersion=minVersion;
+	}
+
+DirtyBoxSet::DirtyBoxSet(void)
+	:maxNumBoxes(16),
+	 mergeFactor(1.25),fullUpdateFraction(0.5),
+	 baseVersion(0)
+	{
+	}
+
+DirtyBoxSet::DirtyBoxSet(const int sSize[3],unsigned int sMaxNumBoxes)
+	:maxNumBoxes(sMaxNumBoxes>0?sMaxNumBoxes:1),
+	 mergeFactor(1.25),fullUpdateFraction(0.5),
+	 baseVersion(0)
+	{
+	for(int i=0;i<3;++i)
+		domain.max[i]=sSize[i];
+	}
+
+void DirtyBoxSet::setMergeFactor(double newMergeFactor)
+	{
+	mergeFactor=newMergeFactor;
+	}
+
+void DirtyBoxSet::setFullUpdateFraction(double newFullUpdateFraction)
+	{
+	fullUpdateFraction=newFullUpdateFraction;
+	}
+
+void DirtyBoxSet::reset(const int newSize[3],unsigned int newVersion)
+	{
+	for(int i=0;i<3;++i)
+		{
+		domain.min[i]=0;
+		domain.max[i]=newSize[i];
+		}
+	baseVersion=newVersion;
+	entries.clear();
+	}
+
+void DirtyBoxSet::addBox(const DirtyBoxSet::Box& box,unsigned int version)
+	{
+	/* Clip the box against the grid: */
+	Entry newEntry(box,version);
+	newEntry.box.intersectBox(domain);
+	if(newEntry.box.isEmpty())
+		return;
+	
+	/* Eagerly merge the new box with existing boxes as long as that adds few clean voxels: */
+	bool merged;
+	do
+		{
+		merged=false;
+		for(std::vector<Entry>::iterator eIt=entries.begin();eIt!=entries.end();++eIt)
+			{
+			size_t cost=getMergeCost(newEntry.box,eIt->box);
+			if(double(cost)<=(mergeFactor-1.0)*double(newEntry.box.getVolume()+eIt->box.getVolume()))
+				{
+				/* Absorb the existing box; the merged box carries the later version: */
+				newEntry.box.addBox(eIt->box);
+				if(newEntry.version<eIt->version)
+					newEntry.version=eIt->version;
+				*eIt=entries.back();
+				entries.pop_back();
+				merged=true;
+				break;
+				}
+			}
+		}
+	while(merged);
+	entries.push_back(newEntry);
+	
+	/* Merge the cheapest pairs of boxes until the list is short enough: */
+	while(entries.size()>maxNumBoxes)
+		{
+		size_t bestI=0,bestJ=1;
+		size_t bestCost=getMergeCost(entries[0].box,entries[1].box);
+		for(size_t i=0;i<entries.size();++i)
+			for(size_t j=i+1;j<entries.size();++j)
+				{
+				size_t cost=getMergeCost(entries[i].box,entries[j].box);
+				if(bestCost>cost)
+					{
+					bestI=i;
+					bestJ=j;
+					bestCost=cost;
+					}
+				}
+		
+		entries[bestI].box.addBox(entries[bestJ].box);
+		if(entries[bestI].version<entries[bestJ].version)
+			entries[bestI].version=entries[bestJ].version;
+		entries[bestJ]=entries.back();
+		entries.pop_back();
+		}
+	
+	/* Fall back to a full update if the dirty boxes cover too much of the grid: */
+	size_t dirtyVolume=0;
+	for(std::vector<Entry>::iterator eIt=entries.begin();eIt!=entries.end();++eIt)
+		dirtyVolume+=eIt->box.getVolume();
+	if(double(dirtyVolume)>fullUpdateFraction*double(domain.getVolume()))
+		{
+		baseVersion=version;
+		entries.clear();
+		}
+	}
+
+void DirtyBoxSet::getBoxes(unsigned int clientVersion,std::vector<DirtyBoxSet::Box>& boxes) const
+	{
+	for(std::vector<Entry>::const_iterator eIt=entries.begin();eIt!=entries.end();++eIt)
+		if(eIt->version>clientVersion)
+			boxes.push_back(eIt->box);
+	}
+
+void DirtyBoxSet::flushClient(const void* owner,const void* client,unsigned int clientVersion)
+	{
+	/* Update the client's version, or register it if it is new: */
+	std::vector<Client>::iterator cIt;
+	for(cIt=clients.begin();cIt!=clients.end()&&(cIt->owner!=owner||cIt->client!=client);++cIt)
+		;
+	if(cIt!=clients.end())
+		cIt->version=clientVersion;
+	else
+		clients.push_back(Client(owner,client,clientVersion));
+	
+	pruneEntries();
+	}
+
+void DirtyBoxSet::removeClients(const void* owner)
+	{
+	for(size_t i=0;i<clients.size();)
+		{
+		if(clients[i].owner==owner)
+			{
+			clients[i]=clients.back();
+			clients.pop_back();
+			}
+		else
+			++i;
+		}
+	
+	/* Removing lagging clients might allow dropping more boxes: */
+	pruneEntries();
+	}
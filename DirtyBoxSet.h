@@ -0,0 +1,158 @@
+/***********************************************************************
+DirtyBoxSet - Class to track which axis-aligned regions of a voxel grid
+changed since some version, to update GPU copies of the grid partially.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef DIRTYBOXSET_INCLUDED
+#define DIRTYBOXSET_INCLUDED
+
+#include <stddef.h>
+#include <vector>
+
+class DirtyBoxSet
+	{
+	/* Embedded classes: */
+	public:
+	struct Box // Structure for half-open boxes of voxel indices
+		{
+		/* Elements: */
+		public:
+		int min[3]; // Index of the box's first voxel
+		int max[3]; // Index one past the box's last voxel
+		
+		/* Constructors and destructors: */
+		Box(void) // Creates an empty box
+			{
+			for(int i=0;i<3;++i)
+				min[i]=max[i]=0;
+			}
+		Box(const int sMin[3],const int sMax[3]) // Creates a box from its index range
+			{
+			for(int i=0;i<3;++i)
+				{
+				min[i]=sMin[i];
+				max[i]=sMax[i];
+				}
+			}
+		
+		/* Methods: */
+		bool isEmpty(void) const // Returns true if the box contains no voxels
+			{
+			return min[0]>=max[0]||min[1]>=max[1]||min[2]>=max[2];
+			}
+		size_t getVolume(void) const // Returns the number of voxels in the box
+			{
+			return isEmpty()?0:size_t(max[0]-min[0])*size_t(max[1]-min[1])*size_t(max[2]-min[2]);
+			}
+		Box& addBox(const Box& other) // Changes the box to the bounding box of itself and the other box
+			{
+			for(int i=0;i<3;++i)
+				{
+				if(min[i]>other.min[i])
+					min[i]=other.min[i];
+				if(max[i]<other.max[i])
+					max[i]=other.max[i];
+				}
+			return *this;
+			}
+		Box& intersectBox(const Box& other) // Changes the box to its intersection with the other box
+			{
+			for(int i=0;i<3;++i)
+				{
+				if(min[i]<other.min[i])
+					min[i]=other.min[i];
+				if(max[i]>other.max[i])
+					max[i]=other.max[i];
+				}
+			return *this;
+			}
+		};
+	
+	private:
+	struct Entry // Structure for a dirty box and the latest version that changed voxels inside it
+		{
+		/* Elements: */
+		public:
+		Box box; // The dirty box
+		unsigned int version; // Latest data version that touched the box
+		
+		/* Constructors and destructors: */
+		Entry(const Box& sBox,unsigned int sVersion)
+			:box(sBox),version(sVersion)
+			{
+			}
+		};
+	
+	struct Client // Structure for a consumer of the dirty boxes and the latest version it flushed
+		{
+		/* Elements: */
+		public:
+		const void* owner; // Object that registered the client
+		const void* client; // Opaque client identifier, unique per owner
+		unsigned int version; // Latest data version the client flushed
+		
+		/* Constructors and destructors: */
+		Client(const void* sOwner,const void* sClient,unsigned int sVersion)
+			:owner(sOwner),client(sClient),version(sVersion)
+			{
+			}
+		};
+	
+	/* Elements: */
+	Box domain; // Box containing all voxels of the grid
+	unsigned int maxNumBoxes; // Maximum number of dirty boxes before the closest pair is merged
+	double mergeFactor; // Two boxes are merged eagerly if their bounding box is at most this factor larger than their combined volume
+	double fullUpdateFraction; // Fraction of the grid's volume above which the grid is marked dirty in its entirety
+	unsigned int baseVersion; // Version at which the entire grid was last changed
+	std::vector<Entry> entries; // List of dirty boxes changed after the base version
+	std::vector<Client> clients; // List of registered clients whose flushed versions allow dropping dirty boxes
+	
+	/* Private methods: */
+	static size_t getMergeCost(const Box& box1,const Box& box2); // Returns the number of clean voxels added by merging the two boxes
+	void pruneEntries(void); // Drops all dirty boxes every registered client has already flushed
+	
+	/* Constructors and destructors: */
+	public:
+	DirtyBoxSet(void); // Creates a clean box set for an empty grid
+	DirtyBoxSet(const int sSize[3],unsigned int sMaxNumBoxes =16); // Creates a clean box set for a grid of the given size
+	
+	/* Methods: */
+	void setMergeFactor(double newMergeFactor); // Sets the eager merging threshold
+	void setFullUpdateFraction(double newFullUpdateFraction); // Sets the fraction of dirty voxels that triggers full updates
+	void reset(const int newSize[3],unsigned int newVersion); // Marks the entire grid of the given new size as changed at the given version
+	void addBox(const Box& box,unsigned int version); // Marks the given box as changed at the given version, which must not be smaller than any previous version
+	bool needsFullUpdate(unsigned int clientVersion) const // Returns true if a client holding the given version must update the entire grid
+		{
+		return clientVersion<baseVersion;
+		}
+	size_t getNumBoxes(void) const // Returns the current number of dirty boxes
+		{
+		return entries.size();
+		}
+	void getBoxes(unsigned int clientVersion,std::vector<Box>& boxes) const; // Appends all boxes a client holding the given version must update
+	void flushClient(const void* owner,const void* client,unsigned int clientVersion); // Records that the given client now holds the given version, and drops boxes no registered client needs anymore
+	void removeClients(const void* owner); // Unregisters all clients registered by the given owner
+	size_t getNumClients(void) const // Returns the number of registered clients
+		{
+		return clients.size();
+		}
+	};
+
+#endif
@@ -22,6 +22,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include "ElementList.h"
 
+#include <stdexcept>
+#include <iostream>
 #include <Misc/StandardMarshallers.h>
 #include <Misc/File.h>
 #include <IO/File.h>
@@ -33,6 +35,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Vrui/Vrui.h>
 #include <Vrui/OpenFile.h>
 
+#include <Abstract/VariableManager.h>
 #include <Abstract/Parameters.h>
 #include <Abstract/BinaryParametersSink.h>
 #include <Abstract/FileParametersSink.h>
@@ -51,12 +54,32 @@ void ElementList::updateUiState(void)
 		/* Update the toggle buttons: */
 		showElementToggle->setToggle(elements[selectedElementIndex].show);
 		showElementSettingsToggle->setToggle(elements[selectedElementIndex].settingsDialogVisible);
+		autoRecolorToggle->setToggle(elements[selectedElementIndex].autoRecolor);
 		}
 	else
 		{
 		/* Reset the toggle buttons: */
 		showElementToggle->setToggle(false);
 		showElementSettingsToggle->setToggle(false);
+		autoRecolorToggle->setToggle(false);
+		}
+	}
+
+void ElementList::recolorElement(size_t elementIndex,int newColorScalarVariableIndex)
+	{
+	Element* element=elements[elementIndex].element.getPointer();
+	int colorScalarVariableIndex=element->getColorScalarVariable();
+	if(colorScalarVariableIndex>=0&&colorScalarVariableIndex!=newColorScalarVariableIndex)
+		{
+		try
+			{
+			/* Re-evaluate the element's colors without re-extracting its geometry: */
+			element->setColorScalarVariable(newColorScalarVariableIndex);
+			}
+		catch(std::runtime_error err)
+			{
+			std::cerr<<"Cannot recolor "<<elements[elementIndex].name<<" due to exception "<<err.what()<<std::endl;
+			}
 		}
 	}
 
@@ -137,11 +160,38 @@ void ElementList::elementSettingsCloseCallback(Misc::CallbackData* cbData)
 		}
 	}
 
+void ElementList::recolorElementSelectedCallback(Misc::CallbackData* cbData)
+	{
+	int selectedElementIndex=elementList->getSelectedItem();
+	if(selectedElementIndex>=0)
+		recolorElement(selectedElementIndex,variableManager->getCurrentScalarVariable());
+	}
+
+void ElementList::autoRecolorToggleValueChangedCallback(GLMotif::ToggleButton::ValueChangedCallbackData* cbData)
+	{
+	int selectedElementIndex=elementList->getSelectedItem();
+	if(selectedElementIndex>=0)
+		{
+		/* Let the element's colors follow the current scalar variable, or stop them from following it: */
+		elements[selectedElementIndex].autoRecolor=cbData->set;
+		
+		/* Catch up with the current scalar variable: */
+		if(cbData->set)
+			recolorElement(selectedElementIndex,variableManager->getCurrentScalarVariable());
+		}
+	else
+		cbData->toggle->setToggle(false);
+	}
+
 void ElementList::deleteElementSelectedCallback(Misc::CallbackData* cbData)
 	{
 	int selectedElementIndex=elementList->getSelectedItem();
 	if(selectedElementIndex>=0)
 		{
+		/* Notify interested parties that the visualization element is going away: */
+		ElementRemovedCallbackData cbData(this,elements[selectedElementIndex].element.getPointer(),elements[selectedElementIndex].name);
+		elementRemovedCallbacks.call(&cbData);
+		
 		/* Delete the visualization element and its settings dialog: */
 		delete elements[selectedElementIndex].settingsDialog;
 		elements.erase(elements.begin()+selectedElementIndex);
@@ -154,8 +204,8 @@ void ElementList::deleteElementSelectedCallback(Misc::CallbackData* cbData)
 		}
 	}
 
-ElementList::ElementList(GLMotif::WidgetManager* sWidgetManager)
-	:widgetManager(sWidgetManager),
+ElementList::ElementList(GLMotif::WidgetManager* sWidgetManager,Visualization::Abstract::VariableManager* sVariableManager)
+	:widgetManager(sWidgetManager),variableManager(sVariableManager),
 	 elementListDialogPopup(0),elementList(0)
 	{
 	/* Create the settings dialog window: */
@@ -190,6 +240,12 @@ ElementList::ElementList(GLMotif::WidgetManager* sWidgetManager)
 	showElementSettingsToggle=new GLMotif::ToggleButton("ShowElementSettingsToggle",buttonBox,"Show Settings");
 	showElementSettingsToggle->getValueChangedCallbacks().add(this,&ElementList::showElementSettingsToggleValueChangedCallback);
 	
+	GLMotif::Button* recolorElementButton=new GLMotif::Button("RecolorElementButton",buttonBox,"Recolor");
+	recolorElementButton->getSelectCallbacks().add(this,&ElementList::recolorElementSelectedCallback);
+	
+	autoRecolorToggle=new GLMotif::ToggleButton("AutoRecolorToggle",buttonBox,"Auto Recolor");
+	autoRecolorToggle->getValueChangedCallbacks().add(this,&ElementList::autoRecolorToggleValueChangedCallback);
+	
 	new GLMotif::Separator("Separator",buttonBox,GLMotif::Separator::HORIZONTAL,0.0f,GLMotif::Separator::LOWERED);
 	
 	GLMotif::Button* deleteElementButton=new GLMotif::Button("DeleteElementButton",buttonBox,"Delete");
@@ -234,6 +290,7 @@ void ElementList::addElement(Element* newElement,const char* elementName)
 	le.settingsDialog=newElement->createSettingsDialog(widgetManager);
 	le.settingsDialogVisible=false;
 	le.show=true;
+	le.autoRecolor=newElement->getColorScalarVariable()==variableManager->getCurrentScalarVariable();
 	
 	/* Add the element to the list and select it: */
 	elements.push_back(le);
@@ -242,6 +299,33 @@ void ElementList::addElement(Element* newElement,const char* elementName)
 	/* Update the toggle buttons: */
 	showElementToggle->setToggle(true);
 	showElementSettingsToggle->setToggle(false);
+	autoRecolorToggle->setToggle(le.autoRecolor);
+	
+	/* Check if the element's settings dialog is a dialog: */
+	GLMotif::PopupWindow* sd=dynamic_cast<GLMotif::PopupWindow*>(le.settingsDialog);
+	if(sd!=0)
+		{
+		/* Add a close button to the settings dialog, and register a close callback: */
+		sd->setCloseButton(true);
+		sd->getCloseCallbacks().add(this,&ElementList::elementSettingsCloseCallback);
+		}
+	}
+
+void ElementList::replaceElement(size_t index,Element* newElement)
+	{
+	ListElement& le=elements[index];
+	
+	/* Replace the element's settings dialog, keeping it at the same position if it is popped up: */
+	GLMotif::Widget* newSettingsDialog=newElement->createSettingsDialog(widgetManager);
+	if(le.settingsDialogVisible)
+		{
+		if(newSettingsDialog!=0)
+			widgetManager->popupPrimaryWidget(newSettingsDialog,widgetManager->calcWidgetTransformation(le.settingsDialog));
+		else
+			le.settingsDialogVisible=false;
+		}
+	delete le.settingsDialog;
+	le.settingsDialog=newSettingsDialog;
 	
 	/* Check if the element's settings dialog is a dialog: */
 	GLMotif::PopupWindow* sd=dynamic_cast<GLMotif::PopupWindow*>(le.settingsDialog);
@@ -251,6 +335,20 @@ void ElementList::addElement(Element* newElement,const char* elementName)
 		sd->setCloseButton(true);
 		sd->getCloseCallbacks().add(this,&ElementList::elementSettingsCloseCallback);
 		}
+	
+	/* Replace the element itself: */
+	le.element=newElement;
+	
+	/* Update the GUI: */
+	updateUiState();
+	}
+
+void ElementList::recolorElements(int newColorScalarVariableIndex)
+	{
+	/* Recolor all elements whose colors follow the current scalar variable: */
+	for(size_t i=0;i<elements.size();++i)
+		if(elements[i].autoRecolor)
+			recolorElement(i,newColorScalarVariableIndex);
 	}
 
 void ElementList::saveElements(const char* elementFileName,bool ascii,const Visualization::Abstract::VariableManager* variableManager) const
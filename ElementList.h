@@ -26,14 +26,13 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <string>
 #include <vector>
 #include <Misc/Autopointer.h>
+#include <Misc/CallbackData.h>
+#include <Misc/CallbackList.h>
 #include <GLMotif/WidgetManager.h>
 #include <GLMotif/ToggleButton.h>
 #include <GLMotif/ListBox.h>
 
 /* Forward declarations: */
-namespace Misc {
-class CallbackData;
-}
 namespace GLMotif {
 class Widget;
 class PopupWindow;
@@ -61,37 +60,73 @@ class ElementList
 		GLMotif::Widget* settingsDialog; // Pointer to the element's settings dialog (or NULL)
 		bool settingsDialogVisible; // Flag if the element's settings dialog is currently popped up
 		bool show; // Flag if the element is being rendered
+		bool autoRecolor; // Flag if the element's colors follow changes of the current scalar variable
 		};
 	typedef std::vector<ListElement> ListElementList;
 	
+	class ElementRemovedCallbackData:public Misc::CallbackData // Callback data sent when the user deletes a visualization element
+		{
+		/* Elements: */
+		public:
+		ElementList* elementList; // Pointer to the element list that sent the callback
+		Element* element; // Pointer to the deleted visualization element; valid for the duration of the callback
+		std::string elementName; // Name of algorithm used to create the element
+		
+		/* Constructors and destructors: */
+		ElementRemovedCallbackData(ElementList* sElementList,Element* sElement,const std::string& sElementName)
+			:elementList(sElementList),element(sElement),elementName(sElementName)
+			{
+			}
+		};
+	
 	private:
 
 	/* Elements: */
 	private:
 	ListElementList elements; // List of previously extracted visualization elements
 	GLMotif::WidgetManager* widgetManager; // Pointer to the widget manager
+	Visualization::Abstract::VariableManager* variableManager; // Pointer to the variable manager
 	GLMotif::PopupWindow* elementListDialogPopup; // Dialog listing visualization elements
 	GLMotif::ListBox* elementList; // List box widget containing the names of all visualization elements
 	GLMotif::ToggleButton* showElementToggle; // Toggle button to set the visibility of a visualization element
 	GLMotif::ToggleButton* showElementSettingsToggle; // Toggle button to show or hide a visualization element's settings dialog
+	GLMotif::ToggleButton* autoRecolorToggle; // Toggle button to let a visualization element's colors follow the current scalar variable
+	Misc::CallbackList elementRemovedCallbacks; // List of callbacks called when the user deletes a visualization element
 	
 	/* Private methods: */
 	void updateUiState(void); // Updates the state of the element list's user interface
+	void recolorElement(size_t elementIndex,int newColorScalarVariableIndex); // Re-evaluates the given element's colors for the given scalar variable if it is colored by a different one
 	void elementListValueChangedCallback(GLMotif::ListBox::ValueChangedCallbackData* cbData);
 	void elementListItemSelectedCallback(GLMotif::ListBox::ItemSelectedCallbackData* cbData);
 	void showElementToggleValueChangedCallback(GLMotif::ToggleButton::ValueChangedCallbackData* cbData);
 	void showElementSettingsToggleValueChangedCallback(GLMotif::ToggleButton::ValueChangedCallbackData* cbData);
 	void elementSettingsCloseCallback(Misc::CallbackData* cbData);
+	void recolorElementSelectedCallback(Misc::CallbackData* cbData);
+	void autoRecolorToggleValueChangedCallback(GLMotif::ToggleButton::ValueChangedCallbackData* cbData);
 	void deleteElementSelectedCallback(Misc::CallbackData* cbData);
 	
 	/* Constructors and destructors: */
 	public:
-	ElementList(GLMotif::WidgetManager* sWidgetManager); // Creates an empty element list
+	ElementList(GLMotif::WidgetManager* sWidgetManager,Visualization::Abstract::VariableManager* sVariableManager); // Creates an empty element list
 	~ElementList(void); // Destroys the element list
 	
 	/* Methods: */
+	Misc::CallbackList& getElementRemovedCallbacks(void) // Returns the list of element removal callbacks
+		{
+		return elementRemovedCallbacks;
+		}
 	void clear(void); // Deletes all elements from the list
 	void addElement(Element* newElement,const char* elementName); // Adds a new visualization element to the list
+	size_t getNumElements(void) const // Returns the number of visualization elements in the list
+		{
+		return elements.size();
+		}
+	const ListElement& getElement(size_t index) const // Returns the list entry of the given visualization element
+		{
+		return elements[index];
+		}
+	void replaceElement(size_t index,Element* newElement); // Replaces the given visualization element with a re-extracted one, keeping its visibility
+	void recolorElements(int newColorScalarVariableIndex); // Re-evaluates the colors of all visualization elements following the current scalar variable for the given scalar variable
 	void saveElements(const char* elementFileName,bool ascii,const Visualization::Abstract::VariableManager* variableManager) const; // Saves all visible visualization elements to the given file
 	GLMotif::PopupWindow* getElementListDialog(void) // Returns the element list dialog
 		{
@@ -37,6 +37,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Abstract/DataSet.h>
 #include <Abstract/DataSetRenderer.h>
 #include <Abstract/CoordinateTransformer.h>
+#include <Templatized/Profiler.h>
 
 #include "GLRenderState.h"
 #include "Visualizer.h"
@@ -100,8 +101,12 @@ EvaluationLocator::~EvaluationLocator(void)
 void EvaluationLocator::motionCallback(Vrui::LocatorTool::MotionCallbackData* cbData)
 	{
 	/* Update the locator: */
-	locator->setPosition(cbData->currentTransformation.getOrigin());
-	locator->setOrientation(cbData->currentTransformation.getRotation());
+		{
+		static const unsigned int locateProbe=Visualization::Templatized::Profiler::registerTimer("Evaluation locator update",Visualization::Templatized::Profiler::LOCATOR);
+		Visualization::Templatized::Profiler::Scope locateScope(locateProbe);
+		locator->setPosition(cbData->currentTransformation.getOrigin());
+		locator->setOrientation(cbData->currentTransformation.getRotation());
+		}
 	
 	if(dragging)
 		{
@@ -163,3 +168,12 @@ void EvaluationLocator::highlightLocator(GLRenderState& renderState) const
 		glEnd();
 		}
 	}
+
+void EvaluationLocator::dataSetChanged(void)
+	{
+	/* Replace the locator with one for the new data set: */
+	delete locator;
+	locator=application->dataSet->getLocator();
+	if(hasPoint)
+		locator->setPosition(point);
+	}
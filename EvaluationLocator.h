@@ -70,6 +70,7 @@ class EvaluationLocator:public BaseLocator
 	
 	/* Methods from class BaseLocator: */
 	virtual void highlightLocator(GLRenderState& renderState) const;
+	virtual void dataSetChanged(void);
 	};
 
 #endif
@@ -0,0 +1,331 @@
+/***********************************************************************
+EvaluationProbe - Class to evaluate data sets at sequences of sample
+positions along polylines or on plane grids using traced locators and
+batched multithreaded evaluation.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include "EvaluationProbe.h"
+
+#include <unistd.h>
+#include <math.h>
+#include <string>
+#include <Misc/ThrowStdErr.h>
+#include <Misc/Timer.h>
+
+#include <Abstract/CoordinateTransformer.h>
+
+namespace {
+
+/****************
+Helper functions:
+****************/
+
+void writeCsvField(FILE* file,const char* field)
+	{
+	/* Quote the field and escape embedded quotes: */
+	fputc('\"',file);
+	for(const char* fPtr=field;*fPtr!='\0';++fPtr)
+		{
+		if(*fPtr=='\"')
+			fputc('\"',file);
+		fputc(*fPtr,file);
+		}
+	fputc('\"',file);
+	}
+
+}
+
+/********************************
+Methods of class EvaluationProbe:
+********************************/
+
+void EvaluationProbe::evaluateSamples(EvaluationProbe::Worker& worker)
+	{
+	/* Trace the worker's locator along its contiguous range of samples: */
+	size_t count=worker.lastSample-worker.firstSample;
+	if(count==0)
+		return;
+	if(valueType==SCALAR)
+		worker.numValid=worker.locator->calcScalars(scalarExtractor,count,&positions[worker.firstSample],&scalarValues[worker.firstSample]);
+	else
+		worker.numValid=worker.locator->calcVectors(vectorExtractor,count,&positions[worker.firstSample],&vectorValues[worker.firstSample]);
+	}
+
+size_t EvaluationProbe::evaluate(const EvaluationProbe::Locator* prototype)
+	{
+	Misc::Timer evaluationTimer;
+	size_t totalNumSamples=positions.size();
+	
+	/* Determine the number of threads to use; small probes are not worth a thread each: */
+	const size_t minSamplesPerThread=256;
+	unsigned int numWorkers=numThreads;
+	if(numWorkers==0)
+		{
+		long numCpus=sysconf(_SC_NPROCESSORS_ONLN);
+		numWorkers=numCpus>1?(unsigned int)(numCpus):1U;
+		}
+	size_t maxNumWorkers=(totalNumSamples+minSamplesPerThread-1)/minSamplesPerThread;
+	if(numWorkers>maxNumWorkers)
+		numWorkers=(unsigned int)(maxNumWorkers);
+	if(numWorkers<1)
+		numWorkers=1;
+	
+	/* Give each worker its own locator and a contiguous range of samples to keep tracing coherent: */
+	Worker* workers=new Worker[numWorkers];
+	for(unsigned int i=0;i<numWorkers;++i)
+		{
+		workers[i].probe=this;
+		workers[i].locator=prototype->clone();
+		workers[i].firstSample=(totalNumSamples*i)/numWorkers;
+		workers[i].lastSample=(totalNumSamples*(i+1))/numWorkers;
+		workers[i].numValid=0;
+		}
+	
+	try
+		{
+		/* Check the extractor in the calling thread so that type mismatches throw here instead of in a worker thread: */
+		if(valueType==SCALAR)
+			workers[0].locator->calcScalars(scalarExtractor,0,0,0);
+		else
+			workers[0].locator->calcVectors(vectorExtractor,0,0,0);
+		}
+	catch(...)
+		{
+		for(unsigned int i=0;i<numWorkers;++i)
+			delete workers[i].locator;
+		delete[] workers;
+		throw;
+		}
+	
+	/* Start worker threads and evaluate the first range in the calling thread: */
+	for(unsigned int i=1;i<numWorkers;++i)
+		workers[i].thread.start(&workers[i],&Worker::workerThreadMethod);
+	evaluateSamples(workers[0]);
+	for(unsigned int i=1;i<numWorkers;++i)
+		workers[i].thread.join();
+	
+	/* Collect the results and clean up: */
+	numValidSamples=0;
+	for(unsigned int i=0;i<numWorkers;++i)
+		{
+		numValidSamples+=workers[i].numValid;
+		delete workers[i].locator;
+		}
+	delete[] workers;
+	
+	evaluationTimer.elapse();
+	evaluationTime=evaluationTimer.getTime();
+	
+	return numValidSamples;
+	}
+
+EvaluationProbe::EvaluationProbe(void)
+	:samplingMode(POLYLINE),
+	 numThreads(0),
+	 scalarExtractor(0),vectorExtractor(0),
+	 valueType(NONE),
+	 numValidSamples(0),
+	 evaluationTime(0.0)
+	{
+	numSamples[0]=numSamples[1]=0;
+	}
+
+void EvaluationProbe::setNumThreads(unsigned int newNumThreads)
+	{
+	numThreads=newNumThreads;
+	}
+
+void EvaluationProbe::setLine(const EvaluationProbe::Point& start,const EvaluationProbe::Point& end,size_t newNumSamples)
+	{
+	Point vertices[2];
+	vertices[0]=start;
+	vertices[1]=end;
+	setPolyline(2,vertices,newNumSamples);
+	}
+
+void EvaluationProbe::setPolyline(size_t numVertices,const EvaluationProbe::Point vertices[],size_t newNumSamples)
+	{
+	if(numVertices<1)
+		Misc::throwStdErr("EvaluationProbe::setPolyline: Polyline has no vertices");
+	if(newNumSamples<2)
+		newNumSamples=2;
+	
+	samplingMode=POLYLINE;
+	numSamples[0]=newNumSamples;
+	numSamples[1]=1;
+	positions.resize(newNumSamples);
+	parameters.resize(newNumSamples);
+	
+	/* Calculate the polyline's total arc length: */
+	Scalar totalLength(0);
+	for(size_t i=1;i<numVertices;++i)
+		totalLength+=Geometry::dist(vertices[i-1],vertices[i]);
+	
+	/* Walk along the polyline's segments while placing samples at uniform arc length steps: */
+	size_t segment=0;
+	Scalar segmentStart(0);
+	Scalar segmentLength=numVertices>1?Geometry::dist(vertices[0],vertices[1]):Scalar(0);
+	for(size_t i=0;i<newNumSamples;++i)
+		{
+		Scalar s=i<newNumSamples-1?(totalLength*Scalar(i))/Scalar(newNumSamples-1):totalLength;
+		while(segment+2<numVertices&&s>segmentStart+segmentLength)
+			{
+			++segment;
+			segmentStart+=segmentLength;
+			segmentLength=Geometry::dist(vertices[segment],vertices[segment+1]);
+			}
+		
+		if(segment+1<numVertices&&segmentLength>Scalar(0))
+			{
+			Scalar w=(s-segmentStart)/segmentLength;
+			if(w>Scalar(1))
+				w=Scalar(1);
+			positions[i]=Geometry::affineCombination(vertices[segment],vertices[segment+1],w);
+			}
+		else
+			positions[i]=vertices[segment];
+		parameters[i]=s;
+		}
+	
+	/* Invalidate previously evaluated values: */
+	valueType=NONE;
+	numValidSamples=0;
+	}
+
+void EvaluationProbe::setPlaneGrid(const EvaluationProbe::Point& origin,const EvaluationProbe::Vector& axis0,const EvaluationProbe::Vector& axis1,size_t newNumSamples0,size_t newNumSamples1)
+	{
+	if(newNumSamples0<2)
+		newNumSamples0=2;
+	if(newNumSamples1<2)
+		newNumSamples1=2;
+	
+	samplingMode=PLANE;
+	numSamples[0]=newNumSamples0;
+	numSamples[1]=newNumSamples1;
+	positions.resize(newNumSamples0*newNumSamples1);
+	parameters.clear();
+	
+	/* Place samples row by row so that consecutive samples are close together for tracing: */
+	std::vector<Point>::iterator pIt=positions.begin();
+	for(size_t j=0;j<newNumSamples1;++j)
+		{
+		Point rowStart=origin+axis1*(Scalar(j)/Scalar(newNumSamples1-1));
+		for(size_t i=0;i<newNumSamples0;++i,++pIt)
+			*pIt=rowStart+axis0*(Scalar(i)/Scalar(newNumSamples0-1));
+		}
+	
+	/* Invalidate previously evaluated values: */
+	valueType=NONE;
+	numValidSamples=0;
+	}
+
+size_t EvaluationProbe::evaluateScalars(const EvaluationProbe::Locator* prototype,const EvaluationProbe::ScalarExtractor* newScalarExtractor)
+	{
+	scalarExtractor=newScalarExtractor;
+	vectorExtractor=0;
+	scalarValues.resize(positions.size());
+	valueType=SCALAR;
+	size_t result=positions.empty()?0:evaluate(prototype);
+	scalarExtractor=0;
+	return result;
+	}
+
+size_t EvaluationProbe::evaluateVectors(const EvaluationProbe::Locator* prototype,const EvaluationProbe::VectorExtractor* newVectorExtractor)
+	{
+	scalarExtractor=0;
+	vectorExtractor=newVectorExtractor;
+	vectorValues.resize(positions.size());
+	valueType=VECTOR;
+	size_t result=positions.empty()?0:evaluate(prototype);
+	vectorExtractor=0;
+	return result;
+	}
+
+void EvaluationProbe::writeCsv(FILE* file,const char* valueName,const EvaluationProbe::CoordinateTransformer* coordinateTransformer) const
+	{
+	/* Write the header line: */
+	if(samplingMode==POLYLINE)
+		fprintf(file,"\"Index\",\"Arc Length\"");
+	else
+		fprintf(file,"\"Index 0\",\"Index 1\"");
+	static const char* defaultComponentNames[3]={"X","Y","Z"};
+	for(int i=0;i<3;++i)
+		{
+		fputc(',',file);
+		writeCsvField(file,coordinateTransformer!=0?coordinateTransformer->getComponentName(i):defaultComponentNames[i]);
+		}
+	if(valueType==SCALAR)
+		{
+		fputc(',',file);
+		writeCsvField(file,valueName);
+		}
+	else if(valueType==VECTOR)
+		{
+		for(int i=0;i<3;++i)
+			{
+			fputc(',',file);
+			std::string componentName=valueName;
+			componentName.push_back(' ');
+			componentName.push_back(defaultComponentNames[i][0]);
+			writeCsvField(file,componentName.c_str());
+			}
+		}
+	fputc('\n',file);
+	
+	/* Write one line per sample; values outside the domain are left empty: */
+	for(size_t index=0;index<positions.size();++index)
+		{
+		if(samplingMode==POLYLINE)
+			fprintf(file,"%lu,%.10g",(unsigned long)index,double(parameters[index]));
+		else
+			fprintf(file,"%lu,%lu",(unsigned long)(index%numSamples[0]),(unsigned long)(index/numSamples[0]));
+		Point p=positions[index];
+		if(coordinateTransformer!=0)
+			p=coordinateTransformer->transformCoordinate(p);
+		fprintf(file,",%.10g,%.10g,%.10g",double(p[0]),double(p[1]),double(p[2]));
+		if(valueType==SCALAR)
+			{
+			if(isnan(scalarValues[index]))
+				fprintf(file,",");
+			else
+				fprintf(file,",%.10g",double(scalarValues[index]));
+			}
+		else if(valueType==VECTOR)
+			{
+			for(int i=0;i<3;++i)
+				{
+				if(isnan(vectorValues[index][i]))
+					fprintf(file,",");
+				else
+					fprintf(file,",%.10g",double(vectorValues[index][i]));
+				}
+			}
+		fputc('\n',file);
+		}
+	}
+
+void EvaluationProbe::saveCsv(const char* fileName,const char* valueName,const EvaluationProbe::CoordinateTransformer* coordinateTransformer) const
+	{
+	FILE* file=fopen(fileName,"w");
+	if(file==0)
+		Misc::throwStdErr("EvaluationProbe::saveCsv: Unable to open file %s",fileName);
+	writeCsv(file,valueName,coordinateTransformer);
+	fclose(file);
+	}
@@ -0,0 +1,167 @@
+/***********************************************************************
+EvaluationProbe - Class to evaluate data sets at sequences of sample
+positions along polylines or on plane grids using traced locators and
+batched multithreaded evaluation.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef EVALUATIONPROBE_INCLUDED
+#define EVALUATIONPROBE_INCLUDED
+
+#include <stddef.h>
+#include <stdio.h>
+#include <vector>
+#include <Geometry/Point.h>
+#include <Geometry/Vector.h>
+#include <Threads/Thread.h>
+
+#include <Abstract/DataSet.h>
+
+/* Forward declarations: */
+namespace Visualization {
+namespace Abstract {
+class CoordinateTransformer;
+}
+}
+
+class EvaluationProbe
+	{
+	/* Embedded classes: */
+	public:
+	typedef Visualization::Abstract::DataSet DataSet;
+	typedef DataSet::Scalar Scalar; // Scalar type for sample positions
+	typedef DataSet::Point Point; // Type for sample positions
+	typedef Geometry::Vector<Scalar,3> Vector; // Type for plane grid axes
+	typedef DataSet::Locator Locator;
+	typedef DataSet::VScalar VScalar; // Type for evaluated scalar values
+	typedef DataSet::VVector VVector; // Type for evaluated vector values
+	typedef Visualization::Abstract::ScalarExtractor ScalarExtractor;
+	typedef Visualization::Abstract::VectorExtractor VectorExtractor;
+	typedef Visualization::Abstract::CoordinateTransformer CoordinateTransformer;
+	
+	enum SamplingMode // Enumerated type for sample layouts
+		{
+		POLYLINE, // Samples spaced uniformly by arc length along a polyline
+		PLANE // Samples on a regular grid on a plane, in row-major order
+		};
+	
+	enum ValueType // Enumerated type for the most recently evaluated values
+		{
+		NONE,SCALAR,VECTOR
+		};
+	
+	private:
+	struct Worker // Structure holding the state of an evaluation thread
+		{
+		/* Elements: */
+		public:
+		EvaluationProbe* probe; // Pointer to the probe
+		Locator* locator; // Private locator tracing the worker's samples
+		size_t firstSample,lastSample; // Range of samples evaluated by the worker
+		size_t numValid; // Number of valid samples found by the worker
+		Threads::Thread thread; // The worker thread
+		
+		/* Methods: */
+		void* workerThreadMethod(void)
+			{
+			probe->evaluateSamples(*this);
+			return 0;
+			}
+		};
+	
+	/* Elements: */
+	SamplingMode samplingMode; // Layout of the current sample positions
+	size_t numSamples[2]; // Number of samples along the polyline, or along the plane grid's two axes
+	std::vector<Point> positions; // Sample positions in model coordinates
+	std::vector<Scalar> parameters; // Arc length of each polyline sample from the polyline's start
+	unsigned int numThreads; // Number of threads to use; 0 uses all CPUs
+	
+	/* Evaluation state: */
+	const ScalarExtractor* scalarExtractor; // Scalar extractor for the current evaluation
+	const VectorExtractor* vectorExtractor; // Vector extractor for the current evaluation
+	ValueType valueType; // Type of the most recently evaluated values
+	std::vector<VScalar> scalarValues; // Evaluated scalar values; NaN outside the domain
+	std::vector<VVector> vectorValues; // Evaluated vector values; NaN vectors outside the domain
+	size_t numValidSamples; // Number of samples inside the domain during the most recent evaluation
+	double evaluationTime; // Wall-clock time of the most recent evaluation in seconds
+	
+	/* Private methods: */
+	void evaluateSamples(Worker& worker); // Evaluates the worker's range of samples
+	size_t evaluate(const Locator* prototype); // Evaluates all samples in parallel with clones of the given locator
+	
+	/* Constructors and destructors: */
+	public:
+	EvaluationProbe(void); // Creates a probe without samples
+	private:
+	EvaluationProbe(const EvaluationProbe& source); // Prohibit copy constructor
+	EvaluationProbe& operator=(const EvaluationProbe& source); // Prohibit assignment operator
+	
+	/* Methods: */
+	public:
+	void setNumThreads(unsigned int newNumThreads); // Sets the number of evaluation threads; 0 uses all CPUs
+	void setLine(const Point& start,const Point& end,size_t newNumSamples); // Places the given number of samples (at least two) uniformly along a line segment
+	void setPolyline(size_t numVertices,const Point vertices[],size_t newNumSamples); // Places the given number of samples (at least two) uniformly by arc length along a polyline
+	void setPlaneGrid(const Point& origin,const Vector& axis0,const Vector& axis1,size_t newNumSamples0,size_t newNumSamples1); // Places a grid of samples on the parallelogram spanned by the given axes; samples along axis0 vary fastest
+	SamplingMode getSamplingMode(void) const // Returns the layout of the current samples
+		{
+		return samplingMode;
+		}
+	size_t getNumSamples(void) const // Returns the total number of samples
+		{
+		return positions.size();
+		}
+	size_t getNumSamples(int axis) const // Returns the number of samples along the polyline or along one plane grid axis
+		{
+		return numSamples[axis];
+		}
+	const Point* getPositions(void) const // Returns the array of sample positions
+		{
+		return positions.empty()?0:&positions[0];
+		}
+	const Scalar* getParameters(void) const // Returns the arc length parameters of polyline samples
+		{
+		return parameters.empty()?0:&parameters[0];
+		}
+	size_t evaluateScalars(const Locator* prototype,const ScalarExtractor* newScalarExtractor); // Evaluates the given scalar extractor at all samples; returns the number of valid samples
+	size_t evaluateVectors(const Locator* prototype,const VectorExtractor* newVectorExtractor); // Evaluates the given vector extractor at all samples; returns the number of valid samples
+	ValueType getValueType(void) const // Returns the type of the most recently evaluated values
+		{
+		return valueType;
+		}
+	const VScalar* getScalarValues(void) const // Returns the array of evaluated scalar values
+		{
+		return scalarValues.empty()?0:&scalarValues[0];
+		}
+	const VVector* getVectorValues(void) const // Returns the array of evaluated vector values
+		{
+		return vectorValues.empty()?0:&vectorValues[0];
+		}
+	size_t getNumValidSamples(void) const // Returns the number of samples inside the domain
+		{
+		return numValidSamples;
+		}
+	double getEvaluationTime(void) const // Returns the time taken by the most recent evaluation in seconds
+		{
+		return evaluationTime;
+		}
+	void writeCsv(FILE* file,const char* valueName,const CoordinateTransformer* coordinateTransformer =0) const; // Writes the samples and their most recently evaluated values as comma-separated values; writes source coordinates if a coordinate transformer is given
+	void saveCsv(const char* fileName,const char* valueName,const CoordinateTransformer* coordinateTransformer =0) const; // Writes comma-separated values to the given file; throws exception if the file cannot be written
+	};
+
+#endif
@@ -0,0 +1,262 @@
+/***********************************************************************
+ExtractionScheduler - Class to share a bounded pool of worker threads
+between all extractors, with work stealing and priority classes for
+interactive, finalization, and batch extraction jobs.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include "ExtractionScheduler.h"
+
+#include <unistd.h>
+#include <algorithm>
+#include <iostream>
+#include <Realtime/AlarmTimer.h>
+
+/*******************************************
+Methods of class ExtractionScheduler::Job:
+*******************************************/
+
+ExtractionScheduler::Job::Job(void)
+	:queued(false),running(false),rescheduleRequested(false),unscheduling(false),
+	 priority(INTERACTIVE),worker(0)
+	{
+	}
+
+ExtractionScheduler::Job::~Job(void)
+	{
+	}
+
+/************************************
+Methods of class ExtractionScheduler:
+************************************/
+
+void ExtractionScheduler::enqueue(ExtractionScheduler::Job* job,unsigned int workerIndex)
+	{
+	/* Append the job to the worker's queue for its current priority: */
+	job->queued=true;
+	job->priority=job->getJobPriority();
+	job->worker=workerIndex;
+	workers[workerIndex].queues[job->priority].push_back(job);
+	
+	/* Update the queue depth statistics: */
+	++statistics.queueDepth[job->priority];
+	unsigned int depth=0;
+	for(int p=0;p<NUM_PRIORITIES;++p)
+		depth+=statistics.queueDepth[p];
+	if(statistics.maxQueueDepth<depth)
+		statistics.maxQueueDepth=depth;
+	
+	/* Wake up all idle workers, as the job might need to be stolen: */
+	workAvailableCond.broadcast();
+	}
+
+ExtractionScheduler::Job* ExtractionScheduler::dequeue(unsigned int workerIndex)
+	{
+	for(int p=0;p<NUM_PRIORITIES;++p)
+		{
+		/* Keep at least one worker free for interactive and finalization jobs: */
+		if(p==BATCH&&numWorkers>1&&numBatchWorkers>=numWorkers-1)
+			break;
+		
+		/* Take the oldest job from the worker's own queue: */
+		JobQueue& own=workers[workerIndex].queues[p];
+		if(!own.empty())
+			{
+			Job* result=own.front();
+			own.pop_front();
+			--statistics.queueDepth[p];
+			return result;
+			}
+		
+		/* Steal the newest job from another worker's queue: */
+		for(unsigned int i=1;i<numWorkers;++i)
+			{
+			JobQueue& other=workers[(workerIndex+i)%numWorkers].queues[p];
+			if(!other.empty())
+				{
+				Job* result=other.back();
+				other.pop_back();
+				--statistics.queueDepth[p];
+				++statistics.numSteals;
+				return result;
+				}
+			}
+		}
+	
+	return 0;
+	}
+
+void* ExtractionScheduler::workerThreadMethod(unsigned int workerIndex)
+	{
+	/* Each worker owns an alarm timer to bound the duration of job steps: */
+	Realtime::AlarmTimer alarm;
+	
+	Threads::Mutex::Lock queueLock(queueMutex);
+	while(true)
+		{
+		/* Wait for a job: */
+		Job* job;
+		while(!terminate&&(job=dequeue(workerIndex))==0)
+			workAvailableCond.wait(queueMutex);
+		if(terminate)
+			break;
+		
+		/* Mark the job as running: */
+		job->queued=false;
+		job->running=true;
+		Priority priority=job->priority;
+		if(priority==BATCH)
+			++numBatchWorkers;
+		++statistics.numBusyWorkers;
+		
+		/* Run one step of the job without holding the lock: */
+		queueMutex.unlock();
+		Misc::Timer stepTimer;
+		bool moreWork=job->runJobStep(alarm);
+		double stepTime=stepTimer.peekTime();
+		queueMutex.lock();
+		
+		/* Update the statistics: */
+		if(priority==BATCH)
+			--numBatchWorkers;
+		--statistics.numBusyWorkers;
+		++statistics.numSteps[priority];
+		statistics.busyTime+=stepTime;
+		
+		/* Requeue the job on this worker to keep its data warm, unless it was unscheduled in the meantime: */
+		job->running=false;
+		if(!job->unscheduling&&(moreWork||job->rescheduleRequested))
+			{
+			job->rescheduleRequested=false;
+			enqueue(job,workerIndex);
+			}
+		else if(priority==BATCH)
+			{
+			/* A finished batch job might unblock queued batch jobs on other workers: */
+			workAvailableCond.broadcast();
+			}
+		stepFinishedCond.broadcast();
+		}
+	
+	return 0;
+	}
+
+ExtractionScheduler::ExtractionScheduler(unsigned int sNumWorkers)
+	:numWorkers(sNumWorkers),workers(0),
+	 terminate(false),nextWorker(0),numBatchWorkers(0)
+	{
+	if(numWorkers==0)
+		{
+		/* Use one worker per available processor: */
+		long numProcessors=sysconf(_SC_NPROCESSORS_ONLN);
+		numWorkers=numProcessors>0?(unsigned int)(numProcessors):1U;
+		}
+	
+	/* Initialize the statistics: */
+	statistics.numWorkers=numWorkers;
+	for(int p=0;p<NUM_PRIORITIES;++p)
+		{
+		statistics.queueDepth[p]=0;
+		statistics.numSteps[p]=0;
+		}
+	statistics.maxQueueDepth=0;
+	statistics.numSteals=0;
+	statistics.numBusyWorkers=0;
+	statistics.busyTime=0.0;
+	statistics.utilization=0.0;
+	
+	/* Start the worker threads: */
+	workers=new Worker[numWorkers];
+	for(unsigned int i=0;i<numWorkers;++i)
+		workers[i].thread.start(this,&ExtractionScheduler::workerThreadMethod,i);
+	}
+
+ExtractionScheduler::~ExtractionScheduler(void)
+	{
+	/* Shut down all worker threads: */
+	{
+	Threads::Mutex::Lock queueLock(queueMutex);
+	terminate=true;
+	workAvailableCond.broadcast();
+	}
+	for(unsigned int i=0;i<numWorkers;++i)
+		workers[i].thread.join();
+	delete[] workers;
+	}
+
+void ExtractionScheduler::schedule(ExtractionScheduler::Job* job)
+	{
+	Threads::Mutex::Lock queueLock(queueMutex);
+	
+	if(job->unscheduling)
+		return;
+	
+	if(job->running)
+		{
+		/* Let the worker running the job requeue it after the current step: */
+		job->rescheduleRequested=true;
+		}
+	else if(!job->queued)
+		{
+		/* Distribute jobs scheduled from outside the pool round-robin: */
+		enqueue(job,nextWorker);
+		nextWorker=(nextWorker+1)%numWorkers;
+		}
+	}
+
+void ExtractionScheduler::unschedule(ExtractionScheduler::Job* job)
+	{
+	Threads::Mutex::Lock queueLock(queueMutex);
+	
+	if(job->queued)
+		{
+		/* Remove the job from its queue: */
+		JobQueue& queue=workers[job->worker].queues[job->priority];
+		queue.erase(std::find(queue.begin(),queue.end(),job));
+		--statistics.queueDepth[job->priority];
+		job->queued=false;
+		}
+	
+	/* Wait until the job's current step finishes; the worker will not requeue it: */
+	job->unscheduling=true;
+	while(job->running)
+		stepFinishedCond.wait(queueMutex);
+	job->unscheduling=false;
+	job->rescheduleRequested=false;
+	}
+
+ExtractionScheduler::Statistics ExtractionScheduler::getStatistics(void) const
+	{
+	Threads::Mutex::Lock queueLock(queueMutex);
+	Statistics result=statistics;
+	double lifetime=clock.peekTime()*double(numWorkers);
+	result.utilization=lifetime>0.0?result.busyTime/lifetime:0.0;
+	
+	return result;
+	}
+
+void ExtractionScheduler::printStatistics(std::ostream& os) const
+	{
+	static const char* priorityNames[NUM_PRIORITIES]={"interactive","finalization","batch"};
+	
+	Statistics s=getStatistics();
+	os<<"Extraction scheduler: "<<s.numWorkers<<" workers, "<<s.utilization*100.0<<"% utilization, "<<s.busyTime<<" s busy, "<<s.numSteals<<" stolen steps, maximum queue depth "<<s.maxQueueDepth<<std::endl;
+	for(int p=0;p<NUM_PRIORITIES;++p)
+		os<<"Extraction scheduler: "<<s.numSteps[p]<<" "<<priorityNames[p]<<" steps, "<<s.queueDepth[p]<<" still queued"<<std::endl;
+	}
@@ -0,0 +1,136 @@
+/***********************************************************************
+ExtractionScheduler - Class to share a bounded pool of worker threads
+between all extractors, with work stealing and priority classes for
+interactive, finalization, and batch extraction jobs.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef EXTRACTIONSCHEDULER_INCLUDED
+#define EXTRACTIONSCHEDULER_INCLUDED
+
+#include <deque>
+#include <iosfwd>
+#include <Misc/Timer.h>
+#include <Threads/Mutex.h>
+#include <Threads/Cond.h>
+#include <Threads/Thread.h>
+
+/* Forward declarations: */
+namespace Realtime {
+class AlarmTimer;
+}
+
+class ExtractionScheduler
+	{
+	/* Embedded classes: */
+	public:
+	enum Priority // Enumerated type for job priority classes, from highest to lowest
+		{
+		INTERACTIVE=0, // Extraction following a dragged seed point
+		FINALIZATION, // Completion of the final element of a concluded dragging operation
+		BATCH, // Immediate (non-incremental) extraction of a complete element
+		NUM_PRIORITIES
+		};
+	
+	class Job // Base class for schedulable objects that perform their work in short steps
+		{
+		friend class ExtractionScheduler;
+		
+		/* Elements: */
+		private:
+		bool queued; // Flag whether the job is in one of the scheduler's queues
+		bool running; // Flag whether a worker thread is currently executing a step of the job
+		bool rescheduleRequested; // Flag whether the job was scheduled again while one of its steps was running
+		bool unscheduling; // Flag whether a thread is waiting to remove the job from the scheduler
+		Priority priority; // Priority class under which the job was queued
+		int worker; // Index of the worker thread whose queue holds the job
+		
+		/* Constructors and destructors: */
+		public:
+		Job(void); // Creates an unscheduled job
+		virtual ~Job(void);
+		
+		/* Methods: */
+		virtual Priority getJobPriority(void) const =0; // Returns the job's current priority class
+		virtual bool runJobStep(Realtime::AlarmTimer& alarm) =0; // Performs a short step of work using the given worker's alarm timer; returns true if the job has more work
+		};
+	
+	struct Statistics // Structure to report scheduler statistics
+		{
+		/* Elements: */
+		public:
+		unsigned int numWorkers; // Number of worker threads
+		unsigned int queueDepth[NUM_PRIORITIES]; // Number of jobs currently queued in each priority class
+		unsigned int maxQueueDepth; // Largest total number of queued jobs observed
+		unsigned int numSteps[NUM_PRIORITIES]; // Number of job steps executed in each priority class
+		unsigned int numSteals; // Number of job steps taken from another worker's queue
+		unsigned int numBusyWorkers; // Number of workers currently executing a job step
+		double busyTime; // Accumulated time all workers spent executing job steps in seconds
+		double utilization; // Fraction of the worker pool's lifetime spent executing job steps
+		};
+	
+	private:
+	typedef std::deque<Job*> JobQueue;
+	
+	struct Worker // Structure holding the state of a worker thread
+		{
+		/* Elements: */
+		public:
+		JobQueue queues[NUM_PRIORITIES]; // Queues of jobs assigned to this worker, one per priority class
+		Threads::Thread thread; // The worker thread
+		};
+	
+	/* Elements: */
+	unsigned int numWorkers; // Number of worker threads
+	Worker* workers; // Array of worker threads
+	mutable Threads::Mutex queueMutex; // Mutex protecting all job queues, job flags, and statistics
+	Threads::Cond workAvailableCond; // Condition variable for idle workers to wait for jobs
+	Threads::Cond stepFinishedCond; // Condition variable for unscheduling threads to wait for running job steps
+	bool terminate; // Flag to shut down all worker threads
+	unsigned int nextWorker; // Index of the worker whose queue receives the next job scheduled from outside the pool
+	unsigned int numBatchWorkers; // Number of workers currently executing batch jobs
+	mutable Misc::Timer clock; // Timer measuring the worker pool's lifetime
+	Statistics statistics; // Scheduler statistics
+	
+	/* Private methods: */
+	void enqueue(Job* job,unsigned int workerIndex); // Adds an unqueued job to the given worker's queue
+	Job* dequeue(unsigned int workerIndex); // Removes and returns the highest-priority job available to the given worker, stealing from other workers if necessary; returns 0 if there is none
+	void* workerThreadMethod(unsigned int workerIndex); // Method executing job steps
+	
+	/* Constructors and destructors: */
+	public:
+	ExtractionScheduler(unsigned int sNumWorkers =0); // Creates a scheduler with the given number of worker threads; uses one per available processor if zero
+	private:
+	ExtractionScheduler(const ExtractionScheduler& source); // Prohibit copy constructor
+	ExtractionScheduler& operator=(const ExtractionScheduler& source); // Prohibit assignment operator
+	public:
+	~ExtractionScheduler(void); // Shuts down all worker threads; all jobs must have been unscheduled
+	
+	/* Methods: */
+	unsigned int getNumWorkers(void) const // Returns the number of worker threads
+		{
+		return numWorkers;
+		}
+	void schedule(Job* job); // Queues the given job under its current priority, unless it is already queued
+	void unschedule(Job* job); // Removes the given job from the queues and waits until none of its steps are running
+	Statistics getStatistics(void) const; // Returns a snapshot of the scheduler statistics
+	void printStatistics(std::ostream& os) const; // Prints a summary of the scheduler statistics to the given stream
+	};
+
+#endif
@@ -22,6 +22,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include "Extractor.h"
 
+#include <algorithm>
+#include <iostream>
 #include <Misc/Time.h>
 #include <Threads/Config.h>
 #include <Realtime/AlarmTimer.h>
@@ -31,144 +33,187 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Abstract/Parameters.h>
 #include <Abstract/BinaryParametersSink.h>
 #include <Abstract/BinaryParametersSource.h>
+#include <Abstract/VariableManager.h>
 #include <Abstract/Algorithm.h>
 #include <Abstract/Element.h>
+#include <Templatized/Profiler.h>
+
+namespace {
+
+/****************
+Helper functions:
+****************/
+
+inline void flushPipe(Cluster::MulticastPipe* pipe)
+	{
+	/* Time sending the buffered extraction messages to the slaves: */
+	static const unsigned int flushProbe=Visualization::Templatized::Profiler::registerTimer("Extractor pipe flush",Visualization::Templatized::Profiler::CLUSTER);
+	Visualization::Templatized::Profiler::Scope flushScope(flushProbe);
+	pipe->flush();
+	}
+
+}
 
 /**************************
 Methods of class Extractor:
 **************************/
 
-void* Extractor::masterExtractorThreadMethod(void)
+Extractor::SeedRequest* Extractor::exchangeSeedRequest(Extractor::SeedRequest* newSeedRequest)
 	{
-	/* Enable asynchronous cancellation of this thread: */
-	Threads::Thread::setCancelState(Threads::Thread::CANCEL_ENABLE);
-	// Threads::Thread::setCancelType(Threads::Thread::CANCEL_ASYNCHRONOUS);
+	/* Swap the pending seed request without locking; compare-and-swap acts as a full memory barrier: */
+	SeedRequest* oldSeedRequest;
+	do
+		{
+		oldSeedRequest=pendingSeedRequest;
+		}
+	while(!__sync_bool_compare_and_swap(&pendingSeedRequest,oldSeedRequest,newSeedRequest));
 	
-	/* Create a data sink for the multicast pipe: */
-	Visualization::Abstract::BinaryParametersSink sink(extractor->getVariableManager(),*extractor->getPipe(),true);
+	return oldSeedRequest;
+	}
+
+void Extractor::startRequest(Extractor::SeedRequest* request)
+	{
+	Parameters* parameters=request->parameters;
+	unsigned int requestID=request->requestID;
 	
-	/* Handle extraction requests until interrupted: */
-	Realtime::AlarmTimer alarm;
-	Misc::Time expirationTime(0.1);
-	while(true)
-		{
-		/* Wait until there is a seed request: */
-		Parameters* parameters;
-		unsigned int requestID;
+	/* Let the algorithm abandon the new element as soon as a newer seed request arrives: */
+	extractor->setRequestGeneration(&requestGeneration,request->generation);
+	
+	/* Start a new visualization element: */
+	TrackedElement& element=trackedElements.startNewValue();
+	element.requestTime=request->requestTime;
+	delete request;
+	if(parameters->isValid())
 		{
-		Threads::Mutex::Lock seedRequestLock(seedRequestMutex);
-		#if !THREADS_CONFIG_CAN_CANCEL
-		while(!terminate&&seedParameters==0)
-			seedRequestCond.wait(seedRequestMutex);
-		if(terminate)
-			return 0;
-		#else
-		while(seedParameters==0)
-			seedRequestCond.wait(seedRequestMutex);
-		#endif
-		
-		/* Grab the seed request parameters: */
-		parameters=seedParameters;
-		seedParameters=0;
-		
-		/* Grab the seed request ID: */
-		requestID=seedRequestID;
-		}
-		
-		/* Start a new visualization element: */
-		std::pair<ElementPointer,unsigned int>& element=trackedElements.startNewValue();
-		if(parameters->isValid())
+		/* Prepare for extracting a new visualization element: */
+		if(extractor->getPipe()!=0)
 			{
-			/* Prepare for extracting a new visualization element: */
-			if(extractor->getPipe()!=0)
-				{
-				/* Notify the slave nodes that a new visualization element is coming: */
-				extractor->getPipe()->write<unsigned int>(requestID);
-				
-				/* Send the extraction parameters to the slaves: */
-				parameters->write(sink);
-				extractor->getPipe()->flush();
-				}
+			/* Notify the slave nodes that a new visualization element is coming: */
+			extractor->getPipe()->write<unsigned int>(requestID);
 			
-			if(extractor->hasIncrementalCreator())
-				{
-				/* Start the visualization element: */
-				element.first=extractor->startElement(parameters);
-				element.second=requestID;
-				
-				/* Continue extracting the visualization element until it is done: */
-				bool keepGrowing;
-				do
-					{
-					/* Grow the visualization element by a little bit: */
-					alarm.armTimer(expirationTime);
-					keepGrowing=!extractor->continueElement(alarm);
-					
-					/* Push this visualization element to the main thread: */
-					trackedElements.postNewValue();
-					update();
-					
-					/* Check if there is another seed request: */
-					if(keepGrowing)
-						{
-						Threads::Mutex::Lock seedRequestLock(seedRequestMutex);
-						keepGrowing=seedParameters==0;
-						}
-					
-					if(extractor->getPipe()!=0)
-						{
-						/* Tell the slave nodes whether the current visualization element is finished: */
-						extractor->getPipe()->write<unsigned int>(keepGrowing?1:0);
-						extractor->getPipe()->flush();
-						}
-					}
-				while(keepGrowing);
-				
-				/* Finish the element: */
-				extractor->finishElement();
-				}
-			else
-				{
-				/* Extract the visualization element: */
-				element.first=extractor->createElement(parameters);
-				element.second=requestID;
-				
-				if(extractor->getPipe()!=0)
-					{
-					/* Tell the slave nodes that the current visualization element is finished: */
-					extractor->getPipe()->write<unsigned int>(0);
-					extractor->getPipe()->flush();
-					}
-				
-				/* Push this visualization element to the main thread: */
-				trackedElements.postNewValue();
-				update();
-				}
+			/* Send the extraction parameters to the slaves: */
+			Visualization::Abstract::BinaryParametersSink sink(extractor->getVariableManager(),*extractor->getPipe(),true);
+			parameters->write(sink);
+			flushPipe(extractor->getPipe());
+			}
+		
+		if(extractor->hasIncrementalCreator())
+			{
+			/* Start the visualization element and grow it in subsequent job steps: */
+			Visualization::Templatized::Profiler::Scope extractionScope(extractionProbe);
+			element.element=extractor->startElement(parameters);
+			element.requestID=requestID;
+			growingElement=&element;
 			}
 		else
 			{
+			/* Extract the visualization element: */
+				{
+				Visualization::Templatized::Profiler::Scope extractionScope(extractionProbe);
+				element.element=extractor->createElement(parameters);
+				}
+			element.requestID=requestID;
+			
 			if(extractor->getPipe()!=0)
 				{
-				/* Notify the slave nodes that there is no visualization element: */
+				/* Tell the slave nodes that the current visualization element is finished: */
 				extractor->getPipe()->write<unsigned int>(0);
-				extractor->getPipe()->write<unsigned int>(requestID);
-				extractor->getPipe()->flush();
+				flushPipe(extractor->getPipe());
 				}
 			
-			/* Store an invalid visualization element: */
-			element.first=0;
-			element.second=requestID;
-			
 			/* Push this visualization element to the main thread: */
 			trackedElements.postNewValue();
 			update();
-			
-			/* Delete the unused extraction parameters: */
-			delete parameters;
 			}
 		}
+	else
+		{
+		if(extractor->getPipe()!=0)
+			{
+			/* Notify the slave nodes that there is no visualization element: */
+			extractor->getPipe()->write<unsigned int>(0);
+			extractor->getPipe()->write<unsigned int>(requestID);
+			flushPipe(extractor->getPipe());
+			}
+		
+		/* Store an invalid visualization element: */
+		element.element=0;
+		element.requestID=requestID;
+		
+		/* Push this visualization element to the main thread: */
+		trackedElements.postNewValue();
+		update();
+		
+		/* Delete the unused extraction parameters: */
+		delete parameters;
+		}
+	}
+
+bool Extractor::growElement(Realtime::AlarmTimer& alarm)
+	{
+	/* Grow the visualization element by a little bit: */
+	alarm.armTimer(Misc::Time(0.1));
+	bool keepGrowing;
+		{
+		Visualization::Templatized::Profiler::Scope extractionScope(extractionProbe);
+		keepGrowing=!extractor->continueElement(alarm);
+		}
 	
-	return 0;
+	/* Push this visualization element to the main thread: */
+	trackedElements.postNewValue();
+	update();
+	
+	/* Abandon the element if there is a newer seed request: */
+	if(keepGrowing&&extractor->isCancelled())
+		{
+		__sync_fetch_and_add(&numCancelledElements,1);
+		keepGrowing=false;
+		}
+	
+	if(extractor->getPipe()!=0)
+		{
+		/* Tell the slave nodes whether the current visualization element is finished: */
+		extractor->getPipe()->write<unsigned int>(keepGrowing?1:0);
+		flushPipe(extractor->getPipe());
+		}
+	
+	if(!keepGrowing)
+		{
+		/* Finish the element: */
+		Visualization::Templatized::Profiler::Scope extractionScope(extractionProbe);
+		extractor->finishElement();
+		growingElement=0;
+		}
+	
+	return !keepGrowing;
+	}
+
+ExtractionScheduler::Priority Extractor::getJobPriority(void) const
+	{
+	/* Immediate extraction blocks a worker for a long time; incremental extraction yields after every step: */
+	if(!extractor->hasIncrementalCreator())
+		return ExtractionScheduler::BATCH;
+	else if(finalElementPending)
+		return ExtractionScheduler::FINALIZATION;
+	else
+		return ExtractionScheduler::INTERACTIVE;
+	}
+
+bool Extractor::runJobStep(Realtime::AlarmTimer& alarm)
+	{
+	if(growingElement!=0)
+		{
+		/* Continue the current element; the job has more work until it is finished or a new request is pending: */
+		return !growElement(alarm)||pendingSeedRequest!=0;
+		}
+	
+	/* Grab the most recent seed request: */
+	SeedRequest* request=exchangeSeedRequest(0);
+	if(request==0)
+		return false;
+	startRequest(request);
+	
+	return growingElement!=0||pendingSeedRequest!=0;
 	}
 
 void* Extractor::slaveExtractorThreadMethod(void)
@@ -195,7 +240,8 @@ void* Extractor::slaveExtractorThreadMethod(void)
 		#endif
 		
 		/* Start a new visualization element: */
-		std::pair<ElementPointer,unsigned int>& element=trackedElements.startNewValue();
+		TrackedElement& element=trackedElements.startNewValue();
+		element.requestTime=0.0;
 		if(requestID!=0)
 			{
 			/* Receive the new element's parameters from the master: */
@@ -203,8 +249,8 @@ void* Extractor::slaveExtractorThreadMethod(void)
 			parameters->read(source);
 			
 			/* Start receiving the visualization element from the master: */
-			element.first=extractor->startSlaveElement(parameters);
-			element.second=requestID;
+			element.element=extractor->startSlaveElement(parameters);
+			element.requestID=requestID;
 			
 			/* Receive fragments of the visualization element until finished: */
 			do
@@ -223,8 +269,8 @@ void* Extractor::slaveExtractorThreadMethod(void)
 			unsigned int requestID=extractor->getPipe()->read<unsigned int>();
 			
 			/* Store an invalid visualization element: */
-			element.first=0;
-			element.second=requestID;
+			element.element=0;
+			element.requestID=requestID;
 			
 			/* Push this visualization element to the main thread: */
 			trackedElements.postNewValue();
@@ -235,79 +281,162 @@ void* Extractor::slaveExtractorThreadMethod(void)
 	return 0;
 	}
 
-Extractor::Extractor(Extractor::Algorithm* sExtractor)
-	:extractor(sExtractor),
-	 #if !THREADS_CONFIG_CAN_CANCEL
-	 terminate(false),
-	 #endif
-	 finalElementPending(false),finalSeedRequestID(0),
-	 seedParameters(0),
-	 seedRequestID(0)
+void Extractor::startExtraction(void)
 	{
-	/* Initialize the extraction thread communications: */
+	#if !THREADS_CONFIG_CAN_CANCEL
+	terminate=false;
+	#endif
+	
+	/* Initialize the extraction communications: */
 	for(int i=0;i<3;++i)
 		{
-		trackedElements.getBuffer(i).first=0;
-		trackedElements.getBuffer(i).second=0;
+		trackedElements.getBuffer(i).element=0;
+		trackedElements.getBuffer(i).requestID=0;
+		trackedElements.getBuffer(i).requestTime=0.0;
 		}
+	growingElement=0;
 	
-	if(extractor->isMaster())
-		{
-		/* Start the master-side extraction thread: */
-		extractorThread.start(this,&Extractor::masterExtractorThreadMethod);
-		}
-	else
+	/* Time the new algorithm's extraction steps under its own name: */
+	extractionProbe=Visualization::Templatized::Profiler::registerTimer(extractor->getName(),Visualization::Templatized::Profiler::EXTRACTION);
+	
+	if(!extractor->isMaster())
 		{
 		/* Start the slave-side extraction thread: */
-		extractorThread.start(this,&Extractor::slaveExtractorThreadMethod);
+		slaveThread.start(this,&Extractor::slaveExtractorThreadMethod);
 		}
+	extractionActive=true;
 	}
 
-Extractor::~Extractor(void)
+void Extractor::stopExtraction(void)
 	{
-	/* Stop the extraction thread: */
-	#if !THREADS_CONFIG_CAN_CANCEL
+	if(!extractionActive)
+		return;
+	
+	/* Abandon the element currently being extracted: */
+	__sync_add_and_fetch(&requestGeneration,1);
+	
 	if(extractor->isMaster())
 		{
+		/* Take the extraction job off the scheduler, waiting for a running step to return: */
+		scheduler->unschedule(this);
+		
+		if(growingElement!=0)
+			{
+			/* Finish the abandoned element: */
+			extractor->finishElement();
+			growingElement=0;
+			#if !THREADS_CONFIG_CAN_CANCEL
+			if(extractor->getPipe()!=0)
+				{
+				/* Tell the slave nodes that the current visualization element is finished: */
+				extractor->getPipe()->write<unsigned int>(0);
+				}
+			#endif
+			}
+		
+		#if !THREADS_CONFIG_CAN_CANCEL
 		if(extractor->getPipe()!=0)
 			{
 			/* Send a flag across the pipe to wake up and kill the extractor threads on the slave node(s): */
 			extractor->getPipe()->write<unsigned int>(0);
+			flushPipe(extractor->getPipe());
 			}
-		
-		/* Wake the extractor thread up to die: */
-		{
-		Threads::Mutex::Lock seedRequestLock(seedRequestMutex);
-		terminate=true;
-		seedRequestCond.signal();
-		}
+		#endif
 		}
 	else
 		{
+		/* Stop the slave-side extraction thread: */
+		#if !THREADS_CONFIG_CAN_CANCEL
 		/* Set the terminate flag and wait for the wake-up message from the master: */
 		terminate=true;
+		#else
+		slaveThread.cancel();
+		#endif
+		slaveThread.join();
 		}
-	#else
-	extractorThread.cancel();
-	#endif
-	extractorThread.join();
+	extractionActive=false;
 	
-	/* Clear the extractor thread communication: */
-	delete seedParameters;
+	/* Clear the extraction communication: */
+	SeedRequest* request=exchangeSeedRequest(0);
+	if(request!=0)
+		{
+		delete request->parameters;
+		delete request;
+		}
+	for(int i=0;i<3;++i)
+		trackedElements.getBuffer(i).element=0;
+	finalElementPending=false;
+	}
+
+Extractor::Extractor(Extractor::Algorithm* sExtractor,ExtractionScheduler* sScheduler)
+	:extractor(sExtractor),
+	 scheduler(sScheduler),
+	 extractionActive(false),extractionProbe(0),
+	 #if !THREADS_CONFIG_CAN_CANCEL
+	 terminate(false),
+	 #endif
+	 finalElementPending(false),finalSeedRequestID(0),
+	 pendingSeedRequest(0),
+	 requestGeneration(0),
+	 growingElement(0),
+	 numRequests(0),numSupersededRequests(0),numCancelledElements(0),
+	 lastVisibleRequestID(0),
+	 nextLatencySample(0)
+	{
+	/* Enable extraction: */
+	startExtraction();
+	}
+
+Extractor::~Extractor(void)
+	{
+	/* Shut down extraction: */
+	stopExtraction();
 	
 	/* Delete the visualization element extractor: */
 	delete extractor;
 	}
 
+void Extractor::suspend(void)
+	{
+	stopExtraction();
+	}
+
+void Extractor::setExtractor(Extractor::Algorithm* newExtractor)
+	{
+	/* Shut down extraction if it is still active: */
+	stopExtraction();
+	
+	/* Replace the visualization element extractor: */
+	delete extractor;
+	extractor=newExtractor;
+	
+	/* Restart extraction for the new extractor: */
+	startExtraction();
+	}
+
 void Extractor::seedRequest(unsigned int newSeedRequestID,Extractor::Parameters* newSeedParameters)
 	{
-	/* Request another visualization element extraction: */
-	Threads::Mutex::Lock seedRequestLock(seedRequestMutex);
-	delete seedParameters;
-	seedParameters=newSeedParameters;
-	seedRequestID=newSeedRequestID;
+	/* Create a new seed request and advance the generation counter to cancel the element currently being extracted: */
+	SeedRequest* request=new SeedRequest;
+	request->parameters=newSeedParameters;
+	request->requestID=newSeedRequestID;
+	request->generation=__sync_add_and_fetch(&requestGeneration,1);
+	request->requestTime=clock.peekTime();
+	__sync_fetch_and_add(&numRequests,1);
+	
+	/* Replace the pending seed request: */
+	SeedRequest* oldRequest=exchangeSeedRequest(request);
+	if(oldRequest!=0)
+		{
+		/* The previous request was never picked up by the extraction job: */
+		__sync_fetch_and_add(&numSupersededRequests,1);
+		delete oldRequest->parameters;
+		delete oldRequest;
+		}
 	
-	seedRequestCond.signal();
+	/* Queue the extraction job; the scheduler ignores the request if the job is already queued: */
+	if(extractionActive)
+		scheduler->schedule(this);
 	}
 
 void Extractor::finalize(unsigned int newFinalSeedRequestID)
@@ -318,23 +447,40 @@ void Extractor::finalize(unsigned int newFinalSeedRequestID)
 
 Extractor::ElementPointer Extractor::checkUpdates(void)
 	{
-	/* Get the most recent visualization element from the extractor thread: */
+	/* Get the most recent visualization element from the extraction job: */
 	if(trackedElements.hasNewValue())
 		{
 		/* Delete the currently locked visualization element: */
-		trackedElements.getLockedValue().first=0;
+		trackedElements.getLockedValue().element=0;
 		
 		/* Lock the most recent visualization element: */
 		trackedElements.lockNewValue();
+		
+		/* Measure the latency of the first visible result of each seed request: */
+		const TrackedElement& te=trackedElements.getLockedValue();
+		if(te.requestID!=lastVisibleRequestID&&te.requestTime>0.0)
+			{
+			double latency=clock.peekTime()-te.requestTime;
+			static const unsigned int latencyProbe=Visualization::Templatized::Profiler::registerCounter("Seed request latency (s)",Visualization::Templatized::Profiler::EXTRACTION);
+			Visualization::Templatized::Profiler::count(latencyProbe,latency);
+			if(latencySamples.size()<maxNumLatencySamples)
+				latencySamples.push_back(latency);
+			else
+				{
+				latencySamples[nextLatencySample]=latency;
+				nextLatencySample=(nextLatencySample+1)%maxNumLatencySamples;
+				}
+			}
+		lastVisibleRequestID=te.requestID;
 		}
 	
 	/* Check if the final element from a concluded dragging operation or an immediate extraction has arrived: */
 	ElementPointer result=0;
-	if(finalElementPending&&trackedElements.getLockedValue().second==finalSeedRequestID)
+	if(finalElementPending&&trackedElements.getLockedValue().requestID==finalSeedRequestID)
 		{
 		/* Return the new element: */
-		result=trackedElements.getLockedValue().first;
-		trackedElements.getLockedValue().first=0;
+		result=trackedElements.getLockedValue().element;
+		trackedElements.getLockedValue().element=0;
 		
 		/* Reset the finalization marker: */
 		finalElementPending=false;
@@ -346,7 +492,7 @@ Extractor::ElementPointer Extractor::checkUpdates(void)
 void Extractor::glRenderAction(GLRenderState& renderState,bool transparent) const
 	{
 	/* Render the tracked visualization element if its transparency matches the parameter: */
-	const Element* element=trackedElements.getLockedValue().first.getPointer();
+	const Element* element=trackedElements.getLockedValue().element.getPointer();
 	if(element!=0&&element->usesTransparency()==transparent)
 		element->glRenderAction(renderState);
 	}
@@ -354,3 +500,35 @@ void Extractor::glRenderAction(GLRenderState& renderState,bool transparent) cons
 void Extractor::update(void)
 	{
 	}
+
+Extractor::Statistics Extractor::getStatistics(void) const
+	{
+	Statistics result;
+	result.numRequests=numRequests;
+	result.numSupersededRequests=numSupersededRequests;
+	result.numCancelledElements=numCancelledElements;
+	result.numLatencySamples=latencySamples.size();
+	result.medianLatency=0.0;
+	result.p99Latency=0.0;
+	result.maxLatency=0.0;
+	if(!latencySamples.empty())
+		{
+		/* Calculate latency percentiles from a sorted copy of the recent samples: */
+		std::vector<double> sorted(latencySamples);
+		std::sort(sorted.begin(),sorted.end());
+		size_t last=sorted.size()-1;
+		result.medianLatency=sorted[last/2];
+		result.p99Latency=sorted[(last*99+50)/100];
+		result.maxLatency=sorted[last];
+		}
+	
+	return result;
+	}
+
+void Extractor::printStatistics(std::ostream& os) const
+	{
+	Statistics s=getStatistics();
+	os<<extractor->getName()<<" extractor: "<<s.numRequests<<" seed requests, "<<s.numSupersededRequests<<" superseded, "<<s.numCancelledElements<<" cancelled mid-way"<<std::endl;
+	if(s.numLatencySamples>0)
+		os<<extractor->getName()<<" extractor: latency to first visible result p50 "<<s.medianLatency*1000.0<<" ms, p99 "<<s.p99Latency*1000.0<<" ms, maximum "<<s.maxLatency*1000.0<<" ms over "<<s.numLatencySamples<<" requests"<<std::endl;
+	}
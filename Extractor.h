@@ -23,14 +23,16 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef EXTRACTOR_INCLUDED
 #define EXTRACTOR_INCLUDED
 
-#include <utility>
+#include <vector>
+#include <iosfwd>
 #include <Misc/Autopointer.h>
+#include <Misc/Timer.h>
 #include <Threads/Config.h>
-#include <Threads/Mutex.h>
-#include <Threads/Cond.h>
 #include <Threads/Thread.h>
 #include <Threads/TripleBuffer.h>
 
+#include "ExtractionScheduler.h"
+
 /* Forward declarations: */
 namespace Visualization {
 namespace Abstract {
@@ -41,7 +43,7 @@ class Element;
 }
 class GLRenderState;
 
-class Extractor
+class Extractor:private ExtractionScheduler::Job
 	{
 	/* Embedded classes: */
 	public:
@@ -50,40 +52,96 @@ class Extractor
 	typedef Visualization::Abstract::Element Element;
 	typedef Misc::Autopointer<Element> ElementPointer;
 	
+	struct Statistics // Structure to report seed request statistics
+		{
+		/* Elements: */
+		public:
+		unsigned int numRequests; // Total number of posted seed requests
+		unsigned int numSupersededRequests; // Number of seed requests replaced by newer ones before extraction started
+		unsigned int numCancelledElements; // Number of extractions abandoned mid-way due to newer seed requests
+		size_t numLatencySamples; // Number of recent latency measurements
+		double medianLatency; // 50th percentile of time from seed request to first visible element in seconds
+		double p99Latency; // 99th percentile of time from seed request to first visible element in seconds
+		double maxLatency; // Maximum time from seed request to first visible element in seconds
+		};
+	
+	private:
+	struct SeedRequest // Structure describing a pending seed request
+		{
+		/* Elements: */
+		public:
+		Parameters* parameters; // Extraction parameters
+		unsigned int requestID; // ID of the seed request
+		unsigned int generation; // Value of the request generation counter when the request was posted
+		double requestTime; // Time at which the request was posted
+		};
+	
+	struct TrackedElement // Structure holding a tracked visualization element
+		{
+		/* Elements: */
+		public:
+		ElementPointer element; // Pointer to the visualization element
+		unsigned int requestID; // ID of the seed request that created the element
+		double requestTime; // Time at which the seed request was posted
+		};
+	
+	static const size_t maxNumLatencySamples=1024; // Number of most recent latency measurements kept for statistics
+	
 	/* Elements: */
 	protected:
 	
 	/* Persistent state: */
 	Algorithm* extractor; // Visualization element extractor
 	
-	/* Persistent extractor thread state: */
+	/* Persistent extraction state: */
 	private:
+	ExtractionScheduler* scheduler; // Scheduler running master-side extraction steps on its shared worker pool
+	bool extractionActive; // Flag whether extraction is currently enabled
+	unsigned int extractionProbe; // Profiler timer probe for the current algorithm's extraction steps
 	#if !THREADS_CONFIG_CAN_CANCEL
-	volatile bool terminate; // Flag to tell the extractor thread to shut itself down
+	volatile bool terminate; // Flag to tell the slave-side receiver thread to shut itself down
 	#endif
-	Threads::Thread extractorThread; // The visualization element extractor thread
+	Threads::Thread slaveThread; // Thread receiving visualization elements from the master on cluster slaves
 	
 	/* Transient extractor state: */
-	bool finalElementPending; // Flag whether the extractor is waiting for the last seed request in a dragging operation to finish
+	volatile bool finalElementPending; // Flag whether the extractor is waiting for the last seed request in a dragging operation to finish
 	unsigned int finalSeedRequestID; // ID of last seed request in a dragging operation
 	
-	/* Extractor thread communication input: */
-	Threads::Mutex seedRequestMutex; // Mutex protecting the seed request state
-	Threads::Cond seedRequestCond; // Condition variable for the extractor thread to block on
-	Parameters* volatile seedParameters; // Extraction parameters for the most recently requested visualization element
-	volatile unsigned int seedRequestID; // ID of current seed request
+	/* Extraction job communication input: */
+	SeedRequest* volatile pendingSeedRequest; // Most recent seed request not yet picked up by the extraction job; exchanged atomically
+	volatile unsigned int requestGeneration; // Counter advanced by every seed request; the extraction job abandons elements of older generations
 	
-	/* Extractor thread communication output: */
-	Threads::TripleBuffer<std::pair<ElementPointer,unsigned int> > trackedElements; // Triple-buffer of currently tracked visualization elements and their IDs
+	/* Extraction job state, only accessed from inside job steps: */
+	TrackedElement* growingElement; // Incremental visualization element currently being extracted, or 0
+	
+	/* Extraction communication output: */
+	Threads::TripleBuffer<TrackedElement> trackedElements; // Triple-buffer of currently tracked visualization elements and their IDs
+	
+	/* Seed request statistics: */
+	Misc::Timer clock; // Free-running timer to time-stamp seed requests
+	volatile unsigned int numRequests; // Total number of posted seed requests
+	volatile unsigned int numSupersededRequests; // Number of seed requests replaced before extraction started
+	volatile unsigned int numCancelledElements; // Number of extractions abandoned mid-way
+	unsigned int lastVisibleRequestID; // ID of the most recent seed request whose result was made visible
+	std::vector<double> latencySamples; // Ring buffer of recent seed request latencies
+	size_t nextLatencySample; // Index of the next latency sample to overwrite once the ring buffer is full
 	
 	/* Private methods: */
 	private:
-	void* masterExtractorThreadMethod(void); // The extractor thread method for single computers or masters in a cluster environment
+	SeedRequest* exchangeSeedRequest(SeedRequest* newSeedRequest); // Atomically replaces the pending seed request; returns the previous one
+	void startRequest(SeedRequest* request); // Starts extracting a visualization element for the given seed request on single computers or masters in a cluster environment
+	bool growElement(Realtime::AlarmTimer& alarm); // Grows the current incremental visualization element by a little bit; returns true if it is finished
 	void* slaveExtractorThreadMethod(void); // The extractor thread method for slaves in a cluster environment
+	void startExtraction(void); // Enables master-side extraction jobs or starts the slave-side receiver thread
+	void stopExtraction(void); // Shuts down extraction and discards all pending and tracked visualization elements
+	
+	/* Methods from ExtractionScheduler::Job: */
+	virtual ExtractionScheduler::Priority getJobPriority(void) const;
+	virtual bool runJobStep(Realtime::AlarmTimer& alarm);
 	
 	/* Constructors and destructors: */
 	public:
-	Extractor(Algorithm* sExtractor); // Creates extractor for the given algorithm; inherits algorithm
+	Extractor(Algorithm* sExtractor,ExtractionScheduler* sScheduler); // Creates extractor for the given algorithm running on the given scheduler; inherits algorithm
 	virtual ~Extractor(void); // Destroys the extractor
 	
 	/* Methods: */
@@ -91,15 +149,19 @@ class Extractor
 		{
 		return extractor;
 		}
-	void seedRequest(unsigned int newSeedRequestID,Parameters* newSeedParameters); // Posts a new seed request to the extraction thread
+	void suspend(void); // Shuts down extraction until the next call to setExtractor, e.g., while the underlying data set is replaced
+	void setExtractor(Algorithm* newExtractor); // Replaces the algorithm and restarts extraction; inherits algorithm
+	void seedRequest(unsigned int newSeedRequestID,Parameters* newSeedParameters); // Posts a new seed request and schedules its extraction; cancels the element currently being extracted
 	void finalize(unsigned int newFinalSeedRequestID); // Posts a finalization request for the given seed request ID
 	bool isFinalizationPending(void) const // Returns true if the main thread is waiting for a new final visualization element
 		{
 		return finalElementPending;
 		}
-	virtual ElementPointer checkUpdates(void); // Method to synchronize the extraction thread's state back to the main thread; returns pointer to new finished element or 0
+	virtual ElementPointer checkUpdates(void); // Method to synchronize the extraction job's state back to the main thread; returns pointer to new finished element or 0
 	void glRenderAction(GLRenderState& renderState,bool transparent) const; // Renders the extractor's current opaque or transparent geometry
 	virtual void update(void); // Hook method called asynchronously when the visual state of the extractor changes
+	Statistics getStatistics(void) const; // Returns a snapshot of the seed request statistics; must be called from the main thread
+	void printStatistics(std::ostream& os) const; // Prints a summary of the seed request statistics to the given stream
 	};
 
 #endif
@@ -33,17 +33,24 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <GLMotif/WidgetStateHelper.h>
 #include <Vrui/Vrui.h>
 
+#include <stdexcept>
+#include <iostream>
+
 #include <Abstract/Parameters.h>
 #include <Abstract/ConfigurationFileParametersSink.h>
+#include <Abstract/MemoryParametersSource.h>
 #include <Abstract/DataSetRenderer.h>
 #include <Abstract/Algorithm.h>
 #include <Abstract/Element.h>
+#include <Abstract/Module.h>
+#include <Templatized/Profiler.h>
 
 #ifdef VISUALIZER_USE_COLLABORATION
 #include "SharedVisualizationClient.h"
 #endif
 
 #include "Visualizer.h"
+#include "CuttingPlane.h"
 #include "ElementList.h"
 
 /*********************************
@@ -78,8 +85,26 @@ void ExtractorLocator::busyFunction(float newCompletionPercentage)
 	Vrui::requestUpdate();
 	}
 
+void ExtractorLocator::updateClipPlanes(void)
+	{
+	if(!application->clipAwareExtraction)
+		return;
+	
+	/* Collect the currently active cutting planes: */
+	Algorithm::ClipPlaneList clipPlanes;
+	for(size_t i=0;i<application->numCuttingPlanes;++i)
+		if(application->cuttingPlanes[i].active)
+			{
+			const CuttingPlane::Plane& plane=application->cuttingPlanes[i].plane;
+			clipPlanes.push_back(Algorithm::ClipPlane(Algorithm::ClipPlane::Vector(plane.getNormal()),Algorithm::ClipPlane::Scalar(plane.getOffset())));
+			}
+	
+	/* Hand the planes to the algorithm for the next extracted element: */
+	extractor->setClipPlanes(clipPlanes);
+	}
+
 ExtractorLocator::ExtractorLocator(Vrui::LocatorTool* sLocatorTool,Visualizer* sApplication,Extractor::Algorithm* sExtractor,const Misc::ConfigurationFileSection* cfg)
-	:BaseLocator(sLocatorTool,sApplication),Extractor(sExtractor),
+	:BaseLocator(sLocatorTool,sApplication),Extractor(sExtractor,sApplication->extractionScheduler),
 	 settingsDialog(extractor->createSettingsDialog(Vrui::getWidgetManager())),
 	 busyDialog(createBusyDialog(extractor->getName())),
 	 locator(application->dataSet->getLocator()),
@@ -121,6 +146,14 @@ ExtractorLocator::~ExtractorLocator(void)
 		}
 	#endif
 	
+	/* Dump the seed request statistics of interactive extractors: */
+	if(Vrui::isMaster()&&extractor->hasSeededCreator()&&extractor->hasIncrementalCreator()&&getStatistics().numRequests>0)
+		printStatistics(std::cout);
+	
+	/* Dump the culling statistics of clip-aware extractors: */
+	if(Vrui::isMaster()&&extractor->getClipStatistics().numElements>0)
+		extractor->printClipStatistics(std::cout);
+	
 	/* Delete the locator: */
 	delete locator;
 	
@@ -158,6 +191,8 @@ void ExtractorLocator::getName(std::string& name) const
 void ExtractorLocator::motionCallback(Vrui::LocatorTool::MotionCallbackData* cbData)
 	{
 	/* Update the locator: */
+	static const unsigned int locateProbe=Visualization::Templatized::Profiler::registerTimer("Extractor locator update",Visualization::Templatized::Profiler::LOCATOR);
+	Visualization::Templatized::Profiler::Scope locateScope(locateProbe);
 	bool positionChanged=locator->setPosition(cbData->currentTransformation.getOrigin());
 	positionChanged=locator->setOrientation(cbData->currentTransformation.getRotation())||positionChanged;
 	
@@ -173,6 +208,7 @@ void ExtractorLocator::motionCallback(Vrui::LocatorTool::MotionCallbackData* cbD
 			/* Get extraction parameters for the current locator state from the extractor: */
 			if(extractor->hasSeededCreator())
 				extractor->setSeedLocator(locator);
+			updateClipPlanes();
 			
 			#ifdef VISUALIZER_USE_COLLABORATION
 			if(application->sharedVisualizationClient!=0)
@@ -194,6 +230,14 @@ void ExtractorLocator::motionCallback(Vrui::LocatorTool::MotionCallbackData* cbD
 		/* Add the new element to visualizer's element list: */
 		application->elementList->addElement(newElement.getPointer(),extractor->getName());
 		
+		#ifdef VISUALIZER_USE_COLLABORATION
+		if(application->sharedVisualizationClient!=0&&Vrui::isMaster())
+			{
+			/* Send the new element's geometry to other clients: */
+			application->sharedVisualizationClient->postElement(this,newElement.getPointer());
+			}
+		#endif
+		
 		/* Pop down the busy dialog: */
 		if(!(extractor->hasSeededCreator()&&extractor->hasIncrementalCreator())&&busyDialog!=0)
 			Vrui::popdownPrimaryWidget(busyDialog);
@@ -234,6 +278,7 @@ void ExtractorLocator::buttonPressCallback(Vrui::LocatorTool::ButtonPressCallbac
 			/* Get extraction parameters for the current locator state from the extractor: */
 			if(extractor->hasSeededCreator())
 				extractor->setSeedLocator(locator);
+			updateClipPlanes();
 			
 			#ifdef VISUALIZER_USE_COLLABORATION
 			if(application->sharedVisualizationClient!=0)
@@ -311,6 +356,62 @@ void ExtractorLocator::renderLocatorTransparent(GLRenderState& renderState) cons
 	glRenderAction(renderState,true);
 	}
 
+void ExtractorLocator::prepareDataSetChange(void)
+	{
+	/* Stop the extraction thread before the algorithm's data set goes away: */
+	suspend();
+	
+	/* Save the algorithm's current parameters: */
+	savedParameters.clear();
+	Visualization::Abstract::MemoryParametersSink sink(application->variableManager,savedParameters);
+	Visualization::Abstract::Parameters* parameters=extractor->cloneParameters();
+	parameters->write(sink);
+	delete parameters;
+	}
+
+void ExtractorLocator::dataSetChanged(void)
+	{
+	/* Create a new algorithm of the same type for the new data set: */
+	Algorithm* newExtractor=application->module->getAlgorithm(extractor->getName(),application->variableManager,Vrui::openPipe());
+	try
+		{
+		/* Restore the saved parameters: */
+		Visualization::Abstract::MemoryParametersSource source(application->variableManager,savedParameters);
+		newExtractor->readParameters(source);
+		}
+	catch(std::runtime_error err)
+		{
+		std::cerr<<"Resetting "<<extractor->getName()<<" parameters due to exception "<<err.what()<<std::endl;
+		}
+	savedParameters.clear();
+	newExtractor->setBusyFunction(Misc::createFunctionCall(this,&ExtractorLocator::busyFunction));
+	
+	/* Replace the old algorithm's settings dialog at the same position: */
+	if(settingsDialog!=0)
+		{
+		GLMotif::WidgetManager* wm=Vrui::getWidgetManager();
+		bool visible=wm->isVisible(settingsDialog);
+		GLMotif::WidgetManager::Transformation transform=wm->calcWidgetTransformation(settingsDialog);
+		delete settingsDialog;
+		settingsDialog=newExtractor->createSettingsDialog(wm);
+		if(settingsDialog!=0&&visible)
+			wm->popupPrimaryWidget(settingsDialog,transform);
+		}
+	
+	/* Restart extraction with the new algorithm: */
+	setExtractor(newExtractor);
+	
+	/* Any pending extraction was cancelled: */
+	if(busyDialog!=0)
+		Vrui::popdownPrimaryWidget(busyDialog);
+	
+	/* Replace the locator with one for the new data set: */
+	Vrui::Point position=locator->getPosition();
+	delete locator;
+	locator=application->dataSet->getLocator();
+	locator->setPosition(position);
+	}
+
 void ExtractorLocator::update(void)
 	{
 	Vrui::requestUpdate();
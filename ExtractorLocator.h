@@ -24,6 +24,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #define EXTRACTORLOCATOR_INCLUDED
 
 #include <Abstract/DataSet.h>
+#include <Abstract/MemoryParametersSink.h>
 
 #include "BaseLocator.h"
 #include "Extractor.h"
@@ -55,10 +56,12 @@ class ExtractorLocator:public BaseLocator,public Extractor
 	unsigned int lastSeedRequestID; // ID used to identify the last issued seed request
 	volatile float completionPercentage; // Completion percentage of long-running operations
 	volatile bool completionPercentageUpdated; // Flag if the completion percentage has been updated
+	Visualization::Abstract::MemoryParametersSink::ValueList savedParameters; // The algorithm's parameters while the data set is being replaced
 	
 	/* Private methods: */
 	GLMotif::PopupWindow* createBusyDialog(const char* algorithmName); // Creates the busy dialog
 	void busyFunction(float newCompletionPercentage); // Called during long-running operations
+	void updateClipPlanes(void); // Passes the currently active cutting planes to the algorithm if clip-aware extraction is enabled
 	
 	/* Constructors and destructors: */
 	public:
@@ -76,6 +79,8 @@ class ExtractorLocator:public BaseLocator,public Extractor
 	virtual void highlightLocator(GLRenderState& renderState) const;
 	virtual void renderLocator(GLRenderState& renderState) const;
 	virtual void renderLocatorTransparent(GLRenderState& renderState) const;
+	virtual void prepareDataSetChange(void);
+	virtual void dataSetChanged(void);
 	
 	/* Methods from Extractor: */
 	virtual void update(void);
@@ -63,6 +63,13 @@ void LICBrush::motionCallback(Vrui::LocatorTool::MotionCallbackData* cbData)
                 }
         }
 
+void LICBrush::dataSetChanged(void)
+	{
+	/* Replace the locator with one for the new data set: */
+	delete locator;
+	locator=application->dataSet->getLocator();
+	}
+
 void LICBrush::buttonPressCallback(Vrui::LocatorTool::ButtonPressCallbackData* cbData)
 	{
 	/* Create a new evaluation point and start dragging it: */
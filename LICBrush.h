@@ -62,6 +62,7 @@ class LICBrush:public BaseLocator
 	
 	/* Methods from class BaseLocater: */
 	virtual void highlightLocator(GLRenderState& renderState) const;
+	virtual void dataSetChanged(void);
 
         private:
         void updateMask(LICBrushMask* mask);
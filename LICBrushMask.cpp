@@ -12,18 +12,49 @@
  */
 
 #include "LICBrushMask.h"
+#include <string.h>
 #include <Math/Math.h>
 #include <iostream>
 
+namespace {
+
+const unsigned int defaultMaskSize[3]={64,64,64};
+
+}
+
+void LICBrushMask::markAllDirty()
+        {
+        int intSize[3];
+        for(int dim=0;dim<3;++dim)
+                intSize[dim]=int(mdataSize[dim]);
+        Threads::Mutex::Lock dirtyBoxLock(dirtyBoxMutex);
+        dirtyBoxes.reset(intSize,mVersion);
+        }
+
+void LICBrushMask::allocate(const unsigned int sDataSize[3])
+        {
+        /* Allocate and clear the mask: */
+        size_t numVoxels=size_t(sDataSize[0])*size_t(sDataSize[1])*size_t(sDataSize[2]);
+        delete[] mdata;
+        mdata = new Voxel[numVoxels*numChannels];
+        memset(mdata,0,numVoxels*numChannels*sizeof(Voxel));
+        for(int dim=0;dim<3;++dim)
+                mdataSize[dim] =sDataSize[dim];
+        painted = false;
+        
+        /* The entire mask has to be uploaded again: */
+        mVersion++;
+        markAllDirty();
+        }
+
 LICBrushMask::LICBrushMask()
+        :mdata(0),mVersion(0),cellSize(0),painted(false)
         {
         // default size texture is 64X64X64
-        mdata = new Voxel[64*64*64*4];
-        mVersion = 0;
+        allocate(defaultMaskSize);
         
         for(int dim=0;dim<3;++dim)
                 {
-                mdataSize[dim] =64;
                 mDomain.min[dim] = 0.0;
                 mDomain.max[dim] = 1.0;
 		cellSize+=Math::sqr((mDomain.max[dim]-mDomain.min[dim])/Scalar(mdataSize[dim]));
@@ -33,35 +64,23 @@ LICBrushMask::LICBrushMask()
         }
 
 LICBrushMask::LICBrushMask(const unsigned int sDataSize[3])
-        :mdata(new Voxel[sDataSize[0]*sDataSize[1]*sDataSize[2]*4]),
-        mVersion(0)
+        :mdata(0),mVersion(0),cellSize(0),painted(false)
         {
-        for(int dim=0;dim<3;++dim)
-                mdataSize[dim] =sDataSize[dim];
-        
-        }
-
-LICBrushMask::LICBrushMask(const LICBrushMask& orig) 
-        {
-        delete[] mdata;
+        allocate(sDataSize);
         }
 
 LICBrushMask::~LICBrushMask() 
         {
-        
+        delete[] mdata;
         }
 
 void LICBrushMask::resize(const unsigned int sDataSize[3], const Box& sDomain)
         {
-        delete mdata;
-        mdata = new Voxel[sDataSize[0]*sDataSize[1]*sDataSize[2]*4];
-        mVersion++;
+        allocate(sDataSize);
         mDomain = sDomain;
+        cellSize = 0;
         for(int dim=0;dim<3;++dim)
-                {
-                mdataSize[dim] =sDataSize[dim];
 		cellSize+=Math::sqr((mDomain.max[dim]-mDomain.min[dim])/Scalar(mdataSize[dim])); 
-                }
 	cellSize=Math::sqrt(cellSize);
         
         std::cout << "LIC Brush domain: " << std::endl;
@@ -72,24 +91,22 @@ void LICBrushMask::resize(const unsigned int sDataSize[3], const Box& sDomain)
 
 void LICBrushMask::semiSphereX()
         {
-        int size = mdataSize[0]*mdataSize[1]*mdataSize[2];
-        std::cout << "mask size: " << size << std::endl;
         for(unsigned int i=0; i<mdataSize[0]/2; i++)
                 for(unsigned int j=0; j<mdataSize[1]; j++)
                         for(unsigned int k=0; k<mdataSize[2]; k++)
                                 {
                                 long adr = (j+k*mdataSize[1])*mdataSize[0]+i;
-                                mdata[4*adr] = 1.0f;
-                                mdata[4*adr+1] = 1.0f;
-                                mdata[4*adr+2] = 1.0f;
-                                mdata[4*adr+3] = 1.0f;
+                                for(int c=0;c<numChannels;++c)
+                                        mdata[numChannels*adr+c] = Voxel(255);
                                 }
+        painted = true;
         mVersion++;
+        markAllDirty();
         }
 
-void LICBrushMask::updateMaskByBrush(Vrui::Point brushPos, Vrui::Scalar brushSize, Voxel value)
+void LICBrushMask::updateMaskByBrush(Vrui::Point brushPos, Vrui::Scalar brushSize, float value)
         {
-        std::cout << "update with brush at: "<<brushPos[0]<<" "<<brushPos[1]<<" "<<brushPos[2]<<" with value: "<<value<< std::endl;
+        Voxel voxelValue = Voxel(Math::floor(Math::clamp(value, 0.0f, 1.0f)*255.0f+0.5f));
         Geometry::Box<int,3> ranges_v, ranges_n;
         Scalar nBrushSize = 0.4*brushSize;
         for(int dim = 0; dim < 3; dim++)
@@ -102,23 +119,25 @@ void LICBrushMask::updateMaskByBrush(Vrui::Point brushPos, Vrui::Scalar brushSiz
                 ranges_v.max[dim] = Math::clamp<int>(ranges_v.max[dim], 0, mdataSize[dim]-1);
                 ranges_n.max[dim] = mdataSize[dim]*(brushPos[dim]+nBrushSize - mDomain.min[dim])/(mDomain.max[dim] - mDomain.min[dim]);
                 ranges_n.max[dim] = Math::clamp<int>(ranges_n.max[dim], 0, mdataSize[dim]-1);
-//                std::cout <<dim<< "range: " << int(ranges_v.min[dim]) << " " << int(ranges_v.max[dim])<<std::endl; 
                 }
-        for(int x = ranges_v.min[0]; x <= ranges_v.max[0]; x++)
+        for(int z = ranges_v.min[2]; z <= ranges_v.max[2]; z++)
             for(int y = ranges_v.min[1]; y <= ranges_v.max[1]; y++)
-                for(int z = ranges_v.min[2]; z <= ranges_v.max[2]; z++)
+                for(int x = ranges_v.min[0]; x <= ranges_v.max[0]; x++)
                         {
                         long adr = (y+z*mdataSize[1])*mdataSize[0]+x;
-                        mdata[4*adr] = value; //r is stored vector_field_mask
+                        mdata[numChannels*adr] = voxelValue; //r is stored vector_field_mask
                         if(x>=ranges_n.min[0] && x <= ranges_n.max[0] && 
                                 y>=ranges_n.min[1] && y <= ranges_n.max[1] &&
                                     z>=ranges_n.min[2] && z <= ranges_n.max[2])
-                                mdata[4*adr+1] = value;
-                        
-//                        mdata[4*adr+1] = value;
-//                        mdata[4*adr+2] = value;
-//                        mdata[4*adr+3] = value;
-//                        std::cout <<"mdata: "<<mdata[4*adr]<<" "<<mdata[4*adr+1]<<" "<<mdata[4*adr+2]<<" "<<mdata[4*adr+3]<<std::endl;
+                                mdata[numChannels*adr+1] = voxelValue;
                         }
+        painted = true;
         mVersion++;
+        
+        /* Remember the painted voxel range for partial texture updates: */
+        int dirtyMax[3];
+        for(int dim=0;dim<3;++dim)
+                dirtyMax[dim]=ranges_v.max[dim]+1;
+        Threads::Mutex::Lock dirtyBoxLock(dirtyBoxMutex);
+        dirtyBoxes.addBox(DirtyBoxSet::Box(ranges_v.min.getComponents(),dirtyMax),mVersion);
         }
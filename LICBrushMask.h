@@ -18,13 +18,19 @@
 #include <GL/GLColor.h>
 #include <GL/GLColorMap.h>
 #include <Geometry/Box.h>
+#include <Threads/Mutex.h>
 
 #include <Vrui/Geometry.h>
 
+#include "DirtyBoxSet.h"
+
 class LICBrushMask
 {
+public:
+        typedef GLubyte Voxel; // Type for voxel data; each voxel has a vector field mask and a noise mask channel
+        static const int numChannels=2; // Number of channels per voxel, uploaded as luminance and alpha
+        
 private:
-        typedef GLfloat Voxel; // Type for voxel data  
         typedef float Scalar;
 	typedef Geometry::Box<Scalar,3> Box;
         Voxel* mdata;
@@ -32,11 +38,19 @@ private:
         unsigned int mdataSize[3];
         Scalar cellSize;
         Box mDomain;
+        DirtyBoxSet dirtyBoxes; // Regions of the mask changed since earlier versions
+        Threads::Mutex dirtyBoxMutex; // Serializes access to the dirty regions from concurrent rendering threads
+        bool painted; // Flag whether any part of the mask was set since it was last cleared
+        
+        void markAllDirty(); // Marks the entire mask as changed at the current version
+        void allocate(const unsigned int sDataSize[3]); // Allocates a cleared mask of the given size and marks it dirty
+
+        LICBrushMask(const LICBrushMask& orig); // Prohibit copy constructor
+        LICBrushMask& operator=(const LICBrushMask& orig); // Prohibit assignment operator
 
 public:
         LICBrushMask();
         LICBrushMask(const unsigned int sDataSize[3]);
-        LICBrushMask(const LICBrushMask& orig);
         virtual ~LICBrushMask();
         
         void resize(const unsigned int sDataSize[3], const Box& sDomain);
@@ -62,11 +76,27 @@ public:
         {
                 return mVersion;
         }
+        bool isPainted() const // Returns true if any part of the mask was set since it was last cleared
+        {
+                return painted;
+        }
+        const DirtyBoxSet& getDirtyBoxes() const // Returns the regions changed since earlier data versions
+        {
+                return dirtyBoxes;
+        }
+        DirtyBoxSet& getDirtyBoxes() // Ditto; used by renderers to flush consumed regions while holding the dirty region mutex
+        {
+                return dirtyBoxes;
+        }
+        Threads::Mutex& getDirtyBoxMutex() // Returns the mutex serializing access to the dirty regions
+        {
+                return dirtyBoxMutex;
+        }
         
         // Custom generate function
         void semiSphereX();
         
-        void updateMaskByBrush(Vrui::Point brushPos, Vrui::Scalar brushSize, Voxel value);
+        void updateMaskByBrush(Vrui::Point brushPos, Vrui::Scalar brushSize, float value);
         
 
 };
@@ -0,0 +1,438 @@
+/***********************************************************************
+LICConvolver - Class to compute 3D line integral convolution volumes from
+sampled vector fields on the CPU, using streamline-coherent convolution.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include "LICConvolver.h"
+
+#include <unistd.h>
+#include <algorithm>
+#include <Math/Math.h>
+
+#include "LICBrushMask.h"
+
+namespace {
+
+/****************
+Helper functions:
+****************/
+
+inline unsigned int hashLatticePoint(int x,int y,int z,unsigned int seed) // Returns a well-mixed hash value for the given noise lattice point
+	{
+	unsigned int h=(unsigned int)(x)*73856093U^(unsigned int)(y)*19349663U^(unsigned int)(z)*83492791U^seed*2654435761U;
+	h^=h>>16;
+	h*=0x85ebca6bU;
+	h^=h>>13;
+	h*=0xc2b2ae35U;
+	h^=h>>16;
+	return h;
+	}
+
+inline float latticeNoise(int x,int y,int z,unsigned int seed) // Returns a reproducible noise value in [0, 1) for the given lattice point
+	{
+	return float(hashLatticePoint(x,y,z,seed)>>8)*(1.0f/16777216.0f);
+	}
+
+}
+
+/*****************************
+Methods of class LICConvolver:
+*****************************/
+
+LICConvolver::Scalar LICConvolver::getNoise(const LICConvolver::Scalar pos[3]) const
+	{
+	/* Find the lattice cell containing the position: */
+	int i0[3];
+	Scalar w1[3];
+	for(int i=0;i<3;++i)
+		{
+		Scalar p=pos[i]*noiseScale;
+		Scalar fl=Math::floor(p);
+		i0[i]=int(fl);
+		w1[i]=p-fl;
+		}
+	
+	/* Interpolate the noise values at the cell's corners: */
+	Scalar result=Scalar(0);
+	for(int corner=0;corner<8;++corner)
+		{
+		Scalar weight=Scalar(1);
+		int c[3];
+		for(int i=0;i<3;++i)
+			{
+			if(corner&(1<<i))
+				{
+				c[i]=i0[i]+1;
+				weight*=w1[i];
+				}
+			else
+				{
+				c[i]=i0[i];
+				weight*=Scalar(1)-w1[i];
+				}
+			}
+		result+=latticeNoise(c[0],c[1],c[2],noiseSeed)*weight;
+		}
+	
+	return result;
+	}
+
+bool LICConvolver::getDirection(const LICConvolver::Scalar pos[3],LICConvolver::Scalar dir[3]) const
+	{
+	/* Find the voxel cell containing the position: */
+	int i0[3];
+	ptrdiff_t step[3];
+	Scalar w1[3];
+	const Scalar* base=vectors;
+	for(int i=0;i<3;++i)
+		{
+		if(pos[i]<Scalar(0)||pos[i]>Scalar(size[i]-1))
+			return false;
+		i0[i]=int(pos[i]);
+		if(i0[i]>int(size[i])-2)
+			i0[i]=int(size[i])-2;
+		if(i0[i]<0)
+			{
+			/* Degenerate dimension: */
+			i0[i]=0;
+			step[i]=0;
+			w1[i]=Scalar(0);
+			}
+		else
+			{
+			step[i]=vectorStrides[i];
+			w1[i]=pos[i]-Scalar(i0[i]);
+			}
+		base+=i0[i]*vectorStrides[i];
+		}
+	
+	/* Trilinearly interpolate the vector: */
+	Scalar v[3]={Scalar(0),Scalar(0),Scalar(0)};
+	for(int corner=0;corner<8;++corner)
+		{
+		Scalar weight=Scalar(1);
+		const Scalar* cPtr=base;
+		for(int i=0;i<3;++i)
+			{
+			if(corner&(1<<i))
+				{
+				cPtr+=step[i];
+				weight*=w1[i];
+				}
+			else
+				weight*=Scalar(1)-w1[i];
+			}
+		for(int i=0;i<3;++i)
+			v[i]+=cPtr[i]*weight;
+		}
+	
+	/* Convert the vector to voxel space and normalize it: */
+	Scalar len2=Scalar(0);
+	for(int i=0;i<3;++i)
+		{
+		dir[i]=v[i]/cellSize[i];
+		len2+=dir[i]*dir[i];
+		}
+	if(len2<Scalar(1.0e-20))
+		return false;
+	Scalar invLen=Scalar(1)/Math::sqrt(len2);
+	for(int i=0;i<3;++i)
+		dir[i]*=invLen;
+	
+	return true;
+	}
+
+bool LICConvolver::isMasked(const int voxel[3],int channel) const
+	{
+	if(mask==0)
+		return false;
+	
+	/* Map the voxel to the mask's grid: */
+	const unsigned int* maskSize=mask->getSize();
+	size_t index=0;
+	for(int i=2;i>=0;--i)
+		index=index*maskSize[i]+(size_t(voxel[i])*maskSize[i])/size[i];
+	
+	/* Use the same threshold as the LIC raycasting shader: */
+	return mask->getData()[index*LICBrushMask::numChannels+channel]<3;
+	}
+
+unsigned int LICConvolver::traceLine(const LICConvolver::Scalar seed[3],LICConvolver::Scalar direction,unsigned int maxNumSteps,std::vector<LICConvolver::Scalar>& positions) const
+	{
+	Scalar h=stepSize*direction;
+	Scalar p[3]={seed[0],seed[1],seed[2]};
+	unsigned int numSteps;
+	for(numSteps=0;numSteps<maxNumSteps;++numSteps)
+		{
+		/* Take a midpoint integration step: */
+		Scalar d[3],mid[3];
+		if(!getDirection(p,d))
+			break;
+		for(int i=0;i<3;++i)
+			mid[i]=p[i]+d[i]*h*Scalar(0.5);
+		if(!getDirection(mid,d))
+			break;
+		for(int i=0;i<3;++i)
+			p[i]+=d[i]*h;
+		
+		/* Stop at the domain boundary: */
+		bool inside=true;
+		for(int i=0;i<3;++i)
+			inside=inside&&p[i]>=Scalar(0)&&p[i]<=Scalar(size[i]-1);
+		if(!inside)
+			break;
+		
+		for(int i=0;i<3;++i)
+			positions.push_back(p[i]);
+		}
+	
+	return numSteps;
+	}
+
+void LICConvolver::convolveTile(unsigned int tileIndex,std::vector<LICConvolver::Scalar>& positions,std::vector<LICConvolver::Scalar>& sums)
+	{
+	/* Calculate the tile's voxel range: */
+	int tileMin[3],tileMax[3];
+	unsigned int t=tileIndex;
+	for(int i=0;i<3;++i)
+		{
+		tileMin[i]=int((t%numTiles[i])*tileSize);
+		tileMax[i]=tileMin[i]+int(tileSize);
+		if(tileMax[i]>int(size[i]))
+			tileMax[i]=int(size[i]);
+		t/=numTiles[i];
+		}
+	
+	unsigned int maxNumSteps=kernelHalfLength+lineExtension;
+	int seed[3];
+	for(seed[2]=tileMin[2];seed[2]<tileMax[2];++seed[2])
+		for(seed[1]=tileMin[1];seed[1]<tileMax[1];++seed[1])
+			for(seed[0]=tileMin[0];seed[0]<tileMax[0];++seed[0])
+				{
+				/* Skip masked voxels and voxels already covered by enough streamlines: */
+				size_t seedIndex=(size_t(seed[2])*size[1]+size_t(seed[1]))*size[0]+size_t(seed[0]);
+				if(hits[seedIndex]>=minHits||isMasked(seed,0))
+					continue;
+				
+				/* Trace a long streamline backward from the seed, then reverse it: */
+				positions.clear();
+				Scalar seedPos[3]={Scalar(seed[0]),Scalar(seed[1]),Scalar(seed[2])};
+				unsigned int numBackward=traceLine(seedPos,Scalar(-1),maxNumSteps,positions);
+				for(unsigned int i=0,j=numBackward-1;numBackward>0&&i<j;++i,--j)
+					for(int k=0;k<3;++k)
+						std::swap(positions[i*3+k],positions[j*3+k]);
+				
+				/* Add the seed and trace forward: */
+				for(int i=0;i<3;++i)
+					positions.push_back(seedPos[i]);
+				unsigned int numForward=traceLine(seedPos,Scalar(1),maxNumSteps,positions);
+				unsigned int numPoints=numBackward+1+numForward;
+				
+				/* Calculate prefix sums of the noise along the streamline: */
+				sums.resize(numPoints+1);
+				sums[0]=Scalar(0);
+				for(unsigned int i=0;i<numPoints;++i)
+					{
+					const Scalar* p=&positions[i*3];
+					int voxel[3];
+					for(int j=0;j<3;++j)
+						voxel[j]=int(Math::floor(p[j]+Scalar(0.5)));
+					sums[i+1]=sums[i]+(isMasked(voxel,1)?Scalar(0):getNoise(p));
+					}
+				
+				/* Deposit box-filtered values for all points with complete kernels, and for the seed: */
+				for(unsigned int i=0;i<numPoints;++i)
+					{
+					bool complete=i>=kernelHalfLength&&i+kernelHalfLength<numPoints;
+					if(!complete&&i!=numBackward)
+						continue;
+					
+					/* Only deposit into this tile's voxels to avoid conflicts between threads: */
+					const Scalar* p=&positions[i*3];
+					int voxel[3];
+					bool inTile=true;
+					for(int j=0;j<3;++j)
+						{
+						voxel[j]=int(Math::floor(p[j]+Scalar(0.5)));
+						inTile=inTile&&voxel[j]>=tileMin[j]&&voxel[j]<tileMax[j];
+						}
+					if(!inTile||isMasked(voxel,0))
+						continue;
+					
+					unsigned int lo=i>=kernelHalfLength?i-kernelHalfLength:0;
+					unsigned int hi=i+kernelHalfLength<numPoints?i+kernelHalfLength:numPoints-1;
+					size_t index=(size_t(voxel[2])*size[1]+size_t(voxel[1]))*size[0]+size_t(voxel[0]);
+					accums[index]+=(sums[hi+1]-sums[lo])/Scalar(hi+1-lo);
+					++hits[index];
+					}
+				}
+	}
+
+void LICConvolver::convolveTiles(void)
+	{
+	std::vector<Scalar> positions;
+	std::vector<Scalar> sums;
+	unsigned int totalNumTiles=numTiles[0]*numTiles[1]*numTiles[2];
+	while(true)
+		{
+		/* Grab the next unprocessed tile: */
+		unsigned int tileIndex=__sync_fetch_and_add(&nextTile,1U);
+		if(tileIndex>=totalNumTiles)
+			break;
+		
+		convolveTile(tileIndex,positions,sums);
+		}
+	}
+
+LICConvolver::LICConvolver(const unsigned int sSize[3],const LICConvolver::Scalar* sVectors,const ptrdiff_t sVectorStrides[3])
+	:vectors(sVectors),
+	 mask(0),
+	 stepSize(0.5f),kernelHalfLength(16),lineExtension(32),minHits(2),
+	 noiseScale(1.0f),noiseSeed(0),
+	 tileSize(16),numThreads(0),
+	 accums(0),hits(0),nextTile(0)
+	{
+	for(int i=0;i<3;++i)
+		{
+		size[i]=sSize[i];
+		vectorStrides[i]=sVectorStrides[i];
+		cellSize[i]=Scalar(1);
+		numTiles[i]=0;
+		}
+	}
+
+void LICConvolver::setCellSize(const LICConvolver::Scalar newCellSize[3])
+	{
+	for(int i=0;i<3;++i)
+		cellSize[i]=newCellSize[i];
+	}
+
+void LICConvolver::setMask(LICBrushMask* newMask)
+	{
+	mask=newMask;
+	}
+
+void LICConvolver::setStepSize(LICConvolver::Scalar newStepSize)
+	{
+	stepSize=newStepSize;
+	}
+
+void LICConvolver::setKernelHalfLength(unsigned int newKernelHalfLength)
+	{
+	kernelHalfLength=newKernelHalfLength;
+	}
+
+void LICConvolver::setLineExtension(unsigned int newLineExtension)
+	{
+	lineExtension=newLineExtension;
+	}
+
+void LICConvolver::setMinHits(unsigned int newMinHits)
+	{
+	minHits=newMinHits>0?newMinHits:1;
+	}
+
+void LICConvolver::setNoise(LICConvolver::Scalar newNoiseScale,unsigned int newNoiseSeed)
+	{
+	noiseScale=newNoiseScale;
+	noiseSeed=newNoiseSeed;
+	}
+
+void LICConvolver::setTileSize(unsigned int newTileSize)
+	{
+	tileSize=newTileSize>0?newTileSize:1;
+	}
+
+void LICConvolver::setNumThreads(unsigned int newNumThreads)
+	{
+	numThreads=newNumThreads;
+	}
+
+void LICConvolver::convolve(LICConvolver::Scalar* result,const ptrdiff_t resultStrides[3])
+	{
+	/* Create the accumulation buffers: */
+	size_t numVoxels=size_t(size[0])*size_t(size[1])*size_t(size[2]);
+	accums=new Scalar[numVoxels];
+	hits=new unsigned int[numVoxels];
+	for(size_t i=0;i<numVoxels;++i)
+		{
+		accums[i]=Scalar(0);
+		hits[i]=0;
+		}
+	
+	/* Split the volume into tiles: */
+	unsigned int totalNumTiles=1;
+	for(int i=0;i<3;++i)
+		{
+		numTiles[i]=(size[i]+tileSize-1)/tileSize;
+		totalNumTiles*=numTiles[i];
+		}
+	nextTile=0;
+	
+	/* Determine the number of threads to use: */
+	unsigned int numWorkers=numThreads;
+	if(numWorkers==0)
+		{
+		long numCpus=sysconf(_SC_NPROCESSORS_ONLN);
+		numWorkers=numCpus>1?(unsigned int)(numCpus):1U;
+		}
+	if(numWorkers>totalNumTiles)
+		numWorkers=totalNumTiles;
+	if(numWorkers<1)
+		numWorkers=1;
+	
+	/* Start worker threads and process tiles in the calling thread as well: */
+	Worker* workers=new Worker[numWorkers];
+	for(unsigned int i=1;i<numWorkers;++i)
+		{
+		workers[i].convolver=this;
+		workers[i].thread.start(&workers[i],&Worker::workerThreadMethod);
+		}
+	convolveTiles();
+	for(unsigned int i=1;i<numWorkers;++i)
+		workers[i].thread.join();
+	delete[] workers;
+	
+	/* Average the deposited values and find their range: */
+	Scalar minValue=Scalar(1),maxValue=Scalar(0);
+	for(size_t i=0;i<numVoxels;++i)
+		if(hits[i]>0)
+			{
+			accums[i]/=Scalar(hits[i]);
+			if(minValue>accums[i])
+				minValue=accums[i];
+			if(maxValue<accums[i])
+				maxValue=accums[i];
+			}
+	
+	/* Stretch the convolved values to the full intensity range: */
+	Scalar scale=maxValue>minValue?Scalar(1)/(maxValue-minValue):Scalar(0);
+	size_t index=0;
+	for(unsigned int z=0;z<size[2];++z)
+		for(unsigned int y=0;y<size[1];++y)
+			for(unsigned int x=0;x<size[0];++x,++index)
+				result[x*resultStrides[0]+y*resultStrides[1]+z*resultStrides[2]]=hits[index]>0?(accums[index]-minValue)*scale:Scalar(0);
+	
+	/* Release the accumulation buffers: */
+	delete[] accums;
+	accums=0;
+	delete[] hits;
+	hits=0;
+	}
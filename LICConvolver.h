@@ -0,0 +1,105 @@
+/***********************************************************************
+LICConvolver - Class to compute 3D line integral convolution volumes from
+sampled vector fields on the CPU, using streamline-coherent convolution.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef LICCONVOLVER_INCLUDED
+#define LICCONVOLVER_INCLUDED
+
+#include <stddef.h>
+#include <vector>
+#include <Threads/Thread.h>
+
+/* Forward declarations: */
+class LICBrushMask;
+
+class LICConvolver
+	{
+	/* Embedded classes: */
+	public:
+	typedef float Scalar; // Scalar type for vector components and convolution results
+	
+	private:
+	struct Worker // Structure holding the state of a convolution thread
+		{
+		/* Elements: */
+		public:
+		LICConvolver* convolver; // Pointer to the convolver
+		Threads::Thread thread; // The worker thread
+		
+		/* Methods: */
+		void* workerThreadMethod(void)
+			{
+			convolver->convolveTiles();
+			return 0;
+			}
+		};
+	
+	/* Elements: */
+	unsigned int size[3]; // Number of voxels in the vector volume in x, y, z
+	const Scalar* vectors; // Pointer to the first component of the first voxel of the vector volume
+	ptrdiff_t vectorStrides[3]; // Strides of the vector volume in x, y, z, in units of Scalar
+	Scalar cellSize[3]; // Distance between adjacent voxels in x, y, z in domain coordinates
+	LICBrushMask* mask; // Optional brush mask limiting the convolution to painted regions
+	Scalar stepSize; // Streamline integration step size in voxels
+	unsigned int kernelHalfLength; // Number of integration steps covered by each half of the box filter kernel
+	unsigned int lineExtension; // Number of additional steps traced beyond the kernel in either direction to reuse along each streamline
+	unsigned int minHits; // Minimum number of streamlines that must contribute to a voxel before it stops seeding new streamlines
+	Scalar noiseScale; // Number of noise lattice cells per voxel
+	unsigned int noiseSeed; // Seed value to generate reproducible noise
+	unsigned int tileSize; // Edge length of cubic tiles processed by one thread at a time
+	unsigned int numThreads; // Number of threads to use; 0 uses all CPUs
+	
+	/* Transient convolution state: */
+	Scalar* accums; // Sums of convolution values deposited into each voxel
+	unsigned int* hits; // Number of convolution values deposited into each voxel
+	unsigned int numTiles[3]; // Number of tiles in x, y, z
+	volatile unsigned int nextTile; // Index of the next tile to be processed
+	
+	/* Private methods: */
+	bool getDirection(const Scalar pos[3],Scalar dir[3]) const; // Returns the normalized flow direction in voxel coordinates at the given position; returns false outside the domain or at critical points
+	bool isMasked(const int voxel[3],int channel) const; // Returns true if the given voxel is excluded by the given mask channel
+	unsigned int traceLine(const Scalar seed[3],Scalar direction,unsigned int maxNumSteps,std::vector<Scalar>& positions) const; // Appends positions along a streamline from the seed in the given direction; returns number of appended positions
+	void convolveTile(unsigned int tileIndex,std::vector<Scalar>& positions,std::vector<Scalar>& sums); // Seeds streamlines inside the given tile until all its voxels received enough hits
+	void convolveTiles(void); // Processes tiles until none are left
+	
+	/* Constructors and destructors: */
+	public:
+	LICConvolver(const unsigned int sSize[3],const Scalar* sVectors,const ptrdiff_t sVectorStrides[3]); // Creates a convolver for an interleaved three-component vector volume
+	private:
+	LICConvolver(const LICConvolver& source); // Prohibit copy constructor
+	LICConvolver& operator=(const LICConvolver& source); // Prohibit assignment operator
+	
+	/* Methods: */
+	public:
+	void setCellSize(const Scalar newCellSize[3]); // Sets the domain-space distance between adjacent voxels
+	void setMask(LICBrushMask* newMask); // Limits convolution to regions painted into the given mask; null disables masking
+	void setStepSize(Scalar newStepSize); // Sets the integration step size in voxels
+	void setKernelHalfLength(unsigned int newKernelHalfLength); // Sets the half length of the box filter kernel in integration steps
+	void setLineExtension(unsigned int newLineExtension); // Sets the number of extra steps traced on either side to reuse each streamline
+	void setMinHits(unsigned int newMinHits); // Sets the number of contributing streamlines after which voxels stop seeding
+	void setNoise(Scalar newNoiseScale,unsigned int newNoiseSeed); // Sets the noise lattice resolution and seed
+	void setTileSize(unsigned int newTileSize); // Sets the edge length of tiles processed by one thread at a time
+	void setNumThreads(unsigned int newNumThreads); // Sets the number of threads; 0 uses all CPUs
+	Scalar getNoise(const Scalar pos[3]) const; // Returns the trilinearly interpolated noise value at the given position in voxel coordinates
+	void convolve(Scalar* result,const ptrdiff_t resultStrides[3]); // Writes the LIC intensity in [0, 1] of each voxel into the given scalar volume; masked voxels are set to zero
+	};
+
+#endif
@@ -23,6 +23,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <LICRaycaster.h>
 
 #include <string>
+#include <vector>
 #include <cstdio>
 #include <iostream>
 #include <GL/gl.h>
@@ -35,6 +36,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Images/RGBImage.h>
 #include <Images/ReadImageFile.h>
 #include <Math/Math.h>
+#include <Threads/Mutex.h>
+
+#include <Templatized/Profiler.h>
 
 /*************************************************
 Methods of class LICRaycaster::DataItem:
@@ -111,7 +115,7 @@ void LICRaycaster::initDataItem(Raycaster::DataItem* dataItem) const
 	glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_WRAP_S,GL_CLAMP);
 	glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_WRAP_T,GL_CLAMP);
 	glTexParameteri(GL_TEXTURE_3D,GL_TEXTURE_WRAP_R,GL_CLAMP);
-	glTexImage3DEXT(GL_TEXTURE_3D,0,GL_RGBA16F_ARB,mask->getSize(0),mask->getSize(1),mask->getSize(2),0,GL_RGBA,GL_FLOAT,mask->getData());
+	uploadMask(myDataItem,true);
 	glBindTexture(GL_TEXTURE_3D,0);
         
         /* Create the noise data texture: */
@@ -205,6 +209,8 @@ void LICRaycaster::bindShader(const Raycaster::PTransform& pmv,const Raycaster::
 	if(myDataItem->volumeTextureVersion!=dataVersion)
 		{
 		/* Upload the new volume data: */
+		static const unsigned int uploadProbe=Visualization::Templatized::Profiler::registerTimer("Raycaster volume upload",Visualization::Templatized::Profiler::UPLOAD);
+		Visualization::Templatized::Profiler::Scope uploadScope(uploadProbe);
                 // padding data
                 float* pData = paddingData(dataSize, data);
 		glTexSubImage3DEXT(GL_TEXTURE_3D,0,0,0,0,dataSize[0],dataSize[1],dataSize[2],GL_RGBA,GL_FLOAT,pData);
@@ -220,14 +226,11 @@ void LICRaycaster::bindShader(const Raycaster::PTransform& pmv,const Raycaster::
 	glBindTexture(GL_TEXTURE_3D,myDataItem->maskTextureID);
 	glUniform1iARB(myDataItem->maskSamplerLoc,2);
 	
-	/* Check if the volume texture needs to be updated: */
+	/* Check if the mask texture needs to be updated: */
 	if(mask->getDataVersion()!=myDataItem->maskTextureVersion)
 		{
-		/* Upload the new mask data: */
-		glTexSubImage3DEXT(GL_TEXTURE_3D,0,0,0,0,mask->getSize(0),mask->getSize(1),mask->getSize(2),GL_RGBA,GL_FLOAT,mask->getData());
-		std::cout << "update mask data over." <<std::endl;
-		/* Mark the mask texture as up-to-date: */
-		myDataItem->maskTextureVersion=mask->getDataVersion();
+		Threads::Mutex::Lock maskLock(mask->getDirtyBoxMutex());
+		uploadMask(myDataItem,mask->getDirtyBoxes().needsFullUpdate(myDataItem->maskTextureVersion));
 		}
         
         /* Bind the noise and kernel textures: */
@@ -278,6 +281,47 @@ void LICRaycaster::unbindShader(Raycaster::DataItem* dataItem) const
 	Raycaster::unbindShader(dataItem);
 	}
 
+void LICRaycaster::uploadMask(DataItem* dataItem,bool full) const
+	{
+	/* Mask rows are tightly packed two-byte voxels: */
+	glPixelStorei(GL_UNPACK_ALIGNMENT,1);
+	
+	if(full)
+		{
+		/* Re-create the mask texture, in case the mask was resized: */
+		glTexImage3DEXT(GL_TEXTURE_3D,0,GL_LUMINANCE8_ALPHA8,mask->getSize(0),mask->getSize(1),mask->getSize(2),0,GL_LUMINANCE_ALPHA,GL_UNSIGNED_BYTE,mask->getData());
+		}
+	else
+		{
+		/* Upload only the mask regions changed since the texture's version: */
+		std::vector<DirtyBoxSet::Box> boxes;
+		mask->getDirtyBoxes().getBoxes(dataItem->maskTextureVersion,boxes);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH,mask->getSize(0));
+		glPixelStorei(GL_UNPACK_IMAGE_HEIGHT,mask->getSize(1));
+		for(std::vector<DirtyBoxSet::Box>::iterator bIt=boxes.begin();bIt!=boxes.end();++bIt)
+			{
+			glPixelStorei(GL_UNPACK_SKIP_PIXELS,bIt->min[0]);
+			glPixelStorei(GL_UNPACK_SKIP_ROWS,bIt->min[1]);
+			glPixelStorei(GL_UNPACK_SKIP_IMAGES,bIt->min[2]);
+			glTexSubImage3DEXT(GL_TEXTURE_3D,0,bIt->min[0],bIt->min[1],bIt->min[2],bIt->max[0]-bIt->min[0],bIt->max[1]-bIt->min[1],bIt->max[2]-bIt->min[2],GL_LUMINANCE_ALPHA,GL_UNSIGNED_BYTE,mask->getData());
+			}
+		
+		/* Reset the pixel unpacking state: */
+		glPixelStorei(GL_UNPACK_ROW_LENGTH,0);
+		glPixelStorei(GL_UNPACK_IMAGE_HEIGHT,0);
+		glPixelStorei(GL_UNPACK_SKIP_PIXELS,0);
+		glPixelStorei(GL_UNPACK_SKIP_ROWS,0);
+		glPixelStorei(GL_UNPACK_SKIP_IMAGES,0);
+		}
+	glPixelStorei(GL_UNPACK_ALIGNMENT,4);
+	
+	/* Mark the mask texture as up-to-date: */
+	dataItem->maskTextureVersion=mask->getDataVersion();
+	
+	/* Let the mask drop the regions all of this raycaster's textures have consumed: */
+	mask->getDirtyBoxes().flushClient(this,dataItem,dataItem->maskTextureVersion);
+	}
+
 bool LICRaycaster::loadNoiseTexture()
         {
         std::string noiseTextureName=VISUALIZER_SHAREDIR;
@@ -382,7 +426,7 @@ float* LICRaycaster::paddingData(const unsigned int dataSize[3], Voxel* data) co
 LICRaycaster::LICRaycaster(const unsigned int sDataSize[3],const Raycaster::Box& sDomain)
 	:Raycaster(sDataSize,sDomain),
 	 data(new Voxel[dataSize[0]*dataSize[1]*dataSize[2]*3]),dataVersion(0),
-         nData(NULL)
+         nData(NULL),mask(0)
 	{
 	/* Multiply the data stride values with the number of channels: */
 	for(int dim=0;dim<3;++dim)
@@ -406,6 +450,13 @@ LICRaycaster::~LICRaycaster(void)
 	/* Delete the volume dataset: */
 	delete[] data;
         delete[] nData;
+	
+	/* Stop holding back the mask's dirty regions for this raycaster's textures: */
+	if(mask!=0)
+		{
+		Threads::Mutex::Lock maskLock(mask->getDirtyBoxMutex());
+		mask->getDirtyBoxes().removeClients(this);
+		}
 	}
 
 void LICRaycaster::initContext(GLContextData& contextData) const
@@ -464,6 +515,11 @@ void LICRaycaster::setTransparencyGamma(GLfloat newTransparencyGamma)
 	}
 void LICRaycaster::setLICMask(LICBrushMask* sMask)
         {
+        if(mask!=0&&mask!=sMask)
+                {
+                Threads::Mutex::Lock maskLock(mask->getDirtyBoxMutex());
+                mask->getDirtyBoxes().removeClients(this);
+                }
         mask = sMask;
         mask->resize(dataSize, domain);
 //        mask->semiSphereX();
@@ -42,8 +42,8 @@ class LICRaycaster:public Raycaster
 		public:
 		bool haveFloatTextures; // Flag whether the local OpenGL supports floating-point textures
 		
-                GLuint maskTextureID;
-                unsigned int maskTextureVersion;
+                GLuint maskTextureID; // Texture object ID for the brush mask texture
+                unsigned int maskTextureVersion; // Version number of the brush mask texture
                 GLuint noiseTextureID; // Texture object ID for noise data texture
                 GLuint kernalTextureID; // Texture object ID for kernel texture
 		GLuint volumeTextureID; // Texture object ID for volume data texture
@@ -88,6 +88,7 @@ class LICRaycaster:public Raycaster
 	virtual void unbindShader(Raycaster::DataItem* dataItem) const;
         
         void loadKernelFunction(DataItem* dataItem) const;
+        void uploadMask(DataItem* dataItem,bool full) const; // Uploads the entire mask or its regions changed since the data item's mask version into the bound mask texture
         bool loadNoiseTexture();
         
         float* paddingData(const unsigned int dataSize[3], Voxel* data) const;
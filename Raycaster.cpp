@@ -39,6 +39,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Vrui/VRWindow.h>
 #include <Vrui/DisplayState.h>
 
+#include <Templatized/Profiler.h>
+
 /************************************
 Methods of class Raycaster::DataItem:
 ************************************/
@@ -296,6 +298,9 @@ void Raycaster::glRenderAction(GLContextData& contextData) const
 	if(!dataItem->shader.isValid())
 		return;
 	
+	static const unsigned int renderProbe=Visualization::Templatized::Profiler::registerTimer("Raycaster rendering",Visualization::Templatized::Profiler::RENDERING);
+	Visualization::Templatized::Profiler::Scope renderScope(renderProbe);
+	
 	/* Save OpenGL state: */
 	glPushAttrib(GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT|GL_ENABLE_BIT|GL_LIGHTING_BIT|GL_POLYGON_BIT);
 	
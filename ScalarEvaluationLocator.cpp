@@ -36,6 +36,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Abstract/DataSet.h>
 #include <Abstract/VariableManager.h>
+#include <Templatized/Profiler.h>
 
 #include "Visualizer.h"
 
@@ -45,7 +46,7 @@ Methods of class ScalarEvaluationLocator:
 
 ScalarEvaluationLocator::ScalarEvaluationLocator(Vrui::LocatorTool* sLocatorTool,Visualizer* sApplication,const Misc::ConfigurationFileSection* cfg)
 	:EvaluationLocator(sLocatorTool,sApplication,""),
-	 scalarExtractor(0),
+	 scalarExtractor(0),scalarVariableIndex(-1),
 	 valueValid(false)
 	{
 	Visualization::Abstract::VariableManager* vm=application->variableManager;
@@ -137,6 +138,8 @@ void ScalarEvaluationLocator::motionCallback(Vrui::LocatorTool::MotionCallbackDa
 		if(locator->isValid())
 			{
 			valueValid=true;
+			static const unsigned int evaluateProbe=Visualization::Templatized::Profiler::registerTimer("Scalar evaluation",Visualization::Templatized::Profiler::LOCATOR);
+			Visualization::Templatized::Profiler::Scope evaluateScope(evaluateProbe);
 			currentValue=locator->calcScalar(scalarExtractor);
 			value->setValue(currentValue);
 			}
@@ -148,6 +151,23 @@ void ScalarEvaluationLocator::motionCallback(Vrui::LocatorTool::MotionCallbackDa
 		}
 	}
 
+void ScalarEvaluationLocator::prepareDataSetChange(void)
+	{
+	/* Remember the evaluated scalar variable before its extractor goes away: */
+	scalarVariableIndex=application->variableManager->getScalarVariable(scalarExtractor);
+	}
+
+void ScalarEvaluationLocator::dataSetChanged(void)
+	{
+	/* Call the base class method: */
+	EvaluationLocator::dataSetChanged();
+	
+	/* Get the extractor for the evaluated scalar variable from the new data set: */
+	scalarExtractor=application->variableManager->getScalarExtractor(scalarVariableIndex);
+	valueValid=false;
+	value->setString("");
+	}
+
 void ScalarEvaluationLocator::insertControlPointCallback(Misc::CallbackData* cbData)
 	{
 	/* Insert a new control point into the color map: */
@@ -45,6 +45,7 @@ class ScalarEvaluationLocator:public EvaluationLocator
 	
 	/* Elements: */
 	const ScalarExtractor* scalarExtractor; // Extractor for the evaluated scalar value
+	int scalarVariableIndex; // Index of the evaluated scalar variable while the data set is being replaced
 	GLMotif::TextField* value; // The value text field
 	bool valueValid; // Flag if the evaluation value is valid
 	Scalar currentValue; // The current evaluation value
@@ -58,6 +59,10 @@ class ScalarEvaluationLocator:public EvaluationLocator
 	virtual void storeState(Misc::ConfigurationFileSection& configFileSection) const;
 	virtual void motionCallback(Vrui::LocatorTool::MotionCallbackData* cbData);
 	
+	/* Methods from class BaseLocator: */
+	virtual void prepareDataSetChange(void);
+	virtual void dataSetChanged(void);
+	
 	/* New methods: */
 	void insertControlPointCallback(Misc::CallbackData* cbData);
 	};
@@ -0,0 +1,389 @@
+/***********************************************************************
+ScalarProbeLocator - Class for locators sampling scalar properties of
+data sets along line segments or on plane grids at interactive rates.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include "ScalarProbeLocator.h"
+
+#include <stdio.h>
+#include <math.h>
+#include <stdexcept>
+#include <iostream>
+#include <Misc/StandardValueCoders.h>
+#include <Misc/ConfigurationFile.h>
+#include <Misc/CreateNumberedFileName.h>
+#include <Math/Math.h>
+#include <Geometry/Vector.h>
+#include <Geometry/OrthogonalTransformation.h>
+#include <GL/gl.h>
+#include <GL/GLVertexTemplates.h>
+#include <GL/GLColorTemplates.h>
+#include <GL/GLColorMap.h>
+#include <GL/GLGeometryWrappers.h>
+#include <GLMotif/StyleSheet.h>
+#include <GLMotif/WidgetManager.h>
+#include <GLMotif/PopupWindow.h>
+#include <GLMotif/Label.h>
+#include <GLMotif/Button.h>
+#include <GLMotif/TextField.h>
+#include <GLMotif/RowColumn.h>
+#include <GLMotif/WidgetStateHelper.h>
+#include <Vrui/Vrui.h>
+
+#include <Abstract/DataSet.h>
+#include <Abstract/VariableManager.h>
+#include <Abstract/CoordinateTransformer.h>
+#include <Templatized/Profiler.h>
+
+#include "GLRenderState.h"
+#include "Visualizer.h"
+
+/***********************************
+Methods of class ScalarProbeLocator:
+***********************************/
+
+void ScalarProbeLocator::updateProbe(void)
+	{
+	/* Place the samples between the start point and the current locator position: */
+	ProbePoint endPoint=locator->getPosition();
+	EvaluationProbe::Vector axis0=endPoint-startPoint;
+	if(planeMode)
+		{
+		/* Span a square plane grid centered on the segment, orthogonal to the tool's pointing direction: */
+		EvaluationProbe::Vector toolDirection=locator->getOrientation().transform(EvaluationProbe::Vector(0,1,0));
+		EvaluationProbe::Vector axis1=Geometry::cross(toolDirection,axis0);
+		EvaluationProbe::Scalar axis1Length=Geometry::mag(axis1);
+		if(axis1Length==EvaluationProbe::Scalar(0))
+			{
+			clearProbe();
+			return;
+			}
+		axis1*=Geometry::mag(axis0)/axis1Length;
+		size_t numAxisSamples=size_t(Math::floor(Math::sqrt(double(numSamples))));
+		probe.setPlaneGrid(startPoint-axis1*EvaluationProbe::Scalar(0.5),axis0,axis1,numAxisSamples,numAxisSamples);
+		}
+	else
+		probe.setLine(startPoint,endPoint,numSamples);
+	
+	/* Evaluate all samples: */
+		{
+		static const unsigned int probeProbe=Visualization::Templatized::Profiler::registerTimer("Scalar probe evaluation",Visualization::Templatized::Profiler::LOCATOR);
+		Visualization::Templatized::Profiler::Scope probeScope(probeProbe);
+		probe.evaluateScalars(locator,scalarExtractor);
+		}
+	hasProbe=true;
+	
+	/* Update the probe display: */
+	char numValidBuffer[64];
+	snprintf(numValidBuffer,sizeof(numValidBuffer),"%lu / %lu",(unsigned long)probe.getNumValidSamples(),(unsigned long)probe.getNumSamples());
+	numValidField->setString(numValidBuffer);
+	if(probe.getNumValidSamples()>0)
+		{
+		const EvaluationProbe::VScalar* values=probe.getScalarValues();
+		Scalar range[2];
+		bool first=true;
+		for(size_t i=0;i<probe.getNumSamples();++i)
+			if(!isnan(values[i]))
+				{
+				if(first||range[0]>values[i])
+					range[0]=values[i];
+				if(first||range[1]<values[i])
+					range[1]=values[i];
+				first=false;
+				}
+		for(int i=0;i<2;++i)
+			rangeFields[i]->setValue(range[i]);
+		}
+	else
+		{
+		for(int i=0;i<2;++i)
+			rangeFields[i]->setString("");
+		}
+	evaluationTimeField->setValue(probe.getEvaluationTime()*1000.0);
+	}
+
+void ScalarProbeLocator::clearProbe(void)
+	{
+	hasProbe=false;
+	numValidField->setString("");
+	for(int i=0;i<2;++i)
+		rangeFields[i]->setString("");
+	evaluationTimeField->setString("");
+	}
+
+ScalarProbeLocator::ScalarProbeLocator(Vrui::LocatorTool* sLocatorTool,Visualizer* sApplication,const Misc::ConfigurationFileSection* cfg)
+	:EvaluationLocator(sLocatorTool,sApplication,""),
+	 scalarExtractor(0),scalarVariableIndex(-1),
+	 colorMap(0),
+	 planeMode(false),numSamples(1000),
+	 hasProbe(false)
+	{
+	Visualization::Abstract::VariableManager* vm=application->variableManager;
+	
+	/* Get the scalar extractor and probe settings: */
+	if(cfg!=0)
+		{
+		/* Read the scalar variable from the configuration file: */
+		std::string scalarVariableName=vm->getScalarVariableName(vm->getCurrentScalarVariable());
+		scalarVariableName=cfg->retrieveValue<std::string>("./scalarVariableName",scalarVariableName);
+		scalarExtractor=vm->getScalarExtractor(vm->getScalarVariable(scalarVariableName.c_str()));
+		
+		/* Read the probe settings: */
+		planeMode=cfg->retrieveValue<std::string>("./samplingMode","Line")=="Plane";
+		numSamples=cfg->retrieveValue<unsigned int>("./numSamples",numSamples);
+		}
+	else
+		{
+		/* Get an extractor for the current scalar variable: */
+		scalarExtractor=vm->getCurrentScalarExtractor();
+		}
+	if(numSamples<4)
+		numSamples=4;
+	
+	/* Get the color map for the scalar extractor: */
+	colorMap=vm->getColorMap(vm->getScalarVariable(scalarExtractor));
+	
+	/* Get the style sheet: */
+	const GLMotif::StyleSheet* ss=Vrui::getWidgetManager()->getStyleSheet();
+	
+	/* Set the dialog's title string: */
+	std::string title="Probe Scalars -- ";
+	title.append(vm->getScalarVariableName(vm->getScalarVariable(scalarExtractor)));
+	evaluationDialogPopup->setTitleString(title.c_str());
+	
+	/* Add to the evaluation dialog: */
+	new GLMotif::Label("SamplingModeLabel",evaluationDialog,"Sampling");
+	
+	GLMotif::RadioBox* samplingModeBox=new GLMotif::RadioBox("SamplingModeBox",evaluationDialog,false);
+	samplingModeBox->setOrientation(GLMotif::RowColumn::HORIZONTAL);
+	samplingModeBox->setPacking(GLMotif::RowColumn::PACK_GRID);
+	samplingModeBox->setSelectionMode(GLMotif::RadioBox::ALWAYS_ONE);
+	samplingModeBox->addToggle("Line");
+	samplingModeBox->addToggle("Plane");
+	samplingModeBox->setSelectedToggle(planeMode?1:0);
+	samplingModeBox->getValueChangedCallbacks().add(this,&ScalarProbeLocator::samplingModeCallback);
+	samplingModeBox->manageChild();
+	
+	new GLMotif::Label("NumSamplesLabel",evaluationDialog,"Samples");
+	
+	GLMotif::TextFieldSlider* numSamplesSlider=new GLMotif::TextFieldSlider("NumSamplesSlider",evaluationDialog,6,ss->fontHeight*10.0f);
+	numSamplesSlider->setSliderMapping(GLMotif::TextFieldSlider::LINEAR);
+	numSamplesSlider->setValueType(GLMotif::TextFieldSlider::INT);
+	numSamplesSlider->setValueRange(10,20000,10);
+	numSamplesSlider->setValue(numSamples);
+	numSamplesSlider->getValueChangedCallbacks().add(this,&ScalarProbeLocator::numSamplesCallback);
+	
+	new GLMotif::Label("NumValidLabel",evaluationDialog,"Inside");
+	
+	numValidField=new GLMotif::TextField("NumValidField",evaluationDialog,16);
+	
+	new GLMotif::Label("RangeLabel",evaluationDialog,vm->getScalarVariableName(vm->getScalarVariable(scalarExtractor)));
+	
+	GLMotif::RowColumn* rangeBox=new GLMotif::RowColumn("RangeBox",evaluationDialog,false);
+	rangeBox->setOrientation(GLMotif::RowColumn::HORIZONTAL);
+	rangeBox->setPacking(GLMotif::RowColumn::PACK_GRID);
+	
+	for(int i=0;i<2;++i)
+		{
+		char rangeFieldName[40];
+		snprintf(rangeFieldName,sizeof(rangeFieldName),"RangeField-%d",i+1);
+		rangeFields[i]=new GLMotif::TextField(rangeFieldName,rangeBox,12);
+		rangeFields[i]->setPrecision(6);
+		}
+	
+	rangeBox->manageChild();
+	
+	new GLMotif::Label("EvaluationTimeLabel",evaluationDialog,"Time (ms)");
+	
+	GLMotif::RowColumn* evaluationTimeBox=new GLMotif::RowColumn("EvaluationTimeBox",evaluationDialog,false);
+	evaluationTimeBox->setOrientation(GLMotif::RowColumn::HORIZONTAL);
+	evaluationTimeBox->setPacking(GLMotif::RowColumn::PACK_GRID);
+	
+	evaluationTimeField=new GLMotif::TextField("EvaluationTimeField",evaluationTimeBox,12);
+	evaluationTimeField->setPrecision(3);
+	
+	GLMotif::Button* saveProfileButton=new GLMotif::Button("SaveProfileButton",evaluationTimeBox,"Save Profile");
+	saveProfileButton->getSelectCallbacks().add(this,&ScalarProbeLocator::saveProfileCallback);
+	
+	evaluationTimeBox->manageChild();
+	
+	evaluationDialog->manageChild();
+	
+	/* Pop up the evaluation dialog: */
+	Vrui::popupPrimaryWidget(evaluationDialogPopup);
+	
+	if(cfg!=0)
+		{
+		/* Read the evaluation dialog's position: */
+		GLMotif::readTopLevelPosition(evaluationDialogPopup,*cfg);
+		}
+	}
+
+ScalarProbeLocator::~ScalarProbeLocator(void)
+	{
+	}
+
+void ScalarProbeLocator::storeState(Misc::ConfigurationFileSection& configFileSection) const
+	{
+	Visualization::Abstract::VariableManager* vm=application->variableManager;
+	
+	/* Write the algorithm type: */
+	configFileSection.storeString("./algorithm","Probe Scalars");
+	
+	/* Write the scalar variable name: */
+	configFileSection.storeValue<std::string>("./scalarVariableName",vm->getScalarVariableName(vm->getScalarVariable(scalarExtractor)));
+	
+	/* Write the probe settings: */
+	configFileSection.storeValue<std::string>("./samplingMode",planeMode?"Plane":"Line");
+	configFileSection.storeValue<unsigned int>("./numSamples",numSamples);
+	
+	/* Write the evaluation dialog's position: */
+	GLMotif::writeTopLevelPosition(evaluationDialogPopup,configFileSection);
+	}
+
+void ScalarProbeLocator::motionCallback(Vrui::LocatorTool::MotionCallbackData* cbData)
+	{
+	/* Call the base class method: */
+	EvaluationLocator::motionCallback(cbData);
+	
+	/* Re-evaluate the probe while its end point is being dragged: */
+	if(dragging)
+		updateProbe();
+	}
+
+void ScalarProbeLocator::buttonPressCallback(Vrui::LocatorTool::ButtonPressCallbackData* cbData)
+	{
+	/* Call the base class method: */
+	EvaluationLocator::buttonPressCallback(cbData);
+	
+	/* Start a new probe at the locator's current position: */
+	startPoint=locator->getPosition();
+	clearProbe();
+	}
+
+void ScalarProbeLocator::highlightLocator(GLRenderState& renderState) const
+	{
+	/* Call the base class method: */
+	EvaluationLocator::highlightLocator(renderState);
+	
+	/* Render the probe's samples colored by their values: */
+	if(hasProbe)
+		{
+		renderState.setLighting(false);
+		renderState.setTextureLevel(0);
+		
+		const EvaluationProbe::Point* positions=probe.getPositions();
+		const EvaluationProbe::VScalar* values=probe.getScalarValues();
+		if(probe.getSamplingMode()==EvaluationProbe::POLYLINE)
+			{
+			/* Draw the line segment's parts inside the domain as line strips: */
+			renderState.setLineWidth(3.0f);
+			bool inStrip=false;
+			for(size_t i=0;i<probe.getNumSamples();++i)
+				{
+				if(!isnan(values[i]))
+					{
+					if(!inStrip)
+						{
+						glBegin(GL_LINE_STRIP);
+						inStrip=true;
+						}
+					glColor((*colorMap)(values[i]));
+					glVertex(positions[i]);
+					}
+				else if(inStrip)
+					{
+					glEnd();
+					inStrip=false;
+					}
+				}
+			if(inStrip)
+				glEnd();
+			}
+		else
+			{
+			/* Draw the plane grid's samples inside the domain as points: */
+			renderState.setPointSize(3.0f);
+			glBegin(GL_POINTS);
+			for(size_t i=0;i<probe.getNumSamples();++i)
+				if(!isnan(values[i]))
+					{
+					glColor((*colorMap)(values[i]));
+					glVertex(positions[i]);
+					}
+			glEnd();
+			}
+		}
+	}
+
+void ScalarProbeLocator::prepareDataSetChange(void)
+	{
+	/* Remember the sampled scalar variable before its extractor goes away: */
+	scalarVariableIndex=application->variableManager->getScalarVariable(scalarExtractor);
+	}
+
+void ScalarProbeLocator::dataSetChanged(void)
+	{
+	/* Call the base class method: */
+	EvaluationLocator::dataSetChanged();
+	
+	/* Get the extractor for the sampled scalar variable from the new data set: */
+	scalarExtractor=application->variableManager->getScalarExtractor(scalarVariableIndex);
+	colorMap=application->variableManager->getColorMap(scalarVariableIndex);
+	
+	/* Re-sample the current probe in the new data set: */
+	if(hasProbe)
+		updateProbe();
+	}
+
+void ScalarProbeLocator::numSamplesCallback(GLMotif::TextFieldSlider::ValueChangedCallbackData* cbData)
+	{
+	/* Set the new number of samples and re-sample the current probe: */
+	numSamples=(unsigned int)(Math::floor(cbData->value+0.5));
+	if(hasProbe)
+		updateProbe();
+	}
+
+void ScalarProbeLocator::samplingModeCallback(GLMotif::RadioBox::ValueChangedCallbackData* cbData)
+	{
+	/* Switch the sampling mode and re-sample the current probe: */
+	planeMode=cbData->radioBox->getToggleIndex(cbData->newSelectedToggle)==1;
+	if(hasProbe)
+		updateProbe();
+	}
+
+void ScalarProbeLocator::saveProfileCallback(Misc::CallbackData* cbData)
+	{
+	if(hasProbe&&Vrui::isMaster())
+		{
+		/* Write the current samples to a numbered comma-separated values file: */
+		Visualization::Abstract::VariableManager* vm=application->variableManager;
+		char profileFileNameBuffer[256];
+		Misc::createNumberedFileName("SavedProfile.csv",4,profileFileNameBuffer);
+		try
+			{
+			probe.saveCsv(profileFileNameBuffer,vm->getScalarVariableName(vm->getScalarVariable(scalarExtractor)),application->coordinateTransformer);
+			}
+		catch(std::runtime_error err)
+			{
+			std::cerr<<"Unable to save probe profile due to exception "<<err.what()<<std::endl;
+			}
+		}
+	}
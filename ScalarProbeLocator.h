@@ -0,0 +1,90 @@
+/***********************************************************************
+ScalarProbeLocator - Class for locators sampling scalar properties of
+data sets along line segments or on plane grids at interactive rates.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef SCALARPROBELOCATOR_INCLUDED
+#define SCALARPROBELOCATOR_INCLUDED
+
+#include <GLMotif/RadioBox.h>
+#include <GLMotif/TextFieldSlider.h>
+
+#include <Abstract/ScalarExtractor.h>
+
+#include "EvaluationLocator.h"
+#include "EvaluationProbe.h"
+
+/* Forward declarations: */
+namespace Misc {
+class CallbackData;
+class ConfigurationFileSection;
+}
+namespace GLMotif {
+class TextField;
+}
+class GLColorMap;
+
+class ScalarProbeLocator:public EvaluationLocator
+	{
+	/* Embedded classes: */
+	private:
+	typedef Visualization::Abstract::ScalarExtractor ScalarExtractor;
+	typedef ScalarExtractor::Scalar Scalar;
+	typedef EvaluationProbe::Point ProbePoint;
+	
+	/* Elements: */
+	const ScalarExtractor* scalarExtractor; // Extractor for the sampled scalar value
+	int scalarVariableIndex; // Index of the sampled scalar variable while the data set is being replaced
+	const GLColorMap* colorMap; // Color map for the sampled scalar value
+	bool planeMode; // Flag whether samples are placed on a plane grid instead of along a line segment
+	unsigned int numSamples; // Total number of samples; plane grids use its square root along each axis
+	GLMotif::TextField* numValidField; // Text field showing the number of samples inside the domain
+	GLMotif::TextField* rangeFields[2]; // Text fields showing the range of sampled values
+	GLMotif::TextField* evaluationTimeField; // Text field showing the time taken by the most recent evaluation
+	EvaluationProbe probe; // The probe holding sample positions and sampled values
+	ProbePoint startPoint; // Position of the locator when the current probe was started
+	bool hasProbe; // Flag whether the probe holds valid samples
+	
+	/* Private methods: */
+	void updateProbe(void); // Places and evaluates the probe's samples between the start and current evaluation points and updates the dialog
+	void clearProbe(void); // Invalidates the probe and clears the dialog
+	
+	/* Constructors and destructors: */
+	public:
+	ScalarProbeLocator(Vrui::LocatorTool* sTool,Visualizer* sApplication,const Misc::ConfigurationFileSection* cfg =0);
+	virtual ~ScalarProbeLocator(void);
+	
+	/* Methods from Vrui::LocatorToolAdapter: */
+	virtual void storeState(Misc::ConfigurationFileSection& configFileSection) const;
+	virtual void motionCallback(Vrui::LocatorTool::MotionCallbackData* cbData);
+	virtual void buttonPressCallback(Vrui::LocatorTool::ButtonPressCallbackData* cbData);
+	
+	/* Methods from class BaseLocator: */
+	virtual void highlightLocator(GLRenderState& renderState) const;
+	virtual void prepareDataSetChange(void);
+	virtual void dataSetChanged(void);
+	
+	/* New methods: */
+	void numSamplesCallback(GLMotif::TextFieldSlider::ValueChangedCallbackData* cbData);
+	void samplingModeCallback(GLMotif::RadioBox::ValueChangedCallbackData* cbData);
+	void saveProfileCallback(Misc::CallbackData* cbData);
+	};
+
+#endif
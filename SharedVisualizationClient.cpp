@@ -23,8 +23,13 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include "SharedVisualizationClient.h"
 
+#include <string.h>
 #include <string>
 #include <iostream>
+#include <algorithm>
+#include <stdexcept>
+#include <Misc/CallbackData.h>
+#include <IO/FixedMemoryFile.h>
 #include <Comm/NetPipe.h>
 #include <Cluster/MulticastPipe.h>
 #include <Vrui/Vrui.h>
@@ -47,8 +52,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 Methods of class SharedVisualizationClient::RemoteLocator:
 *********************************************************/
 
-SharedVisualizationClient::RemoteLocator::RemoteLocator(SharedVisualizationClient::Algorithm* sExtractor)
-	:Extractor(sExtractor)
+SharedVisualizationClient::RemoteLocator::RemoteLocator(SharedVisualizationClient::Algorithm* sExtractor,ExtractionScheduler* sScheduler)
+	:Extractor(sExtractor,sScheduler)
 	{
 	}
 
@@ -82,7 +87,8 @@ Methods of class SharedVisualizationClient::RemoteClientState:
 *************************************************************/
 
 SharedVisualizationClient::RemoteClientState::RemoteClientState(void)
-	:locators(17)
+	:sharedExtraction(false),
+	 locators(17)
 	{
 	}
 
@@ -113,7 +119,7 @@ void SharedVisualizationClient::receiveRemoteLocator(SharedVisualizationClient::
 	if(algorithm!=0)
 		{
 		/* Create a new remote locator and add it to the client's hash table: */
-		RemoteLocator* newRemoteLocator=new RemoteLocator(algorithm);
+		RemoteLocator* newRemoteLocator=new RemoteLocator(algorithm,application->extractionScheduler);
 		{
 		Threads::Mutex::Lock locatorLock(rcs->locatorMutex);
 		rcs->locators.setEntry(RemoteLocatorHash::Entry(newLocatorID,newRemoteLocator));
@@ -142,8 +148,64 @@ SharedVisualizationClient::RemoteLocator* SharedVisualizationClient::findRemoteL
 	}
 	}
 
-SharedVisualizationClient::SharedVisualizationClient(Visualizer* sApplication)
+bool SharedVisualizationClient::receivesGeometry(const SharedVisualizationClient::RemoteClientState* rcs,const SharedVisualizationClient::RemoteLocator* locator) const
+	{
+	/* Remote clients only send the geometry of elements that have element readers: */
+	return sharedExtraction&&rcs->sharedExtraction&&locator->getExtractor()->hasElementReader();
+	}
+
+SharedVisualizationClient::Algorithm* SharedVisualizationClient::getElementReader(const std::string& algorithmName)
+	{
+	/* Check if an algorithm of the given name was already created: */
+	for(std::vector<Algorithm*>::iterator erIt=elementReaders.begin();erIt!=elementReaders.end();++erIt)
+		if(algorithmName==(*erIt)->getName())
+			return (*erIt)->hasElementReader()?*erIt:0;
+	
+	/* Create a new algorithm; it never extracts, so it does not need a multicast pipe: */
+	Algorithm* algorithm=application->module->getAlgorithm(algorithmName.c_str(),application->variableManager,0);
+	if(algorithm==0)
+		return 0;
+	elementReaders.push_back(algorithm);
+	
+	return algorithm->hasElementReader()?algorithm:0;
+	}
+
+void SharedVisualizationClient::receiveElement(Comm::NetPipe& pipe)
+	{
+	/* Read the element's algorithm name: */
+	std::string algorithmName=read<std::string>(pipe);
+	
+	/* The blobs were written in the extracting client's byte order, not the server's: */
+	ReceivedElement newElement(algorithmName,pipe.read<Byte>()!=getHostByteOrder());
+	
+	/* Read the element's parameter blob: */
+	newElement.parameters.resize(pipe.read<Card>());
+	if(!newElement.parameters.empty())
+		pipe.read(&newElement.parameters[0],newElement.parameters.size());
+	pipe.read<Byte>(); // Ignore the enabled flag
+	
+	/* Read the element's geometry blob: */
+	newElement.geometry.resize(pipe.read<Card>());
+	if(!newElement.geometry.empty())
+		pipe.read(&newElement.geometry[0],newElement.geometry.size());
+	
+	#ifdef VERBOSE
+	std::cout<<"SharedVisualizationClient: Received "<<newElement.algorithmName<<" element of size "<<newElement.geometry.size()<<std::endl;
+	#endif
+	
+	/* Queue the element for the main thread, which owns the variable manager and the algorithms: */
+	{
+	Threads::Mutex::Lock receivedElementsLock(receivedElementsMutex);
+	receivedElements.push_back(newElement);
+	}
+	
+	/* Wake up the main application: */
+	Vrui::requestUpdate();
+	}
+
+SharedVisualizationClient::SharedVisualizationClient(Visualizer* sApplication,bool sSharedExtraction)
 	:application(sApplication),
+	 sharedExtraction(sSharedExtraction),
 	 nextLocatorID(0),
 	 locators(17)
 	{
@@ -151,6 +213,9 @@ SharedVisualizationClient::SharedVisualizationClient(Visualizer* sApplication)
 
 SharedVisualizationClient::~SharedVisualizationClient(void)
 	{
+	/* Delete all algorithms used to recreate received elements: */
+	for(std::vector<Algorithm*>::iterator erIt=elementReaders.begin();erIt!=elementReaders.end();++erIt)
+		delete *erIt;
 	}
 
 const char* SharedVisualizationClient::getName(void) const
@@ -166,10 +231,13 @@ unsigned int SharedVisualizationClient::getNumMessages(void) const
 void SharedVisualizationClient::sendConnectRequest(Comm::NetPipe& pipe)
 	{
 	/* Send the length of the following message: */
-	pipe.write<Card>(sizeof(Card));
+	pipe.write<Card>(sizeof(Card)+sizeof(Byte));
 	
 	/* Send the client's protocol version: */
 	pipe.write<Card>(protocolVersion);
+	
+	/* Send the client's extraction mode: */
+	pipe.write<Byte>(sharedExtraction?1:0);
 	}
 
 Collaboration::ProtocolClient::RemoteClientState* SharedVisualizationClient::receiveClientConnect(Comm::NetPipe& pipe)
@@ -177,6 +245,9 @@ Collaboration::ProtocolClient::RemoteClientState* SharedVisualizationClient::rec
 	/* Create a new remote client state object: */
 	RemoteClientState* newClient=new RemoteClientState;
 	
+	/* Receive the remote client's extraction mode: */
+	newClient->sharedExtraction=pipe.read<Byte>()!=0;
+	
 	/* Receive the number of locators on the remote client: */
 	unsigned int numLocators=pipe.read<Card>();
 	
@@ -189,25 +260,22 @@ Collaboration::ProtocolClient::RemoteClientState* SharedVisualizationClient::rec
 
 bool SharedVisualizationClient::receiveServerUpdate(Comm::NetPipe& pipe)
 	{
-	/* Ignore a list of global server messages: */
+	/* Receive a list of global server messages: */
 	MessageIdType message;
 	while((message=readMessage(pipe))!=UPDATE_END)
 		switch(message)
 			{
 			case CREATE_ELEMENT:
 				{
-				/* Skip an element creation message: */
-				unsigned int elementId=pipe.read<Card>();
-				std::string algorithmName=read<std::string>(pipe);
-				size_t parametersSize=pipe.read<Card>();
-				Byte* parameters=new Byte[parametersSize];
-				pipe.read(parameters,parametersSize);
-				pipe.read<Byte>(); // bool enabled=pipe.read<unsigned char>()!=0;
+				/* Receive a cached element created before this client connected: */
+				pipe.read<Card>(); // Read and ignore element ID
+				receiveElement(pipe);
 				
-				#ifdef VERBOSE
-				std::cout<<"Ignored creation of "<<algorithmName<<" element with ID "<<elementId<<std::endl;
-				#endif
+				break;
 				}
+			
+			default:
+				Misc::throwStdErr("SharedVisualizationClient::receiveServerUpdate: received unknown server message %u",message);
 			}
 	
 	return false;
@@ -234,9 +302,9 @@ bool SharedVisualizationClient::receiveServerUpdate(Collaboration::ProtocolClien
 			
 			case SEED_REQUEST:
 				{
-				/* Find the remote locator: */
+				/* Find the remote locator; skip extraction if its client sends the finished geometry: */
 				RemoteLocator* locator=findRemoteLocator(myRcs,pipe);
-				if(locator!=0)
+				if(locator!=0&&!receivesGeometry(myRcs,locator))
 					{
 					/* Read and post the seed request: */
 					locator->readSeedRequest(pipe);
@@ -263,7 +331,7 @@ bool SharedVisualizationClient::receiveServerUpdate(Collaboration::ProtocolClien
 				std::cout<<"SharedVisualizationServer: Received finalization request "<<finalRequestID<<std::endl;
 				#endif
 				
-				if(locator!=0)
+				if(locator!=0&&!receivesGeometry(myRcs,locator))
 					{
 					/* Post the finalization request: */
 					locator->finalize(finalRequestID);
@@ -295,6 +363,16 @@ bool SharedVisualizationClient::receiveServerUpdate(Collaboration::ProtocolClien
 				break;
 				}
 			
+			case ELEMENT_GEOMETRY:
+				{
+				/* Receive a finished element extracted by the remote client: */
+				pipe.read<Card>(); // Read and ignore locator ID
+				pipe.read<Card>(); // Read and ignore element ID
+				receiveElement(pipe);
+				
+				break;
+				}
+			
 			default:
 				Misc::throwStdErr("SharedVisualizationClient::receiveServerUpdate: received unknown locator action message %u",message);
 			}
@@ -386,16 +464,66 @@ void SharedVisualizationClient::sendClientUpdate(Comm::NetPipe& pipe)
 					
 				break;
 			
+			case ELEMENT_GEOMETRY:
+				{
+				#ifdef VERBOSE
+				std::cout<<"SharedVisualizationClient: Sending element geometry for locator "<<aIt->locatorIt->getDest().locatorID<<std::endl;
+				#endif
+				
+				/* Send an element geometry message: */
+				writeMessage(ELEMENT_GEOMETRY,pipe);
+				pipe.write<Card>(aIt->locatorIt->getDest().locatorID);
+				
+				/* Send this client's byte order, in which the following blobs are written: */
+				pipe.write<Byte>(getHostByteOrder());
+				
+				/* Calculate and send the element's extraction parameters message size: */
+				Visualization::Abstract::BinaryParametersSize size(application->variableManager,false);
+				aIt->element->getParameters()->write(size);
+				pipe.write<Card>(size.getSize());
+				
+				/* Send the element's extraction parameters: */
+				Visualization::Abstract::BinaryParametersSink sink(application->variableManager,pipe,false);
+				aIt->element->getParameters()->write(sink);
+				
+				/* Send the element's geometry: */
+				pipe.write<Card>(aIt->element->getGeometrySize());
+				aIt->element->writeGeometry(pipe);
+				
+				break;
+				}
+			
 			default:
 				; // Just to make g++ happy
 			}
 		}
 	
+	/* Tell the server to stop handing out the geometry of deleted elements: */
+	for(std::vector<RemovedElement>::iterator reIt=removedElements.begin();reIt!=removedElements.end();++reIt)
+		{
+		#ifdef VERBOSE
+		std::cout<<"SharedVisualizationClient: Removing "<<reIt->algorithmName<<" element"<<std::endl;
+		#endif
+		
+		/* Send an element removal message: */
+		writeMessage(REMOVE_ELEMENT,pipe);
+		write(reIt->algorithmName,pipe);
+		pipe.write<Byte>(getHostByteOrder());
+		
+		/* Send the element's extraction parameters, which identify the element on the server: */
+		Visualization::Abstract::BinaryParametersSize size(application->variableManager,false);
+		reIt->element->getParameters()->write(size);
+		pipe.write<Card>(size.getSize());
+		Visualization::Abstract::BinaryParametersSink sink(application->variableManager,pipe,false);
+		reIt->element->getParameters()->write(sink);
+		}
+	
 	/* Terminate the action list: */
 	writeMessage(UPDATE_END,pipe);
 	
-	/* Clear the action list: */
+	/* Clear the action and removal lists: */
 	actions.clear();
+	removedElements.clear();
 	}
 
 void SharedVisualizationClient::rejectedByServer(void)
@@ -500,6 +628,25 @@ void SharedVisualizationClient::postFinalizationRequest(ExtractorLocator* locato
 	}
 	}
 
+void SharedVisualizationClient::postElement(ExtractorLocator* locator,SharedVisualizationClient::Element* element)
+	{
+	/* Only send geometry that other clients can recreate: */
+	if(!sharedExtraction||!locator->getExtractor()->hasElementReader())
+		return;
+	
+	{
+	Threads::Mutex::Lock locatorLock(locatorMutex);
+	
+	/* Find the locator's ID in the hash table: */
+	LocatorHash::Iterator locatorIt=locators.findEntry(locator);
+	if(locatorIt.isFinished())
+		Misc::throwStdErr("SharedVisualizationClient::postElement: Locator not found");
+	
+	/* Enqueue a locator list action: */
+	actions.push_back(LocatorAction(locatorIt,element));
+	}
+	}
+
 void SharedVisualizationClient::destroyLocator(ExtractorLocator* locator)
 	{
 	{
@@ -528,3 +675,63 @@ void SharedVisualizationClient::drawLocators(GLRenderState& renderState,bool tra
 		}
 		}
 	}
+
+void SharedVisualizationClient::elementRemovedCallback(Misc::CallbackData* cbData)
+	{
+	ElementList::ElementRemovedCallbackData* myCbData=dynamic_cast<ElementList::ElementRemovedCallbackData*>(cbData);
+	
+	/* Only the server's element cache holds geometry that could be handed out after deletion: */
+	if(myCbData==0||!sharedExtraction||myCbData->element->getParameters()==0)
+		return;
+	
+	/* Enqueue the element's removal: */
+	Threads::Mutex::Lock locatorLock(locatorMutex);
+	removedElements.push_back(RemovedElement(myCbData->element,myCbData->elementName));
+	}
+
+void SharedVisualizationClient::insertReceivedElements(void)
+	{
+	/* Grab the list of received elements: */
+	std::vector<ReceivedElement> newElements;
+	{
+	Threads::Mutex::Lock receivedElementsLock(receivedElementsMutex);
+	std::swap(newElements,receivedElements);
+	}
+	
+	for(std::vector<ReceivedElement>::iterator reIt=newElements.begin();reIt!=newElements.end();++reIt)
+		{
+		/* Find an algorithm to recreate the element: */
+		Algorithm* algorithm=getElementReader(reIt->algorithmName);
+		if(algorithm==0)
+			{
+			std::cout<<"SharedVisualizationClient::insertReceivedElements: Ignoring element of unsupported type "<<reIt->algorithmName<<std::endl;
+			continue;
+			}
+		
+		try
+			{
+			/* Read the element's extraction parameters: */
+			IO::FixedMemoryFile parametersFile(reIt->parameters.size());
+			if(!reIt->parameters.empty())
+				memcpy(parametersFile.getMemory(),&reIt->parameters[0],reIt->parameters.size());
+			parametersFile.setSwapOnRead(reIt->swapOnRead);
+			Visualization::Abstract::BinaryParametersSource source(application->variableManager,parametersFile,false);
+			Parameters* parameters=algorithm->cloneParameters();
+			parameters->read(source);
+			
+			/* Recreate the element from its geometry: */
+			IO::FixedMemoryFile geometryFile(reIt->geometry.size());
+			if(!reIt->geometry.empty())
+				memcpy(geometryFile.getMemory(),&reIt->geometry[0],reIt->geometry.size());
+			geometryFile.setSwapOnRead(reIt->swapOnRead);
+			Extractor::ElementPointer element=algorithm->readElement(parameters,geometryFile);
+			
+			/* Add the element to the Visualizer's element list: */
+			application->elementList->addElement(element.getPointer(),reIt->algorithmName.c_str());
+			}
+		catch(std::runtime_error err)
+			{
+			std::cerr<<"SharedVisualizationClient::insertReceivedElements: Ignoring "<<reIt->algorithmName<<" element due to exception "<<err.what()<<std::endl;
+			}
+		}
+	}
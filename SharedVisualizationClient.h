@@ -24,6 +24,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef SHAREDVISUALIZATIONCLIENT_INCLUDED
 #define SHAREDVISUALIZATIONCLIENT_INCLUDED
 
+#include <string>
 #include <vector>
 #include <Misc/HashTable.h>
 #include <Threads/Mutex.h>
@@ -33,6 +34,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include "Extractor.h"
 
 /* Forward declarations: */
+namespace Misc {
+class CallbackData;
+}
 namespace Visualization {
 namespace Abstract {
 class Parameters;
@@ -57,7 +61,7 @@ class SharedVisualizationClient:public Collaboration::ProtocolClient,private Sha
 		{
 		/* Constructors and destructors: */
 		public:
-		RemoteLocator(Algorithm* sExtractor); // Creates a remote locator for the given algorithm
+		RemoteLocator(Algorithm* sExtractor,ExtractionScheduler* sScheduler); // Creates a remote locator for the given algorithm running on the given scheduler
 		
 		/* Methods from Extractor: */
 		virtual void update(void);
@@ -74,6 +78,7 @@ class SharedVisualizationClient:public Collaboration::ProtocolClient,private Sha
 		
 		/* Elements: */
 		private:
+		bool sharedExtraction; // Flag whether the remote client sends the geometry of its finished elements
 		mutable Threads::Mutex locatorMutex; // Mutex protecting the locator hash table
 		RemoteLocatorHash locators; // Hash table of all locators registered with the remote client
 		
@@ -107,33 +112,76 @@ class SharedVisualizationClient:public Collaboration::ProtocolClient,private Sha
 		MessageIdType action; // What kind of action, values taken from respective protocol messages
 		LocatorHash::Iterator locatorIt;
 		unsigned int requestID; // Request ID for seed and finalization actions
+		Extractor::ElementPointer element; // Finished visualization element for element geometry actions
 		
 		/* Constructors and destructors: */
 		LocatorAction(MessageIdType sAction,const LocatorHash::Iterator& sLocatorIt,unsigned int sRequestID)
 			:action(sAction),locatorIt(sLocatorIt),requestID(sRequestID)
 			{
 			}
+		LocatorAction(const LocatorHash::Iterator& sLocatorIt,Element* sElement)
+			:action(ELEMENT_GEOMETRY),locatorIt(sLocatorIt),requestID(0),element(sElement)
+			{
+			}
 		};
 	
 	typedef std::vector<LocatorAction> LocatorActionList; // Type for lists of locator actions
 	
+	struct ReceivedElement // Structure for visualization elements whose parameters and geometry were received from the server
+		{
+		/* Elements: */
+		public:
+		std::string algorithmName; // Name of the algorithm that created the element
+		bool swapOnRead; // Flag whether the extracting client wrote the element's data in the opposite byte order
+		std::vector<Byte> parameters; // The element's parameter blob
+		std::vector<Byte> geometry; // The element's geometry blob
+		
+		/* Constructors and destructors: */
+		ReceivedElement(const std::string& sAlgorithmName,bool sSwapOnRead)
+			:algorithmName(sAlgorithmName),swapOnRead(sSwapOnRead)
+			{
+			}
+		};
+	
+	struct RemovedElement // Structure for local visualization elements deleted by the user since the last client update
+		{
+		/* Elements: */
+		public:
+		Extractor::ElementPointer element; // The deleted visualization element
+		std::string algorithmName; // Name of the algorithm that created the element
+		
+		/* Constructors and destructors: */
+		RemovedElement(Element* sElement,const std::string& sAlgorithmName)
+			:element(sElement),algorithmName(sAlgorithmName)
+			{
+			}
+		};
+	
 	/* Elements: */
 	Visualizer* application; // Pointer to the Visualizer application object
+	bool sharedExtraction; // Flag whether to send the geometry of finished local elements and to accept geometry from other sharing clients instead of extracting their elements
 	unsigned int nextLocatorID; // ID to assign to the next local locator
 	Threads::Mutex locatorMutex; // Mutex protecting the locator hash table
 	LocatorHash locators; // Hash table mapping Visualizer's extractor locators to server locator IDs
 	LocatorActionList actions; // List of locator actions queued up since the last client update
+	std::vector<RemovedElement> removedElements; // List of deleted elements whose geometry the server must no longer hand out; protected by the locator mutex
 	unsigned int mostRecentSeedRequestID; // ID of most recently posted seed request
 	mutable Threads::Mutex clientStatesMutex; // Mutex protecting the remote client list
 	std::vector<RemoteClientState*> clientStates; // List of currently connected remote clients
+	std::vector<Algorithm*> elementReaders; // Algorithms used to recreate visualization elements from received geometry; only accessed by the main thread
+	Threads::Mutex receivedElementsMutex; // Mutex protecting the list of received elements
+	std::vector<ReceivedElement> receivedElements; // Parameters and geometry of visualization elements received since the last frame
 	
 	/* Private methods: */
 	void receiveRemoteLocator(RemoteClientState* rcs,Comm::NetPipe& pipe); // Creates a new remote locator by reading from the given pipe, and adds it to the hash table
 	RemoteLocator* findRemoteLocator(RemoteClientState* rcs,Comm::NetPipe& pipe); // Returns a pointer to a remote locator whose ID was read from the given pipe, or 0 if not found
+	bool receivesGeometry(const RemoteClientState* rcs,const RemoteLocator* locator) const; // Returns true if the finished elements of the given remote locator arrive as geometry instead of having to be extracted locally
+	Algorithm* getElementReader(const std::string& algorithmName); // Returns an algorithm that can recreate elements of the given algorithm name, or 0 if there is none
+	void receiveElement(Comm::NetPipe& pipe); // Reads a visualization element's parameters and geometry from the given pipe and queues them for the main thread
 	
 	/* Constructors and destructors: */
 	public:
-	SharedVisualizationClient(Visualizer* sApplication); // Creates a shared visualization client for the given Visualizer application
+	SharedVisualizationClient(Visualizer* sApplication,bool sSharedExtraction); // Creates a shared visualization client for the given Visualizer application; shares extracted geometry with other clients if flag is true
 	virtual ~SharedVisualizationClient(void); // Destroys the shared visualization client
 	
 	/* Methods from ProtocolClient: */
@@ -153,7 +201,10 @@ class SharedVisualizationClient:public Collaboration::ProtocolClient,private Sha
 	void createLocator(ExtractorLocator* locator); // Registers a newly created extractor locator
 	void postSeedRequest(ExtractorLocator* locator,unsigned int seedRequestID,Parameters* seedParameters); // Sends a seed request of the given ID for the given locator; client inherits parameter object
 	void postFinalizationRequest(ExtractorLocator* locator,unsigned int finalSeedRequestID); // Notifies server that the given seed request ID is the final one for a current seeding operation on the given locator
+	void postElement(ExtractorLocator* locator,Element* element); // Sends the geometry of a finished visualization element created by the given locator to the server if extracted geometry is shared
 	void destroyLocator(ExtractorLocator* locator); // Unregisters an extractor locator before it is destroyed
+	void elementRemovedCallback(Misc::CallbackData* cbData); // Tells the server to stop handing out the geometry of a visualization element deleted from the element list
+	void insertReceivedElements(void); // Recreates all visualization elements received from the server and adds them to the element list; must be called from the main thread
 	void drawLocators(GLRenderState& renderState,bool transparent) const;
 	};
 
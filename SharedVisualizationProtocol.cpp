@@ -27,4 +27,14 @@ Static elements of class SharedVisualizationProtocol:
 ****************************************************/
 
 const char* SharedVisualizationProtocol::protocolName="SharedVisualization";
-const unsigned int SharedVisualizationProtocol::protocolVersion=(3U<<16)+0U; // Version 3.0
+const unsigned int SharedVisualizationProtocol::protocolVersion=(6U<<16)+0U; // Version 6.0
+
+/********************************************
+Methods of class SharedVisualizationProtocol:
+********************************************/
+
+SharedVisualizationProtocol::Byte SharedVisualizationProtocol::getHostByteOrder(void)
+	{
+	unsigned int test=1U;
+	return *reinterpret_cast<const Byte*>(&test)==1U?1:0;
+	}
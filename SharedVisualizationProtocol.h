@@ -36,6 +36,8 @@ class SharedVisualizationProtocol:public Collaboration::Protocol
 		FINALIZATION_REQUEST,
 		DESTROY_LOCATOR,
 		CREATE_ELEMENT,
+		ELEMENT_GEOMETRY,
+		REMOVE_ELEMENT,
 		UPDATE_END,
 		MESSAGES_END
 		};
@@ -43,6 +45,9 @@ class SharedVisualizationProtocol:public Collaboration::Protocol
 	/* Elements: */
 	static const char* protocolName; // Network name of shared Visualizer protocol
 	static const unsigned int protocolVersion; // Specific version number of protocol implementation
+	
+	/* Methods: */
+	static Byte getHostByteOrder(void); // Returns 1 if the host stores multi-byte values little-endian, 0 otherwise; sent along with opaque element blobs
 	};
 
 #endif
@@ -69,29 +69,62 @@ SharedVisualizationServer::LocatorState::LocatorState(const std::string& sAlgori
 Methods of class SharedVisualizationServer::Element:
 ***************************************************/
 
-SharedVisualizationServer::Element::Element(const SharedVisualizationServer::LocatorState& ls)
-	:algorithmName(ls.algorithmName),
-	 parametersSize(ls.seedRequest.parametersSize),parameters(new Byte[parametersSize]),
-	 enabled(true)
+SharedVisualizationServer::Element::Element(const std::string& sAlgorithmName)
+	:algorithmName(sAlgorithmName),byteOrder(0),
+	 parametersSize(0),parameters(0),
+	 enabled(true),
+	 geometrySize(0),geometry(0)
 	{
-	/* Copy the seed request's parameters blob: */
-	memcpy(parameters,ls.seedRequest.parameters,parametersSize);
+	}
+
+SharedVisualizationServer::Element& SharedVisualizationServer::Element::receive(Comm::NetPipe& pipe)
+	{
+	/* Read the byte order of the extracting client: */
+	byteOrder=pipe.read<Byte>();
+	
+	/* Read the parameters blob: */
+	delete[] parameters;
+	parametersSize=pipe.read<Card>();
+	parameters=new Byte[parametersSize];
+	pipe.read(parameters,parametersSize);
+	
+	/* Read the geometry blob: */
+	delete[] geometry;
+	geometrySize=pipe.read<Card>();
+	geometry=new Byte[geometrySize];
+	pipe.read(geometry,geometrySize);
+	
+	return *this;
 	}
 
 void SharedVisualizationServer::Element::send(Comm::NetPipe& pipe) const
 	{
 	SharedVisualizationProtocol::write(algorithmName,pipe);
+	pipe.write<Byte>(byteOrder);
 	pipe.write<Card>(parametersSize);
 	pipe.write<Byte>(parameters,parametersSize);
 	pipe.write<Byte>(enabled?1:0);
+	pipe.write<Card>(geometrySize);
+	pipe.write<Byte>(geometry,geometrySize);
+	}
+
+std::string SharedVisualizationServer::Element::getCacheKey(const std::string& algorithmName,SharedVisualizationServer::Byte byteOrder,const Byte* parameters,size_t parametersSize)
+	{
+	std::string result=algorithmName;
+	result.push_back('\0');
+	result.push_back(char(byteOrder));
+	result.append(reinterpret_cast<const char*>(parameters),parametersSize);
+	
+	return result;
 	}
 
 /*******************************************************
 Methods of class SharedVisualizationServer::ClientState:
 *******************************************************/
 
-SharedVisualizationServer::ClientState::ClientState(void)
-	:firstUpdate(true),
+SharedVisualizationServer::ClientState::ClientState(bool sSharedExtraction)
+	:sharedExtraction(sSharedExtraction),
+	 firstUpdate(true),
 	 locators(17)
 	{
 	}
@@ -107,8 +140,42 @@ SharedVisualizationServer::ClientState::~ClientState(void)
 Methods of class SharedVisualizationServer:
 ******************************************/
 
+void SharedVisualizationServer::removeElement(const SharedVisualizationServer::ElementHash::Iterator& elementIt)
+	{
+	Element* element=elementIt->getDest();
+	
+	/* Remove the element's cache entry: */
+	ElementCache::iterator ecIt=elementCache.find(element->getCacheKey());
+	if(ecIt!=elementCache.end()&&ecIt->second==elementIt->getSource())
+		elementCache.erase(ecIt);
+	
+	/* Delete the element: */
+	geometrySize-=element->geometrySize;
+	delete element;
+	elements.removeEntry(elementIt);
+	}
+
+void SharedVisualizationServer::limitElementCache(void)
+	{
+	while(elementOrder.size()>1&&(elements.getNumEntries()>maxNumElements||geometrySize>maxGeometrySize))
+		{
+		/* Remove the oldest element unless it was removed explicitly before: */
+		ElementHash::Iterator eIt=elements.findEntry(elementOrder.front());
+		elementOrder.pop_front();
+		if(!eIt.isFinished())
+			{
+			#ifdef VERBOSE
+			std::cout<<"SharedVisualizationServer: Evicting element "<<eIt->getSource()<<" from cache"<<std::endl;
+			#endif
+			
+			removeElement(eIt);
+			}
+		}
+	}
+
 SharedVisualizationServer::SharedVisualizationServer(void)
-	:nextElementID(0),elements(31)
+	:nextElementID(0),elements(31),
+	 maxNumElements(256),maxGeometrySize(size_t(256)*1024*1024),geometrySize(0)
 	{
 	}
 
@@ -137,7 +204,17 @@ Collaboration::ProtocolServer::ClientState* SharedVisualizationServer::receiveCo
 	
 	/* Check for the correct version number: */
 	if(clientProtocolVersion==protocolVersion)
-		return new ClientState;
+		{
+		/* Receive the client's extraction mode: */
+		bool sharedExtraction=pipe.read<Byte>()!=0;
+		
+		#ifdef VERBOSE
+		if(sharedExtraction)
+			std::cout<<"SharedVisualizationServer: Client shares extracted geometry"<<std::endl;
+		#endif
+		
+		return new ClientState(sharedExtraction);
+		}
 	else
 		return 0;
 	}
@@ -251,6 +328,87 @@ void SharedVisualizationServer::receiveClientUpdate(Collaboration::ProtocolServe
 				break;
 				}
 			
+			case ELEMENT_GEOMETRY:
+				{
+				/* Read the locator's ID: */
+				unsigned int locatorID=pipe.read<Card>();
+				
+				/* Find the locator's state: */
+				LocatorHash::Iterator locatorIt=myCs->locators.findEntry(locatorID);
+				
+				if(locatorIt.isFinished())
+					{
+					/* We could just silently ignore the request, but it's safer to bail out with a protocol error: */
+					Misc::throwStdErr("SharedVisualizationServer::handleMessage: Locator ID %u not found",locatorID);
+					}
+				
+				/* Receive the finished element: */
+				Element* newElement=new Element(locatorIt->getDest()->algorithmName);
+				newElement->receive(pipe);
+				
+				/* Store the element unless an identical one is already cached: */
+				unsigned int elementID;
+				{
+				Threads::Mutex::Lock elementListLock(elementListMutex);
+				std::pair<ElementCache::iterator,bool> cacheResult=elementCache.insert(ElementCache::value_type(newElement->getCacheKey(),nextElementID));
+				if(cacheResult.second)
+					{
+					elementID=nextElementID;
+					++nextElementID;
+					elements.setEntry(ElementHash::Entry(elementID,newElement));
+					elementOrder.push_back(elementID);
+					geometrySize+=newElement->geometrySize;
+					
+					/* Drop the oldest elements if the cache grew too big: */
+					limitElementCache();
+					}
+				else
+					{
+					elementID=cacheResult.first->second;
+					delete newElement;
+					}
+				}
+				
+				#ifdef VERBOSE
+				std::cout<<"SharedVisualizationServer: Received geometry of element "<<elementID<<" from locator "<<locatorID<<std::endl;
+				#endif
+				
+				/* Enqueue a locator action: */
+				myCs->actions.push_back(LocatorAction(ELEMENT_GEOMETRY,locatorIt,elementID));
+				
+				break;
+				}
+			
+			case REMOVE_ELEMENT:
+				{
+				/* Read the removed element's algorithm name, the removing client's byte order, and the parameter blob: */
+				std::string algorithmName=read<std::string>(pipe);
+				Byte byteOrder=pipe.read<Byte>();
+				std::vector<Byte> parameters(pipe.read<Card>());
+				if(!parameters.empty())
+					pipe.read(&parameters[0],parameters.size());
+				
+				/* Remove the element from the cache so that clients connecting later do not receive it: */
+				{
+				Threads::Mutex::Lock elementListLock(elementListMutex);
+				ElementCache::iterator ecIt=elementCache.find(Element::getCacheKey(algorithmName,byteOrder,parameters.empty()?0:&parameters[0],parameters.size()));
+				if(ecIt!=elementCache.end())
+					{
+					#ifdef VERBOSE
+					std::cout<<"SharedVisualizationServer: Removing element "<<ecIt->second<<std::endl;
+					#endif
+					
+					ElementHash::Iterator eIt=elements.findEntry(ecIt->second);
+					if(!eIt.isFinished())
+						removeElement(eIt);
+					else
+						elementCache.erase(ecIt);
+					}
+				}
+				
+				break;
+				}
+			
 			default:
 				Misc::throwStdErr("SharedVisualizationServer::receiveClientUpdate: received unknown locator action message %u",message);
 			}
@@ -263,6 +421,9 @@ void SharedVisualizationServer::sendClientConnect(Collaboration::ProtocolServer:
 	if(mySourceCs==0||myDestCs==0)
 		Misc::throwStdErr("SharedVisualizationServer::sendClientConnect: Mismatching client state object type");
 	
+	/* Tell the destination client whether the source client shares its extracted geometry: */
+	pipe.write<Byte>(mySourceCs->sharedExtraction?1:0);
+	
 	/* Send the existing locators of the source client to the destination client: */
 	unsigned int numLocators=mySourceCs->locators.getNumEntries();
 	pipe.write<Card>(numLocators);
@@ -282,13 +443,16 @@ void SharedVisualizationServer::sendServerUpdate(Collaboration::ProtocolServer::
 	
 	if(myDestCs->firstUpdate)
 		{
-		/* Send all existing visualization elements to the newly-connected client: */
-		Threads::Mutex::Lock elementListLock(elementListMutex);
-		for(ElementHash::Iterator eIt=elements.begin();!eIt.isFinished();++eIt)
+		if(myDestCs->sharedExtraction)
 			{
-			writeMessage(CREATE_ELEMENT,pipe);
-			pipe.write<Card>(eIt->getSource());
-			eIt->getDest()->send(pipe);
+			/* Send all cached visualization elements to the newly-connected client: */
+			Threads::Mutex::Lock elementListLock(elementListMutex);
+			for(ElementHash::Iterator eIt=elements.begin();!eIt.isFinished();++eIt)
+				{
+				writeMessage(CREATE_ELEMENT,pipe);
+				pipe.write<Card>(eIt->getSource());
+				eIt->getDest()->send(pipe);
+				}
 			}
 		
 		myDestCs->firstUpdate=false;
@@ -357,6 +521,26 @@ void SharedVisualizationServer::sendServerUpdate(Collaboration::ProtocolServer::
 				
 				break;
 			
+			case ELEMENT_GEOMETRY:
+				/* Only clients that accept shared geometry receive finished elements: */
+				if(myDestCs->sharedExtraction)
+					{
+					Threads::Mutex::Lock elementListLock(elementListMutex);
+					ElementHash::Iterator eIt=elements.findEntry(aIt->requestID);
+					if(!eIt.isFinished())
+						{
+						/* Send an element geometry message: */
+						writeMessage(ELEMENT_GEOMETRY,pipe);
+						
+						/* Send the locator's ID, the element's ID, and the element: */
+						pipe.write<Card>(aIt->locatorIt->getSource());
+						pipe.write<Card>(eIt->getSource());
+						eIt->getDest()->send(pipe);
+						}
+					}
+				
+				break;
+			
 			default:
 				; // Just to make g++ happy
 			}
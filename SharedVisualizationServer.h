@@ -26,6 +26,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <string>
 #include <vector>
+#include <deque>
+#include <map>
 #include <Misc/HashTable.h>
 #include <Threads/Mutex.h>
 #include <Collaboration/ProtocolServer.h>
@@ -86,7 +88,7 @@ class SharedVisualizationServer:public Collaboration::ProtocolServer,private Sha
 		public:
 		MessageIdType action; // What kind of action, values taken from respective protocol messages
 		LocatorHash::Iterator locatorIt;
-		unsigned int requestID; // Request ID for seed and finalization actions
+		unsigned int requestID; // Request ID for seed and finalization actions, or element ID for element geometry actions
 		
 		/* Constructors and destructors: */
 		LocatorAction(MessageIdType sAction,const LocatorHash::Iterator& sLocatorIt,unsigned int sRequestID)
@@ -102,39 +104,51 @@ class SharedVisualizationServer:public Collaboration::ProtocolServer,private Sha
 		/* Elements: */
 		public:
 		std::string algorithmName; // Name of the algorithm which created the element
+		Byte byteOrder; // Byte order of the extracting client in which both blobs were written, as returned by getHostByteOrder()
 		size_t parametersSize; // Size of element parameter blob in bytes
 		Byte* parameters; // Element parameter blob
 		bool enabled; // Flag whether the element is currently enabled (visible)
+		size_t geometrySize; // Size of element geometry blob in bytes
+		Byte* geometry; // Element geometry blob as written by the extracting client
 		
 		/* Constructors and destructors: */
-		Element(const LocatorState& ls); // Creates a visualization element from the final seed request of a locator state
+		Element(const std::string& sAlgorithmName); // Creates an empty visualization element for the given algorithm
 		private:
 		Element(const Element& source); // Prohibit copy constructor
 		Element& operator=(const Element& source); // Prohibit assignment operator
 		public:
-		~Element(void) // Destroys a seed request
+		~Element(void) // Destroys a visualization element
 			{
 			delete[] parameters;
+			delete[] geometry;
 			}
 		
 		/* Methods: */
+		Element& receive(Comm::NetPipe& pipe); // Reads visualization element parameters and geometry from pipe
 		void send(Comm::NetPipe& pipe) const; // Writes visualization element to pipe
+		static std::string getCacheKey(const std::string& algorithmName,Byte byteOrder,const Byte* parameters,size_t parametersSize); // Returns a key identifying elements created by the given algorithm from the given parameters written in the given byte order
+		std::string getCacheKey(void) const // Returns a key identifying elements created by the same algorithm from the same parameters
+			{
+			return getCacheKey(algorithmName,byteOrder,parameters,parametersSize);
+			}
 		};
 	
 	typedef Misc::HashTable<unsigned int,Element*> ElementHash; // Type for hash tables mapping element IDs to element objects
+	typedef std::map<std::string,unsigned int> ElementCache; // Type for maps from algorithm and parameter keys to element IDs
 	
 	class ClientState:public Collaboration::ProtocolServer::ClientState
 		{
 		friend class SharedVisualizationServer;
 		
 		/* Elements: */
+		bool sharedExtraction; // Flag whether the client uploads the geometry of its finished elements and accepts geometry in place of seed requests
 		bool firstUpdate; // Flag to indicate that the client has not yet received a server update packet
 		LocatorHash locators; // Hash table containing locators currently registered by the client
 		LocatorActionList actions; // List of locator actions queued up since the last server update
 		
 		/* Constructors and destructors: */
 		public:
-		ClientState(void);
+		ClientState(bool sSharedExtraction);
 		virtual ~ClientState(void);
 		};
 	
@@ -142,6 +156,15 @@ class SharedVisualizationServer:public Collaboration::ProtocolServer,private Sha
 	Threads::Mutex elementListMutex; // Mutex serializing access to the element list
 	unsigned int nextElementID; // ID number to assign to next created visualization element
 	ElementHash elements; // Hash table containing all current visualization elements
+	ElementCache elementCache; // Map from algorithm and parameters to the IDs of elements whose geometry was already received
+	std::deque<unsigned int> elementOrder; // IDs of cached elements in the order in which they were received; may contain IDs of removed elements
+	size_t maxNumElements; // Maximum number of cached elements
+	size_t maxGeometrySize; // Maximum total size of cached element geometry in bytes
+	size_t geometrySize; // Current total size of cached element geometry in bytes
+	
+	/* Private methods: */
+	void removeElement(const ElementHash::Iterator& elementIt); // Removes the given element from the element list and the cache; caller must hold the element list mutex
+	void limitElementCache(void); // Removes the oldest elements until the cache fits its limits again, but always keeps the newest element; caller must hold the element list mutex
 	
 	/* Constructors and destructors: */
 	public:
@@ -31,6 +31,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <GL/Extensions/GLEXTTexture3D.h>
 #include <GL/GLShader.h>
 
+#include <Templatized/Profiler.h>
+
 /*************************************************
 Methods of class SingleChannelRaycaster::DataItem:
 *************************************************/
@@ -123,6 +125,8 @@ void SingleChannelRaycaster::bindShader(const Raycaster::PTransform& pmv,const R
 	if(myDataItem->volumeTextureVersion!=dataVersion)
 		{
 		/* Upload the new volume data: */
+		static const unsigned int uploadProbe=Visualization::Templatized::Profiler::registerTimer("Raycaster volume upload",Visualization::Templatized::Profiler::UPLOAD);
+		Visualization::Templatized::Profiler::Scope uploadScope(uploadProbe);
 		glTexSubImage3DEXT(GL_TEXTURE_3D,0,0,0,0,dataSize[0],dataSize[1],dataSize[2],GL_LUMINANCE,GL_UNSIGNED_BYTE,data);
 		
 		/* Mark the volume texture as up-to-date: */
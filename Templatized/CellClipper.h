@@ -0,0 +1,112 @@
+/***********************************************************************
+CellClipper - Helper class to cull data set cells that lie entirely
+outside of a set of cutting planes before extracting visualization
+elements from them.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_CELLCLIPPER_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_CELLCLIPPER_INCLUDED
+
+#include <stddef.h>
+#include <vector>
+#include <Geometry/Plane.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class DataSetParam>
+class CellClipper
+	{
+	/* Embedded classes: */
+	public:
+	typedef DataSetParam DataSet; // Type of the data set whose cells are culled
+	typedef typename DataSet::Scalar Scalar; // Scalar type of the data set's domain
+	static const int dimension=DataSet::dimension; // Dimension of the data set's domain
+	typedef typename DataSet::CellTopology CellTopology; // Topology of the data set's cells
+	typedef typename DataSet::Cell Cell; // Type of the data set's cells
+	typedef Geometry::Plane<Scalar,dimension> Plane; // Type for cutting planes in the data set's domain
+	
+	/* Elements: */
+	private:
+	std::vector<Plane> planes; // List of cutting planes; the visible side of each plane is its positive half-space
+	size_t numCellsSkipped; // Number of cells skipped since the planes were last set
+	size_t numTrianglesSaved; // Number of triangles the skipped cells would have contributed
+	
+	/* Constructors and destructors: */
+	public:
+	CellClipper(void) // Creates a cell clipper without cutting planes
+		:numCellsSkipped(0),numTrianglesSaved(0)
+		{
+		}
+	
+	/* Methods: */
+	template <class SourcePlaneParam>
+	void setPlanes(const std::vector<SourcePlaneParam>& newPlanes) // Sets a new list of cutting planes of any scalar type and resets the culling statistics
+		{
+		planes.clear();
+		planes.reserve(newPlanes.size());
+		for(typename std::vector<SourcePlaneParam>::const_iterator pIt=newPlanes.begin();pIt!=newPlanes.end();++pIt)
+			{
+			/* Convert the plane to the data set's domain; surplus components are dropped, missing ones are zero: */
+			typename Plane::Vector normal;
+			for(int i=0;i<dimension;++i)
+				normal[i]=i<SourcePlaneParam::dimension?Scalar(pIt->getNormal()[i]):Scalar(0);
+			planes.push_back(Plane(normal,Scalar(pIt->getOffset())));
+			}
+		numCellsSkipped=0;
+		numTrianglesSaved=0;
+		}
+	bool isActive(void) const // Returns true if there are any cutting planes
+		{
+		return !planes.empty();
+		}
+	bool isClipped(const Cell& cell) const // Returns true if all of the cell's vertices lie outside the same cutting plane
+		{
+		for(typename std::vector<Plane>::const_iterator pIt=planes.begin();pIt!=planes.end();++pIt)
+			{
+			int i;
+			for(i=0;i<CellTopology::numVertices&&pIt->calcDistance(cell.getVertexPosition(i))<Scalar(0);++i)
+				;
+			if(i==CellTopology::numVertices)
+				return true;
+			}
+		return false;
+		}
+	void skipCell(size_t numTriangles) // Records that a clipped cell containing the given number of triangles was skipped
+		{
+		++numCellsSkipped;
+		numTrianglesSaved+=numTriangles;
+		}
+	size_t getNumCellsSkipped(void) const // Returns the number of cells skipped since the planes were last set
+		{
+		return numCellsSkipped;
+		}
+	size_t getNumTrianglesSaved(void) const // Returns the number of triangles not extracted since the planes were last set
+		{
+		return numTrianglesSaved;
+		}
+	};
+
+}
+
+}
+
+#endif
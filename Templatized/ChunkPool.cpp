@@ -0,0 +1,222 @@
+/***********************************************************************
+ChunkPool - Process-wide pool recycling the fixed-size buffer chunks of
+triangle sets and polylines across extractions.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Templatized/ChunkPool.h>
+
+#include <new>
+#include <iostream>
+#include <Threads/Mutex.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+namespace {
+
+/**************
+Helper classes:
+**************/
+
+struct FreeBlock // Header overlaid onto free blocks in the pool
+	{
+	/* Elements: */
+	public:
+	FreeBlock* succ; // Pointer to the next free block of the same size class
+	};
+
+struct SizeClass // Structure for lists of free blocks of the same size
+	{
+	/* Elements: */
+	public:
+	size_t blockSize; // Size of blocks in this class in bytes, or 0 if the class is unused
+	FreeBlock* head; // Pointer to the first free block of this class
+	};
+
+/****************************
+Static pool state and limits:
+****************************/
+
+const size_t granularity=64; // Block sizes are rounded up to multiples of this many bytes to form size classes
+const int maxNumSizeClasses=32; // Maximum number of distinct block sizes kept by the pool
+Threads::Mutex poolMutex; // Mutex serializing access to the pool
+SizeClass sizeClasses[maxNumSizeClasses]; // Array of size classes; unused entries have a block size of 0
+size_t maxNumBytesRetained=size_t(256)*size_t(1024*1024); // Hard limit on the number of bytes kept in free blocks
+ChunkPool::Statistics statistics={0,0,0,0,0,0}; // Current usage counters
+size_t prevHighWaterMark=0; // High-water mark of the previous trim interval
+
+/****************
+Helper functions:
+****************/
+
+inline size_t roundBlockSize(size_t size)
+	{
+	return ((size+granularity-1)/granularity)*granularity;
+	}
+
+SizeClass* findSizeClass(size_t blockSize)
+	{
+	/* Find the block size's class, or claim an unused one: */
+	for(int i=0;i<maxNumSizeClasses;++i)
+		{
+		if(sizeClasses[i].blockSize==blockSize)
+			return &sizeClasses[i];
+		if(sizeClasses[i].blockSize==0)
+			{
+			sizeClasses[i].blockSize=blockSize;
+			sizeClasses[i].head=0;
+			return &sizeClasses[i];
+			}
+		}
+	
+	/* The size class table is full: */
+	return 0;
+	}
+
+void releaseRetained(size_t targetNumBytesRetained)
+	{
+	/* Return free blocks to the heap, one from each size class in turn, until the retained size drops below the target: */
+	bool releasedAny=true;
+	while(statistics.numBytesRetained>targetNumBytesRetained&&releasedAny)
+		{
+		releasedAny=false;
+		for(int i=0;i<maxNumSizeClasses&&statistics.numBytesRetained>targetNumBytesRetained;++i)
+			if(sizeClasses[i].head!=0)
+				{
+				FreeBlock* block=sizeClasses[i].head;
+				sizeClasses[i].head=block->succ;
+				::operator delete(block);
+				statistics.numBytesRetained-=sizeClasses[i].blockSize;
+				statistics.numBytesTrimmed+=sizeClasses[i].blockSize;
+				releasedAny=true;
+				}
+		}
+	}
+
+}
+
+/**************************
+Methods of class ChunkPool:
+**************************/
+
+void* ChunkPool::allocate(size_t size)
+	{
+	size_t blockSize=roundBlockSize(size);
+	
+		{
+		Threads::Mutex::Lock poolLock(poolMutex);
+		
+		/* Account for the new block: */
+		statistics.numBytesInUse+=blockSize;
+		if(statistics.highWaterMark<statistics.numBytesInUse)
+			statistics.highWaterMark=statistics.numBytesInUse;
+		
+		/* Recycle a free block of the same size if there is one: */
+		SizeClass* sc=findSizeClass(blockSize);
+		if(sc!=0&&sc->head!=0)
+			{
+			FreeBlock* block=sc->head;
+			sc->head=block->succ;
+			statistics.numBytesRetained-=blockSize;
+			++statistics.numHits;
+			return block;
+			}
+		++statistics.numMisses;
+		}
+	
+	/* Allocate a new block outside the lock: */
+	return ::operator new(blockSize);
+	}
+
+void ChunkPool::release(void* block,size_t size)
+	{
+	if(block==0)
+		return;
+	
+	size_t blockSize=roundBlockSize(size);
+	
+		{
+		Threads::Mutex::Lock poolLock(poolMutex);
+		statistics.numBytesInUse-=blockSize;
+		
+		/* Keep the block if its size class exists and the pool has room: */
+		SizeClass* sc=findSizeClass(blockSize);
+		if(sc!=0&&statistics.numBytesRetained+blockSize<=maxNumBytesRetained)
+			{
+			FreeBlock* freeBlock=static_cast<FreeBlock*>(block);
+			freeBlock->succ=sc->head;
+			sc->head=freeBlock;
+			statistics.numBytesRetained+=blockSize;
+			return;
+			}
+		}
+	
+	/* Return the block to the heap: */
+	::operator delete(block);
+	}
+
+void ChunkPool::setMaxNumBytesRetained(size_t newMaxNumBytesRetained)
+	{
+	Threads::Mutex::Lock poolLock(poolMutex);
+	maxNumBytesRetained=newMaxNumBytesRetained;
+	releaseRetained(maxNumBytesRetained);
+	}
+
+void ChunkPool::trim(void)
+	{
+	Threads::Mutex::Lock poolLock(poolMutex);
+	
+	/*********************************************************************
+	Keep only as many free blocks as are needed to grow back to the
+	larger of the last two intervals' high-water marks. A burst of
+	extractions is therefore served from the pool while it lasts, and its
+	memory is given back two trim intervals after it ends.
+	*********************************************************************/
+	
+	size_t peak=statistics.highWaterMark;
+	if(peak<prevHighWaterMark)
+		peak=prevHighWaterMark;
+	releaseRetained(peak-statistics.numBytesInUse);
+	
+	/* Start a new interval: */
+	prevHighWaterMark=statistics.highWaterMark;
+	statistics.highWaterMark=statistics.numBytesInUse;
+	}
+
+ChunkPool::Statistics ChunkPool::getStatistics(void)
+	{
+	Threads::Mutex::Lock poolLock(poolMutex);
+	return statistics;
+	}
+
+void ChunkPool::printStatistics(std::ostream& os)
+	{
+	Statistics s=getStatistics();
+	os<<"Geometry chunk pool: "<<s.numHits<<" hits, "<<s.numMisses<<" misses";
+	if(s.numHits+s.numMisses>0)
+		os<<" ("<<double(s.numHits)*100.0/double(s.numHits+s.numMisses)<<"% hit rate)";
+	os<<", "<<double(s.numBytesRetained)/(1024.0*1024.0)<<" MB retained, "<<double(s.numBytesTrimmed)/(1024.0*1024.0)<<" MB trimmed";
+	os<<std::endl;
+	}
+
+}
+
+}
@@ -0,0 +1,62 @@
+/***********************************************************************
+ChunkPool - Process-wide pool recycling the fixed-size buffer chunks of
+triangle sets and polylines across extractions.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_CHUNKPOOL_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_CHUNKPOOL_INCLUDED
+
+#include <stddef.h>
+#include <iosfwd>
+
+namespace Visualization {
+
+namespace Templatized {
+
+class ChunkPool
+	{
+	/* Embedded classes: */
+	public:
+	struct Statistics // Structure reporting the pool's usage counters
+		{
+		/* Elements: */
+		public:
+		size_t numHits; // Number of allocations served from the pool
+		size_t numMisses; // Number of allocations that had to go to the heap
+		size_t numBytesInUse; // Number of bytes in blocks currently handed out by the pool
+		size_t numBytesRetained; // Number of bytes in free blocks currently kept by the pool
+		size_t numBytesTrimmed; // Total number of bytes returned to the heap by trimming
+		size_t highWaterMark; // Highest number of bytes in use since the last trim
+		};
+	
+	/* Methods: */
+	static void* allocate(size_t size); // Returns a block of at least the given size, recycled from the pool if possible
+	static void release(void* block,size_t size); // Returns a block of the given size previously returned by allocate() to the pool
+	static void setMaxNumBytesRetained(size_t newMaxNumBytesRetained); // Sets the hard limit on the number of bytes kept in free blocks
+	static void trim(void); // Returns free blocks to the heap that were not needed to reach the last two trim intervals' high-water marks
+	static Statistics getStatistics(void); // Returns the pool's current usage counters
+	static void printStatistics(std::ostream& os); // Prints a summary of the pool's usage counters to the given stream
+	};
+
+}
+
+}
+
+#endif
@@ -23,7 +23,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_COLOREDISOSURFACEEXTRACTOR_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_COLOREDISOSURFACEEXTRACTOR_INCLUDED
 
+#include <vector>
 #include <Misc/OneTimeQueue.h>
+#include <Templatized/EdgeSample.h>
 
 /* Forward declarations: */
 namespace Visualization {
@@ -51,6 +53,8 @@ class ColoredIsosurfaceExtractor
 	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from a data set
 	typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
 	typedef IsosurfaceParam Isosurface; // Type of isosurface representation
+	typedef EdgeSample<DataSet> VertexSample; // Type to remember where extracted vertices lie inside the data set's cells
+	typedef std::vector<VertexSample> VertexSampleList; // Type for lists of vertex samples, in isosurface vertex order
 	
 	enum ExtractionMode // Enumerated type for isosurface extraction modes
 		{
@@ -75,6 +79,7 @@ class ColoredIsosurfaceExtractor
 	/* Isosurface extraction state: */
 	VScalar isovalue; // The current isovalue
 	Isosurface* isosurface; // Pointer to the isosurface representation storing extracted isosurface fragments
+	VertexSampleList* vertexSamples; // List receiving a sample for each vertex added to the isosurface, or 0
 	CellQueue cellQueue; // Queue of cells waiting for fragment extraction
 	
 	/* Private methods: */
@@ -122,6 +127,10 @@ class ColoredIsosurfaceExtractor
 		}
 	void setColorScalarExtractor(const ScalarExtractor& newColorScalarExtractor); // Sets the scalar extractor for isosurface color values
 	void setExtractionMode(ExtractionMode newExtractionMode); // Sets the current isosurface extraction mode
+	void setVertexSamples(VertexSampleList* newVertexSamples) // Sets a list receiving a sample for each vertex of the next extracted isosurface, or 0 to disable sampling
+		{
+		vertexSamples=newVertexSamples;
+		}
 	void extractIsosurface(VScalar newIsovalue,Isosurface& newIsosurface); // Extracts a global isosurface for the given isovalue and stores it in the given isosurface
 	void extractSeededIsosurface(const Locator& seedLocator,Isosurface& newIsosurface); // Extracts a seeded isosurface for the given isovalue from the given cell and stores it in the given isosurface
 	void startSeededIsosurface(const Locator& seedLocator,Isosurface& newIsosurface); // Starts extracting a seeded isosurface for the given isovalue from the given cell
@@ -29,11 +29,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/Vector.h>
 #include <Geometry/Box.h>
 #include <Geometry/ValuedPoint.h>
-#include <Geometry/ArrayKdTree.h>
 
 #include <Templatized/Tesseract.h>
 #include <Templatized/LinearIndexID.h>
 #include <Templatized/IteratorWrapper.h>
+#include <Templatized/MappedKdTree.h>
+#include <Templatized/SphericalGridIndex.h>
 
 /* Forward declarations: */
 namespace Visualization {
@@ -277,7 +278,7 @@ class Curvilinear
 	
 	private:
 	typedef Geometry::ValuedPoint<Point,CellID> CellCenter; // Data type to associate a cell's center point and its ID
-	typedef Geometry::ArrayKdTree<CellCenter> CellCenterTree; // Data type for kd-trees to locate closest cell centers
+	typedef MappedKdTree<CellCenter> CellCenterTree; // Data type for kd-trees to locate closest cell centers
 	
 	friend class Vertex;
 	friend class Cell;
@@ -291,6 +292,8 @@ class Curvilinear
 	Index numCells; // Number of cells in data set in each dimension
 	int vertexOffsets[CellTopology::numVertices]; // Array of pointer offsets from a cell's base vertex to all cell vertices
 	CellCenterTree cellCenterTree; // Kd-tree containing cell centers
+	SphericalGridIndex<Scalar,dimensionParam> sphericalGridIndex; // Direct cell index if the grid is a logically-regular spherical shell
+	bool useSphericalGridIndex; // Flag whether findClosestCell uses the spherical grid index when it is valid
 	VertexIterator firstVertex,lastVertex; // Bounds of vertex list
 	CellIterator firstCell,lastCell; // Bounds of cell list
 	Box domainBox; // Bounding box of all vertices
@@ -356,12 +359,20 @@ class Curvilinear
 		return numCells;
 		}
 	void finalizeGrid(void); // Recalculates derived grid information after grid structure change
-	CellID findClosestCell(const Point& position) const; // Finds the cell whose center is closest to the given position, or an invalid ID if there is no close cell
+	CellID findClosestCell(const Point& position) const; // Finds a cell close to the given position, or an invalid ID if there is no close cell
 	Scalar getLocatorEpsilon(void) const // Returns the current default accuracy threshold for locators working on this data set
 		{
 		return locatorEpsilon;
 		}
 	void setLocatorEpsilon(Scalar newLocatorEpsilon); // Sets the default accuracy threshold for locators working on this data set
+	bool hasSphericalGridIndex(void) const // Returns true if the grid was recognized as a logically-regular spherical shell
+		{
+		return sphericalGridIndex.isValid();
+		}
+	void setUseSphericalGridIndex(bool newUseSphericalGridIndex) // Enables or disables locating points via the spherical grid index
+		{
+		useSphericalGridIndex=newUseSphericalGridIndex;
+		}
 	
 	/* Methods implementing the data set interface: */
 	size_t getTotalNumVertices(void) const // Returns total number of vertices in the data set
@@ -0,0 +1,503 @@
+/***********************************************************************
+DepthSorter - Helper class to sort the primitives of transparent
+visualization elements back to front using a parallel radix sort.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Templatized/DepthSorter.h>
+
+#include <string.h>
+#include <unistd.h>
+#include <iostream>
+#include <Misc/Timer.h>
+#include <Math/Math.h>
+#include <Threads/Mutex.h>
+#include <Threads/Cond.h>
+#include <Threads/Thread.h>
+
+#include <Templatized/Profiler.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+namespace {
+
+/******************************
+Static sorter state and limits:
+******************************/
+
+const size_t minNumThreadItems=65536; // Minimum number of items to sort per thread
+const size_t maxInsertionSortSize=32; // Buckets up to this size are sorted by insertion sort
+const float reuseCosine=0.99985f; // An order is reused if the view direction changed by less than about one degree
+const double maxKey=double((1U<<24)-1); // Keys are depths quantized to 24 bits
+Threads::Mutex statisticsMutex; // Mutex serializing access to the statistics
+DepthSorter::Statistics statistics={0,0,0,0.0}; // Current sorting counters
+
+}
+
+/*****************************************
+Declaration of struct DepthSorter::Worker:
+*****************************************/
+
+struct DepthSorter::Worker
+	{
+	/* Elements: */
+	public:
+	const float* centroids; // Array of item centroids
+	float direction[3]; // Direction along which items are sorted
+	float* depths; // Array of item depths along the sort direction
+	Misc::UInt32* keys; // Array of quantized item depths
+	unsigned int* order; // Item order being produced
+	Misc::UInt32* tempKeys; // Scratch array of keys
+	unsigned int* tempOrder; // Scratch array of item indices
+	double depthMin,depthScale; // Transformation from depths to keys
+	size_t firstItem,lastItem; // Index range of items handled by this worker in the key and scatter phases
+	const size_t* bucketStarts; // Shared array of 257 start indices of the items sharing a key's high byte
+	int firstBucket,lastBucket; // Range of buckets handled by this worker in the bucket sorting phase
+	size_t histogram[256]; // Per-worker counts of items per bucket, then the worker's scatter positions
+	float minDepth,maxDepth; // Depth range of this worker's items
+	
+	/* Methods: */
+	void* calcDepthsThreadMethod(void) // Calculates the depths of this worker's items and their range
+		{
+		minDepth=maxDepth=0.0f;
+		if(firstItem<lastItem)
+			minDepth=maxDepth=depths[firstItem]=centroids[firstItem*3+0]*direction[0]+centroids[firstItem*3+1]*direction[1]+centroids[firstItem*3+2]*direction[2];
+		const float* cPtr=centroids+(firstItem+1)*3;
+		for(size_t i=firstItem+1;i<lastItem;++i,cPtr+=3)
+			{
+			float d=cPtr[0]*direction[0]+cPtr[1]*direction[1]+cPtr[2]*direction[2];
+			depths[i]=d;
+			if(minDepth>d)
+				minDepth=d;
+			if(maxDepth<d)
+				maxDepth=d;
+			}
+		return 0;
+		}
+	void* calcKeysThreadMethod(void) // Quantizes this worker's depths and counts the items per bucket
+		{
+		for(int i=0;i<256;++i)
+			histogram[i]=0;
+		for(size_t i=firstItem;i<lastItem;++i)
+			{
+			keys[i]=Misc::UInt32((double(depths[i])-depthMin)*depthScale);
+			++histogram[keys[i]>>16];
+			}
+		return 0;
+		}
+	void* scatterThreadMethod(void) // Distributes this worker's items into their buckets using the scatter positions in the histogram
+		{
+		for(size_t i=firstItem;i<lastItem;++i)
+			{
+			size_t pos=histogram[keys[i]>>16]++;
+			tempKeys[pos]=keys[i];
+			tempOrder[pos]=(unsigned int)i;
+			}
+		return 0;
+		}
+	void sortBucket(size_t bucketStart,size_t bucketEnd) // Sorts one bucket by the low 16 bits of its keys
+		{
+		size_t n=bucketEnd-bucketStart;
+		Misc::UInt32* srcKeys=tempKeys+bucketStart;
+		unsigned int* srcOrder=tempOrder+bucketStart;
+		Misc::UInt32* destKeys=keys+bucketStart;
+		unsigned int* destOrder=order+bucketStart;
+		
+		if(n<=maxInsertionSortSize)
+			{
+			/* Sort small buckets in place: */
+			for(size_t i=1;i<n;++i)
+				{
+				Misc::UInt32 key=srcKeys[i];
+				unsigned int item=srcOrder[i];
+				size_t j;
+				for(j=i;j>0&&srcKeys[j-1]>key;--j)
+					{
+					srcKeys[j]=srcKeys[j-1];
+					srcOrder[j]=srcOrder[j-1];
+					}
+				srcKeys[j]=key;
+				srcOrder[j]=item;
+				}
+			}
+		else
+			{
+			/* Sort large buckets by two least-significant-digit radix passes: */
+			for(int shift=0;shift<16;shift+=8)
+				{
+				size_t counts[256];
+				for(int i=0;i<256;++i)
+					counts[i]=0;
+				for(size_t i=0;i<n;++i)
+					++counts[(srcKeys[i]>>shift)&0xffU];
+				
+				/* Skip the pass if all keys share the same digit: */
+				if(counts[(srcKeys[0]>>shift)&0xffU]==n)
+					continue;
+				
+				size_t pos=0;
+				for(int i=0;i<256;++i)
+					{
+					size_t count=counts[i];
+					counts[i]=pos;
+					pos+=count;
+					}
+				for(size_t i=0;i<n;++i)
+					{
+					size_t p=counts[(srcKeys[i]>>shift)&0xffU]++;
+					destKeys[p]=srcKeys[i];
+					destOrder[p]=srcOrder[i];
+					}
+				
+				/* Swap source and destination: */
+				Misc::UInt32* tk=srcKeys;
+				srcKeys=destKeys;
+				destKeys=tk;
+				unsigned int* to=srcOrder;
+				srcOrder=destOrder;
+				destOrder=to;
+				}
+			}
+		
+		/* Copy the sorted bucket into the result arrays if it ended up in the scratch arrays: */
+		if(srcOrder!=order+bucketStart)
+			{
+			memcpy(keys+bucketStart,srcKeys,n*sizeof(Misc::UInt32));
+			memcpy(order+bucketStart,srcOrder,n*sizeof(unsigned int));
+			}
+		}
+	void* sortBucketsThreadMethod(void) // Sorts all buckets handled by this worker
+		{
+		for(int b=firstBucket;b<lastBucket;++b)
+			if(bucketStarts[b]<bucketStarts[b+1])
+				sortBucket(bucketStarts[b],bucketStarts[b+1]);
+		return 0;
+		}
+	};
+
+/*********************************************
+Declaration of struct DepthSorter::WorkerPool:
+*********************************************/
+
+struct DepthSorter::WorkerPool
+	{
+	/* Embedded classes: */
+	public:
+	typedef void* (Worker::*Method)(void); // Type for worker methods run in a sorting phase
+	
+	struct PoolThread // Structure for a thread of the pool
+		{
+		/* Elements: */
+		public:
+		WorkerPool* pool; // The pool owning the thread
+		size_t workerIndex; // Index of the worker run by this thread in each phase
+		Threads::Thread thread; // The thread
+		
+		/* Methods: */
+		void* threadMethod(void)
+			{
+			pool->runThread(workerIndex);
+			return 0;
+			}
+		};
+	
+	/* Elements: */
+	Threads::Mutex phaseMutex; // Mutex protecting the pool's state
+	Threads::Cond phaseStartCond; // Condition variable signalled when a phase starts or the pool shuts down
+	Threads::Cond phaseDoneCond; // Condition variable signalled when the last pool thread finished its part of a phase
+	size_t numThreads; // Number of pool threads; the calling thread acts as an additional worker
+	PoolThread* threads; // Array of pool threads
+	bool busy; // Flag whether a depth sorter currently uses the pool
+	bool shutdown; // Flag telling the pool threads to terminate
+	unsigned int phase; // Number of phases started so far
+	Worker* workers; // Workers of the current phase
+	size_t numWorkers; // Number of workers in the current phase
+	Method method; // Worker method run in the current phase
+	size_t numPendingThreads; // Number of pool threads that did not yet finish the current phase
+	
+	/* Constructors and destructors: */
+	WorkerPool(size_t sNumThreads) // Starts the given number of pool threads
+		:numThreads(sNumThreads),threads(new PoolThread[sNumThreads]),
+		 busy(false),shutdown(false),phase(0),
+		 workers(0),numWorkers(0),method(0),numPendingThreads(0)
+		{
+		for(size_t i=0;i<numThreads;++i)
+			{
+			threads[i].pool=this;
+			threads[i].workerIndex=i+1;
+			threads[i].thread.start(&threads[i],&PoolThread::threadMethod);
+			}
+		}
+	~WorkerPool(void) // Terminates all pool threads
+		{
+		{
+		Threads::Mutex::Lock phaseLock(phaseMutex);
+		shutdown=true;
+		phaseStartCond.broadcast();
+		}
+		for(size_t i=0;i<numThreads;++i)
+			threads[i].thread.join();
+		delete[] threads;
+		}
+	
+	/* Methods: */
+	void runThread(size_t workerIndex) // Runs this thread's worker in every phase until the pool shuts down
+		{
+		Threads::Mutex::Lock phaseLock(phaseMutex);
+		unsigned int lastPhase=0;
+		while(true)
+			{
+			/* Wait for the next phase: */
+			while(!shutdown&&phase==lastPhase)
+				phaseStartCond.wait(phaseMutex);
+			if(shutdown)
+				break;
+			lastPhase=phase;
+			
+			/* Run this thread's worker if the phase has enough workers: */
+			if(workerIndex<numWorkers)
+				{
+				Worker* worker=&workers[workerIndex];
+				Method m=method;
+				phaseMutex.unlock();
+				(worker->*m)();
+				phaseMutex.lock();
+				}
+			
+			/* Wake up the calling thread if this was the last pool thread to finish: */
+			if(--numPendingThreads==0)
+				phaseDoneCond.signal();
+			}
+		}
+	size_t acquire(void) // Reserves the pool for the calling depth sorter; returns the number of pool threads, or 0 if the pool is in use
+		{
+		Threads::Mutex::Lock phaseLock(phaseMutex);
+		if(busy||numThreads==0)
+			return 0;
+		busy=true;
+		return numThreads;
+		}
+	void release(void) // Releases the pool after a sort
+		{
+		Threads::Mutex::Lock phaseLock(phaseMutex);
+		busy=false;
+		}
+	static void runPhase(WorkerPool* pool,Worker* workers,size_t numWorkers,Method method) // Runs the given method on all workers, on the given acquired pool if there is one and more than one worker
+		{
+		if(pool!=0&&numWorkers>1)
+			pool->run(workers,numWorkers,method);
+		else
+			(workers[0].*method)();
+		}
+	void run(Worker* newWorkers,size_t newNumWorkers,Method newMethod) // Runs the given method on all workers, using the calling thread for the first; pool must be acquired
+		{
+		/* Start a new phase: */
+		{
+		Threads::Mutex::Lock phaseLock(phaseMutex);
+		workers=newWorkers;
+		numWorkers=newNumWorkers;
+		method=newMethod;
+		numPendingThreads=numThreads;
+		++phase;
+		phaseStartCond.broadcast();
+		}
+		
+		/* Run the first worker in the calling thread: */
+		(newWorkers[0].*newMethod)();
+		
+		/* Wait until all pool threads finished the phase: */
+		Threads::Mutex::Lock phaseLock(phaseMutex);
+		while(numPendingThreads!=0)
+			phaseDoneCond.wait(phaseMutex);
+		}
+	};
+
+/****************************
+Methods of class DepthSorter:
+****************************/
+
+DepthSorter::DepthSorter(void)
+	:numOrderedItems(0)
+	{
+	for(int i=0;i<3;++i)
+		orderDirection[i]=0.0f;
+	}
+
+bool DepthSorter::update(size_t numItems,const float* centroids,const float direction[3],unsigned int order[])
+	{
+	/* Normalize the sort direction; only its direction affects the order: */
+	float dirLen2=direction[0]*direction[0]+direction[1]*direction[1]+direction[2]*direction[2];
+	if(dirLen2==0.0f)
+		return false;
+	float dirScale=1.0f/Math::sqrt(dirLen2);
+	float dir[3];
+	for(int i=0;i<3;++i)
+		dir[i]=direction[i]*dirScale;
+	
+	/* Reuse the previous order if the items are the same and the direction barely changed: */
+	if(numItems==numOrderedItems&&dir[0]*orderDirection[0]+dir[1]*orderDirection[1]+dir[2]*orderDirection[2]>=reuseCosine)
+		{
+		Threads::Mutex::Lock statisticsLock(statisticsMutex);
+		++statistics.numReusedOrders;
+		return false;
+		}
+	
+	Misc::Timer sortTimer;
+	static const unsigned int sortProbe=Profiler::registerTimer("Transparent depth sort",Profiler::RENDERING);
+	Profiler::Scope sortScope(sortProbe);
+	
+	/* Prepare the scratch arrays: */
+	depths.resize(numItems);
+	keys.resize(numItems);
+	tempKeys.resize(numItems);
+	tempOrder.resize(numItems);
+	
+	/* Determine the number of threads to use; small sorts run in the calling thread only: */
+	size_t numThreads=numItems/minNumThreadItems;
+	WorkerPool* pool=0;
+	if(numThreads>1)
+		{
+		/* Create the shared pool on first use, with one thread less than the number of CPUs as the calling thread works as well: */
+		long numCpus=sysconf(_SC_NPROCESSORS_ONLN);
+		static WorkerPool sharedPool(numCpus>1?size_t(numCpus-1):0);
+		
+		/* Use the pool unless another depth sorter is using it: */
+		size_t numPoolThreads=sharedPool.acquire();
+		if(numPoolThreads>0)
+			pool=&sharedPool;
+		if(numThreads>numPoolThreads+1)
+			numThreads=numPoolThreads+1;
+		}
+	if(numThreads<1)
+		numThreads=1;
+	
+	/* Split the items into one interval per thread: */
+	size_t bucketStarts[257];
+	Worker* workers=new Worker[numThreads];
+	for(size_t i=0;i<numThreads;++i)
+		{
+		Worker& w=workers[i];
+		w.centroids=centroids;
+		for(int j=0;j<3;++j)
+			w.direction[j]=dir[j];
+		w.depths=numItems>0?&depths[0]:0;
+		w.keys=numItems>0?&keys[0]:0;
+		w.order=order;
+		w.tempKeys=numItems>0?&tempKeys[0]:0;
+		w.tempOrder=numItems>0?&tempOrder[0]:0;
+		w.firstItem=(numItems*i)/numThreads;
+		w.lastItem=(numItems*(i+1))/numThreads;
+		w.bucketStarts=bucketStarts;
+		}
+	
+	/* Calculate item depths and their overall range: */
+	WorkerPool::runPhase(pool,workers,numThreads,&Worker::calcDepthsThreadMethod);
+	float minDepth=workers[0].minDepth;
+	float maxDepth=workers[0].maxDepth;
+	for(size_t i=1;i<numThreads;++i)
+		if(workers[i].firstItem<workers[i].lastItem)
+			{
+			if(minDepth>workers[i].minDepth)
+				minDepth=workers[i].minDepth;
+			if(maxDepth<workers[i].maxDepth)
+				maxDepth=workers[i].maxDepth;
+			}
+	double depthScale=maxDepth>minDepth?maxKey/(double(maxDepth)-double(minDepth)):0.0;
+	for(size_t i=0;i<numThreads;++i)
+		{
+		workers[i].depthMin=double(minDepth);
+		workers[i].depthScale=depthScale;
+		}
+	
+	/* Quantize the depths into keys and count the items per high key byte: */
+	WorkerPool::runPhase(pool,workers,numThreads,&Worker::calcKeysThreadMethod);
+	
+	/* Turn the per-worker counts into scatter positions: */
+	size_t pos=0;
+	for(int b=0;b<256;++b)
+		{
+		bucketStarts[b]=pos;
+		for(size_t i=0;i<numThreads;++i)
+			{
+			size_t count=workers[i].histogram[b];
+			workers[i].histogram[b]=pos;
+			pos+=count;
+			}
+		}
+	bucketStarts[256]=pos;
+	
+	/* Distribute the items into buckets by their keys' high bytes: */
+	WorkerPool::runPhase(pool,workers,numThreads,&Worker::scatterThreadMethod);
+	
+	/* Assign contiguous bucket ranges holding roughly equal numbers of items to the workers: */
+	int bucket=0;
+	for(size_t i=0;i<numThreads;++i)
+		{
+		workers[i].firstBucket=bucket;
+		size_t itemEnd=(numItems*(i+1))/numThreads;
+		while(bucket<256&&bucketStarts[bucket+1]<=itemEnd)
+			++bucket;
+		if(i==numThreads-1)
+			bucket=256;
+		workers[i].lastBucket=bucket;
+		}
+	
+	/* Sort all buckets by the remaining key bits: */
+	WorkerPool::runPhase(pool,workers,numThreads,&Worker::sortBucketsThreadMethod);
+	delete[] workers;
+	if(pool!=0)
+		pool->release();
+	
+	/* Remember the order's direction: */
+	numOrderedItems=numItems;
+	for(int i=0;i<3;++i)
+		orderDirection[i]=dir[i];
+	
+	/* Update the statistics: */
+	sortTimer.elapse();
+	{
+	Threads::Mutex::Lock statisticsLock(statisticsMutex);
+	++statistics.numSorts;
+	statistics.numSortedItems+=numItems;
+	statistics.sortTime+=sortTimer.getTime();
+	}
+	
+	return true;
+	}
+
+DepthSorter::Statistics DepthSorter::getStatistics(void)
+	{
+	Threads::Mutex::Lock statisticsLock(statisticsMutex);
+	return statistics;
+	}
+
+void DepthSorter::printStatistics(std::ostream& os)
+	{
+	Statistics s=getStatistics();
+	os<<"Transparent depth sorting: "<<s.numSorts<<" sorts of "<<s.numSortedItems<<" primitives, "<<s.numReusedOrders<<" reused orders";
+	if(s.numSortedItems>0)
+		os<<", "<<s.sortTime*1.0e9/double(s.numSortedItems)<<" ms per million primitives";
+	os<<std::endl;
+	}
+
+}
+
+}
@@ -0,0 +1,79 @@
+/***********************************************************************
+DepthSorter - Helper class to sort the primitives of transparent
+visualization elements back to front using a parallel radix sort.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_DEPTHSORTER_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_DEPTHSORTER_INCLUDED
+
+#include <stddef.h>
+#include <iosfwd>
+#include <vector>
+#include <Misc/SizedTypes.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+class DepthSorter
+	{
+	/* Embedded classes: */
+	public:
+	struct Statistics // Structure reporting process-wide depth sorting counters
+		{
+		/* Elements: */
+		public:
+		size_t numSorts; // Number of sorts performed
+		size_t numReusedOrders; // Number of sort requests answered by reusing the previous order
+		size_t numSortedItems; // Total number of items sorted
+		double sortTime; // Total time spent sorting in seconds
+		};
+	
+	private:
+	struct Worker; // Structure holding the state of a sorting thread
+	struct WorkerPool; // Structure for the persistent pool of sorting threads shared by all depth sorters
+	
+	/* Elements: */
+	std::vector<float> depths; // Depths of the items along the sort direction
+	std::vector<Misc::UInt32> keys; // Sort keys of the items in their current order
+	std::vector<Misc::UInt32> tempKeys; // Scratch array for radix sort passes
+	std::vector<unsigned int> tempOrder; // Scratch array for radix sort passes
+	size_t numOrderedItems; // Number of items in the most recently produced order, or 0 if there is no valid order
+	float orderDirection[3]; // Normalized direction along which the most recent order was produced
+	
+	/* Constructors and destructors: */
+	public:
+	DepthSorter(void); // Creates a depth sorter without a valid order
+	
+	/* Methods: */
+	void invalidate(void) // Forces a full sort on the next update, i.e., after item positions changed
+		{
+		numOrderedItems=0;
+		}
+	bool update(size_t numItems,const float* centroids,const float direction[3],unsigned int order[]); // Sorts items by the projection of their centroids (packed as x, y, z triples) onto the direction, ascending, into the given order array, unless the order from the previous call can be reused; returns true if the order array was rewritten
+	static Statistics getStatistics(void); // Returns the process-wide depth sorting counters
+	static void printStatistics(std::ostream& os); // Prints a summary of the depth sorting counters to the given stream
+	};
+
+}
+
+}
+
+#endif
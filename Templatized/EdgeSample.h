@@ -0,0 +1,73 @@
+/***********************************************************************
+EdgeSample - Class to remember where on an edge of a data set cell an
+extracted vertex lies, to re-evaluate other scalar variables at the
+vertex without locating it again.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_EDGESAMPLE_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_EDGESAMPLE_INCLUDED
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class DataSetParam>
+class EdgeSample
+	{
+	/* Embedded classes: */
+	public:
+	typedef DataSetParam DataSet; // Type of data set containing the sampled cell
+	typedef typename DataSet::Scalar Scalar; // Scalar type of the data set's domain
+	typedef typename DataSet::CellID CellID; // Type of the data set's cell IDs
+	
+	private:
+	typedef typename DataSet::CellTopology CellTopology; // Topology of the data set's cells
+	typedef typename DataSet::Cell Cell; // Type of the data set's cells
+	
+	/* Elements: */
+	CellID cellID; // ID of the cell whose edge contains the vertex
+	int edge; // Index of the edge inside the cell
+	Scalar weight; // Interpolation weight of the edge's second vertex
+	
+	/* Constructors and destructors: */
+	public:
+	EdgeSample(const CellID& sCellID,int sEdge,Scalar sWeight)
+		:cellID(sCellID),edge(sEdge),weight(sWeight)
+		{
+		}
+	
+	/* Methods: */
+	template <class ScalarExtractorParam>
+	typename ScalarExtractorParam::Scalar calcValue(const DataSet* dataSet,const ScalarExtractorParam& extractor) const // Interpolates the given scalar variable at the sampled vertex
+		{
+		typedef typename ScalarExtractorParam::Scalar VScalar;
+		
+		Cell cell=dataSet->getCell(cellID);
+		VScalar val0=cell.getVertexValue(CellTopology::edgeVertexIndices[edge][0],extractor);
+		VScalar val1=cell.getVertexValue(CellTopology::edgeVertexIndices[edge][1],extractor);
+		return val0*VScalar(Scalar(1)-weight)+val1*VScalar(weight);
+		}
+	};
+
+}
+
+}
+
+#endif
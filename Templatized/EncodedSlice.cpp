@@ -0,0 +1,296 @@
+/***********************************************************************
+EncodedSlice - Classes for value slices stored in compressed bricks of
+consecutive values that are decoded on demand through small per-thread
+caches of decoded bricks.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#define VISUALIZATION_TEMPLATIZED_ENCODEDSLICE_IMPLEMENTATION
+
+#include <Templatized/EncodedSlice.h>
+
+#include <string.h>
+#include <strings.h>
+#include <pthread.h>
+#include <Misc/ThrowStdErr.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+namespace {
+
+/****************************************
+Static encoded slice state and constants:
+****************************************/
+
+const char* codecNames[EncodedSliceBase::NUM_CODECS]={"float16","quantized8","quantized16","lossless"};
+unsigned int lastSliceId=0; // ID assigned to the most recently created encoded slice
+pthread_key_t brickCacheKey; // Key to release a thread's brick cache when the thread terminates
+pthread_once_t brickCacheKeyOnce=PTHREAD_ONCE_INIT; // Guard to create the brick cache key once
+const unsigned int hashTableSizeLog=12; // Binary logarithm of the size of the compressor's match hash table
+const size_t minMatchLength=4; // Minimum length of matches encoded by the compressor
+const size_t maxMatchOffset=65535; // Maximum distance of matches encoded by the compressor
+
+/****************
+Helper functions:
+****************/
+
+inline unsigned int readUInt32(const unsigned char* bytes)
+	{
+	unsigned int result;
+	memcpy(&result,bytes,sizeof(unsigned int));
+	return result;
+	}
+
+inline unsigned char* writeLength(unsigned char* dest,size_t length) // Writes the continuation bytes of a length that did not fit into its token nibble
+	{
+	for(;length>=255;length-=255)
+		*(dest++)=255;
+	*(dest++)=(unsigned char)(length);
+	return dest;
+	}
+
+inline const unsigned char* readLength(const unsigned char* source,const unsigned char* sourceEnd,size_t& length) // Adds the continuation bytes of an extended length
+	{
+	unsigned char byte;
+	do
+		{
+		if(source==sourceEnd)
+			Misc::throwStdErr("EncodedSlice: Corrupted compressed brick");
+		byte=*(source++);
+		length+=byte;
+		}
+	while(byte==255);
+	return source;
+	}
+
+unsigned char* writeSequence(unsigned char* dest,const unsigned char* literals,size_t numLiterals,size_t matchOffset,size_t matchLength) // Writes a run of literals followed by an optional match
+	{
+	/* Write the token byte: */
+	unsigned char* token=dest++;
+	*token=(unsigned char)((numLiterals<15?numLiterals:15)<<4);
+	if(numLiterals>=15)
+		dest=writeLength(dest,numLiterals-15);
+	
+	/* Copy the literals: */
+	memcpy(dest,literals,numLiterals);
+	dest+=numLiterals;
+	
+	if(matchLength>0)
+		{
+		/* Write the match offset and length: */
+		*(dest++)=(unsigned char)(matchOffset&0xffU);
+		*(dest++)=(unsigned char)((matchOffset>>8)&0xffU);
+		size_t length=matchLength-minMatchLength;
+		*token|=(unsigned char)(length<15?length:15);
+		if(length>=15)
+			dest=writeLength(dest,length-15);
+		}
+	
+	return dest;
+	}
+
+}
+
+/*****************************************
+Static elements of class EncodedSliceBase:
+*****************************************/
+
+__thread EncodedSliceBase::BrickCache* EncodedSliceBase::threadBrickCache=0;
+
+/*********************************
+Methods of class EncodedSliceBase:
+*********************************/
+
+void EncodedSliceBase::createBrickCacheKey(void)
+	{
+	pthread_key_create(&brickCacheKey,releaseBrickCache);
+	}
+
+void EncodedSliceBase::releaseBrickCache(void* cache)
+	{
+	/* Delete the terminated thread's decoded bricks and the cache itself: */
+	BrickCache* brickCache=static_cast<BrickCache*>(cache);
+	for(unsigned int i=0;i<BrickCache::numEntries;++i)
+		delete[] static_cast<double*>(brickCache->entries[i].values);
+	delete brickCache;
+	}
+
+const void* EncodedSliceBase::loadBrick(size_t brickIndex) const
+	{
+	/* Create the calling thread's cache on first use: */
+	BrickCache* cache=threadBrickCache;
+	if(cache==0)
+		{
+		pthread_once(&brickCacheKeyOnce,createBrickCacheKey);
+		cache=new BrickCache;
+		for(unsigned int i=0;i<BrickCache::numEntries;++i)
+			{
+			cache->entries[i].sliceId=0;
+			cache->entries[i].brickIndex=0;
+			cache->entries[i].values=0;
+			}
+		pthread_setspecific(brickCacheKey,cache);
+		threadBrickCache=cache;
+		}
+	
+	/* Look for the brick among the less recently used entries of its set: */
+	BrickCache::Entry* set=cache->entries+getCacheSet(sliceId,brickIndex);
+	unsigned int way;
+	for(way=0;way<BrickCache::numWays&&!(set[way].sliceId==sliceId&&set[way].brickIndex==brickIndex);++way)
+		;
+	if(way==BrickCache::numWays)
+		{
+		/* Decode the brick into the set's least recently used entry, replacing the entry's previous brick: */
+		way=BrickCache::numWays-1;
+		BrickCache::Entry& entry=set[way];
+		if(entry.values==0)
+			entry.values=new double[brickSize];
+		entry.sliceId=0;
+		decodeBrick(brickIndex,entry.values);
+		entry.sliceId=sliceId;
+		entry.brickIndex=brickIndex;
+		}
+	
+	/* Move the brick's entry to the front of its set: */
+	BrickCache::Entry entry=set[way];
+	for(;way>0;--way)
+		set[way]=set[way-1];
+	set[0]=entry;
+	
+	return entry.values;
+	}
+
+EncodedSliceBase::EncodedSliceBase(EncodedSliceBase::Codec sCodec,size_t sNumValues,size_t valueSize)
+	:codec(sCodec),numValues(sNumValues),
+	 numBricks((sNumValues+brickSize-1)>>brickSizeLog),
+	 sliceId(__sync_add_and_fetch(&lastSliceId,1U))
+	{
+	if(valueSize>maxValueSize)
+		Misc::throwStdErr("EncodedSlice: Value size %u exceeds maximum of %u bytes",(unsigned int)(valueSize),(unsigned int)(maxValueSize));
+	
+	/* Skip the reserved ID of unused cache entries if the ID counter wraps around: */
+	if(sliceId==0)
+		sliceId=__sync_add_and_fetch(&lastSliceId,1U);
+	}
+
+size_t EncodedSliceBase::compressBytes(const unsigned char* source,size_t sourceSize,unsigned char* dest)
+	{
+	/* Find matches greedily using a hash table of the most recent positions of all four-byte sequences: */
+	const unsigned int hashTableSize=1U<<hashTableSizeLog;
+	size_t hashTable[hashTableSize];
+	for(unsigned int i=0;i<hashTableSize;++i)
+		hashTable[i]=~size_t(0);
+	unsigned char* destPtr=dest;
+	size_t anchor=0;
+	size_t pos=0;
+	while(pos+minMatchLength<=sourceSize)
+		{
+		unsigned int sequence=readUInt32(source+pos);
+		unsigned int hash=(sequence*2654435761U)>>(32-hashTableSizeLog);
+		size_t candidate=hashTable[hash];
+		hashTable[hash]=pos;
+		if(candidate!=~size_t(0)&&pos-candidate<=maxMatchOffset&&readUInt32(source+candidate)==sequence)
+			{
+			/* Extend the match as far as possible: */
+			size_t matchLength=minMatchLength;
+			while(pos+matchLength<sourceSize&&source[candidate+matchLength]==source[pos+matchLength])
+				++matchLength;
+			
+			/* Write the pending literals and the match: */
+			destPtr=writeSequence(destPtr,source+anchor,pos-anchor,pos-candidate,matchLength);
+			pos+=matchLength;
+			anchor=pos;
+			}
+		else
+			++pos;
+		}
+	
+	/* Write the remaining literals: */
+	destPtr=writeSequence(destPtr,source+anchor,sourceSize-anchor,0,0);
+	
+	return size_t(destPtr-dest);
+	}
+
+void EncodedSliceBase::decompressBytes(const unsigned char* source,size_t sourceSize,unsigned char* dest,size_t destSize)
+	{
+	const unsigned char* sourceEnd=source+sourceSize;
+	unsigned char* destPtr=dest;
+	unsigned char* destEnd=dest+destSize;
+	while(source!=sourceEnd)
+		{
+		/* Read the token byte and copy the literals: */
+		unsigned char token=*(source++);
+		size_t numLiterals=token>>4;
+		if(numLiterals==15)
+			source=readLength(source,sourceEnd,numLiterals);
+		if(numLiterals>size_t(sourceEnd-source)||numLiterals>size_t(destEnd-destPtr))
+			Misc::throwStdErr("EncodedSlice: Corrupted compressed brick");
+		memcpy(destPtr,source,numLiterals);
+		source+=numLiterals;
+		destPtr+=numLiterals;
+		
+		/* The last sequence contains only literals: */
+		if(source==sourceEnd)
+			break;
+		
+		/* Read the match offset and length: */
+		if(sourceEnd-source<2)
+			Misc::throwStdErr("EncodedSlice: Corrupted compressed brick");
+		size_t matchOffset=size_t(source[0])|(size_t(source[1])<<8);
+		source+=2;
+		size_t matchLength=token&0x0fU;
+		if(matchLength==15)
+			source=readLength(source,sourceEnd,matchLength);
+		matchLength+=minMatchLength;
+		if(matchOffset==0||matchOffset>size_t(destPtr-dest)||matchLength>size_t(destEnd-destPtr))
+			Misc::throwStdErr("EncodedSlice: Corrupted compressed brick");
+		
+		/* Copy the match byte by byte, as it might overlap the bytes it produces: */
+		const unsigned char* matchPtr=destPtr-matchOffset;
+		for(size_t i=0;i<matchLength;++i)
+			*(destPtr++)=*(matchPtr++);
+		}
+	if(destPtr!=destEnd)
+		Misc::throwStdErr("EncodedSlice: Corrupted compressed brick");
+	}
+
+EncodedSliceBase::~EncodedSliceBase(void)
+	{
+	}
+
+const char* EncodedSliceBase::getCodecName(EncodedSliceBase::Codec codec)
+	{
+	return codecNames[codec];
+	}
+
+EncodedSliceBase::Codec EncodedSliceBase::parseCodecName(const char* codecName)
+	{
+	for(int i=0;i<NUM_CODECS;++i)
+		if(strcasecmp(codecName,codecNames[i])==0)
+			return Codec(i);
+	
+	Misc::throwStdErr("EncodedSlice: Unknown slice codec %s",codecName);
+	return NUM_CODECS;
+	}
+
+}
+
+}
@@ -0,0 +1,265 @@
+/***********************************************************************
+EncodedSlice - Classes for value slices stored in compressed bricks of
+consecutive values that are decoded on demand through small per-thread
+caches of decoded bricks.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_ENCODEDSLICE_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_ENCODEDSLICE_INCLUDED
+
+#include <stddef.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+class EncodedSliceBase // Base class for encoded slices, independent of the slice value type
+	{
+	/* Embedded classes: */
+	public:
+	enum Codec // Enumerated type for slice storage codecs
+		{
+		FLOAT16=0, // Values rounded to IEEE half precision
+		QUANTIZED8, // Values quantized to 8 bits between each brick's finite minimum and maximum; NaNs are kept, infinities are clamped
+		QUANTIZED16, // Values quantized to 16 bits between each brick's finite minimum and maximum; NaNs are kept, infinities are clamped
+		LOSSLESS, // Value bytes shuffled into byte planes and compressed with a byte-oriented LZ77 coder
+		NUM_CODECS
+		};
+	
+	static const unsigned int brickSizeLog=12; // Binary logarithm of the number of consecutive values in each brick
+	static const size_t brickSize=size_t(1)<<brickSizeLog; // Number of consecutive values in each brick
+	static const size_t maxValueSize=8; // Maximum size of a decoded value in bytes
+	
+	private:
+	struct BrickCache // Structure for set-associative per-thread caches of decoded bricks with least-recently-used replacement
+		{
+		/* Embedded classes: */
+		public:
+		static const unsigned int numSetsLog=4; // Binary logarithm of the number of cache sets
+		static const unsigned int numSets=1U<<numSetsLog; // Number of cache sets
+		static const unsigned int numWays=4; // Number of entries in each cache set
+		static const unsigned int numEntries=numSets*numWays; // Total number of cache entries
+		
+		struct Entry // Structure for a cache entry
+			{
+			/* Elements: */
+			public:
+			unsigned int sliceId; // ID of the slice whose brick is in the entry, or 0 if the entry is unused
+			size_t brickIndex; // Index of the brick in the entry
+			void* values; // Array of decoded brick values, or null if not allocated yet
+			};
+		
+		/* Elements: */
+		Entry entries[numEntries]; // Cache entries grouped by set; the entries of each set are ordered from most to least recently used
+		};
+	
+	/* Elements: */
+	static __thread BrickCache* threadBrickCache; // The calling thread's decoded brick cache, or null if not created yet
+	protected:
+	Codec codec; // Codec used to encode the slice
+	size_t numValues; // Number of values in the slice
+	size_t numBricks; // Number of bricks in the slice; the last brick might be partial
+	private:
+	unsigned int sliceId; // Unique ID to associate cached bricks with the slice
+	
+	/* Private methods: */
+	static void createBrickCacheKey(void); // Creates the key to release the brick caches of terminated threads
+	static void releaseBrickCache(void* cache); // Releases the brick cache of a terminated thread
+	static unsigned int getCacheSet(unsigned int sliceId,size_t brickIndex) // Returns the index of the first cache entry of the set that can hold a brick
+		{
+		return (((unsigned int)(brickIndex)*2654435761U+sliceId*0x85ebca6bU)>>(32-BrickCache::numSetsLog))*BrickCache::numWays;
+		}
+	const void* loadBrick(size_t brickIndex) const; // Finds a brick among the less recently used entries of its set, or decodes it into the set's least recently used entry, and returns its values
+	
+	/* Protected methods: */
+	protected:
+	EncodedSliceBase(Codec sCodec,size_t sNumValues,size_t valueSize); // Creates a slice of the given number of values of the given size
+	size_t getNumBrickValues(size_t brickIndex) const // Returns the number of values in the given brick
+		{
+		return brickIndex<numBricks-1?brickSize:numValues-brickIndex*brickSize;
+		}
+	virtual void decodeBrick(size_t brickIndex,void* values) const =0; // Decodes the given brick into the given value array
+	static unsigned short encodeHalf(float value) // Converts a value to IEEE half precision, rounding to nearest even
+		{
+		union
+			{
+			float f;
+			unsigned int u;
+			} bits;
+		bits.f=value;
+		unsigned int sign=(bits.u>>16)&0x8000U;
+		unsigned int absBits=bits.u&0x7fffffffU;
+		
+		/* Handle infinity, NaN, and values that overflow half precision: */
+		if(absBits>=0x7f800000U)
+			return sign|0x7c00U|(absBits>0x7f800000U?0x0200U:0x0000U);
+		if(absBits>=0x477ff000U)
+			return sign|0x7c00U;
+		
+		if(absBits<0x38800000U)
+			{
+			/* Handle values that become subnormal or zero in half precision: */
+			if(absBits<0x33000000U)
+				return sign;
+			unsigned int mantissa=(absBits&0x007fffffU)|0x00800000U;
+			unsigned int shift=126U-(absBits>>23);
+			unsigned int result=mantissa>>shift;
+			unsigned int remainder=mantissa&((1U<<shift)-1U);
+			unsigned int halfway=1U<<(shift-1U);
+			if(remainder>halfway||(remainder==halfway&&(result&1U)))
+				++result;
+			return sign|result;
+			}
+		
+		/* Re-bias the exponent and round the mantissa; a carry correctly increments the exponent: */
+		unsigned int result=(absBits-0x38000000U)>>13;
+		unsigned int remainder=absBits&0x1fffU;
+		if(remainder>0x1000U||(remainder==0x1000U&&(result&1U)))
+			++result;
+		return sign|result;
+		}
+	static float decodeHalf(unsigned short value) // Converts an IEEE half precision value to single precision
+		{
+		unsigned int sign=(unsigned int)(value&0x8000U)<<16;
+		unsigned int exponent=(value>>10)&0x1fU;
+		unsigned int mantissa=value&0x03ffU;
+		union
+			{
+			float f;
+			unsigned int u;
+			} bits;
+		if(exponent==0x1fU)
+			bits.u=sign|0x7f800000U|(mantissa<<13);
+		else if(exponent!=0U)
+			bits.u=sign|((exponent+112U)<<23)|(mantissa<<13);
+		else if(mantissa==0U)
+			bits.u=sign;
+		else
+			{
+			/* Normalize a subnormal value: */
+			exponent=113U;
+			while((mantissa&0x0400U)==0U)
+				{
+				mantissa<<=1;
+				--exponent;
+				}
+			bits.u=sign|(exponent<<23)|((mantissa&0x03ffU)<<13);
+			}
+		return bits.f;
+		}
+	static size_t getMaxCompressedSize(size_t sourceSize) // Returns the maximum size of a compressed block of bytes
+		{
+		return sourceSize+sourceSize/255+16;
+		}
+	static size_t compressBytes(const unsigned char* source,size_t sourceSize,unsigned char* dest); // Compresses a block of bytes into a buffer of at least the maximum compressed size; returns the compressed size
+	static void decompressBytes(const unsigned char* source,size_t sourceSize,unsigned char* dest,size_t destSize); // Decompresses a block of bytes of known uncompressed size
+	
+	/* Constructors and destructors: */
+	public:
+	virtual ~EncodedSliceBase(void);
+	
+	/* Methods: */
+	static const char* getCodecName(Codec codec); // Returns the name of a codec
+	static Codec parseCodecName(const char* codecName); // Returns the codec of the given case-insensitive name; throws exception if the name is unknown
+	Codec getCodec(void) const // Returns the slice's codec
+		{
+		return codec;
+		}
+	size_t getNumValues(void) const // Returns the number of values in the slice
+		{
+		return numValues;
+		}
+	virtual size_t getEncodedSize(void) const =0; // Returns the memory used by the encoded slice in bytes
+	const void* getDecodedBrick(size_t brickIndex) const // Returns the decoded values of the given brick; pointer is valid until the calling thread decodes another brick
+		{
+		/* Check the most recently used entry of the brick's set: */
+		BrickCache* cache=threadBrickCache;
+		if(cache!=0)
+			{
+			const BrickCache::Entry& entry=cache->entries[getCacheSet(sliceId,brickIndex)];
+			if(entry.sliceId==sliceId&&entry.brickIndex==brickIndex)
+				return entry.values;
+			}
+		return loadBrick(brickIndex);
+		}
+	};
+
+template <class ValueScalarParam>
+class EncodedSlice:public EncodedSliceBase
+	{
+	/* Embedded classes: */
+	public:
+	typedef ValueScalarParam ValueScalar; // Type of decoded slice values
+	
+	private:
+	struct Brick // Structure describing an encoded brick
+		{
+		/* Elements: */
+		public:
+		size_t dataOffset; // Offset of the brick's encoded data in the slice's data array
+		size_t dataSize; // Size of the brick's encoded data in bytes
+		ValueScalar offset; // Value represented by quantization level zero in quantized bricks
+		ValueScalar scale; // Value difference between adjacent quantization levels in quantized bricks; the highest level represents NaN
+		};
+	
+	struct EncodingWorker; // Structure holding the state of an encoding thread
+	
+	/* Elements: */
+	Brick* bricks; // Array of brick descriptors
+	unsigned char* data; // Encoded data of all bricks
+	size_t dataSize; // Total size of the encoded data in bytes
+	
+	/* Private methods: */
+	static bool isFinite(ValueScalar value) // Returns true if the given value is neither infinite nor NaN
+		{
+		return value-value==ValueScalar(0);
+		}
+	size_t encodeBrick(const ValueScalar* values,size_t numBrickValues,Brick& brick,unsigned char* buffer) const; // Encodes the given values into a buffer of sufficient size; returns the encoded size
+	virtual void decodeBrick(size_t brickIndex,void* values) const;
+	
+	/* Constructors and destructors: */
+	public:
+	EncodedSlice(Codec sCodec,const ValueScalar* values,size_t sNumValues); // Encodes the given array of values in parallel using the given codec
+	private:
+	EncodedSlice(const EncodedSlice& source); // Prohibit copy constructor
+	EncodedSlice& operator=(const EncodedSlice& source); // Prohibit assignment operator
+	public:
+	virtual ~EncodedSlice(void);
+	
+	/* Methods from EncodedSliceBase: */
+	virtual size_t getEncodedSize(void) const;
+	
+	/* New methods: */
+	ValueScalar getValue(size_t linearIndex) const // Returns the decoded value at the given linear index
+		{
+		const ValueScalar* brickValues=static_cast<const ValueScalar*>(getDecodedBrick(linearIndex>>brickSizeLog));
+		return brickValues[linearIndex&(brickSize-1)];
+		}
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_ENCODEDSLICE_IMPLEMENTATION
+#include <Templatized/EncodedSlice.icpp>
+#endif
+
+#endif
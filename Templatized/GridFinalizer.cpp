@@ -0,0 +1,105 @@
+/***********************************************************************
+GridFinalizer - Helper class to calculate the derived grid information
+of non-Cartesian data sets, i.e., domain bounds, cell centers, cell size
+statistics, and cell center kd-trees, in parallel.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#define VISUALIZATION_TEMPLATIZED_GRIDFINALIZER_IMPLEMENTATION
+
+#include <Templatized/GridFinalizer.h>
+
+#include <stdio.h>
+#include <unistd.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+namespace {
+
+/************************
+Grid finalization limits:
+************************/
+
+const size_t minNumThreadItems=65536; // Minimum number of points or cells to process per thread
+
+}
+
+/**************************************
+Static elements of class GridFinalizer:
+**************************************/
+
+unsigned int GridFinalizer::numThreads=0;
+std::string GridFinalizer::cacheDirectory;
+
+/******************************
+Methods of class GridFinalizer:
+******************************/
+
+std::string GridFinalizer::getTreeFileName(const char* treeName,Misc::UInt64 fingerprint)
+	{
+	char fingerprintBuffer[32];
+	snprintf(fingerprintBuffer,sizeof(fingerprintBuffer),"%016llx",(unsigned long long)fingerprint);
+	std::string result=cacheDirectory;
+	result.push_back('/');
+	result.append(treeName);
+	result.push_back('-');
+	result.append(fingerprintBuffer);
+	result.append(".kdtree");
+	return result;
+	}
+
+void GridFinalizer::setNumThreads(unsigned int newNumThreads)
+	{
+	numThreads=newNumThreads;
+	}
+
+unsigned int GridFinalizer::getNumThreads(void)
+	{
+	if(numThreads!=0)
+		return numThreads;
+	
+	/* Use one thread per online CPU: */
+	long numCpus=sysconf(_SC_NPROCESSORS_ONLN);
+	return numCpus>1?(unsigned int)(numCpus):1U;
+	}
+
+size_t GridFinalizer::getNumWorkers(size_t numItems)
+	{
+	size_t result=getNumThreads();
+	if(result>numItems/minNumThreadItems)
+		result=numItems/minNumThreadItems;
+	if(result<1)
+		result=1;
+	return result;
+	}
+
+void GridFinalizer::setCacheDirectory(const char* newCacheDirectory)
+	{
+	cacheDirectory=newCacheDirectory!=0?newCacheDirectory:"";
+	
+	/* Strip trailing slashes except for the root directory: */
+	while(cacheDirectory.size()>1&&cacheDirectory[cacheDirectory.size()-1]=='/')
+		cacheDirectory.erase(cacheDirectory.size()-1);
+	}
+
+}
+
+}
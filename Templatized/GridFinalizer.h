@@ -0,0 +1,113 @@
+/***********************************************************************
+GridFinalizer - Helper class to calculate the derived grid information
+of non-Cartesian data sets, i.e., domain bounds, cell centers, cell size
+statistics, and cell center kd-trees, in parallel.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_GRIDFINALIZER_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_GRIDFINALIZER_INCLUDED
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include <Misc/SizedTypes.h>
+
+#include <Templatized/MappedKdTree.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+class GridFinalizer
+	{
+	/* Embedded classes: */
+	public:
+	template <class ScalarParam>
+	struct CellStatistics // Structure for size statistics of a set of cells
+		{
+		/* Elements: */
+		public:
+		ScalarParam minCellRadius2; // Squared minimum "radius" of any cell
+		ScalarParam maxCellRadius2; // Squared maximum "radius" of any cell
+		double cellRadiusSum; // Sum of the "radii" of all cells
+		};
+	
+	private:
+	template <class BoxParam,class PointParam>
+	struct BoundsWorker; // Structure holding the state of a bounding box calculation thread
+	template <class CellTopologyParam,class CellIteratorParam,class CellCenterParam>
+	struct CellCenterWorker; // Structure holding the state of a cell center calculation thread
+	
+	/* Elements: */
+	static unsigned int numThreads; // Number of threads used to finalize grids, or 0 to use one thread per online CPU
+	static std::string cacheDirectory; // Directory holding saved cell center trees, or empty to always build trees
+	
+	/* Private methods: */
+	static std::string getTreeFileName(const char* treeName,Misc::UInt64 fingerprint); // Returns the name of the cache file for the given tree and grid fingerprint
+	
+	/* Methods: */
+	public:
+	static void setNumThreads(unsigned int newNumThreads); // Sets the number of threads used to finalize grids; 0 uses one thread per online CPU
+	static unsigned int getNumThreads(void); // Returns the number of threads used to finalize grids
+	static size_t getNumWorkers(size_t numItems); // Returns the number of workers among which to split the given number of items
+	static size_t getFirstItem(size_t numItems,size_t numWorkers,size_t worker) // Returns the index of the first item processed by the given worker
+		{
+		return (numItems*worker)/numWorkers;
+		}
+	template <class IndexParam>
+	static IndexParam calcIndex(size_t linearIndex,const IndexParam& size) // Converts a linear index into an array index for an array of the given size
+		{
+		IndexParam result;
+		for(int i=IndexParam::dimension-1;i>=0;--i)
+			{
+			result[i]=int(linearIndex%size_t(size[i]));
+			linearIndex/=size_t(size[i]);
+			}
+		return result;
+		}
+	static void setCacheDirectory(const char* newCacheDirectory); // Sets the directory in which cell center trees are saved for later runs; null or empty disables the cache
+	static const std::string& getCacheDirectory(void) // Returns the cell center tree cache directory
+		{
+		return cacheDirectory;
+		}
+	static Misc::UInt64 hashValue(Misc::UInt64 fingerprint,Misc::UInt64 value) // Mixes the given value into the given grid fingerprint
+		{
+		fingerprint=(fingerprint^value)*0x9e3779b97f4a7c15ULL;
+		return fingerprint^(fingerprint>>29);
+		}
+	template <class BoxParam,class PointParam>
+	static Misc::UInt64 addPoints(BoxParam& box,const PointParam* points,size_t numPoints,size_t pointStride,Misc::UInt64 fingerprint); // Adds the given strided array of points to the given box and returns the given grid fingerprint updated with the points' positions
+	template <class CellTopologyParam,class CellIteratorParam,class CellCenterParam>
+	static CellStatistics<typename CellCenterParam::Scalar> calcCellCenters(size_t numCells,const std::vector<CellIteratorParam>& workerCells,CellCenterParam* cellCenters); // Calculates the centers of the given number of cells of the given topology, split among one worker per given first cell, into the given array if not null, and returns the cells' size statistics
+	template <class StoredPointParam>
+	static bool loadTree(MappedKdTree<StoredPointParam>& tree,const char* treeName,Misc::UInt64 fingerprint); // Maps a tree saved for the grid of the given fingerprint from the cache directory; returns false if there is no matching saved tree
+	template <class StoredPointParam>
+	static void saveTree(const MappedKdTree<StoredPointParam>& tree,const char* treeName,Misc::UInt64 fingerprint); // Saves the given tree for the grid of the given fingerprint into the cache directory
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_GRIDFINALIZER_IMPLEMENTATION
+#include <Templatized/GridFinalizer.icpp>
+#endif
+
+#endif
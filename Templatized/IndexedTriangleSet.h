@@ -23,13 +23,21 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_INDEXEDTRIANGLESET_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_INDEXEDTRIANGLESET_INCLUDED
 
+#include <vector>
 #include <GL/gl.h>
 #include <GL/GLObject.h>
 
+#include <Templatized/VertexRange.h>
+#include <Templatized/ChunkPool.h>
+#include <Templatized/DepthSorter.h>
+
 /* Forward declarations: */
 namespace Cluster {
 class MulticastPipe;
 }
+namespace IO {
+class File;
+}
 
 namespace Visualization {
 
@@ -42,6 +50,7 @@ class IndexedTriangleSet:public GLObject
 	public:
 	typedef VertexParam Vertex; // Type for triangle vertices
 	typedef GLuint Index; // Type for vertex indices
+	typedef std::vector<VertexRange<Vertex> > VertexRangeList; // Type for lists of contiguous runs of vertices
 	
 	private:
 	static const size_t vertexChunkSize=10000; // Number of vertices per vertex chunk
@@ -59,6 +68,16 @@ class IndexedTriangleSet:public GLObject
 			:succ(0)
 			{
 			}
+		
+		/* Methods: */
+		static void* operator new(size_t size) // Allocates chunks from the process-wide chunk pool
+			{
+			return ChunkPool::allocate(size);
+			}
+		static void operator delete(void* chunk,size_t size) // Returns chunks to the process-wide chunk pool
+			{
+			ChunkPool::release(chunk,size);
+			}
 		};
 	
 	struct IndexChunk // Structure for index buffer chunks
@@ -73,6 +92,16 @@ class IndexedTriangleSet:public GLObject
 			:succ(0)
 			{
 			}
+		
+		/* Methods: */
+		static void* operator new(size_t size) // Allocates chunks from the process-wide chunk pool
+			{
+			return ChunkPool::allocate(size);
+			}
+		static void operator delete(void* chunk,size_t size) // Returns chunks to the process-wide chunk pool
+			{
+			ChunkPool::release(chunk,size);
+			}
 		};
 	
 	struct DataItem:public GLObject::DataItem
@@ -82,8 +111,15 @@ class IndexedTriangleSet:public GLObject
 		GLuint vertexBufferId; // ID of buffer object for vertex data
 		GLuint indexBufferId; // ID of buffer object for index data
 		unsigned int version; // Version number of the triangle set in the buffer objects
+		unsigned int texCoordVersion; // Version number of the vertex texture coordinates in the vertex buffer
 		size_t numVertices; // Number of vertices in the vertex buffer
 		size_t numTriangles; // Number of triangles (index triples) in the index buffer
+		bool sortedIndexBuffer; // Flag if the index buffer holds triangles in back-to-front order
+		size_t numSortTriangles; // Number of triangles whose centroids are in the centroid array
+		std::vector<float> centroids; // Triangle centroids for depth sorting
+		DepthSorter depthSorter; // Sorter producing back-to-front triangle orders for this context
+		std::vector<unsigned int> triangleOrder; // Current back-to-front triangle order
+		std::vector<Index> sortedIndices; // Staging buffer for depth-sorted vertex indices
 		
 		/* Constructors and destructors: */
 		DataItem(void);
@@ -94,6 +130,7 @@ class IndexedTriangleSet:public GLObject
 	private:
 	Cluster::MulticastPipe* pipe; // Pipe to stream triangle set data in a cluster environment (owned by caller)
 	unsigned int version; // Version number of the triangle set (incremented on each clear operation)
+	unsigned int texCoordVersion; // Version number of the vertex texture coordinates (incremented on each in-place update)
 	size_t numVertices; // Number of vertices in the triangle set
 	size_t numTriangles; // Number of triangles (index triples) in the triangle set
 	VertexChunk* vertexHead; // Pointer to first vertex buffer chunk
@@ -110,6 +147,9 @@ class IndexedTriangleSet:public GLObject
 	/* Private methods: */
 	void addNewVertexChunk(void); // Adds a new chunk to the vertex buffer
 	void addNewIndexChunk(void); // Adds a new chunk to the index buffer
+	bool updateTexCoords(size_t numRenderVertices) const; // Updates only the texture coordinates in the currently bound vertex buffer; returns false if the buffer could not be updated
+	void calcCentroids(size_t numRenderTriangles,std::vector<float>& centroids) const; // Calculates the centroids of the given number of triangles
+	void uploadSortedIndices(size_t numRenderTriangles,DataItem* dataItem) const; // Uploads the given number of triangles into the currently bound index buffer in the data item's triangle order
 	
 	/* Constructors and destructors: */
 	public:
@@ -160,6 +200,14 @@ class IndexedTriangleSet:public GLObject
 		}
 	void receive(void); // Receives triangle set data via multicast pipe until next flush() point
 	void flush(void); // Sends pending triangle set data across the multicast pipe and terminates receive() method on slaves
+	size_t getGeometrySize(void) const; // Returns the number of bytes written by writeGeometry
+	void writeGeometry(IO::File& file) const; // Writes all vertices and triangles currently in the set to the given file
+	void readGeometry(IO::File& file); // Reads vertices and triangles written by writeGeometry into an empty set
+	void getVertexRanges(VertexRangeList& ranges); // Appends the storage ranges of all vertices currently in the set to the given list
+	void invalidateTexCoords(void) // Notifies the triangle set that vertex texture coordinates were changed in place
+		{
+		++texCoordVersion;
+		}
 	size_t getNumVertices(void) const // Returns number of vertices currently in buffer
 		{
 		return numVertices;
@@ -168,7 +216,7 @@ class IndexedTriangleSet:public GLObject
 		{
 		return numTriangles;
 		}
-	void glRenderAction(GLContextData& contextData) const; // Renders all triangles in the buffer
+	void glRenderAction(GLContextData& contextData,bool depthSort =false) const; // Renders all triangles in the buffer, optionally back to front with respect to the current modelview matrix
 	};
 
 }
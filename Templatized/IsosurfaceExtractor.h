@@ -24,6 +24,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #define VISUALIZATION_TEMPLATIZED_ISOSURFACEEXTRACTOR_INCLUDED
 
 #include <Misc/OneTimeQueue.h>
+#include <Templatized/CellClipper.h>
 
 /* Forward declarations: */
 namespace Visualization {
@@ -53,6 +54,7 @@ class IsosurfaceExtractor
 	typedef typename DataSet::Locator Locator; // Type of data set locators
 	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from a data set
 	typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
+	typedef CellClipper<DataSet> Clipper; // Type to cull cells outside of cutting planes
 	typedef IsosurfaceParam Isosurface; // Type of isosurface representation
 	
 	enum ExtractionMode // Enumerated type for isosurface extraction modes
@@ -73,6 +75,7 @@ class IsosurfaceExtractor
 	const DataSet* dataSet; // Data set the isosurface extractor works on
 	ScalarExtractor scalarExtractor; // Scalar extractor working on data set
 	ExtractionMode extractionMode; // Surface extraction mode
+	Clipper clipper; // Culls cells lying entirely outside of the active cutting planes
 	
 	/* Isosurface extraction state: */
 	VScalar isovalue; // The current isovalue
@@ -82,6 +85,7 @@ class IsosurfaceExtractor
 	/* Private methods: */
 	int extractFlatIsosurfaceFragment(const Cell& cell); // Extracts a flat-shaded isosurface fragment from a cell and stores it in the current isosurface representation
 	int extractSmoothIsosurfaceFragment(const Cell& cell); // Extracts a gradient-shaded isosurface fragment from a cell and stores it in the current isosurface representation
+	int skipClippedCell(const Cell& cell); // Counts the triangles a clipped cell would contribute to the current isosurface without extracting them; returns the cell's case index
 	
 	/* Constructors and destructors: */
 	public:
@@ -115,7 +119,16 @@ class IsosurfaceExtractor
 		scalarExtractor=newScalarExtractor;
 		}
 	void setExtractionMode(ExtractionMode newExtractionMode); // Sets the current isosurface extraction mode
-	void extractIsosurface(VScalar newIsovalue,Isosurface& newIsosurface,Visualization::Abstract::Algorithm* algorithm); // Extracts a global isosurface for the given isovalue and stores it in the given isosurface
+	template <class ClipPlaneParam>
+	void setClipPlanes(const std::vector<ClipPlaneParam>& newClipPlanes) // Sets the cutting planes outside of which subsequent extractions skip cells, and resets the culling statistics
+		{
+		clipper.setPlanes(newClipPlanes);
+		}
+	const Clipper& getClipper(void) const // Returns the cell clipper to query culling statistics
+		{
+		return clipper;
+		}
+	void extractIsosurface(VScalar newIsovalue,Isosurface& newIsosurface,Visualization::Abstract::Algorithm* algorithm); // Extracts a global isosurface for the given isovalue and stores it in the given isosurface; reports progress to the algorithm if it is not null
 	void extractSeededIsosurface(const Locator& seedLocator,Isosurface& newIsosurface); // Extracts a seeded isosurface for the given isovalue from the given cell and stores it in the given isosurface
 	void startSeededIsosurface(const Locator& seedLocator,Isosurface& newIsosurface); // Starts extracting a seeded isosurface for the given isovalue from the given cell
 	template <class ContinueFunctorParam>
@@ -56,6 +56,7 @@ class IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<V
 	typedef typename DataSet::Locator Locator; // Type of data set locators
 	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from a data set
 	typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
+	typedef CellClipper<DataSet> Clipper; // Type to cull cells outside of cutting planes
 	typedef IndexedTriangleSet<VertexParam> Isosurface; // Type of isosurface representation
 	
 	enum ExtractionMode // Enumerated type for isosurface extraction modes
@@ -79,6 +80,7 @@ class IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<V
 	const DataSet* dataSet; // Data set the isosurface extractor works on
 	ScalarExtractor scalarExtractor; // Scalar extractor working on data set
 	ExtractionMode extractionMode; // Surface extraction mode
+	Clipper clipper; // Culls cells lying entirely outside of the active cutting planes
 	
 	/* Isosurface extraction state: */
 	VScalar isovalue; // The current isovalue
@@ -89,6 +91,7 @@ class IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<V
 	/* Private methods: */
 	int extractFlatIsosurfaceFragment(const Cell& cell); // Extracts a flat-shaded isosurface fragment from a cell and stores it in the current isosurface representation
 	int extractSmoothIsosurfaceFragment(const Cell& cell); // Extracts a gradient-shaded isosurface fragment from a cell and stores it in the current isosurface representation
+	int skipClippedCell(const Cell& cell); // Counts the triangles a clipped cell would contribute to the current isosurface without extracting them; returns the cell's case index
 	
 	/* Constructors and destructors: */
 	public:
@@ -122,7 +125,16 @@ class IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<V
 		scalarExtractor=newScalarExtractor;
 		}
 	void setExtractionMode(ExtractionMode newExtractionMode); // Sets the current isosurface extraction mode
-	void extractIsosurface(VScalar newIsovalue,Isosurface& newIsosurface,Visualization::Abstract::Algorithm* algorithm); // Extracts a global isosurface for the given isovalue and stores it in the given isosurface
+	template <class ClipPlaneParam>
+	void setClipPlanes(const std::vector<ClipPlaneParam>& newClipPlanes) // Sets the cutting planes outside of which subsequent extractions skip cells, and resets the culling statistics
+		{
+		clipper.setPlanes(newClipPlanes);
+		}
+	const Clipper& getClipper(void) const // Returns the cell clipper to query culling statistics
+		{
+		return clipper;
+		}
+	void extractIsosurface(VScalar newIsovalue,Isosurface& newIsosurface,Visualization::Abstract::Algorithm* algorithm); // Extracts a global isosurface for the given isovalue and stores it in the given isosurface; reports progress to the algorithm if it is not null
 	void extractSeededIsosurface(const Locator& seedLocator,Isosurface& newIsosurface); // Extracts a seeded isosurface for the given isovalue from the given cell and stores it in the given isosurface
 	void startSeededIsosurface(const Locator& seedLocator,Isosurface& newIsosurface); // Starts extracting a seeded isosurface for the given isovalue from the given cell
 	template <class ContinueFunctorParam>
@@ -0,0 +1,62 @@
+/***********************************************************************
+LocatorSample - Class to remember the cell and local cell position of
+an extracted vertex, to re-evaluate other scalar variables at the
+vertex without locating it again.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_LOCATORSAMPLE_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_LOCATORSAMPLE_INCLUDED
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class DataSetParam>
+class LocatorSample
+	{
+	/* Embedded classes: */
+	public:
+	typedef DataSetParam DataSet; // Type of data set containing the sampled cell
+	typedef typename DataSet::Locator Locator; // Type of data set locators
+	
+	/* Elements: */
+	private:
+	Locator locator; // Copy of a locator that was successfully placed at the vertex
+	
+	/* Constructors and destructors: */
+	public:
+	LocatorSample(const Locator& sLocator)
+		:locator(sLocator)
+		{
+		}
+	
+	/* Methods: */
+	template <class ScalarExtractorParam>
+	typename ScalarExtractorParam::Scalar calcValue(const DataSet* dataSet,const ScalarExtractorParam& extractor) const // Interpolates the given scalar variable at the sampled vertex
+		{
+		return locator.calcValue(extractor);
+		}
+	};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,162 @@
+/***********************************************************************
+MappedKdTree - Class for kd-trees stored implicitly in arrays of points
+that are built in parallel and can be saved to files and memory-mapped
+back from them.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#define VISUALIZATION_TEMPLATIZED_MAPPEDKDTREE_IMPLEMENTATION
+
+#include <Templatized/MappedKdTree.h>
+
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <string>
+#include <Misc/ThrowStdErr.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+namespace {
+
+/*****************************
+Layout of saved kd-tree files:
+*****************************/
+
+const char fileMagic[8]={'V','i','s','K','d','T','r','1'}; // Identifier at the beginning of kd-tree files
+
+struct FileHeader // Structure for the header preceding the nodes in a kd-tree file
+	{
+	/* Elements: */
+	public:
+	char magic[8]; // File identifier
+	Misc::UInt32 nodeSize; // Size of a tree node in bytes
+	Misc::UInt32 reserved; // Padding to align the following fields
+	Misc::UInt64 numNodes; // Number of nodes in the tree
+	Misc::UInt64 fingerprint; // Fingerprint of the grid for which the tree was built
+	};
+
+}
+
+/*********************************
+Methods of class MappedKdTreeBase:
+*********************************/
+
+const void* MappedKdTreeBase::mapFile(const char* fileName,size_t nodeSize,Misc::UInt64 fingerprint,size_t& numNodes)
+	{
+	/* Release a previously mapped file: */
+	unmapFile();
+	
+	/* Open the tree file and check its size: */
+	int fd=open(fileName,O_RDONLY);
+	if(fd<0)
+		return 0;
+	struct stat fileStat;
+	if(fstat(fd,&fileStat)!=0||size_t(fileStat.st_size)<sizeof(FileHeader))
+		{
+		close(fd);
+		return 0;
+		}
+	
+	/* Map the entire file; the mapping stays valid after the file is closed: */
+	size_t fileSize=size_t(fileStat.st_size);
+	void* fileMapping=mmap(0,fileSize,PROT_READ,MAP_SHARED,fd,0);
+	close(fd);
+	if(fileMapping==MAP_FAILED)
+		return 0;
+	
+	/* Check that the file was written for the same node type and grid: */
+	const FileHeader* header=static_cast<const FileHeader*>(fileMapping);
+	if(memcmp(header->magic,fileMagic,sizeof(fileMagic))!=0||header->nodeSize!=nodeSize||header->fingerprint!=fingerprint||(fileSize-sizeof(FileHeader))/nodeSize!=header->numNodes||(fileSize-sizeof(FileHeader))%nodeSize!=0)
+		{
+		munmap(fileMapping,fileSize);
+		return 0;
+		}
+	
+	mapping=fileMapping;
+	mappingSize=fileSize;
+	numNodes=size_t(header->numNodes);
+	return header+1;
+	}
+
+void MappedKdTreeBase::unmapFile(void)
+	{
+	if(mapping!=0)
+		munmap(mapping,mappingSize);
+	mapping=0;
+	mappingSize=0;
+	}
+
+void MappedKdTreeBase::writeFile(const char* fileName,size_t nodeSize,Misc::UInt64 fingerprint,const void* nodes,size_t numNodes)
+	{
+	/* Write into a temporary file first so that concurrent readers never see a partial tree: */
+	std::string tempFileName=fileName;
+	char pidBuffer[32];
+	snprintf(pidBuffer,sizeof(pidBuffer),".%d.tmp",int(getpid()));
+	tempFileName.append(pidBuffer);
+	int fd=open(tempFileName.c_str(),O_WRONLY|O_CREAT|O_TRUNC,0644);
+	if(fd<0)
+		Misc::throwStdErr("MappedKdTree::save: Unable to create tree file %s",tempFileName.c_str());
+	
+	/* Write the file header and the node array: */
+	FileHeader header;
+	memset(&header,0,sizeof(FileHeader));
+	memcpy(header.magic,fileMagic,sizeof(fileMagic));
+	header.nodeSize=Misc::UInt32(nodeSize);
+	header.numNodes=Misc::UInt64(numNodes);
+	header.fingerprint=fingerprint;
+	const char* writePtrs[2]={reinterpret_cast<const char*>(&header),static_cast<const char*>(nodes)};
+	size_t writeSizes[2]={sizeof(FileHeader),nodeSize*numNodes};
+	bool ok=true;
+	for(int part=0;part<2&&ok;++part)
+		{
+		const char* writePtr=writePtrs[part];
+		size_t writeSize=writeSizes[part];
+		while(writeSize>0)
+			{
+			ssize_t written=write(fd,writePtr,writeSize);
+			if(written<=0)
+				{
+				ok=false;
+				break;
+				}
+			writePtr+=written;
+			writeSize-=size_t(written);
+			}
+		}
+	if(close(fd)!=0)
+		ok=false;
+	
+	/* Move the completed file into place: */
+	if(!ok||rename(tempFileName.c_str(),fileName)!=0)
+		{
+		unlink(tempFileName.c_str());
+		Misc::throwStdErr("MappedKdTree::save: Unable to write tree file %s",fileName);
+		}
+	}
+
+}
+
+}
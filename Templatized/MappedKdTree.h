@@ -0,0 +1,126 @@
+/***********************************************************************
+MappedKdTree - Class for kd-trees stored implicitly in arrays of points
+that are built in parallel and can be saved to files and memory-mapped
+back from them.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_MAPPEDKDTREE_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_MAPPEDKDTREE_INCLUDED
+
+#include <stddef.h>
+#include <Misc/SizedTypes.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+class MappedKdTreeBase // Base class for mapped kd-trees, independent of the stored point type
+	{
+	/* Elements: */
+	private:
+	void* mapping; // Memory-mapped tree file, or null if the tree's nodes are not mapped
+	size_t mappingSize; // Size of the memory-mapped tree file in bytes
+	
+	/* Protected methods: */
+	protected:
+	MappedKdTreeBase(void)
+		:mapping(0),mappingSize(0)
+		{
+		}
+	~MappedKdTreeBase(void)
+		{
+		unmapFile();
+		}
+	const void* mapFile(const char* fileName,size_t nodeSize,Misc::UInt64 fingerprint,size_t& numNodes); // Maps the nodes of a tree from the given file; returns null if the file does not exist or does not match the node size and grid fingerprint
+	void unmapFile(void); // Releases a memory-mapped tree file
+	static void writeFile(const char* fileName,size_t nodeSize,Misc::UInt64 fingerprint,const void* nodes,size_t numNodes); // Writes the given tree nodes to the given file; throws exception on failure
+	
+	/* Methods: */
+	public:
+	bool isMapped(void) const // Returns true if the tree's nodes are memory-mapped from a file
+		{
+		return mapping!=0;
+		}
+	};
+
+template <class StoredPointParam>
+class MappedKdTree:public MappedKdTreeBase
+	{
+	/* Embedded classes: */
+	public:
+	typedef StoredPointParam StoredPoint; // Type of points stored in the tree
+	typedef typename StoredPoint::Scalar Scalar; // Scalar type of the tree's space
+	static const int dimension=StoredPoint::dimension; // Dimension of the tree's space
+	typedef typename StoredPoint::Point Point; // Type of points in the tree's space
+	
+	private:
+	class SplitComparator; // Class to order points along a split dimension
+	struct BuildWorker; // Structure holding the state of a subtree building thread
+	
+	/* Elements: */
+	size_t numNodes; // Number of nodes in the tree
+	StoredPoint* ownedNodes; // Array of nodes allocated by the tree, or null if the nodes are mapped
+	const StoredPoint* nodes; // Array of nodes in tree order
+	
+	/* Private methods: */
+	void clear(void); // Releases the tree's nodes
+	void buildSubtree(size_t first,size_t last,int splitDimension,unsigned int numThreads); // Builds the subtree of the given node range with the given number of threads
+	template <class TraversalFunctionParam>
+	void traverseSubtreeDirected(size_t first,size_t last,int splitDimension,TraversalFunctionParam& traversalFunction) const; // Traverses the subtree of the given node range
+	
+	/* Constructors and destructors: */
+	public:
+	MappedKdTree(void) // Creates an empty tree
+		:numNodes(0),ownedNodes(0),nodes(0)
+		{
+		}
+	private:
+	MappedKdTree(const MappedKdTree& source); // Prohibit copy constructor
+	MappedKdTree& operator=(const MappedKdTree& source); // Prohibit assignment operator
+	public:
+	~MappedKdTree(void);
+	
+	/* Methods: */
+	StoredPoint* createTree(size_t newNumNodes); // Discards the current tree and returns an array of the given number of points to be filled in before calling releasePoints
+	void releasePoints(unsigned int numThreads =1); // Builds the tree from the filled-in points using the given number of threads
+	bool load(const char* fileName,Misc::UInt64 fingerprint); // Discards the current tree and maps a tree previously saved for the grid of the given fingerprint; returns false if there is no matching saved tree
+	void save(const char* fileName,Misc::UInt64 fingerprint) const; // Saves the tree for the grid of the given fingerprint; throws exception on failure
+	size_t getNumNodes(void) const // Returns the number of nodes in the tree
+		{
+		return numNodes;
+		}
+	template <class TraversalFunctionParam>
+	void traverseTreeDirected(TraversalFunctionParam& traversalFunction) const // Traverses the tree towards the traversal function's query position, visiting the far side of a node's split plane only if the traversal function returns true for the node
+		{
+		if(numNodes>0)
+			traverseSubtreeDirected(0,numNodes,0,traversalFunction);
+		}
+	const StoredPoint& findClosestPoint(const Point& queryPosition) const; // Returns the stored point closest to the given query position; tree must not be empty
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_MAPPEDKDTREE_IMPLEMENTATION
+#include <Templatized/MappedKdTree.icpp>
+#endif
+
+#endif
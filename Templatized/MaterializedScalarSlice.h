@@ -0,0 +1,266 @@
+/***********************************************************************
+MaterializedScalarSlice - Class for contiguous arrays of precomputed
+scalar values that replace per-access evaluation of derived variables.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_MATERIALIZEDSCALARSLICE_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_MATERIALIZEDSCALARSLICE_INCLUDED
+
+#include <stddef.h>
+#include <Misc/Autopointer.h>
+#include <Threads/RefCounted.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class ScalarParam>
+class MaterializedScalarSlice
+	{
+	/* Embedded classes: */
+	public:
+	typedef ScalarParam Scalar; // Type of materialized values
+	
+	private:
+	class Storage:public Threads::RefCounted // Reference-counted value array shared by all copies of an extractor
+		{
+		/* Elements: */
+		public:
+		Scalar* values; // The materialized values
+		size_t numValues; // Number of materialized values
+		
+		/* Constructors and destructors: */
+		Storage(size_t sNumValues)
+			:values(new Scalar[sNumValues]),numValues(sNumValues)
+			{
+			}
+		virtual ~Storage(void)
+			{
+			delete[] values;
+			}
+		};
+	
+	/* Elements: */
+	Misc::Autopointer<Storage> storage; // The value array, or null if the slice is empty
+	const char* valueBase; // Address of the source value belonging to the first materialized value
+	unsigned int strideShift; // Number of trailing zero bits of the distance between consecutive source values in bytes
+	size_t strideInverse; // Multiplicative inverse of the odd part of the distance between consecutive source values, modulo the size_t range
+	const Scalar* values; // Shortcut to the materialized values
+	
+	/* Constructors and destructors: */
+	public:
+	MaterializedScalarSlice(void) // Creates an empty slice
+		:valueBase(0),strideShift(0),strideInverse(0),values(0)
+		{
+		}
+	MaterializedScalarSlice(const void* sValueBase,ptrdiff_t sValueStride,size_t sNumValues) // Creates an uninitialized slice for the given source value layout; stride must be positive
+		:storage(new Storage(sNumValues)),
+		 valueBase(static_cast<const char*>(sValueBase)),strideShift(0),strideInverse(1),
+		 values(storage->values)
+		{
+		/*********************************************************************
+		Source value offsets are exact multiples of the stride, so they can be
+		divided by shifting out the stride's power of two and multiplying by
+		the inverse of its odd part, which wraps around to the exact index.
+		*********************************************************************/
+		
+		size_t oddStride=size_t(sValueStride);
+		while((oddStride&0x1U)==0)
+			{
+			oddStride>>=1;
+			++strideShift;
+			}
+		
+		/* Calculate the inverse by Newton iteration; each step doubles the number of correct bits: */
+		strideInverse=oddStride;
+		for(int i=0;i<6;++i)
+			strideInverse*=size_t(2)-oddStride*strideInverse;
+		}
+	
+	/* Methods: */
+	bool isMaterialized(void) const // Returns true if the slice contains values
+		{
+		return values!=0;
+		}
+	size_t getNumValues(void) const // Returns the number of values in the slice
+		{
+		return storage!=0?storage->numValues:0;
+		}
+	Scalar* getValues(void) // Returns the value array to fill in the slice
+		{
+		return storage->values;
+		}
+	template <class SourceValueParam>
+	Scalar getValue(const SourceValueParam& source) const // Returns the materialized value for the given source value inside the materialized data set
+		{
+		return values[(size_t(reinterpret_cast<const char*>(&source)-valueBase)>>strideShift)*strideInverse];
+		}
+	};
+
+template <class ValueParam>
+class ValueAddressExtractor // Value extractor returning the addresses of source values to probe a data set's value layout
+	{
+	/* Embedded classes: */
+	public:
+	typedef const ValueParam* DestValue; // Returned value type
+	typedef ValueParam SourceValue; // Source value type
+	
+	/* Methods: */
+	DestValue getValue(const SourceValue& source) const
+		{
+		return &source;
+		}
+	};
+
+template <class ScalarParam>
+class MaterializedScalarExtractorBase // Base class for scalar extractors that can read from materialized slices
+	{
+	/* Elements: */
+	protected:
+	MaterializedScalarSlice<ScalarParam> materializedSlice; // Precomputed values of the extracted scalar, if materialized
+	
+	/* Methods: */
+	public:
+	const MaterializedScalarSlice<ScalarParam>& getMaterializedSlice(void) const // Returns the extractor's materialized slice
+		{
+		return materializedSlice;
+		}
+	void setMaterializedSlice(const MaterializedScalarSlice<ScalarParam>& newMaterializedSlice) // Makes the extractor read from the given slice; an empty slice evaluates source values again
+		{
+		materializedSlice=newMaterializedSlice;
+		}
+	};
+
+template <class ScalarExtractorParam>
+class IsMaterializableScalarExtractor // Helper class to check whether a scalar extractor type derives from MaterializedScalarExtractorBase
+	{
+	/* Embedded classes: */
+	private:
+	typedef char Yes;
+	struct No
+		{
+		char dummy[2];
+		};
+	
+	/* Private methods: */
+	static Yes check(const MaterializedScalarExtractorBase<typename ScalarExtractorParam::Scalar>*);
+	static No check(...);
+	
+	/* Elements: */
+	public:
+	static const bool value=sizeof(check(static_cast<const ScalarExtractorParam*>(0)))==sizeof(Yes); // Flag whether the extractor type can read from materialized slices
+	};
+
+template <class ScalarExtractorParam,bool canMaterializeParam=IsMaterializableScalarExtractor<ScalarExtractorParam>::value>
+class ScalarExtractorMaterialization // Traits class for scalar extractors; by default, extractors do not support materialization
+	{
+	/* Embedded classes: */
+	public:
+	typedef ScalarExtractorParam ScalarExtractor; // Scalar extractor type
+	typedef MaterializedScalarSlice<typename ScalarExtractor::Scalar> Slice; // Type of materialized slices
+	static const bool canMaterialize=false; // Flag whether the extractor type can read from materialized slices
+	
+	/* Methods: */
+	static bool isMaterialized(const ScalarExtractor& se) // Returns true if the extractor reads from a materialized slice
+		{
+		return false;
+		}
+	static void setSlice(ScalarExtractor& se,const Slice& slice) // Makes the extractor read from the given slice, or evaluate source values again if the slice is empty
+		{
+		}
+	};
+
+template <class ScalarExtractorParam>
+class ScalarExtractorMaterialization<ScalarExtractorParam,true> // Traits class for scalar extractors derived from MaterializedScalarExtractorBase
+	{
+	/* Embedded classes: */
+	public:
+	typedef ScalarExtractorParam ScalarExtractor; // Scalar extractor type
+	typedef MaterializedScalarSlice<typename ScalarExtractor::Scalar> Slice; // Type of materialized slices
+	static const bool canMaterialize=true; // Flag whether the extractor type can read from materialized slices
+	
+	/* Methods: */
+	static bool isMaterialized(const ScalarExtractor& se)
+		{
+		return se.getMaterializedSlice().isMaterialized();
+		}
+	static void setSlice(ScalarExtractor& se,const Slice& slice)
+		{
+		se.setMaterializedSlice(slice);
+		}
+	};
+
+template <class ScalarExtractorParam>
+bool
+materializeScalarSlice(
+	const ScalarExtractorParam& scalarExtractor,
+	const typename ScalarExtractorParam::SourceValue* firstValue,
+	ptrdiff_t valueStride,
+	size_t numValues,
+	MaterializedScalarSlice<typename ScalarExtractorParam::Scalar>& slice); // Evaluates the extractor for all values of a uniformly strided value array in parallel into a new slice; extractor must not be materialized itself
+
+template <class ScalarExtractorParam>
+bool
+materializeScalarSlices(
+	int numScalarExtractors,
+	const ScalarExtractorParam scalarExtractors[],
+	const typename ScalarExtractorParam::SourceValue* firstValue,
+	ptrdiff_t valueStride,
+	size_t numValues,
+	MaterializedScalarSlice<typename ScalarExtractorParam::Scalar> slices[]); // Transposes a uniformly strided value array into one new slice per extractor in a single parallel pass; extractors must not be materialized themselves
+
+template <class DataSetParam,class ScalarExtractorParam,bool canMaterializeParam=ScalarExtractorMaterialization<ScalarExtractorParam>::canMaterialize>
+class DataSetScalarMaterializer // Helper class to materialize an extractor over a data set's vertex values; does nothing for extractors that cannot be materialized
+	{
+	/* Methods: */
+	public:
+	static size_t materialize(const DataSetParam& ds,ScalarExtractorParam& se) // Returns the size of the materialized slice in bytes, or 0 if the extractor was not materialized
+		{
+		return 0;
+		}
+	static void materialize(const DataSetParam& ds,int numScalarExtractors,ScalarExtractorParam ses[],size_t sliceSizes[]) // Stores the size of each extractor's materialized slice in bytes, or 0 if the extractor was not materialized
+		{
+		for(int i=0;i<numScalarExtractors;++i)
+			sliceSizes[i]=0;
+		}
+	};
+
+template <class DataSetParam,class ScalarExtractorParam>
+class DataSetScalarMaterializer<DataSetParam,ScalarExtractorParam,true>
+	{
+	/* Private methods: */
+	private:
+	static const typename DataSetParam::Value* getValueLayout(const DataSetParam& ds,ptrdiff_t& valueStride,size_t& numValues); // Returns the first vertex value if the data set's vertex values form a uniformly strided array in iteration order, null otherwise
+	
+	/* Methods: */
+	public:
+	static size_t materialize(const DataSetParam& ds,ScalarExtractorParam& se); // Materializes the extractor if the data set's vertex values form a uniformly strided array in iteration order
+	static void materialize(const DataSetParam& ds,int numScalarExtractors,ScalarExtractorParam ses[],size_t sliceSizes[]); // Materializes all extractors in a single pass over the data set's vertex values
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_MATERIALIZEDSCALARSLICE_IMPLEMENTATION
+#include <Templatized/MaterializedScalarSlice.icpp>
+#endif
+
+#endif
@@ -30,11 +30,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/Vector.h>
 #include <Geometry/Box.h>
 #include <Geometry/ValuedPoint.h>
-#include <Geometry/ArrayKdTree.h>
 
 #include <Templatized/Tesseract.h>
 #include <Templatized/LinearIndexID.h>
 #include <Templatized/IteratorWrapper.h>
+#include <Templatized/MappedKdTree.h>
+#include <Templatized/SphericalGridIndex.h>
 
 /* Forward declarations: */
 namespace Visualization {
@@ -106,6 +107,7 @@ class MultiCurvilinear
 		int vertexStrides[dimension]; // Array of pointer stride values in the vertex array
 		Index numCells; // Number of cells in data set in each dimension
 		int vertexOffsets[CellTopology::numVertices]; // Array of pointer offsets from a cell's base vertex to all cell vertices
+		SphericalGridIndex<Scalar,dimensionParam> sphericalGridIndex; // Direct cell index if the grid is a logically-regular spherical shell
 		
 		/* Constructors and destructors: */
 		private:
@@ -365,7 +367,7 @@ class MultiCurvilinear
 	
 	private:
 	typedef Geometry::ValuedPoint<Point,CellID> CellCenter; // Data type to associate a cell's center point and its ID
-	typedef Geometry::ArrayKdTree<CellCenter> CellCenterTree; // Data type for kd-trees to locate closest cell centers
+	typedef MappedKdTree<CellCenter> CellCenterTree; // Data type for kd-trees to locate closest cell centers
 	
 	friend class Vertex;
 	friend class Cell;
@@ -382,6 +384,7 @@ class MultiCurvilinear
 	CellID::Index* cellIDBases; // Bases of cell IDs for each grid
 	CellID** gridConnectors; // Arrays mapping outer faces of all grids to stitched grid cells
 	CellCenterTree cellCenterTree; // Kd-tree containing cell centers of all grids
+	bool useSphericalGridIndex; // Flag whether findClosestCell uses the grids' spherical grid indices when they are valid
 	VertexIterator firstVertex,lastVertex; // Bounds of vertex list
 	CellIterator firstCell,lastCell; // Bounds of cell list
 	Box domainBox; // Bounding box of all vertices
@@ -422,12 +425,16 @@ class MultiCurvilinear
 		return grids[gridIndex];
 		}
 	void finalizeGrid(void); // Recalculates derived grid information after grid structure change
-	CellID findClosestCell(const Point& position) const; // Finds the cell whose center is closest to the given position, or an invalid ID if there is no close cell
+	CellID findClosestCell(const Point& position) const; // Finds a cell close to the given position, or an invalid ID if there is no close cell
 	Scalar getLocatorEpsilon(void) const // Returns the current default accuracy threshold for locators working on this data set
 		{
 		return locatorEpsilon;
 		}
 	void setLocatorEpsilon(Scalar newLocatorEpsilon); // Sets the default accuracy threshold for locators working on this data set
+	void setUseSphericalGridIndex(bool newUseSphericalGridIndex) // Enables or disables locating points via the grids' spherical grid indices
+		{
+		useSphericalGridIndex=newUseSphericalGridIndex;
+		}
 	bool isBoundaryFace(int gridIndex,int faceIndex) const; // Returns true if the given face of the given grid is entirely on the boundary of the data set
 	bool isInteriorFace(int gridIndex,int faceIndex) const; // Returns true if the given face of the given grid is entirely in the interior of the data set
 	
@@ -22,13 +22,20 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_MULTIPOLYLINE_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_MULTIPOLYLINE_INCLUDED
 
+#include <vector>
 #include <GL/gl.h>
 #include <GL/GLObject.h>
 
+#include <Templatized/VertexRange.h>
+#include <Templatized/ChunkPool.h>
+
 /* Forward declarations: */
 namespace Cluster {
 class MulticastPipe;
 }
+namespace IO {
+class File;
+}
 
 namespace Visualization {
 
@@ -40,6 +47,7 @@ class MultiPolyline:public GLObject
 	/* Embedded classes: */
 	public:
 	typedef VertexParam Vertex; // Type for polyline vertices
+	typedef std::vector<VertexRange<Vertex> > VertexRangeList; // Type for lists of contiguous runs of vertices
 	
 	private:
 	static const size_t chunkSize=5000; // Number of vertices per chunk
@@ -56,6 +64,16 @@ class MultiPolyline:public GLObject
 			:succ(0)
 			{
 			}
+		
+		/* Methods: */
+		static void* operator new(size_t size) // Allocates chunks from the process-wide chunk pool
+			{
+			return ChunkPool::allocate(size);
+			}
+		static void operator delete(void* chunk,size_t size) // Returns chunks to the process-wide chunk pool
+			{
+			ChunkPool::release(chunk,size);
+			}
 		};
 	
 	struct Polyline // Structure holding state of an individual polyline
@@ -88,6 +106,7 @@ class MultiPolyline:public GLObject
 		unsigned int numPolylines; // Number of individual polylines
 		GLuint* vertexBufferIds; // Array of IDs of vertex buffer objects for point data (or 0 if extension is not supported)
 		unsigned int version; // Version number of the polyline in the vertex buffer
+		unsigned int texCoordVersion; // Version number of the vertex texture coordinates in the vertex buffers
 		size_t* numVertices; // Array of numbers of vertices already uploaded to the vertex buffers
 		
 		/* Constructors and destructors: */
@@ -100,11 +119,13 @@ class MultiPolyline:public GLObject
 	unsigned int numPolylines; // Number of individual polylines
 	Cluster::MulticastPipe* pipe; // Pipe to stream polyline data in a cluster environment (owned by caller)
 	unsigned int version; // Version number of the multipolyline (incremented on each clear operation)
+	unsigned int texCoordVersion; // Version number of the vertex texture coordinates (incremented on each in-place update)
 	Polyline* polylines; // Array of individual polylines
 	size_t maxNumVertices; // Maximum number of vertices in any individual polyline
 	
 	/* Private methods: */
 	void addNewChunk(unsigned int polylineIndex); // Adds a new chunk to the vertex buffer of the given polyline
+	bool updateTexCoords(const Polyline& p,size_t numRenderVertices) const; // Updates only the texture coordinates of the given polyline in the currently bound vertex buffer; returns false if the buffer could not be updated
 	
 	/* Constructors and destructors: */
 	public:
@@ -138,6 +159,14 @@ class MultiPolyline:public GLObject
 		}
 	void receive(void); // Receives multi-polyline data via multicast pipe until next flush() point
 	void flush(void); // Sends pending multi-polyline data across the multicast pipe and terminates receive() method on slaves
+	size_t getGeometrySize(void) const; // Returns the number of bytes written by writeGeometry
+	void writeGeometry(IO::File& file) const; // Writes all vertices currently in all polylines to the given file
+	void readGeometry(IO::File& file); // Appends vertices written by writeGeometry to the polylines; throws exception if the number of polylines does not match
+	void getVertexRanges(VertexRangeList& ranges); // Appends the storage ranges of all vertices currently in all polylines to the given list
+	void invalidateTexCoords(void) // Notifies the multi-polyline that vertex texture coordinates were changed in place
+		{
+		++texCoordVersion;
+		}
 	unsigned int getNumPolylines(void) const // Returns the number of individual polylines
 		{
 		return numPolylines;
@@ -23,6 +23,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_MULTISTREAMLINEEXTRACTOR_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_MULTISTREAMLINEEXTRACTOR_INCLUDED
 
+#include <vector>
+#include <Templatized/LocatorSample.h>
+
 namespace Visualization {
 
 namespace Templatized {
@@ -43,6 +46,8 @@ class MultiStreamlineExtractor
 	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from a data set (to color the streamline)
 	typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
 	typedef MultiStreamlineParam MultiStreamline; // Type of multi-streamline representation
+	typedef LocatorSample<DataSet> VertexSample; // Type to remember where extracted vertices lie inside the data set's cells
+	typedef std::vector<VertexSample> VertexSampleList; // Type for lists of vertex samples, in streamline vertex order
 	
 	struct StreamlineState // Structure containing the state of the streamline extractor for each streamline
 		{
@@ -68,10 +73,19 @@ class MultiStreamlineExtractor
 	unsigned int numStreamlines; // Number of individual streamlines reflected in current state variables
 	StreamlineState* streamlineStates; // Array of streamline states
 	MultiStreamline* multiStreamline; // Pointer to the multi-streamline representations
+	VertexSampleList* vertexSamples; // Array of lists receiving a sample for each vertex added to each streamline, or 0
+	
+	/* Batched integration state: */
+	unsigned int numActiveLines; // Number of streamlines that have not yet left the data set's domain
+	unsigned int* activeLines; // Compacted array of indices of active streamlines
+	unsigned int* pendingLines; // Array of indices of active streamlines whose current step has not yet been accepted
+	Vector* stageValues; // Vector field values at the six Cash-Karp stages, six consecutive entries per streamline
+	Vector* errorScales; // Per-component error scaling factors for each streamline's current step
+	Scalar* trialStepSizes; // Trial step sizes for each streamline's current step
 	
 	/* Private methods: */
-	Vector cashKarpStep(unsigned int index,const Vector& vfp1,Scalar trialStepSize,Vector& error); // Computes a trial step vector with Cash-Karp coefficients
-	bool stepStreamline(unsigned int index); // Advances one current streamline position by one step
+	void evaluateStages(unsigned int numPending); // Evaluates Cash-Karp stages two to six for all pending streamlines in lockstep
+	bool stepStreamlines(void); // Advances all active streamlines by one step; returns true if any streamlines are still active
 	
 	/* Constructors and destructors: */
 	public:
@@ -120,6 +134,10 @@ class MultiStreamlineExtractor
 	void setEpsilon(Scalar newEpsilon); // Sets the integration accuracy threshold
 	void setNumStreamlines(unsigned int newNumStreamlines); // Sets number of streamlines without setting the multi-streamline itself
 	void setMultiStreamline(MultiStreamline& newMultiStreamline); // Sets the multi-streamline object
+	void setVertexSamples(VertexSampleList* newVertexSamples) // Sets an array of one list per streamline receiving a sample for each vertex of the next extracted streamlines, or 0 to disable sampling
+		{
+		vertexSamples=newVertexSamples;
+		}
 	void initializeStreamline(unsigned int index,const Point& startPoint,const Locator& startLocator,Scalar startEpsilon); // Initializes one streamline
 	void extractStreamlines(void); // Extracts streamlines for the previously initialized positions, locators, and streamline storages
 	void startStreamlines(void); // Starts extracting streamlines for the previously initialized positions, locators, and streamline storages
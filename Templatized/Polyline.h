@@ -22,13 +22,20 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_POLYLINE_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_POLYLINE_INCLUDED
 
+#include <vector>
 #include <GL/gl.h>
 #include <GL/GLObject.h>
 
+#include <Templatized/VertexRange.h>
+#include <Templatized/ChunkPool.h>
+
 /* Forward declarations: */
 namespace Cluster {
 class MulticastPipe;
 }
+namespace IO {
+class File;
+}
 
 namespace Visualization {
 
@@ -40,6 +47,7 @@ class Polyline:public GLObject
 	/* Embedded classes: */
 	public:
 	typedef VertexParam Vertex; // Type for polyline vertices
+	typedef std::vector<VertexRange<Vertex> > VertexRangeList; // Type for lists of contiguous runs of vertices
 	
 	private:
 	static const size_t chunkSize=5000; // Number of vertices per chunk
@@ -56,6 +64,16 @@ class Polyline:public GLObject
 			:succ(0)
 			{
 			}
+		
+		/* Methods: */
+		static void* operator new(size_t size) // Allocates chunks from the process-wide chunk pool
+			{
+			return ChunkPool::allocate(size);
+			}
+		static void operator delete(void* chunk,size_t size) // Returns chunks to the process-wide chunk pool
+			{
+			ChunkPool::release(chunk,size);
+			}
 		};
 	
 	struct DataItem:public GLObject::DataItem
@@ -64,6 +82,7 @@ class Polyline:public GLObject
 		public:
 		GLuint vertexBufferId; // ID of vertex buffer object for point data (or 0 if extension is not supported)
 		unsigned int version; // Version number of the polyline in the vertex buffer
+		unsigned int texCoordVersion; // Version number of the vertex texture coordinates in the vertex buffer
 		size_t numVertices; // Number of vertices already uploaded to the vertex buffer
 		
 		/* Constructors and destructors: */
@@ -75,6 +94,7 @@ class Polyline:public GLObject
 	private:
 	Cluster::MulticastPipe* pipe; // Pipe to stream polyline data in a cluster environment (owned by caller)
 	unsigned int version; // Version number of the polyline (incremented on each clear operation)
+	unsigned int texCoordVersion; // Version number of the vertex texture coordinates (incremented on each in-place update)
 	size_t numVertices; // Total number of vertices currently in set
 	Chunk* head; // Pointer to first vertex buffer chunk
 	Chunk* tail; // Pointer to last vertex buffer chunk
@@ -84,6 +104,7 @@ class Polyline:public GLObject
 	
 	/* Private methods: */
 	void addNewChunk(void); // Adds a new chunk to the vertex buffer
+	bool updateTexCoords(size_t numRenderVertices) const; // Updates only the texture coordinates in the currently bound vertex buffer; returns false if the buffer could not be updated
 	
 	/* Constructors and destructors: */
 	public:
@@ -115,6 +136,14 @@ class Polyline:public GLObject
 		}
 	void receive(void); // Receives polyline data via multicast pipe until next flush() point
 	void flush(void); // Sends pending polyline data across the multicast pipe and terminates receive() method on slaves
+	size_t getGeometrySize(void) const; // Returns the number of bytes written by writeGeometry
+	void writeGeometry(IO::File& file) const; // Writes all vertices currently in the polyline to the given file
+	void readGeometry(IO::File& file); // Appends vertices written by writeGeometry to the polyline
+	void getVertexRanges(VertexRangeList& ranges); // Appends the storage ranges of all vertices currently in the polyline to the given list
+	void invalidateTexCoords(void) // Notifies the polyline that vertex texture coordinates were changed in place
+		{
+		++texCoordVersion;
+		}
 	size_t getNumVertices(void) const // Returns number of vertices currently in buffer
 		{
 		return numVertices;
@@ -0,0 +1,497 @@
+/***********************************************************************
+Profiler - Process-wide registry of scoped timers and counters recording
+into per-thread ring buffers, with periodic summaries and Chrome trace
+export.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Templatized/Profiler.h>
+
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <stdio.h>
+#include <deque>
+#include <set>
+#include <iostream>
+#include <iomanip>
+#include <Misc/ThrowStdErr.h>
+#include <Threads/Mutex.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+namespace {
+
+/**************
+Helper classes:
+**************/
+
+struct Event // Structure for events recorded by probes
+	{
+	/* Elements: */
+	public:
+	unsigned int probeId; // ID of the recording probe
+	unsigned int threadId; // Kernel ID of the recording thread
+	Profiler::Timestamp time; // Start time of a time interval, or time of a counter value
+	Profiler::Timestamp duration; // Length of a time interval
+	double value; // Counter value
+	};
+
+const unsigned int ringBufferSize=16384; // Number of events in each thread's ring buffer; must be a power of two
+
+struct RingBuffer // Structure for per-thread event ring buffers
+	{
+	/* Elements: */
+	public:
+	unsigned int threadId; // Kernel ID of the thread owning the ring buffer
+	bool inUse; // Flag whether the ring buffer is owned by a running thread
+	Event events[ringBufferSize]; // Event storage
+	volatile size_t numWritten; // Total number of events written by the owning thread
+	size_t numCollected; // Total number of events read by the collector
+	std::deque<Event> openIntervals; // Collected time intervals not yet known to be enclosed by a later interval, in completion order
+	RingBuffer* succ; // Pointer to the next ring buffer
+	};
+
+struct Statistics // Structure accumulating probe events
+	{
+	/* Elements: */
+	public:
+	size_t numEvents; // Number of accumulated events
+	double total,min,max; // Sum and range of accumulated values
+	
+	/* Constructors and destructors: */
+	Statistics(void)
+		:numEvents(0),total(0.0),min(0.0),max(0.0)
+		{
+		}
+	
+	/* Methods: */
+	void add(double value)
+		{
+		if(numEvents==0||min>value)
+			min=value;
+		if(numEvents==0||max<value)
+			max=value;
+		total+=value;
+		++numEvents;
+		}
+	};
+
+struct Probe // Structure for registered probes
+	{
+	/* Elements: */
+	public:
+	std::string name; // Probe name
+	Profiler::Category category; // Probe category
+	bool counter; // Flag whether the probe records counter values
+	Statistics totalStats; // Statistics since the start
+	Statistics intervalStats; // Statistics since the last interval reset
+	double totalSelf; // Sum of interval lengths since the start, minus the time spent in timers nested inside them
+	double intervalSelf; // Ditto, since the last interval reset
+	};
+
+/********************************
+Static profiler state and limits:
+********************************/
+
+const size_t maxNumTraceEvents=size_t(1)<<20; // Maximum number of events retained for trace export
+const size_t maxNumOpenIntervals=256; // Maximum number of collected intervals per thread kept to find enclosing intervals
+const char* categoryNames[Profiler::NUM_CATEGORIES]={"Frame","Rendering","Extraction","Upload","Locator","Cluster"};
+Threads::Mutex registryMutex; // Mutex serializing access to the probe registry and statistics
+std::vector<Probe> probes; // List of registered probes, indexed by probe ID
+Threads::Mutex ringBufferMutex; // Mutex serializing access to the list of ring buffers
+RingBuffer* ringBuffers=0; // Head of the list of ring buffers
+size_t numLostEvents=0; // Number of events overwritten before they could be collected
+bool traceEnabled=false; // Flag whether collected events are retained for trace export
+std::vector<Event> traceEvents; // Events retained for trace export
+size_t numDroppedTraceEvents=0; // Number of collected events not retained because the trace was full
+__thread RingBuffer* threadRingBuffer=0; // The calling thread's ring buffer
+pthread_key_t ringBufferKey; // Key to release a thread's ring buffer when the thread terminates
+pthread_once_t ringBufferKeyOnce=PTHREAD_ONCE_INIT; // Guard to create the ring buffer key once
+
+/****************
+Helper functions:
+****************/
+
+extern "C" void releaseRingBuffer(void* buffer)
+	{
+	/* Hand the ring buffer to the next new thread: */
+	Threads::Mutex::Lock ringBufferLock(ringBufferMutex);
+	static_cast<RingBuffer*>(buffer)->inUse=false;
+	}
+
+extern "C" void createRingBufferKey(void)
+	{
+	pthread_key_create(&ringBufferKey,releaseRingBuffer);
+	}
+
+RingBuffer* getThreadRingBuffer(void)
+	{
+	if(threadRingBuffer==0)
+		{
+		/* Adopt a ring buffer released by a terminated thread, or create a new one: */
+		pthread_once(&ringBufferKeyOnce,createRingBufferKey);
+		Threads::Mutex::Lock ringBufferLock(ringBufferMutex);
+		RingBuffer* buffer;
+		for(buffer=ringBuffers;buffer!=0&&buffer->inUse;buffer=buffer->succ)
+			;
+		if(buffer==0)
+			{
+			buffer=new RingBuffer;
+			buffer->numWritten=0;
+			buffer->numCollected=0;
+			buffer->succ=ringBuffers;
+			ringBuffers=buffer;
+			}
+		buffer->threadId=(unsigned int)(syscall(SYS_gettid));
+		buffer->inUse=true;
+		pthread_setspecific(ringBufferKey,buffer);
+		threadRingBuffer=buffer;
+		}
+	
+	return threadRingBuffer;
+	}
+
+Event& startEvent(RingBuffer* buffer)
+	{
+	return buffer->events[buffer->numWritten&(ringBufferSize-1)];
+	}
+
+void finishEvent(RingBuffer* buffer)
+	{
+	/* Publish the event to the collector: */
+	__sync_synchronize();
+	buffer->numWritten=buffer->numWritten+1;
+	}
+
+unsigned int registerProbe(const char* name,Profiler::Category category,bool counter)
+	{
+	Threads::Mutex::Lock registryLock(registryMutex);
+	
+	/* Return an existing probe of the same name and kind: */
+	for(unsigned int i=0;i<probes.size();++i)
+		if(probes[i].counter==counter&&probes[i].name==name)
+			return i;
+	
+	/* Create a new probe: */
+	probes.push_back(Probe());
+	Probe& probe=probes.back();
+	probe.name=name;
+	probe.category=category;
+	probe.counter=counter;
+	probe.totalSelf=0.0;
+	probe.intervalSelf=0.0;
+	return probes.size()-1;
+	}
+
+void writeJsonString(FILE* file,const std::string& string)
+	{
+	fputc('\"',file);
+	for(std::string::const_iterator sIt=string.begin();sIt!=string.end();++sIt)
+		{
+		if(*sIt=='\"'||*sIt=='\\')
+			fprintf(file,"\\%c",*sIt);
+		else if((unsigned char)(*sIt)<0x20U)
+			fprintf(file,"\\u%04x",(unsigned int)(unsigned char)(*sIt));
+		else
+			fputc(*sIt,file);
+		}
+	fputc('\"',file);
+	}
+
+}
+
+/*********************************
+Static elements of class Profiler:
+*********************************/
+
+volatile bool Profiler::enabled=false;
+
+/*************************
+Methods of class Profiler:
+*************************/
+
+void Profiler::setEnabled(bool newEnabled)
+	{
+	enabled=newEnabled;
+	}
+
+void Profiler::setTraceEnabled(bool newTraceEnabled)
+	{
+	Threads::Mutex::Lock registryLock(registryMutex);
+	traceEnabled=newTraceEnabled;
+	}
+
+unsigned int Profiler::registerTimer(const char* name,Profiler::Category category)
+	{
+	return registerProbe(name,category,false);
+	}
+
+unsigned int Profiler::registerCounter(const char* name,Profiler::Category category)
+	{
+	return registerProbe(name,category,true);
+	}
+
+Profiler::Timestamp Profiler::getTimestamp(void)
+	{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC,&now);
+	return Timestamp(now.tv_sec)*Timestamp(1000000000)+Timestamp(now.tv_nsec);
+	}
+
+void Profiler::recordInterval(unsigned int probeId,Profiler::Timestamp start,Profiler::Timestamp end)
+	{
+	RingBuffer* buffer=getThreadRingBuffer();
+	Event& event=startEvent(buffer);
+	event.probeId=probeId;
+	event.threadId=buffer->threadId;
+	event.time=start;
+	event.duration=end-start;
+	event.value=0.0;
+	finishEvent(buffer);
+	}
+
+void Profiler::recordCounter(unsigned int probeId,double value)
+	{
+	RingBuffer* buffer=getThreadRingBuffer();
+	Event& event=startEvent(buffer);
+	event.probeId=probeId;
+	event.threadId=buffer->threadId;
+	event.time=getTimestamp();
+	event.duration=0;
+	event.value=value;
+	finishEvent(buffer);
+	}
+
+void Profiler::collect(void)
+	{
+	Threads::Mutex::Lock registryLock(registryMutex);
+	Threads::Mutex::Lock ringBufferLock(ringBufferMutex);
+	
+	for(RingBuffer* buffer=ringBuffers;buffer!=0;buffer=buffer->succ)
+		{
+		/*******************************************************************
+		Owning threads keep writing while the buffer is read. Events that
+		are about to be overwritten are skipped and counted as lost, leaving
+		a quarter of the buffer as safety margin against a fast writer.
+		*******************************************************************/
+		
+		size_t numWritten=buffer->numWritten;
+		__sync_synchronize();
+		size_t first=buffer->numCollected;
+		if(numWritten-first>ringBufferSize-ringBufferSize/4)
+			{
+			numLostEvents+=numWritten-(ringBufferSize-ringBufferSize/4)-first;
+			first=numWritten-(ringBufferSize-ringBufferSize/4);
+			
+			/* Nested intervals can no longer be matched across the gap: */
+			buffer->openIntervals.clear();
+			}
+		
+		for(size_t i=first;i<numWritten;++i)
+			{
+			const Event& event=buffer->events[i&(ringBufferSize-1)];
+			if(event.probeId>=probes.size())
+				continue;
+			
+			/* Accumulate the event into its probe's statistics: */
+			Probe& probe=probes[event.probeId];
+			double value=probe.counter?event.value:double(event.duration)*1.0e-9;
+			probe.totalStats.add(value);
+			probe.intervalStats.add(value);
+			
+			if(!probe.counter)
+				{
+				/*****************************************************************
+				A thread records an interval when it ends, i.e., after all
+				intervals nested inside it. The nested intervals that are not
+				themselves nested inside another are therefore the most recent
+				open intervals starting no earlier than this one.
+				*****************************************************************/
+				
+				Profiler::Timestamp nestedDuration=0;
+				while(!buffer->openIntervals.empty()&&buffer->openIntervals.back().time>=event.time)
+					{
+					nestedDuration+=buffer->openIntervals.back().duration;
+					buffer->openIntervals.pop_back();
+					}
+				double self=double(event.duration-nestedDuration)*1.0e-9;
+				probe.totalSelf+=self;
+				probe.intervalSelf+=self;
+				
+				/* Keep this interval until an enclosing interval claims it: */
+				if(buffer->openIntervals.size()>=maxNumOpenIntervals)
+					buffer->openIntervals.pop_front();
+				buffer->openIntervals.push_back(event);
+				}
+			
+			/* Retain the event for trace export: */
+			if(traceEnabled)
+				{
+				if(traceEvents.size()<maxNumTraceEvents)
+					traceEvents.push_back(event);
+				else
+					++numDroppedTraceEvents;
+				}
+			}
+		buffer->numCollected=numWritten;
+		}
+	}
+
+std::vector<Profiler::ProbeSummary> Profiler::getSummary(bool interval)
+	{
+	Threads::Mutex::Lock registryLock(registryMutex);
+	
+	std::vector<ProbeSummary> result;
+	result.reserve(probes.size());
+	for(std::vector<Probe>::iterator pIt=probes.begin();pIt!=probes.end();++pIt)
+		{
+		const Statistics& stats=interval?pIt->intervalStats:pIt->totalStats;
+		ProbeSummary ps;
+		ps.name=pIt->name;
+		ps.category=pIt->category;
+		ps.counter=pIt->counter;
+		ps.numEvents=stats.numEvents;
+		ps.total=stats.total;
+		ps.self=interval?pIt->intervalSelf:pIt->totalSelf;
+		ps.min=stats.min;
+		ps.max=stats.max;
+		result.push_back(ps);
+		}
+	
+	return result;
+	}
+
+void Profiler::getCategoryTimes(double times[Profiler::NUM_CATEGORIES])
+	{
+	Threads::Mutex::Lock registryLock(registryMutex);
+	
+	for(int i=0;i<NUM_CATEGORIES;++i)
+		times[i]=0.0;
+	for(std::vector<Probe>::iterator pIt=probes.begin();pIt!=probes.end();++pIt)
+		if(!pIt->counter)
+			times[pIt->category]+=pIt->totalSelf;
+	}
+
+void Profiler::resetInterval(void)
+	{
+	Threads::Mutex::Lock registryLock(registryMutex);
+	
+	for(std::vector<Probe>::iterator pIt=probes.begin();pIt!=probes.end();++pIt)
+		{
+		pIt->intervalStats=Statistics();
+		pIt->intervalSelf=0.0;
+		}
+	}
+
+const char* Profiler::getCategoryName(Profiler::Category category)
+	{
+	return categoryNames[category];
+	}
+
+void Profiler::printSummary(std::ostream& os,bool interval)
+	{
+	std::vector<ProbeSummary> summary=getSummary(interval);
+	
+	/* Print one line per probe with recorded events, in a fixed column layout to be compared across runs: */
+	std::ios::fmtflags oldFlags=os.flags();
+	std::streamsize oldPrecision=os.precision();
+	os<<std::fixed<<std::setprecision(3);
+	os<<(interval?"Profile summary (interval):":"Profile summary (total):")<<std::endl;
+	os<<"  category\tprobe\tevents\ttotal\tself\tmean\tmin\tmax"<<std::endl;
+	for(std::vector<ProbeSummary>::iterator sIt=summary.begin();sIt!=summary.end();++sIt)
+		if(sIt->numEvents>0)
+			{
+			/* Print times in milliseconds and counter values as recorded: */
+			double scale=sIt->counter?1.0:1000.0;
+			os<<"  "<<getCategoryName(sIt->category)<<'\t'<<sIt->name<<(sIt->counter?"":" (ms)");
+			os<<'\t'<<sIt->numEvents<<'\t'<<sIt->total*scale<<'\t';
+			if(sIt->counter)
+				os<<'-';
+			else
+				os<<sIt->self*scale;
+			os<<'\t'<<sIt->total*scale/double(sIt->numEvents);
+			os<<'\t'<<sIt->min*scale<<'\t'<<sIt->max*scale<<std::endl;
+			}
+	
+	Threads::Mutex::Lock registryLock(registryMutex);
+	if(numLostEvents>0)
+		os<<"  "<<numLostEvents<<" events were overwritten before collection"<<std::endl;
+	os.flags(oldFlags);
+	os.precision(oldPrecision);
+	}
+
+void Profiler::writeChromeTrace(const char* fileName)
+	{
+	Threads::Mutex::Lock registryLock(registryMutex);
+	
+	FILE* file=fopen(fileName,"w");
+	if(file==0)
+		Misc::throwStdErr("Profiler::writeChromeTrace: Unable to open trace file %s",fileName);
+	
+	/* Write time stamps in microseconds relative to the first retained event: */
+	Timestamp epoch=0;
+	if(!traceEvents.empty())
+		{
+		epoch=traceEvents.front().time;
+		for(std::vector<Event>::iterator teIt=traceEvents.begin();teIt!=traceEvents.end();++teIt)
+			if(epoch>teIt->time)
+				epoch=teIt->time;
+		}
+	
+	fprintf(file,"{\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":%lu,\"lostEvents\":%lu},\"traceEvents\":[\n",(unsigned long)numDroppedTraceEvents,(unsigned long)numLostEvents);
+	
+	/* Name all threads that recorded retained events by their kernel IDs: */
+	std::set<unsigned int> threadIds;
+	for(std::vector<Event>::iterator teIt=traceEvents.begin();teIt!=traceEvents.end();++teIt)
+		threadIds.insert(teIt->threadId);
+	unsigned int mainThreadId=(unsigned int)(getpid());
+	bool first=true;
+	for(std::set<unsigned int>::iterator tIt=threadIds.begin();tIt!=threadIds.end();++tIt)
+		{
+		if(*tIt==mainThreadId)
+			fprintf(file,"%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"Main thread\"}}",first?"":",\n",mainThreadId,*tIt);
+		else
+			fprintf(file,"%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"Thread %u\"}}",first?"":",\n",mainThreadId,*tIt,*tIt);
+		first=false;
+		}
+	
+	for(std::vector<Event>::iterator teIt=traceEvents.begin();teIt!=traceEvents.end();++teIt)
+		{
+		const Probe& probe=probes[teIt->probeId];
+		fprintf(file,"%s{\"name\":",first?"":",\n");
+		writeJsonString(file,probe.name);
+		fprintf(file,",\"cat\":\"%s\",\"pid\":%u,\"tid\":%u,\"ts\":%.3f",categoryNames[probe.category],mainThreadId,teIt->threadId,double(teIt->time-epoch)*1.0e-3);
+		if(probe.counter)
+			fprintf(file,",\"ph\":\"C\",\"args\":{\"value\":%g}}",teIt->value);
+		else
+			fprintf(file,",\"ph\":\"X\",\"dur\":%.3f}",double(teIt->duration)*1.0e-3);
+		first=false;
+		}
+	
+	fprintf(file,"\n]}\n");
+	fclose(file);
+	}
+
+}
+
+}
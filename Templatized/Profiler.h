@@ -0,0 +1,116 @@
+/***********************************************************************
+Profiler - Process-wide registry of scoped timers and counters recording
+into per-thread ring buffers, with periodic summaries and Chrome trace
+export.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_PROFILER_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_PROFILER_INCLUDED
+
+#include <stddef.h>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include <Misc/SizedTypes.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+class Profiler
+	{
+	/* Embedded classes: */
+	public:
+	typedef Misc::SInt64 Timestamp; // Type for time stamps in nanoseconds since the profiler's epoch
+	
+	enum Category // Enumerated type for groups of probes shown together; category times are sums of their timers' self times, so FRAME timers only count time not spent in nested timers
+		{
+		FRAME=0,RENDERING,EXTRACTION,UPLOAD,LOCATOR,CLUSTER,NUM_CATEGORIES
+		};
+	
+	struct ProbeSummary // Structure summarizing the events recorded by a probe
+		{
+		/* Elements: */
+		public:
+		std::string name; // Probe name
+		Category category; // Probe category
+		bool counter; // Flag whether the probe records counter values instead of time intervals
+		size_t numEvents; // Number of recorded events
+		double total; // Sum of interval lengths in seconds, or sum of counter values
+		double self; // Sum of interval lengths in seconds minus the time spent in timers nested inside them on the same thread; unused for counters
+		double min,max; // Range of interval lengths in seconds, or of counter values
+		};
+	
+	class Scope // Class to time the lifetime of a scope with a timer probe
+		{
+		/* Elements: */
+		private:
+		unsigned int probeId; // ID of the timer probe
+		Timestamp start; // Time at which the scope was entered, or -1 if the profiler was disabled
+		
+		/* Constructors and destructors: */
+		public:
+		Scope(unsigned int sProbeId)
+			:probeId(sProbeId),start(enabled?getTimestamp():Timestamp(-1))
+			{
+			}
+		~Scope(void)
+			{
+			if(start>=0)
+				recordInterval(probeId,start,getTimestamp());
+			}
+		};
+	
+	/* Elements: */
+	private:
+	static volatile bool enabled; // Flag whether probes currently record events
+	
+	/* Methods: */
+	public:
+	static bool isEnabled(void) // Returns true if probes currently record events
+		{
+		return enabled;
+		}
+	static void setEnabled(bool newEnabled); // Enables or disables event recording
+	static void setTraceEnabled(bool newTraceEnabled); // Sets whether collected events are retained for trace export
+	static unsigned int registerTimer(const char* name,Category category); // Returns the ID of the timer probe of the given name, creating it if necessary; call once per site
+	static unsigned int registerCounter(const char* name,Category category); // Returns the ID of the counter probe of the given name, creating it if necessary; call once per site
+	static Timestamp getTimestamp(void); // Returns the current time
+	static void recordInterval(unsigned int probeId,Timestamp start,Timestamp end); // Records a time interval for a timer probe into the calling thread's ring buffer
+	static void recordCounter(unsigned int probeId,double value); // Records a value for a counter probe into the calling thread's ring buffer
+	static void count(unsigned int probeId,double value) // Records a counter value if the profiler is enabled
+		{
+		if(enabled)
+			recordCounter(probeId,value);
+		}
+	static void collect(void); // Drains all threads' ring buffers into the probe summaries and the trace; called periodically from the main thread
+	static std::vector<ProbeSummary> getSummary(bool interval); // Returns summaries of all probes since the last interval reset, or since the start
+	static void getCategoryTimes(double times[NUM_CATEGORIES]); // Returns the total self time in seconds recorded by timer probes in each category since the start
+	static void resetInterval(void); // Starts a new summary interval
+	static const char* getCategoryName(Category category); // Returns a category's name
+	static void printSummary(std::ostream& os,bool interval); // Prints a table of probe summaries since the last interval reset, or since the start
+	static void writeChromeTrace(const char* fileName); // Writes all retained events to a trace file in Chrome's trace event JSON format
+	};
+
+}
+
+}
+
+#endif
@@ -32,11 +32,11 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/Vector.h>
 #include <Geometry/Box.h>
 #include <Geometry/ValuedPoint.h>
-#include <Geometry/ArrayKdTree.h>
 
 #include <Templatized/Simplex.h>
 #include <Templatized/PointerID.h>
 #include <Templatized/IteratorWrapper.h>
+#include <Templatized/MappedKdTree.h>
 
 namespace Visualization {
 
@@ -383,7 +383,7 @@ class Simplical
 	
 	private:
 	typedef Geometry::ValuedPoint<Point,CellID> CellCenter; // Data type to associate a cell's center point and its ID
-	typedef Geometry::ArrayKdTree<CellCenter> CellCenterTree; // Data type for kd-trees to locate closest cell centers
+	typedef MappedKdTree<CellCenter> CellCenterTree; // Data type for kd-trees to locate closest cell centers
 	
 	friend class Vertex;
 	friend class Cell;
@@ -0,0 +1,610 @@
+/***********************************************************************
+SliceExpression - Class for compiled expressions defining derived
+variables over the value slices of sliced data sets.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#define VISUALIZATION_TEMPLATIZED_SLICEEXPRESSION_IMPLEMENTATION
+
+#include <Templatized/SliceExpression.h>
+
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <Misc/ThrowStdErr.h>
+#include <Math/Constants.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+/********************************************
+Declaration of struct SliceExpression::Node:
+********************************************/
+
+struct SliceExpression::Node
+	{
+	/* Embedded classes: */
+	public:
+	enum Type // Enumerated type for node types
+		{
+		CONSTANT,INPUT,OPERATION,FIELD
+		};
+	
+	/* Elements: */
+	Type type; // Type of this node
+	double constant; // Value of constant nodes
+	InputType inputType; // Source of input nodes
+	int inputIndex; // Slice index, position component, or temporary index of input nodes
+	OpCode opCode; // Operation of operation nodes
+	FieldOperator fieldOperator; // Operator of field operator nodes
+	std::vector<Node*> children; // Operands of operation and field operator nodes
+	};
+
+/*********************************************
+Declaration of class SliceExpression::Parser:
+*********************************************/
+
+class SliceExpression::Parser
+	{
+	/* Elements: */
+	private:
+	const std::string& source; // Source text of the parsed expression
+	const VariableResolver& resolver; // Resolver for variable names
+	int numComponents; // Number of components of vector variables
+	size_t pos; // Current parsing position
+	std::vector<Node*> nodes; // List of all created nodes, to destroy them if parsing fails
+	
+	/* Private methods: */
+	void error(const char* message) const // Throws a parsing error
+		{
+		Misc::throwStdErr("SliceExpression: %s at position %d in \"%s\"",message,int(pos),source.c_str());
+		}
+	void skipWhitespace(void)
+		{
+		while(pos<source.size()&&isspace(source[pos]))
+			++pos;
+		}
+	bool accept(char c) // Consumes the given character if it is the next non-whitespace character
+		{
+		skipWhitespace();
+		if(pos<source.size()&&source[pos]==c)
+			{
+			++pos;
+			return true;
+			}
+		return false;
+		}
+	void expect(char c)
+		{
+		if(!accept(c))
+			{
+			char message[32];
+			snprintf(message,sizeof(message),"Missing '%c'",c);
+			error(message);
+			}
+		}
+	Node* newNode(Node::Type type)
+		{
+		Node* result=new Node;
+		nodes.push_back(result);
+		result->type=type;
+		result->constant=0.0;
+		result->inputType=SLICE;
+		result->inputIndex=-1;
+		result->opCode=PUSH_CONSTANT;
+		result->fieldOperator=RADIAL_MEAN;
+		return result;
+		}
+	Node* newConstant(double constant)
+		{
+		Node* result=newNode(Node::CONSTANT);
+		result->constant=constant;
+		return result;
+		}
+	Node* newInput(InputType inputType,int inputIndex)
+		{
+		Node* result=newNode(Node::INPUT);
+		result->inputType=inputType;
+		result->inputIndex=inputIndex;
+		return result;
+		}
+	Node* newOperation(OpCode opCode,Node* child0,Node* child1 =0)
+		{
+		Node* result=newNode(Node::OPERATION);
+		result->opCode=opCode;
+		result->children.push_back(child0);
+		if(child1!=0)
+			result->children.push_back(child1);
+		return result;
+		}
+	Node* newField(FieldOperator fieldOperator,Node* child)
+		{
+		Node* result=newNode(Node::FIELD);
+		result->fieldOperator=fieldOperator;
+		result->children.push_back(child);
+		return result;
+		}
+	std::string parseName(void); // Parses an identifier or a braced variable name
+	bool resolveVector(const std::string& name,std::vector<Node*>& components); // Resolves the given name as a vector; returns false if it is not a vector
+	void parseVector(std::vector<Node*>& components); // Parses a vector-valued function argument
+	Node* parseFunction(const std::string& name); // Parses the argument list of the given function
+	Node* parsePrimary(void);
+	Node* parsePower(void);
+	Node* parseUnary(void);
+	Node* parseTerm(void);
+	Node* parseExpression(void);
+	
+	/* Constructors and destructors: */
+	public:
+	Parser(const std::string& sSource,const VariableResolver& sResolver)
+		:source(sSource),resolver(sResolver),
+		 numComponents(resolver.getNumVectorComponents()),
+		 pos(0)
+		{
+		}
+	~Parser(void)
+		{
+		for(std::vector<Node*>::iterator nIt=nodes.begin();nIt!=nodes.end();++nIt)
+			delete *nIt;
+		}
+	
+	/* Methods: */
+	Node* parse(void) // Parses the entire source text
+		{
+		Node* result=parseExpression();
+		skipWhitespace();
+		if(pos<source.size())
+			error("Unexpected character");
+		return result;
+		}
+	};
+
+/*****************************************
+Methods of class SliceExpression::Parser:
+*****************************************/
+
+std::string SliceExpression::Parser::parseName(void)
+	{
+	skipWhitespace();
+	std::string result;
+	if(pos<source.size()&&source[pos]=='{')
+		{
+		/* Read a variable name that can contain arbitrary characters: */
+		size_t end=source.find('}',pos+1);
+		if(end==std::string::npos)
+			error("Missing '}'");
+		result=source.substr(pos+1,end-(pos+1));
+		pos=end+1;
+		}
+	else
+		{
+		while(pos<source.size()&&(isalnum(source[pos])||source[pos]=='_'))
+			result.push_back(source[pos++]);
+		}
+	if(result.empty())
+		error("Missing name");
+	return result;
+	}
+
+bool SliceExpression::Parser::resolveVector(const std::string& name,std::vector<Node*>& components)
+	{
+	components.clear();
+	int sliceIndices[3];
+	if(numComponents<=3&&resolver.getVectorVariableSlices(name.c_str(),sliceIndices))
+		{
+		for(int i=0;i<numComponents;++i)
+			components.push_back(newInput(SLICE,sliceIndices[i]));
+		return true;
+		}
+	else if(name=="pos")
+		{
+		for(int i=0;i<numComponents;++i)
+			components.push_back(newInput(POSITION,i));
+		return true;
+		}
+	else
+		return false;
+	}
+
+void SliceExpression::Parser::parseVector(std::vector<Node*>& components)
+	{
+	std::string name=parseName();
+	if(!resolveVector(name,components))
+		error("Vector variable expected");
+	}
+
+SliceExpression::Node* SliceExpression::Parser::parseFunction(const std::string& name)
+	{
+	static const char* unaryNames[]={"abs","sqrt","exp","log","sin","cos","tan","asin","acos","atan",0};
+	static const OpCode unaryOpCodes[]={ABS,SQRT,EXP,LOG,SIN,COS,TAN,ASIN,ACOS,ATAN};
+	static const char* binaryNames[]={"atan2","pow","min","max",0};
+	static const OpCode binaryOpCodes[]={ATAN2,POWER,MIN,MAX};
+	static const char* fieldNames[]={"radialMean","ddx","ddy","ddz",0};
+	static const FieldOperator fieldOperators[]={RADIAL_MEAN,DERIVATIVE_X,DERIVATIVE_Y,DERIVATIVE_Z};
+	
+	Node* result=0;
+	
+	/* Check for scalar functions: */
+	for(int i=0;unaryNames[i]!=0&&result==0;++i)
+		if(name==unaryNames[i])
+			result=newOperation(unaryOpCodes[i],parseExpression());
+	for(int i=0;binaryNames[i]!=0&&result==0;++i)
+		if(name==binaryNames[i])
+			{
+			Node* arg0=parseExpression();
+			expect(',');
+			result=newOperation(binaryOpCodes[i],arg0,parseExpression());
+			}
+	for(int i=0;fieldNames[i]!=0&&result==0;++i)
+		if(name==fieldNames[i])
+			{
+			if(fieldOperators[i]!=RADIAL_MEAN&&int(fieldOperators[i]-DERIVATIVE_X)>=numComponents)
+				error("Derivative direction exceeds data set dimension");
+			result=newField(fieldOperators[i],parseExpression());
+			}
+	
+	/* Check for vector functions, which are expanded into their components: */
+	if(result==0&&(name=="mag"||name=="dot"))
+		{
+		std::vector<Node*> v0,v1;
+		parseVector(v0);
+		if(name=="dot")
+			{
+			expect(',');
+			parseVector(v1);
+			}
+		else
+			v1=v0;
+		result=newOperation(MULTIPLY,v0[0],v1[0]);
+		for(int i=1;i<numComponents;++i)
+			result=newOperation(ADD,result,newOperation(MULTIPLY,v0[i],v1[i]));
+		if(name=="mag")
+			result=newOperation(SQRT,result);
+		}
+	else if(result==0&&name=="div")
+		{
+		std::vector<Node*> v;
+		parseVector(v);
+		result=newField(DERIVATIVE_X,v[0]);
+		for(int i=1;i<numComponents;++i)
+			result=newOperation(ADD,result,newField(FieldOperator(DERIVATIVE_X+i),v[i]));
+		}
+	
+	if(result==0)
+		error("Unknown function");
+	expect(')');
+	
+	return result;
+	}
+
+SliceExpression::Node* SliceExpression::Parser::parsePrimary(void)
+	{
+	skipWhitespace();
+	if(pos>=source.size())
+		error("Unexpected end of expression");
+	
+	/* Check for numbers: */
+	if(isdigit(source[pos])||source[pos]=='.')
+		{
+		const char* start=source.c_str()+pos;
+		char* end;
+		double value=strtod(start,&end);
+		if(end==start)
+			error("Malformed number");
+		pos+=end-start;
+		return newConstant(value);
+		}
+	
+	/* Check for parenthesized expressions: */
+	if(accept('('))
+		{
+		Node* result=parseExpression();
+		expect(')');
+		return result;
+		}
+	
+	/* Parse a name: */
+	bool braced=source[pos]=='{';
+	std::string name=parseName();
+	
+	/* Check for function calls: */
+	if(!braced&&accept('('))
+		return parseFunction(name);
+	
+	/* Check for scalar variables: */
+	int sliceIndex=resolver.getScalarVariableSlice(name.c_str());
+	if(sliceIndex>=0)
+		return newInput(SLICE,sliceIndex);
+	
+	/* Check for vector variables with component selectors: */
+	std::vector<Node*> components;
+	if(resolveVector(name,components))
+		{
+		int componentIndex=-1;
+		if(accept('.'))
+			{
+			skipWhitespace();
+			if(pos<source.size()&&source[pos]>='x'&&source[pos]<='z')
+				componentIndex=source[pos++]-'x';
+			}
+		else if(accept('['))
+			{
+			skipWhitespace();
+			if(pos<source.size()&&isdigit(source[pos]))
+				componentIndex=source[pos++]-'0';
+			expect(']');
+			}
+		if(componentIndex<0||componentIndex>=numComponents)
+			error("Missing or invalid vector component");
+		return components[componentIndex];
+		}
+	
+	/* Check for constants: */
+	if(!braced&&name=="pi")
+		return newConstant(Math::Constants<double>::pi);
+	
+	error("Unknown variable");
+	return 0;
+	}
+
+SliceExpression::Node* SliceExpression::Parser::parsePower(void)
+	{
+	Node* result=parsePrimary();
+	if(accept('^'))
+		result=newOperation(POWER,result,parseUnary());
+	return result;
+	}
+
+SliceExpression::Node* SliceExpression::Parser::parseUnary(void)
+	{
+	if(accept('-'))
+		return newOperation(NEGATE,parseUnary());
+	accept('+');
+	return parsePower();
+	}
+
+SliceExpression::Node* SliceExpression::Parser::parseTerm(void)
+	{
+	Node* result=parseUnary();
+	while(true)
+		{
+		if(accept('*'))
+			result=newOperation(MULTIPLY,result,parseUnary());
+		else if(accept('/'))
+			result=newOperation(DIVIDE,result,parseUnary());
+		else
+			break;
+		}
+	return result;
+	}
+
+SliceExpression::Node* SliceExpression::Parser::parseExpression(void)
+	{
+	Node* result=parseTerm();
+	while(true)
+		{
+		if(accept('+'))
+			result=newOperation(ADD,result,parseTerm());
+		else if(accept('-'))
+			result=newOperation(SUBTRACT,result,parseTerm());
+		else
+			break;
+		}
+	return result;
+	}
+
+/***************************************************
+Methods of class SliceExpression::VariableResolver:
+***************************************************/
+
+SliceExpression::VariableResolver::~VariableResolver(void)
+	{
+	}
+
+/*********************************
+Methods of class SliceExpression:
+*********************************/
+
+int SliceExpression::addInput(SliceExpression::InputType type,int index)
+	{
+	/* Check if the input array is already referenced: */
+	for(size_t i=0;i<inputs.size();++i)
+		if(inputs[i].type==type&&inputs[i].index==index)
+			return int(i);
+	
+	Input input;
+	input.type=type;
+	input.index=index;
+	inputs.push_back(input);
+	return int(inputs.size())-1;
+	}
+
+void SliceExpression::emit(const SliceExpression::Node* node,SliceExpression::Kernel& kernel,int& stackDepth)
+	{
+	Instruction instruction;
+	instruction.input=-1;
+	instruction.constant=0.0;
+	switch(node->type)
+		{
+		case Node::CONSTANT:
+			instruction.opCode=PUSH_CONSTANT;
+			instruction.constant=node->constant;
+			++stackDepth;
+			break;
+		
+		case Node::INPUT:
+			instruction.opCode=PUSH_INPUT;
+			instruction.input=addInput(node->inputType,node->inputIndex);
+			++stackDepth;
+			break;
+		
+		case Node::OPERATION:
+			for(std::vector<Node*>::const_iterator cIt=node->children.begin();cIt!=node->children.end();++cIt)
+				emit(*cIt,kernel,stackDepth);
+			instruction.opCode=node->opCode;
+			stackDepth-=int(node->children.size())-1;
+			break;
+		
+		case Node::FIELD:
+			{
+			/* Compile the operator's argument into a new stage; nested stages are added first: */
+			Stage stage;
+			stage.kernel.maxStackDepth=0;
+			int stageStackDepth=0;
+			emit(node->children[0],stage.kernel,stageStackDepth);
+			stage.fieldOperator=node->fieldOperator;
+			stages.push_back(stage);
+			
+			/* Read the stage's result as a temporary input array: */
+			instruction.opCode=PUSH_INPUT;
+			instruction.input=addInput(TEMPORARY,int(stages.size())-1);
+			++stackDepth;
+			break;
+			}
+		}
+	kernel.code.push_back(instruction);
+	if(kernel.maxStackDepth<stackDepth)
+		kernel.maxStackDepth=stackDepth;
+	}
+
+SliceExpression::SliceExpression(const char* sSource,const SliceExpression::VariableResolver& resolver)
+	:source(sSource)
+	{
+	/* Parse the source text and compile the syntax tree: */
+	Parser parser(source,resolver);
+	const Node* root=parser.parse();
+	result.maxStackDepth=0;
+	int stackDepth=0;
+	emit(root,result,stackDepth);
+	}
+
+std::vector<SliceExpression::Definition> SliceExpression::parseDefinitions(const char* definitions)
+	{
+	std::vector<Definition> result;
+	
+	/* Split the definition list at top-level semicolons: */
+	std::vector<std::string> items;
+	std::string item;
+	int depth=0;
+	for(const char* dPtr=definitions;*dPtr!='\0';++dPtr)
+		{
+		if(*dPtr=='('||*dPtr=='{'||*dPtr=='[')
+			++depth;
+		else if(*dPtr==')'||*dPtr=='}'||*dPtr==']')
+			--depth;
+		if(*dPtr==';'&&depth==0)
+			{
+			items.push_back(item);
+			item.clear();
+			}
+		else
+			item.push_back(*dPtr);
+		}
+	items.push_back(item);
+	
+	for(std::vector<std::string>::iterator iIt=items.begin();iIt!=items.end();++iIt)
+		{
+		/* Trim the definition and skip empty ones: */
+		size_t start=iIt->find_first_not_of(" \t\n");
+		if(start==std::string::npos)
+			continue;
+		size_t end=iIt->find_last_not_of(" \t\n")+1;
+		std::string text=iIt->substr(start,end-start);
+		
+		/* Split the definition into name and expression: */
+		size_t equals=text.find('=',text[0]=='{'?text.find('}'):0);
+		if(equals==std::string::npos)
+			Misc::throwStdErr("SliceExpression::parseDefinitions: Missing '=' in definition \"%s\"",text.c_str());
+		Definition definition;
+		definition.name=text.substr(0,equals);
+		definition.name.erase(definition.name.find_last_not_of(" \t\n")+1);
+		if(definition.name.size()>=2&&definition.name[0]=='{'&&definition.name[definition.name.size()-1]=='}')
+			definition.name=definition.name.substr(1,definition.name.size()-2);
+		if(definition.name.empty())
+			Misc::throwStdErr("SliceExpression::parseDefinitions: Missing variable name in definition \"%s\"",text.c_str());
+		std::string expression=text.substr(equals+1);
+		expression.erase(0,expression.find_first_not_of(" \t\n"));
+		
+		/* Check for a parenthesized list of vector components: */
+		definition.vector=false;
+		if(expression.size()>=2&&expression[0]=='('&&expression[expression.size()-1]==')')
+			{
+			std::vector<std::string> components;
+			std::string component;
+			int depth=0;
+			bool enclosed=true;
+			for(size_t i=1;i<expression.size()-1&&enclosed;++i)
+				{
+				char c=expression[i];
+				if(c=='('||c=='{'||c=='[')
+					++depth;
+				else if(c==')'||c=='}'||c==']')
+					{
+					if(--depth<0)
+						enclosed=false;
+					}
+				if(c==','&&depth==0)
+					{
+					components.push_back(component);
+					component.clear();
+					}
+				else
+					component.push_back(c);
+				}
+			components.push_back(component);
+			if(enclosed&&components.size()>1)
+				{
+				definition.vector=true;
+				definition.components=components;
+				}
+			}
+		if(!definition.vector)
+			definition.components.push_back(expression);
+		
+		result.push_back(definition);
+		}
+	
+	return result;
+	}
+
+bool SliceExpression::usesPositions(void) const
+	{
+	for(std::vector<Input>::const_iterator iIt=inputs.begin();iIt!=inputs.end();++iIt)
+		if(iIt->type==POSITION)
+			return true;
+	
+	/* Radial means need vertex positions as well: */
+	for(std::vector<Stage>::const_iterator sIt=stages.begin();sIt!=stages.end();++sIt)
+		if(sIt->fieldOperator==RADIAL_MEAN)
+			return true;
+	
+	return false;
+	}
+
+const char* SliceExpression::getFieldOperatorName(SliceExpression::FieldOperator fieldOperator)
+	{
+	static const char* names[]={"radialMean","ddx","ddy","ddz"};
+	return names[fieldOperator];
+	}
+
+}
+
+}
@@ -0,0 +1,163 @@
+/***********************************************************************
+SliceExpression - Class for compiled expressions defining derived
+variables over the value slices of sliced data sets.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_SLICEEXPRESSION_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_SLICEEXPRESSION_INCLUDED
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+namespace Visualization {
+
+namespace Templatized {
+
+class SliceExpression
+	{
+	/* Embedded classes: */
+	public:
+	class VariableResolver // Interface to resolve variable names while compiling an expression
+		{
+		/* Constructors and destructors: */
+		public:
+		virtual ~VariableResolver(void);
+		
+		/* Methods: */
+		virtual int getNumVectorComponents(void) const =0; // Returns the number of components of vector variables
+		virtual int getScalarVariableSlice(const char* scalarVariableName) const =0; // Returns the index of the slice holding the given scalar variable, or -1 if there is no such variable
+		virtual bool getVectorVariableSlices(const char* vectorVariableName,int sliceIndices[]) const =0; // Stores the indices of the slices holding the given vector variable's components; returns false if there is no such variable
+		};
+	
+	enum OpCode // Enumerated type for bytecode instructions
+		{
+		PUSH_INPUT,PUSH_CONSTANT,
+		NEGATE,ADD,SUBTRACT,MULTIPLY,DIVIDE,POWER,MIN,MAX,
+		ABS,SQRT,EXP,LOG,SIN,COS,TAN,ASIN,ACOS,ATAN,ATAN2
+		};
+	
+	struct Instruction // Structure for bytecode instructions
+		{
+		/* Elements: */
+		public:
+		OpCode opCode; // Instruction's operation
+		int input; // Index of input array for PUSH_INPUT
+		double constant; // Value for PUSH_CONSTANT
+		};
+	
+	enum InputType // Enumerated type for the sources of kernel input arrays
+		{
+		SLICE,POSITION,TEMPORARY
+		};
+	
+	struct Input // Structure describing a kernel input array
+		{
+		/* Elements: */
+		public:
+		InputType type; // Source of the input array
+		int index; // Slice index, position component, or temporary index, respectively
+		};
+	
+	struct Kernel // Structure for bytecode programs evaluating one value per vertex from input arrays
+		{
+		/* Elements: */
+		public:
+		std::vector<Instruction> code; // Bytecode instructions in postfix order
+		int maxStackDepth; // Maximum depth of the evaluation stack
+		};
+	
+	enum FieldOperator // Enumerated type for operators that need the entire field of their argument
+		{
+		RADIAL_MEAN,DERIVATIVE_X,DERIVATIVE_Y,DERIVATIVE_Z
+		};
+	
+	struct Stage // Structure for field operators; a stage evaluates its kernel and applies its operator to the result to create the temporary of the same index
+		{
+		/* Elements: */
+		public:
+		Kernel kernel; // Kernel evaluating the field operator's argument
+		FieldOperator fieldOperator; // Operator to apply to the kernel's result
+		};
+	
+	struct Definition // Structure for a derived variable definition of the form name=expression or name=(expression,...,expression)
+		{
+		/* Elements: */
+		public:
+		std::string name; // Name of the derived variable
+		bool vector; // Flag whether the definition defines a vector variable
+		std::vector<std::string> components; // Expressions defining the variable or its components
+		};
+	
+	struct Node; // Structure for nodes of expression syntax trees
+	class Parser; // Class to parse expressions into syntax trees
+	
+	/* Elements: */
+	private:
+	std::string source; // Source text of the expression
+	std::vector<Input> inputs; // Input arrays referenced by the expression's kernels
+	std::vector<Stage> stages; // Field operator stages in evaluation order
+	Kernel result; // Kernel evaluating the expression's final result
+	
+	/* Private methods: */
+	int addInput(InputType type,int index); // Returns the index of the given input array, adding it if necessary
+	void emit(const Node* node,Kernel& kernel,int& stackDepth); // Compiles the given syntax tree into the given kernel
+	
+	/* Constructors and destructors: */
+	public:
+	SliceExpression(const char* sSource,const VariableResolver& resolver); // Compiles the given expression; throws exception on syntax errors or unknown variables
+	
+	/* Methods: */
+	static std::vector<Definition> parseDefinitions(const char* definitions); // Splits a semicolon-separated list of derived variable definitions
+	const std::string& getSource(void) const // Returns the source text of the expression
+		{
+		return source;
+		}
+	const std::vector<Input>& getInputs(void) const // Returns the input arrays referenced by the expression
+		{
+		return inputs;
+		}
+	bool usesPositions(void) const; // Returns true if any kernel references vertex positions
+	int getNumStages(void) const // Returns the number of field operator stages
+		{
+		return int(stages.size());
+		}
+	const Stage& getStage(int stageIndex) const // Returns a field operator stage
+		{
+		return stages[stageIndex];
+		}
+	const Kernel& getResult(void) const // Returns the kernel evaluating the final result
+		{
+		return result;
+		}
+	static const char* getFieldOperatorName(FieldOperator fieldOperator); // Returns the name of a field operator
+	template <class ValueScalarParam>
+	static void evaluateKernel(const Kernel& kernel,const ValueScalarParam* const* inputArrays,size_t numValues,ValueScalarParam* resultArray); // Evaluates a kernel for all values of the given input arrays in parallel
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_SLICEEXPRESSION_IMPLEMENTATION
+#include <Templatized/SliceExpression.icpp>
+#endif
+
+#endif
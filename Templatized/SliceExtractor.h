@@ -22,8 +22,11 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_SLICEEXTRACTOR_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_SLICEEXTRACTOR_INCLUDED
 
+#include <vector>
 #include <Misc/OneTimeQueue.h>
 #include <Geometry/Plane.h>
+#include <Templatized/CellClipper.h>
+#include <Templatized/EdgeSample.h>
 
 /* Forward declarations: */
 namespace Visualization {
@@ -51,7 +54,10 @@ class SliceExtractor
 	typedef typename DataSet::Locator Locator; // Type of data set locators
 	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from a data set
 	typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
+	typedef CellClipper<DataSet> Clipper; // Type to cull cells outside of cutting planes
 	typedef SliceParam Slice; // Type of slice representation
+	typedef EdgeSample<DataSet> VertexSample; // Type to remember where extracted vertices lie inside the data set's cells
+	typedef std::vector<VertexSample> VertexSampleList; // Type for lists of vertex samples, in slice vertex order
 	
 	private:
 	typedef typename DataSet::CellTopology CellTopology; // Topology of the data set's cells
@@ -65,14 +71,17 @@ class SliceExtractor
 	private:
 	const DataSet* dataSet; // Data set the isosurface extractor works on
 	ScalarExtractor scalarExtractor; // Scalar extractor working on data set
+	Clipper clipper; // Culls cells lying entirely outside of the active cutting planes
 	
 	/* Slice extraction state: */
 	Plane slicePlane; // The current slicing plane
 	Slice* slice; // Pointer to the slice representation storing extracted slice fragments
+	VertexSampleList* vertexSamples; // List receiving a sample for each vertex added to the slice, or 0
 	CellQueue cellQueue; // Queue of cells waiting for fragment extraction
 	
 	/* Private methods: */
 	int extractSliceFragment(const Cell& cell); // Extracts a slice fragment from a cell and stores it in the current slice representation
+	int skipClippedCell(const Cell& cell); // Counts the triangles a clipped cell would contribute to the current slice without extracting them; returns the cell's case index
 	
 	/* Constructors and destructors: */
 	public:
@@ -101,6 +110,19 @@ class SliceExtractor
 		dataSet=newDataSet;
 		scalarExtractor=newScalarExtractor;
 		}
+	template <class ClipPlaneParam>
+	void setClipPlanes(const std::vector<ClipPlaneParam>& newClipPlanes) // Sets the cutting planes outside of which subsequent extractions skip cells, and resets the culling statistics
+		{
+		clipper.setPlanes(newClipPlanes);
+		}
+	const Clipper& getClipper(void) const // Returns the cell clipper to query culling statistics
+		{
+		return clipper;
+		}
+	void setVertexSamples(VertexSampleList* newVertexSamples) // Sets a list receiving a sample for each vertex of the next extracted slice, or 0 to disable sampling
+		{
+		vertexSamples=newVertexSamples;
+		}
 	void extractSlice(const Plane& newSlicePlane,Slice& newSlice); // Extracts a global slice for the given plane and stores it in the given slice
 	void extractSeededSlice(const Locator& seedLocator,const Plane& newSlicePlane,Slice& newSlice); // Extracts a seeded slice for the given plane from the given cell and stores it in the given slice
 	void startSeededSlice(const Locator& seedLocator,const Plane& newSlicePlane,Slice& newSlice); // Starts extracting a seeded slice for the given plane from the given cell
@@ -23,10 +23,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_SLICEEXTRACTORINDEXEDTRIANGLESET_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_SLICEEXTRACTORINDEXEDTRIANGLESET_INCLUDED
 
+#include <vector>
 #include <Misc/HashTable.h>
 #include <Misc/OneTimeQueue.h>
 #include <Geometry/Plane.h>
 #include <Templatized/IndexedTriangleSet.h>
+#include <Templatized/EdgeSample.h>
 #include <Templatized/SliceExtractor.h>
 
 /* Forward declarations: */
@@ -55,7 +57,10 @@ class SliceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<Vertex
 	typedef typename DataSet::Locator Locator; // Type of data set locators
 	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from a data set
 	typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
+	typedef CellClipper<DataSet> Clipper; // Type to cull cells outside of cutting planes
 	typedef IndexedTriangleSet<VertexParam> Slice; // Type of slice representation
+	typedef EdgeSample<DataSet> VertexSample; // Type to remember where extracted vertices lie inside the data set's cells
+	typedef std::vector<VertexSample> VertexSampleList; // Type for lists of vertex samples, in slice vertex order
 	
 	private:
 	typedef typename DataSet::CellTopology CellTopology; // Topology of the data set's cells
@@ -72,15 +77,18 @@ class SliceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<Vertex
 	private:
 	const DataSet* dataSet; // Data set the isosurface extractor works on
 	ScalarExtractor scalarExtractor; // Scalar extractor working on data set
+	Clipper clipper; // Culls cells lying entirely outside of the active cutting planes
 	
 	/* Slice extraction state: */
 	Plane slicePlane; // The current slicing plane
 	Slice* slice; // Pointer to the slice representation storing extracted slice fragments
 	VertexIndexHasher vertexIndices; // Hasher mapping edge IDs to vertex indices in the slice
+	VertexSampleList* vertexSamples; // List receiving a sample for each vertex added to the slice, or 0
 	CellQueue cellQueue; // Queue of cells waiting for fragment extraction
 	
 	/* Private methods: */
 	int extractSliceFragment(const Cell& cell); // Extracts a slice fragment from a cell and stores it in the current slice representation
+	int skipClippedCell(const Cell& cell); // Counts the triangles a clipped cell would contribute to the current slice without extracting them; returns the cell's case index
 	
 	/* Constructors and destructors: */
 	public:
@@ -109,6 +117,19 @@ class SliceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<Vertex
 		dataSet=newDataSet;
 		scalarExtractor=newScalarExtractor;
 		}
+	template <class ClipPlaneParam>
+	void setClipPlanes(const std::vector<ClipPlaneParam>& newClipPlanes) // Sets the cutting planes outside of which subsequent extractions skip cells, and resets the culling statistics
+		{
+		clipper.setPlanes(newClipPlanes);
+		}
+	const Clipper& getClipper(void) const // Returns the cell clipper to query culling statistics
+		{
+		return clipper;
+		}
+	void setVertexSamples(VertexSampleList* newVertexSamples) // Sets a list receiving a sample for each vertex of the next extracted slice, or 0 to disable sampling
+		{
+		vertexSamples=newVertexSamples;
+		}
 	void extractSlice(const Plane& newSlicePlane,Slice& newSlice); // Extracts a global slice for the given plane and stores it in the given slice
 	void extractSeededSlice(const Locator& seedLocator,const Plane& newSlicePlane,Slice& newSlice); // Extracts a seeded slice for the given plane from the given cell and stores it in the given slice
 	void startSeededSlice(const Locator& seedLocator,const Plane& newSlicePlane,Slice& newSlice); // Starts extracting a seeded slice for the given plane from the given cell
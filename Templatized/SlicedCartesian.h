@@ -30,6 +30,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/Box.h>
 
 #include <Templatized/SlicedDataValue.h>
+#include <Templatized/EncodedSlice.h>
 #include <Templatized/Tesseract.h>
 #include <Templatized/LinearIndexID.h>
 #include <Templatized/IteratorWrapper.h>
@@ -254,6 +255,7 @@ class SlicedCartesian
 	Box domainBox; // Bounding box of all vertices
 	int numSlices; // Number of scalar value slices in the data set
 	ValueScalar** slices; // Array of vertex value slices
+	EncodedSlice<ValueScalar>** encodedSlices; // Array of encoded vertex value slices; null for slices stored as value arrays
 	
 	/* Private methods: */
 	template <class ScalarExtractorParam>
@@ -268,6 +270,7 @@ class SlicedCartesian
 	/* Data set construction methods: */
 	void setData(const Index& sNumVertices,const Size& sCellSize,int sNumSlices,const ValueScalar* sVertexValues =0); // Sets the number of vertices and cell size of the data set; copies slice-major vertex data if pointer is not null
 	int addSlice(const ValueScalar* sSliceValues =0); // Adds another slice to the data set; copies vertex data if pointer is not null
+	void encodeSlice(int sliceIndex,EncodedSliceBase::Codec codec); // Replaces a slice's value array with an encoded copy; the slice's value array is null afterwards
 	
 	/* Low-level data access methods: */
 	const Index& getNumVertices(void) const // Returns number of vertices in the data set
@@ -291,11 +294,17 @@ class SlicedCartesian
 		{
 		return slices[sliceIndex];
 		}
+	const EncodedSlice<ValueScalar>* getEncodedSlice(int sliceIndex) const // Returns one of the data set's value slices if it is encoded, null otherwise
+		{
+		return encodedSlices[sliceIndex];
+		}
 	ValueScalar getVertexValue(int sliceIndex,const Index& vertexIndex) const // Returns a vertex' data value inside a slice
 		{
+		if(encodedSlices[sliceIndex]!=0)
+			return encodedSlices[sliceIndex]->getValue(numVertices.calcOffset(vertexIndex));
 		return slices[sliceIndex][numVertices.calcOffset(vertexIndex)];
 		}
-	ValueScalar& getVertexValue(int sliceIndex,const Index& vertexIndex)  // Ditto
+	ValueScalar& getVertexValue(int sliceIndex,const Index& vertexIndex) // Ditto; slice must not be encoded
 		{
 		return slices[sliceIndex][numVertices.calcOffset(vertexIndex)];
 		}
@@ -30,12 +30,14 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/Vector.h>
 #include <Geometry/Box.h>
 #include <Geometry/ValuedPoint.h>
-#include <Geometry/ArrayKdTree.h>
 
 #include <Templatized/SlicedDataValue.h>
+#include <Templatized/EncodedSlice.h>
 #include <Templatized/Tesseract.h>
 #include <Templatized/LinearIndexID.h>
 #include <Templatized/IteratorWrapper.h>
+#include <Templatized/MappedKdTree.h>
+#include <Templatized/SphericalGridIndex.h>
 
 namespace Visualization {
 
@@ -228,6 +230,7 @@ class SlicedCurvilinear
 		bool canTrace; // Flag if the locator can trace on the next locatePoint call
 		
 		/* Private methods: */
+		bool findStartCell(const Point& position); // Moves the locator to a cell close to the given position; returns false if there is no close cell
 		bool newtonRaphsonStep(const Point& position); // Performs one Newton-Raphson step while tracing the given position
 		
 		/* Constructors and destructors: */
@@ -252,7 +255,7 @@ class SlicedCurvilinear
 	
 	private:
 	typedef Geometry::ValuedPoint<Point,CellID> CellCenter; // Data type to associate a cell's center point and its ID
-	typedef Geometry::ArrayKdTree<CellCenter> CellCenterTree; // Data type for kd-trees to locate closest cell centers
+	typedef MappedKdTree<CellCenter> CellCenterTree; // Data type for kd-trees to locate closest cell centers
 	
 	friend class Vertex;
 	friend class Cell;
@@ -264,10 +267,13 @@ class SlicedCurvilinear
 	GridArray grid; // Array defining data set's grid
 	int numSlices; // Number of scalar value slices in data set
 	ValueArray* slices; // Array of arrays defining data set's value slices
+	EncodedSlice<ValueScalar>** encodedSlices; // Array of encoded value slices; null for slices stored as value arrays
 	int vertexStrides[dimension]; // Array of pointer stride values in the vertex array
 	Index numCells; // Number of cells in data set in each dimension
 	int vertexOffsets[CellTopology::numVertices]; // Array of pointer offsets from a cell's base vertex to all cell vertices
 	CellCenterTree cellCenterTree; // Kd-tree containing cell centers
+	SphericalGridIndex<Scalar,dimensionParam> sphericalGridIndex; // Direct cell index if the grid is a logically-regular spherical shell
+	bool useSphericalGridIndex; // Flag whether locators use the spherical grid index when it is valid
 	VertexIterator firstVertex,lastVertex; // Bounds of vertex list
 	CellIterator firstCell,lastCell; // Bounds of cell list
 	Box domainBox; // Bounding box of all vertices
@@ -289,6 +295,7 @@ class SlicedCurvilinear
 	/* Data set construction methods: */
 	void setGrid(const Index& sNumVertices,const Point* sVertexPositions =0); // Creates a data set with the given number of vertices; copies vertex positions if pointer is not null
 	int addSlice(const ValueScalar* sSliceValues =0); // Adds another slice to the data set; copies slice values from given array if pointer is not null; returns index of new slice
+	void encodeSlice(int sliceIndex,EncodedSliceBase::Codec codec); // Replaces a slice's value array with an encoded copy; the slice's value array is empty afterwards
 	
 	/* Low-level data access methods: */
 	const Index& getNumVertices(void) const // Returns number of vertices in the data set
@@ -331,11 +338,17 @@ class SlicedCurvilinear
 		{
 		return slices[sliceIndex].getArray();
 		}
+	const EncodedSlice<ValueScalar>* getEncodedSlice(int sliceIndex) const // Returns one of the data set's value slices if it is encoded, null otherwise
+		{
+		return encodedSlices[sliceIndex];
+		}
 	ValueScalar getVertexValue(int sliceIndex,const Index& vertexIndex) const // Returns a vertex' data value from one slice
 		{
+		if(encodedSlices[sliceIndex]!=0)
+			return encodedSlices[sliceIndex]->getValue(numVertices.calcOffset(vertexIndex));
 		return slices[sliceIndex](vertexIndex);
 		}
-	ValueScalar& getVertexValue(int sliceIndex,const Index& vertexIndex) // Ditto
+	ValueScalar& getVertexValue(int sliceIndex,const Index& vertexIndex) // Ditto; slice must not be encoded
 		{
 		return slices[sliceIndex](vertexIndex);
 		}
@@ -349,6 +362,14 @@ class SlicedCurvilinear
 		return locatorEpsilon;
 		}
 	void setLocatorEpsilon(Scalar newLocatorEpsilon); // Sets the default accuracy threshold for locators working on this data set
+	bool hasSphericalGridIndex(void) const // Returns true if the grid was recognized as a logically-regular spherical shell
+		{
+		return sphericalGridIndex.isValid();
+		}
+	void setUseSphericalGridIndex(bool newUseSphericalGridIndex) // Enables or disables locating points via the spherical grid index
+		{
+		useSphericalGridIndex=newUseSphericalGridIndex;
+		}
 	
 	/* Methods implementing the data set interface: */
 	size_t getTotalNumVertices(void) const // Returns total number of vertices in the data set
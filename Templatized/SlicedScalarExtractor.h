@@ -26,6 +26,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <stddef.h>
 
 #include <Templatized/SlicedDataValue.h>
+#include <Templatized/EncodedSlice.h>
 
 /* Forward declarations: */
 namespace Visualization {
@@ -52,11 +53,12 @@ class ScalarExtractor<ScalarParam,SlicedDataValue<SourceValueScalarParam> >
 	private:
 	int sliceIndex; // Index of the value slice from which this extractor reads
 	const SourceValueScalar* valueArray; // Pointer to the used slice value array
+	const EncodedSlice<SourceValueScalar>* encodedSlice; // Pointer to the used encoded slice if the slice is not stored as a value array
 	
 	/* Constructors and destructors: */
 	public:
-	ScalarExtractor(int sSliceIndex,const SourceValueScalar* sValueArray) // Creates extractor for given value array
-		:sliceIndex(sSliceIndex),valueArray(sValueArray)
+	ScalarExtractor(int sSliceIndex,const SourceValueScalar* sValueArray,const EncodedSlice<SourceValueScalar>* sEncodedSlice =0) // Creates extractor for given value array or encoded slice
+		:sliceIndex(sSliceIndex),valueArray(sValueArray),encodedSlice(sEncodedSlice)
 		{
 		}
 	
@@ -67,6 +69,8 @@ class ScalarExtractor<ScalarParam,SlicedDataValue<SourceValueScalarParam> >
 		}
 	DestValue getValue(ptrdiff_t linearIndex) const // Extracts scalar from given linear index in slice value array
 		{
+		if(encodedSlice!=0)
+			return DestValue(encodedSlice->getValue(linearIndex));
 		return DestValue(valueArray[linearIndex]);
 		}
 	};
@@ -27,6 +27,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/Vector.h>
 
 #include <Templatized/SlicedDataValue.h>
+#include <Templatized/EncodedSlice.h>
 
 /* Forward declarations: */
 namespace Visualization {
@@ -53,23 +54,45 @@ class VectorExtractor<VectorParam,SlicedDataValue<SourceValueScalarParam> >
 	/* Elements: */
 	private:
 	const SourceValueScalar* valueArrays[dimension]; // Pointers to the used slice value arrays
+	const EncodedSlice<SourceValueScalar>* encodedSlices[dimension]; // Pointers to the used encoded slices for components whose slices are not stored as value arrays
+	bool encoded; // Flag whether any component reads from an encoded slice
 	
 	/* Constructors and destructors: */
 	public:
 	VectorExtractor(void) // Creates an undefined vector extractor
+		:encoded(false)
 		{
+		for(int i=0;i<dimension;++i)
+			encodedSlices[i]=0;
 		}
 	
 	/* Methods: */
-	void setSlice(int sliceIndex,const SourceValueScalar* sValueArray) // Sets the value array for one result vector component
+	void setSlice(int sliceIndex,const SourceValueScalar* sValueArray,const EncodedSlice<SourceValueScalar>* sEncodedSlice =0) // Sets the value array or encoded slice for one result vector component
 		{
 		valueArrays[sliceIndex]=sValueArray;
+		encodedSlices[sliceIndex]=sEncodedSlice;
+		encoded=false;
+		for(int i=0;i<dimension;++i)
+			encoded=encoded||encodedSlices[i]!=0;
 		}
 	DestValue getValue(ptrdiff_t linearIndex) const // Extracts vector from given linear index in all slice value arrays
 		{
 		DestValue result;
-		for(int i=0;i<dimension;++i)
-			result[i]=typename Vector::Scalar(valueArrays[i][linearIndex]);
+		if(encoded)
+			{
+			for(int i=0;i<dimension;++i)
+				{
+				if(encodedSlices[i]!=0)
+					result[i]=typename Vector::Scalar(encodedSlices[i]->getValue(linearIndex));
+				else
+					result[i]=typename Vector::Scalar(valueArrays[i][linearIndex]);
+				}
+			}
+		else
+			{
+			for(int i=0;i<dimension;++i)
+				result[i]=typename Vector::Scalar(valueArrays[i][linearIndex]);
+			}
 		return result;
 		}
 	};
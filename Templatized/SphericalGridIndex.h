@@ -0,0 +1,94 @@
+/***********************************************************************
+SphericalGridIndex - Helper class to directly locate cells in
+logically-regular curvilinear grids whose vertices are laid out along
+the radius, colatitude, and longitude axes of a spherical shell.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_SPHERICALGRIDINDEX_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_SPHERICALGRIDINDEX_INCLUDED
+
+#include <stddef.h>
+#include <vector>
+#include <Geometry/Point.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class ScalarParam,int dimensionParam>
+class SphericalGridIndex
+	{
+	/* Embedded classes: */
+	public:
+	typedef ScalarParam Scalar; // Scalar type of grid vertex positions
+	static const int dimension=dimensionParam; // Dimension of the grid
+	typedef Geometry::Point<Scalar,dimensionParam> Point; // Type for grid vertex positions
+	
+	private:
+	struct Axis // Structure mapping one spherical coordinate to one grid axis
+		{
+		/* Elements: */
+		public:
+		int coordinate; // Spherical coordinate varying along this grid axis: 0 - radius, 1 - colatitude, 2 - longitude
+		double sign; // 1.0 if the coordinate increases along the grid axis, -1.0 if it decreases
+		double center; // Center of the coordinate's range along the grid axis; used to unwrap longitudes
+		std::vector<double> values; // Signed coordinate values of all grid vertices along the axis, in increasing order
+		double lowLimit,highLimit; // Range of signed coordinate values covered by the grid, including some slack
+		double binScale; // Scale factor from signed coordinate values to lookup bin indices
+		std::vector<int> bins; // Index of the last grid vertex at or below the beginning of each lookup bin
+		};
+	
+	/* Elements: */
+	bool valid; // Flag whether the index was successfully built for the current grid
+	Axis axes[dimensionParam]; // Spherical coordinate mappings for all grid axes
+	
+	/* Private methods: */
+	static double wrapAngle(double angle); // Wraps an angle difference into the interval (-pi, pi]
+	static void calcSpherical(const Point& position,double spherical[3]); // Converts a Cartesian position to (radius, colatitude, longitude)
+	double getCoordinate(const double spherical[3],const Axis& axis) const; // Returns the signed coordinate value of a spherical position along the given axis
+	static int findInterval(const Axis& axis,double value,double& intervalPos); // Returns the index of the vertex interval containing the given signed value, and the position inside the interval
+	
+	/* Constructors and destructors: */
+	public:
+	SphericalGridIndex(void) // Creates an invalid index
+		:valid(false)
+		{
+		}
+	
+	/* Methods: */
+	template <class IndexParam>
+	bool build(const IndexParam& numVertices,const int vertexStrides[dimensionParam],const Point* firstVertexPosition,size_t vertexPositionStride); // Builds the index for the grid of the given layout; returns false if the grid is not a logically-regular spherical shell
+	void invalidate(void); // Marks the index as invalid and releases its lookup tables
+	bool isValid(void) const // Returns true if the index can be used to locate cells
+		{
+		return valid;
+		}
+	bool findCell(const Point& position,int cellIndex[dimensionParam],Scalar cellPos[dimensionParam]) const; // Returns the index of and local position inside the cell likely containing the given position; returns false if the position is outside the grid
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_SPHERICALGRIDINDEX_IMPLEMENTATION
+#include <Templatized/SphericalGridIndex.icpp>
+#endif
+
+#endif
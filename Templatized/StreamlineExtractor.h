@@ -23,6 +23,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_STREAMLINEEXTRACTOR_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_STREAMLINEEXTRACTOR_INCLUDED
 
+#include <vector>
+#include <Templatized/LocatorSample.h>
+
 namespace Visualization {
 
 namespace Templatized {
@@ -43,6 +46,8 @@ class StreamlineExtractor
 	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from a data set (to color the streamline)
 	typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
 	typedef StreamlineParam Streamline; // Type of streamline representation
+	typedef LocatorSample<DataSet> VertexSample; // Type to remember where extracted vertices lie inside the data set's cells
+	typedef std::vector<VertexSample> VertexSampleList; // Type for lists of vertex samples, in streamline vertex order
 	
 	private:
 	typedef typename Streamline::Vertex Vertex; // Type of vertices stored in streamline
@@ -59,6 +64,7 @@ class StreamlineExtractor
 	Locator locator; // Locator following the current streamline position
 	Scalar stepSize; // Step size for the current streamline integration step
 	Streamline* streamline; // Pointer to the streamline representation
+	VertexSampleList* vertexSamples; // List receiving a sample for each vertex added to the streamline, or 0
 	
 	/* Private methods: */
 	bool cashKarpStep(const Vector& vfp1,Scalar trialStepSize,Vector& step,Vector& error); // Computes a trial step vector with Cash-Karp coefficients; returns false if any evaluation point was outside the domain
@@ -105,6 +111,10 @@ class StreamlineExtractor
 		scalarExtractor=newScalarExtractor;
 		}
 	void setEpsilon(Scalar newEpsilon); // Sets the integration error threshold
+	void setVertexSamples(VertexSampleList* newVertexSamples) // Sets a list receiving a sample for each vertex of the next extracted streamline, or 0 to disable sampling
+		{
+		vertexSamples=newVertexSamples;
+		}
 	void extractStreamline(const Point& startPoint,const Locator& startLocator,Scalar startStepSize,Streamline& newStreamline); // Extracts a streamline for the given position and locator and stores it in the given streamline
 	void startStreamline(const Point& startPoint,const Locator& startLocator,Scalar startStepSize,Streamline& newStreamline); // Starts extracting a streamline for the given position and locator and stores it in the given streamline
 	template <class ContinueFunctorParam>
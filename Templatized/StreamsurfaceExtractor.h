@@ -23,6 +23,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_STREAMSURFACEEXTRACTOR_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_STREAMSURFACEEXTRACTOR_INCLUDED
 
+#include <vector>
+#include <GL/gl.h>
+#include <Threads/Mutex.h>
+#include <Threads/Cond.h>
+#include <Threads/Thread.h>
+
 namespace Visualization {
 
 namespace Templatized {
@@ -46,37 +52,108 @@ class StreamsurfaceExtractor
 	
 	private:
 	typedef typename Streamsurface::Vertex Vertex; // Type of vertices stored in stream surface
+	typedef typename Streamsurface::Index Index; // Type of vertex indices stored in stream surface
 	
-	struct Streamline // Structure storing the current state of one streamline defining the surface
+	struct Streamline // Structure storing the current state of one streamline on the stream surface's front
 		{
 		/* Elements: */
 		public:
-		Point pos0; // Tracing position at beginning of iteration step
+		Point pos; // Current tracing position
 		Locator locator; // Data set locator for current tracing position
-		VScalar scalar0; // Associated scalar value at the initial position
-		Vector vec0; // Vector value at the initial position
-		Point pos1; // Tracing position at end of iteration step
-		Scalar arclength; // Accumulated arc length of the streamline including the initial position
-		typename Streamsurface::Index index; // Index of most recently created vertex
-		Streamline* pred; // Pointer to previous streamline in the surface
-		Streamline* succ; // Pointer to next streamline in the surface
-		bool connectPred; // Flag whether this streamline is connected to the previous one
-		bool connectSucc; // Flag whether this streamline is connected to the next one
+		Vector vec; // Vector value at the current tracing position
+		VScalar scalar; // Associated scalar value at the current tracing position
+		Point prevPos; // Tracing position at the beginning of the current iteration step
+		Index index; // Index of the stream surface vertex at the current tracing position
+		Index prevIndex; // Index of the stream surface vertex at the previous tracing position
+		bool valid; // Flag whether the streamline is still inside the data set's domain
+		bool connectSucc; // Flag whether this streamline is connected to the next one on the front
+		};
+	
+	struct Worker // Structure holding the state of a front processing thread
+		{
+		/* Elements: */
+		public:
+		StreamsurfaceExtractor* extractor; // Pointer to the stream surface extractor
+		size_t firstLine,lastLine; // Index range of front streamlines handled by this worker in the current phase
+		std::vector<Index> indices; // Vertex indices of triangle strips created by this worker
+		std::vector<GLsizei> stripLengths; // Lengths of triangle strips created by this worker
+		Threads::Thread thread; // The worker thread
+		
+		/* Methods: */
+		void* workerThreadMethod(void)
+			{
+			extractor->stepWorker(*this);
+			return 0;
+			}
 		};
 	
+	struct PhaseBarrier // Structure to let all workers of an integration step finish one phase before any starts the next
+		{
+		/* Elements: */
+		public:
+		Threads::Mutex mutex; // Mutex protecting the barrier state
+		Threads::Cond cond; // Condition variable signalling the end of a phase
+		size_t numThreads; // Number of workers taking part in the current step
+		size_t numWaiting; // Number of workers that finished the current phase
+		unsigned int phase; // Number of the current phase
+		
+		/* Constructors and destructors: */
+		PhaseBarrier(void)
+			:numThreads(1),numWaiting(0),phase(0)
+			{
+			}
+		
+		/* Methods: */
+		void synchronize(void) // Blocks until all workers of the current step called synchronize
+			{
+			Threads::Mutex::Lock lock(mutex);
+			if(++numWaiting==numThreads)
+				{
+				/* Release all waiting workers into the next phase: */
+				numWaiting=0;
+				++phase;
+				cond.broadcast();
+				}
+			else
+				{
+				unsigned int waitPhase=phase;
+				while(phase==waitPhase)
+					cond.wait(mutex);
+				}
+			}
+		};
+	
+	friend struct Worker;
+	
 	/* Elements: */
 	private:
 	const DataSet* dataSet; // Data set the isosurface extractor works on
 	VectorExtractor vectorExtractor; // Vector extractor working on data set
 	ScalarExtractor scalarExtractor; // Scalar extractor working on data set
 	Scalar stepSize; // Fixed step size for streamline integration
+	int numStreamlines; // Number of seed streamlines
+	bool closed; // Flag whether the stream surface is a closed tube
+	unsigned int numThreads; // Number of threads to use; 0 uses all CPUs
+	std::vector<Streamline> seeds; // Array of seed streamline states
 	
-	/* Streamline extraction state: */
-	Streamline* streamlineHead; // Pointer to one of the streamlines defining the surface
+	/* Stream surface extraction state: */
+	std::vector<Streamline> front; // Array of streamlines on the current stream surface front, in front order
+	std::vector<Streamline> newFront; // Front under construction during refinement
+	std::vector<Index> slivers; // Vertex index triples of triangles left behind by streamlines removed from the front
+	Scalar minDistance,maxDistance; // Range of distances between neighboring streamlines outside of which the front is refined
 	Streamsurface* streamsurface; // Pointer to the stream surface representation
+	size_t numWorkers; // Number of workers processing the current integration step
+	Worker* workers; // Array of workers processing the current integration step
+	PhaseBarrier phaseBarrier; // Barrier separating the phases of the current integration step
 	
 	/* Private methods: */
-	bool stepStreamline(Streamline& s); // Advances the given streamline by one step
+	bool evaluateStreamline(Streamline& s); // Evaluates the vector field at the given streamline's position; returns false if the streamline left the domain
+	void advanceFront(size_t firstLine,size_t lastLine); // Advances the given range of streamlines by one step
+	void refineFront(void); // Removes or inserts streamlines where neighboring streamlines converge or diverge
+	void addFrontVertices(void); // Adds a new layer of vertices for the current front to the stream surface
+	void stitchFront(Worker& worker); // Creates triangle strips between the previous and current layer for the worker's range of streamlines
+	void splitFront(void); // Assigns an interval of the current front to each worker
+	void stepWorker(Worker& worker); // Runs one integration step as the given worker; worker 0 refines the front between the parallel phases
 	bool stepStreamsurface(void); // Advances all current streamline positions by one step and adds a new layer to the stream surface
 	
 	/* Constructors and destructors: */
@@ -114,13 +191,14 @@ class StreamsurfaceExtractor
 		return stepSize;
 		}
 	void setStepSize(Scalar newStepSize); // Sets the integration step size
-	int getNumStreamlines(void) const // Returns the number of streamlines extracted in parallel
+	int getNumStreamlines(void) const // Returns the number of seed streamlines
 		{
 		return numStreamlines;
 		}
-	void setNumStreamlines(int newNumStreamlines); // Sets the number of streamlines extracted in parallel
+	void setNumStreamlines(int newNumStreamlines); // Sets the number of seed streamlines
 	void setClosed(bool newClosed); // Sets if the stream surface is open or a closed tube
-	void initializeStreamline(int index,const Point& startPoint,const Locator& startLocator); // Initializes one streamline
+	void setNumThreads(unsigned int newNumThreads); // Sets the number of threads used to advance and stitch the front; 0 uses all CPUs
+	void initializeStreamline(int index,const Point& startPoint,const Locator& startLocator); // Initializes one seed streamline
 	void extractStreamsurface(Streamsurface& newStreamsurface); // Extracts stream surface for the previously initialized positions and locators
 	void startStreamsurface(Streamsurface& newStreamsurface); // Starts extracting stream surface for the previously initialized positions and locators
 	template <class ContinueFunctorParam>
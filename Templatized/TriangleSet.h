@@ -23,13 +23,21 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_TRIANGLESET_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_TRIANGLESET_INCLUDED
 
+#include <vector>
 #include <GL/gl.h>
 #include <GL/GLObject.h>
 
+#include <Templatized/VertexRange.h>
+#include <Templatized/ChunkPool.h>
+#include <Templatized/DepthSorter.h>
+
 /* Forward declarations: */
 namespace Cluster {
 class MulticastPipe;
 }
+namespace IO {
+class File;
+}
 
 namespace Visualization {
 
@@ -41,6 +49,7 @@ class TriangleSet:public GLObject
 	/* Embedded classes: */
 	public:
 	typedef VertexParam Vertex; // Type for triangle vertices
+	typedef std::vector<VertexRange<Vertex> > VertexRangeList; // Type for lists of contiguous runs of vertices
 	
 	private:
 	static const size_t chunkSize=3333; // Number of triangles per chunk
@@ -57,6 +66,16 @@ class TriangleSet:public GLObject
 			:succ(0)
 			{
 			}
+		
+		/* Methods: */
+		static void* operator new(size_t size) // Allocates chunks from the process-wide chunk pool
+			{
+			return ChunkPool::allocate(size);
+			}
+		static void operator delete(void* chunk,size_t size) // Returns chunks to the process-wide chunk pool
+			{
+			ChunkPool::release(chunk,size);
+			}
 		};
 	
 	struct DataItem:public GLObject::DataItem
@@ -65,7 +84,14 @@ class TriangleSet:public GLObject
 		public:
 		GLuint vertexBufferId; // ID of vertex buffer object for point data (or 0 if extension is not supported)
 		unsigned int version; // Version number of the triangle set in the vertex buffer
+		unsigned int texCoordVersion; // Version number of the vertex texture coordinates in the vertex buffer
 		size_t numTriangles; // Number of triangles already uploaded to the vertex buffer
+		unsigned int sortVersion; // Version number of the triangle set whose centroids are in the centroid array
+		size_t numSortTriangles; // Number of triangles whose centroids are in the centroid array
+		std::vector<float> centroids; // Triangle centroids for depth sorting
+		DepthSorter depthSorter; // Sorter producing back-to-front triangle orders for this context
+		std::vector<unsigned int> triangleOrder; // Current back-to-front triangle order
+		std::vector<GLuint> sortedIndices; // Vertex indices of all triangles in back-to-front order
 		
 		/* Constructors and destructors: */
 		DataItem(void);
@@ -76,6 +102,7 @@ class TriangleSet:public GLObject
 	private:
 	Cluster::MulticastPipe* pipe; // Pipe to stream triangle set data in a cluster environment (owned by caller)
 	unsigned int version; // Version number of the triangle set (incremented on each clear operation)
+	unsigned int texCoordVersion; // Version number of the vertex texture coordinates (incremented on each in-place update)
 	size_t numTriangles; // Total number of triangles currently in set
 	Chunk* head; // Pointer to first triangle buffer chunk
 	Chunk* tail; // Pointer to last triangle buffer chunk
@@ -85,6 +112,8 @@ class TriangleSet:public GLObject
 	
 	/* Private methods: */
 	void addNewChunk(void); // Adds a new chunk to the triangle buffer
+	bool updateTexCoords(size_t numRenderTriangles) const; // Updates only the texture coordinates in the currently bound vertex buffer; returns false if the buffer could not be updated
+	void sortTriangles(size_t numRenderTriangles,DataItem* dataItem) const; // Updates the data item's back-to-front vertex indices for the given number of triangles and the current modelview matrix
 	
 	/* Constructors and destructors: */
 	public:
@@ -116,11 +145,19 @@ class TriangleSet:public GLObject
 		}
 	void receive(void); // Receives triangle set data via multicast pipe until next flush() point
 	void flush(void); // Sends pending triangle set data across the multicast pipe and terminates receive() method on slaves
+	size_t getGeometrySize(void) const; // Returns the number of bytes written by writeGeometry
+	void writeGeometry(IO::File& file) const; // Writes all triangles currently in the set to the given file
+	void readGeometry(IO::File& file); // Appends triangles written by writeGeometry to the set
+	void getVertexRanges(VertexRangeList& ranges); // Appends the storage ranges of all vertices currently in the set to the given list
+	void invalidateTexCoords(void) // Notifies the triangle set that vertex texture coordinates were changed in place
+		{
+		++texCoordVersion;
+		}
 	size_t getNumTriangles(void) const // Returns number of triangles currently in buffer
 		{
 		return numTriangles;
 		}
-	void glRenderAction(GLContextData& contextData) const; // Renders all triangles in the buffer
+	void glRenderAction(GLContextData& contextData,bool depthSort =false) const; // Renders all triangles in the buffer, optionally back to front with respect to the current modelview matrix
 	};
 
 }
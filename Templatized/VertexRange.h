@@ -0,0 +1,54 @@
+/***********************************************************************
+VertexRange - Structure describing a contiguous run of vertices inside
+the chunked vertex storage of a visualization element.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_VERTEXRANGE_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_VERTEXRANGE_INCLUDED
+
+#include <stddef.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class VertexParam>
+struct VertexRange
+	{
+	/* Embedded classes: */
+	public:
+	typedef VertexParam Vertex; // Type of vertices in the range
+	
+	/* Elements: */
+	Vertex* vertices; // Pointer to the first vertex in the range
+	size_t numVertices; // Number of vertices in the range
+	
+	/* Constructors and destructors: */
+	VertexRange(Vertex* sVertices,size_t sNumVertices)
+		:vertices(sVertices),numVertices(sNumVertices)
+		{
+		}
+	};
+
+}
+
+}
+
+#endif
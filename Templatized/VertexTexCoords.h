@@ -0,0 +1,80 @@
+/***********************************************************************
+VertexTexCoords - Helper class to update only the texture coordinates
+of vertices stored in a mapped vertex buffer.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_VERTEXTEXCOORDS_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_VERTEXTEXCOORDS_INCLUDED
+
+#include <stddef.h>
+#include <GL/gl.h>
+#define GLVERTEX_NONSTANDARD_TEMPLATES
+#include <GL/GLVertex.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class VertexParam>
+class VertexTexCoords // Generic version for vertex types without texture coordinates
+	{
+	/* Embedded classes: */
+	public:
+	typedef VertexParam Vertex;
+	
+	/* Methods: */
+	static void copy(Vertex* dest,const Vertex* source,size_t numVertices) // Copies the texture coordinates of the given vertices; does nothing
+		{
+		}
+	};
+
+template <class TexCoordScalarParam,GLsizei numTexCoordComponentsParam,class ColorScalarParam,GLsizei numColorComponentsParam,class NormalScalarParam,class PositionScalarParam,GLsizei numPositionComponentsParam>
+class VertexTexCoords<GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> >
+	{
+	/* Embedded classes: */
+	public:
+	typedef GLVertex<TexCoordScalarParam,numTexCoordComponentsParam,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> Vertex;
+	
+	/* Methods: */
+	static void copy(Vertex* dest,const Vertex* source,size_t numVertices) // Copies only the texture coordinates of the given vertices
+		{
+		for(size_t i=0;i<numVertices;++i)
+			dest[i].texCoord=source[i].texCoord;
+		}
+	};
+
+template <class ColorScalarParam,GLsizei numColorComponentsParam,class NormalScalarParam,class PositionScalarParam,GLsizei numPositionComponentsParam>
+class VertexTexCoords<GLVertex<void,0,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> >
+	{
+	/* Embedded classes: */
+	public:
+	typedef GLVertex<void,0,ColorScalarParam,numColorComponentsParam,NormalScalarParam,PositionScalarParam,numPositionComponentsParam> Vertex;
+	
+	/* Methods: */
+	static void copy(Vertex* dest,const Vertex* source,size_t numVertices)
+		{
+		}
+	};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,246 @@
+/***********************************************************************
+DirtyBoxSetTest - Unit test for merging, clearing, and pruning of dirty
+boxes tracked by DirtyBoxSet.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <iostream>
+#include <vector>
+
+#include <DirtyBoxSet.h>
+
+namespace {
+
+/**************************************************
+Helper functions to create boxes and check results:
+**************************************************/
+
+int numFailures=0;
+
+void
+check(
+	bool condition,
+	const char* description)
+	{
+	if(!condition)
+		{
+		std::cerr<<"FAILED: "<<description<<std::endl;
+		++numFailures;
+		}
+	}
+
+DirtyBoxSet::Box
+makeBox(
+	int min0,int min1,int min2,
+	int max0,int max1,int max2)
+	{
+	int min[3]={min0,min1,min2};
+	int max[3]={max0,max1,max2};
+	return DirtyBoxSet::Box(min,max);
+	}
+
+bool
+equal(
+	const DirtyBoxSet::Box& box1,
+	const DirtyBoxSet::Box& box2)
+	{
+	for(int i=0;i<3;++i)
+		if(box1.min[i]!=box2.min[i]||box1.max[i]!=box2.max[i])
+			return false;
+	return true;
+	}
+
+bool
+contains(
+	const std::vector<DirtyBoxSet::Box>& boxes,
+	const DirtyBoxSet::Box& box)
+	{
+	for(std::vector<DirtyBoxSet::Box>::const_iterator bIt=boxes.begin();bIt!=boxes.end();++bIt)
+		if(equal(*bIt,box))
+			return true;
+	return false;
+	}
+
+/**********
+Test cases:
+**********/
+
+void
+testEagerMerge(
+	void)
+	{
+	int size[3]={64,64,64};
+	DirtyBoxSet set(size);
+	
+	/* Adjacent boxes merge without adding clean voxels: */
+	set.addBox(makeBox(0,0,0,8,8,8),1);
+	set.addBox(makeBox(8,0,0,16,8,8),2);
+	check(set.getNumBoxes()==1,"adjacent boxes are merged eagerly");
+	std::vector<DirtyBoxSet::Box> boxes;
+	set.getBoxes(1,boxes);
+	check(boxes.size()==1&&equal(boxes[0],makeBox(0,0,0,16,8,8)),"merged box covers both boxes and carries the later version");
+	
+	/* Distant boxes stay separate: */
+	set.addBox(makeBox(40,40,40,44,44,44),3);
+	check(set.getNumBoxes()==2,"distant boxes are not merged");
+	
+	/* Boxes outside the grid are ignored, and boxes straddling it are clipped: */
+	set.addBox(makeBox(70,0,0,80,8,8),4);
+	check(set.getNumBoxes()==2,"boxes outside the grid are ignored");
+	set.addBox(makeBox(60,60,60,70,70,70),5);
+	boxes.clear();
+	set.getBoxes(4,boxes);
+	check(boxes.size()==1&&equal(boxes[0],makeBox(60,60,60,64,64,64)),"boxes are clipped against the grid");
+	}
+
+void
+testCheapestPairMerge(
+	void)
+	{
+	int size[3]={64,64,64};
+	DirtyBoxSet set(size,2);
+	
+	/* Three boxes too far apart to merge eagerly; the closest two must be merged to stay within two boxes: */
+	set.addBox(makeBox(0,0,0,2,2,2),1);
+	set.addBox(makeBox(40,0,0,42,2,2),2);
+	set.addBox(makeBox(44,0,0,46,2,2),3);
+	check(set.getNumBoxes()==2,"box count is limited to the maximum");
+	std::vector<DirtyBoxSet::Box> boxes;
+	set.getBoxes(0,boxes);
+	check(contains(boxes,makeBox(0,0,0,2,2,2)),"distant box is kept separate");
+	check(contains(boxes,makeBox(40,0,0,46,2,2)),"closest pair of boxes is merged");
+	}
+
+void
+testFullUpdate(
+	void)
+	{
+	int size[3]={8,8,8};
+	DirtyBoxSet set(size);
+	check(!set.needsFullUpdate(0),"new set is clean");
+	
+	/* Dirtying more than half the grid falls back to a full update: */
+	set.addBox(makeBox(0,0,0,8,8,5),3);
+	check(set.getNumBoxes()==0,"boxes are dropped on full update");
+	check(set.needsFullUpdate(2),"older clients need a full update");
+	check(!set.needsFullUpdate(3),"current clients do not need a full update");
+	}
+
+void
+testReset(
+	void)
+	{
+	int size[3]={64,64,64};
+	DirtyBoxSet set(size);
+	set.addBox(makeBox(0,0,0,4,4,4),1);
+	set.addBox(makeBox(32,32,32,36,36,36),2);
+	
+	/* Resetting clears all boxes and forces older clients to update fully: */
+	int newSize[3]={16,16,16};
+	set.reset(newSize,5);
+	check(set.getNumBoxes()==0,"reset clears all boxes");
+	check(set.needsFullUpdate(4),"reset forces full updates on older clients");
+	check(!set.needsFullUpdate(5),"reset does not force full updates on current clients");
+	
+	/* The new size clips subsequent boxes: */
+	set.addBox(makeBox(32,32,32,36,36,36),6);
+	check(set.getNumBoxes()==0,"reset changes the grid size");
+	}
+
+void
+testVersionFiltering(
+	void)
+	{
+	int size[3]={64,64,64};
+	DirtyBoxSet set(size);
+	set.addBox(makeBox(0,0,0,4,4,4),1);
+	set.addBox(makeBox(32,32,32,36,36,36),2);
+	
+	std::vector<DirtyBoxSet::Box> boxes;
+	set.getBoxes(0,boxes);
+	check(boxes.size()==2,"oldest client receives all boxes");
+	boxes.clear();
+	set.getBoxes(1,boxes);
+	check(boxes.size()==1&&equal(boxes[0],makeBox(32,32,32,36,36,36)),"client receives only boxes changed after its version");
+	boxes.clear();
+	set.getBoxes(2,boxes);
+	check(boxes.empty(),"current client receives no boxes");
+	}
+
+void
+testPruning(
+	void)
+	{
+	int size[3]={64,64,64};
+	DirtyBoxSet set(size);
+	int owner1,owner2;
+	int client1,client2,client3;
+	
+	/* Register two clients holding the initial version: */
+	set.flushClient(&owner1,&client1,0);
+	set.flushClient(&owner1,&client2,0);
+	check(set.getNumClients()==2,"clients are registered on first flush");
+	set.addBox(makeBox(0,0,0,4,4,4),1);
+	set.addBox(makeBox(32,32,32,36,36,36),2);
+	
+	/* Boxes are kept until every client has flushed them: */
+	set.flushClient(&owner1,&client1,2);
+	check(set.getNumClients()==2,"flushing again does not register a client twice");
+	check(set.getNumBoxes()==2,"boxes are kept while a client lags behind");
+	set.flushClient(&owner1,&client2,1);
+	check(set.getNumBoxes()==1,"boxes flushed by all clients are dropped");
+	check(!set.needsFullUpdate(1)&&set.needsFullUpdate(0),"clients older than all registered clients need a full update");
+	set.flushClient(&owner1,&client2,2);
+	check(set.getNumBoxes()==0,"all boxes are dropped once every client is current");
+	check(set.needsFullUpdate(1),"dropped boxes force full updates on unregistered clients");
+	
+	/* A lagging client of another owner holds back boxes until it is removed: */
+	set.flushClient(&owner2,&client3,2);
+	set.addBox(makeBox(0,0,0,4,4,4),3);
+	set.flushClient(&owner1,&client1,3);
+	set.flushClient(&owner1,&client2,3);
+	check(set.getNumBoxes()==1,"lagging client holds back boxes");
+	set.removeClients(&owner2);
+	check(set.getNumClients()==2,"removing an owner's clients keeps other clients");
+	check(set.getNumBoxes()==0,"removing a lagging client drops the boxes it held back");
+	
+	/* Resetting keeps client registrations: */
+	set.reset(size,4);
+	check(set.getNumClients()==2,"reset keeps registered clients");
+	}
+
+}
+
+int main(void)
+	{
+	testEagerMerge();
+	testCheapestPairMerge();
+	testFullUpdate();
+	testReset();
+	testVersionFiltering();
+	testPruning();
+	
+	if(numFailures!=0)
+		{
+		std::cerr<<numFailures<<" test(s) failed"<<std::endl;
+		return 1;
+		}
+	std::cout<<"All DirtyBoxSet tests passed"<<std::endl;
+	return 0;
+	}
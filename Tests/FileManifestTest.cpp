@@ -0,0 +1,211 @@
+/***********************************************************************
+FileManifestTest - Unit test for validation of cached block checksum
+manifests against copied and modified data files.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <iostream>
+#include <string>
+
+#include <Abstract/FileManifest.h>
+
+namespace {
+
+/***********************************************************
+Helper functions to create data files and check the results:
+***********************************************************/
+
+int numFailures=0;
+
+void
+check(
+	bool condition,
+	const char* description)
+	{
+	if(!condition)
+		{
+		std::cerr<<"FAILED: "<<description<<std::endl;
+		++numFailures;
+		}
+	}
+
+void
+writeFile(
+	const std::string& fileName,
+	size_t size,
+	unsigned char seed)
+	{
+	FILE* file=fopen(fileName.c_str(),"wb");
+	for(size_t i=0;i<size;++i)
+		fputc((unsigned char)(seed+i*7),file);
+	fclose(file);
+	}
+
+void
+copyFile(
+	const std::string& sourceFileName,
+	const std::string& destFileName)
+	{
+	FILE* source=fopen(sourceFileName.c_str(),"rb");
+	FILE* dest=fopen(destFileName.c_str(),"wb");
+	int c;
+	while((c=fgetc(source))!=EOF)
+		fputc(c,dest);
+	fclose(dest);
+	fclose(source);
+	}
+
+void
+copyModTime(
+	const std::string& sourceFileName,
+	const std::string& destFileName)
+	{
+	/* Set the destination's access and modification times to the source's, like "cp -p" does: */
+	struct stat sourceStats;
+	stat(sourceFileName.c_str(),&sourceStats);
+	struct timespec times[2];
+	#ifdef __APPLE__
+	times[0]=sourceStats.st_atimespec;
+	times[1]=sourceStats.st_mtimespec;
+	#else
+	times[0]=sourceStats.st_atim;
+	times[1]=sourceStats.st_mtim;
+	#endif
+	utimensat(AT_FDCWD,destFileName.c_str(),times,0);
+	}
+
+/**********
+Test cases:
+**********/
+
+const size_t blockSize=64; // Small block size to get several blocks from small test files
+
+void
+testCachedManifest(
+	const std::string& directory)
+	{
+	std::string fileName=directory+"/cached.dat";
+	writeFile(fileName,1000,1);
+	
+	Visualization::Abstract::FileManifest computed;
+	computed.compute(fileName.c_str(),blockSize);
+	check(computed.getFileSize()==1000&&computed.getNumBlocks()==16,"manifest covers all blocks including the partial last block");
+	
+	/* The first get computes and caches the manifest, the second one loads the cache: */
+	Visualization::Abstract::FileManifest first,second;
+	first.get(fileName.c_str(),blockSize);
+	check(access((fileName+".manifest").c_str(),F_OK)==0,"manifest is cached");
+	second.get(fileName.c_str(),blockSize);
+	check(first==computed&&second==computed,"cached manifest matches the computed manifest");
+	}
+
+void
+testCopyWithPreservedModTime(
+	const std::string& directory)
+	{
+	/* Create an original and a replica of the same size but with different contents: */
+	std::string originalFileName=directory+"/original.dat";
+	std::string replicaFileName=directory+"/replica.dat";
+	writeFile(originalFileName,1000,1);
+	writeFile(replicaFileName,1000,2);
+	
+	/* Cache the original's manifest, then copy it to the replica along with the original's modification time: */
+	Visualization::Abstract::FileManifest original;
+	original.get(originalFileName.c_str(),blockSize);
+	copyFile(originalFileName+".manifest",replicaFileName+".manifest");
+	copyModTime(originalFileName,replicaFileName);
+	
+	/* The replica must be rehashed instead of matching the original through the copied cache file: */
+	Visualization::Abstract::FileManifest replica,computed;
+	replica.get(replicaFileName.c_str(),blockSize);
+	computed.compute(replicaFileName.c_str(),blockSize);
+	check(replica==computed,"copied cache file is not used for a different file with the same size and modification time");
+	check(!(replica==original)&&replica.findMismatch(original)==0,"replica with different contents mismatches the original");
+	}
+
+void
+testModificationWithPreservedModTime(
+	const std::string& directory)
+	{
+	std::string fileName=directory+"/modified.dat";
+	std::string savedFileName=directory+"/saved.dat";
+	writeFile(fileName,1000,1);
+	Visualization::Abstract::FileManifest before;
+	before.get(fileName.c_str(),blockSize);
+	
+	/* Modify the file in place and restore its modification time: */
+	writeFile(savedFileName,1000,1);
+	copyModTime(fileName,savedFileName);
+	FILE* file=fopen(fileName.c_str(),"r+b");
+	fseek(file,500,SEEK_SET);
+	fputc(0,file);
+	fclose(file);
+	copyModTime(savedFileName,fileName);
+	
+	Visualization::Abstract::FileManifest after;
+	after.get(fileName.c_str(),blockSize);
+	check(!(after==before)&&after.findMismatch(before)==500/blockSize,"modified file is rehashed even though its modification time is unchanged");
+	}
+
+void
+removeFiles(
+	const std::string& directory)
+	{
+	static const char* fileNames[]={"cached.dat","original.dat","replica.dat","modified.dat","saved.dat",0};
+	for(int i=0;fileNames[i]!=0;++i)
+		{
+		std::string fileName=directory+"/"+fileNames[i];
+		remove(fileName.c_str());
+		remove((fileName+".manifest").c_str());
+		}
+	rmdir(directory.c_str());
+	}
+
+}
+
+int main(void)
+	{
+	/* Create a scratch directory for the test files: */
+	char directoryTemplate[]="/tmp/FileManifestTest.XXXXXX";
+	if(mkdtemp(directoryTemplate)==0)
+		{
+		std::cerr<<"Unable to create scratch directory"<<std::endl;
+		return 1;
+		}
+	std::string directory=directoryTemplate;
+	
+	testCachedManifest(directory);
+	testCopyWithPreservedModTime(directory);
+	testModificationWithPreservedModTime(directory);
+	removeFiles(directory);
+	
+	if(numFailures!=0)
+		{
+		std::cerr<<numFailures<<" test(s) failed"<<std::endl;
+		return 1;
+		}
+	std::cout<<"All FileManifest tests passed"<<std::endl;
+	return 0;
+	}
@@ -0,0 +1,236 @@
+/***********************************************************************
+LICConvolverTest - Regression test comparing CPU line integral
+convolution of a uniform flow against a directly computed reference.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <stddef.h>
+#include <math.h>
+#include <iostream>
+#include <vector>
+
+#include "LICConvolver.h"
+
+namespace {
+
+/****************************************************
+Helper functions to create volumes and check results:
+****************************************************/
+
+int numFailures=0;
+
+void
+check(
+	bool condition,
+	const char* description)
+	{
+	if(!condition)
+		{
+		std::cerr<<"FAILED: "<<description<<std::endl;
+		++numFailures;
+		}
+	}
+
+typedef LICConvolver::Scalar Scalar;
+
+const unsigned int size[3]={40,5,3}; // Size of the test volumes; several tiles along x
+const unsigned int kernelHalfLength=6; // Half length of the box filter kernel in integration steps
+
+size_t
+getIndex(
+	unsigned int x,
+	unsigned int y,
+	unsigned int z)
+	{
+	return (size_t(z)*size[1]+size_t(y))*size[0]+size_t(x);
+	}
+
+void
+createUniformFlow(
+	std::vector<Scalar>& vectors,
+	ptrdiff_t vectorStrides[3])
+	{
+	/* Create an interleaved vector volume flowing along +x: */
+	vectorStrides[0]=3;
+	vectorStrides[1]=vectorStrides[0]*ptrdiff_t(size[0]);
+	vectorStrides[2]=vectorStrides[1]*ptrdiff_t(size[1]);
+	vectors.resize(size_t(size[0])*size_t(size[1])*size_t(size[2])*3);
+	for(size_t i=0;i<vectors.size();i+=3)
+		{
+		vectors[i+0]=Scalar(2);
+		vectors[i+1]=Scalar(0);
+		vectors[i+2]=Scalar(0);
+		}
+	}
+
+void
+convolve(
+	LICConvolver& convolver,
+	std::vector<Scalar>& result)
+	{
+	ptrdiff_t resultStrides[3];
+	resultStrides[0]=1;
+	resultStrides[1]=ptrdiff_t(size[0]);
+	resultStrides[2]=resultStrides[1]*ptrdiff_t(size[1]);
+	result.resize(size_t(size[0])*size_t(size[1])*size_t(size[2]));
+	convolver.convolve(&result[0],resultStrides);
+	}
+
+void
+calcReference(
+	const LICConvolver& convolver,
+	std::vector<Scalar>& reference)
+	{
+	/*********************************************************************
+	With unit steps along +x, every streamline runs along a voxel row and
+	visits integer positions. Each voxel therefore receives the mean of
+	the noise over the kernel window around it, clipped to the row.
+	*********************************************************************/
+	
+	reference.resize(size_t(size[0])*size_t(size[1])*size_t(size[2]));
+	double minValue=1.0,maxValue=0.0;
+	std::vector<double> means(reference.size());
+	for(unsigned int z=0;z<size[2];++z)
+		for(unsigned int y=0;y<size[1];++y)
+			for(unsigned int x=0;x<size[0];++x)
+				{
+				unsigned int lo=x>=kernelHalfLength?x-kernelHalfLength:0;
+				unsigned int hi=x+kernelHalfLength<size[0]?x+kernelHalfLength:size[0]-1;
+				double sum=0.0;
+				for(unsigned int xi=lo;xi<=hi;++xi)
+					{
+					Scalar pos[3]={Scalar(xi),Scalar(y),Scalar(z)};
+					sum+=double(convolver.getNoise(pos));
+					}
+				double mean=sum/double(hi+1-lo);
+				means[getIndex(x,y,z)]=mean;
+				if(minValue>mean)
+					minValue=mean;
+				if(maxValue<mean)
+					maxValue=mean;
+				}
+	
+	/* Stretch the means to the full intensity range like the convolver: */
+	for(size_t i=0;i<reference.size();++i)
+		reference[i]=Scalar((means[i]-minValue)/(maxValue-minValue));
+	}
+
+double
+calcMaxError(
+	const std::vector<Scalar>& result,
+	const std::vector<Scalar>& reference)
+	{
+	double maxError=0.0;
+	for(size_t i=0;i<result.size();++i)
+		{
+		double error=fabs(double(result[i])-double(reference[i]));
+		if(maxError<error)
+			maxError=error;
+		}
+	return maxError;
+	}
+
+/**********
+Test cases:
+**********/
+
+void
+testUniformFlow(
+	void)
+	{
+	std::vector<Scalar> vectors;
+	ptrdiff_t vectorStrides[3];
+	createUniformFlow(vectors,vectorStrides);
+	
+	/* Convolve with unit steps, using several threads on small tiles: */
+	LICConvolver convolver(size,&vectors[0],vectorStrides);
+	convolver.setStepSize(Scalar(1));
+	convolver.setKernelHalfLength(kernelHalfLength);
+	convolver.setNoise(Scalar(1),17);
+	convolver.setTileSize(8);
+	convolver.setNumThreads(4);
+	std::vector<Scalar> result;
+	convolve(convolver,result);
+	
+	std::vector<Scalar> reference;
+	calcReference(convolver,reference);
+	check(calcMaxError(result,reference)<1.0e-4,"multi-threaded convolution matches the reference");
+	
+	/* The result must not depend on the number of threads: */
+	convolver.setNumThreads(1);
+	std::vector<Scalar> serialResult;
+	convolve(convolver,serialResult);
+	check(serialResult==result,"single-threaded convolution matches multi-threaded convolution");
+	}
+
+void
+testNoiseFrequency(
+	void)
+	{
+	std::vector<Scalar> vectors;
+	ptrdiff_t vectorStrides[3];
+	createUniformFlow(vectors,vectorStrides);
+	
+	/* Sample the noise at twice the frequency: */
+	LICConvolver convolver(size,&vectors[0],vectorStrides);
+	LICConvolver unitConvolver(size,&vectors[0],vectorStrides);
+	convolver.setNoise(Scalar(2),17);
+	unitConvolver.setNoise(Scalar(1),17);
+	bool scaled=true;
+	for(unsigned int x=0;x<size[0];++x)
+		{
+		Scalar pos[3]={Scalar(x)*Scalar(0.5),Scalar(1),Scalar(2)};
+		Scalar scaledPos[3]={Scalar(x),Scalar(2),Scalar(4)};
+		scaled=scaled&&convolver.getNoise(pos)==unitConvolver.getNoise(scaledPos);
+		}
+	check(scaled,"noise lattice is scaled by the noise frequency");
+	
+	/* Convolve with the higher frequency and compare against the reference: */
+	convolver.setStepSize(Scalar(1));
+	convolver.setKernelHalfLength(kernelHalfLength);
+	std::vector<Scalar> result;
+	convolve(convolver,result);
+	std::vector<Scalar> reference;
+	calcReference(convolver,reference);
+	check(calcMaxError(result,reference)<1.0e-4,"convolution with a higher noise frequency matches the reference");
+	
+	/* Different seeds must create different noise: */
+	unitConvolver.setNoise(Scalar(2),18);
+	unitConvolver.setStepSize(Scalar(1));
+	unitConvolver.setKernelHalfLength(kernelHalfLength);
+	std::vector<Scalar> otherResult;
+	convolve(unitConvolver,otherResult);
+	check(calcMaxError(result,otherResult)>0.1,"noise depends on the noise seed");
+	}
+
+}
+
+int main(void)
+	{
+	testUniformFlow();
+	testNoiseFrequency();
+	
+	if(numFailures!=0)
+		{
+		std::cerr<<numFailures<<" test(s) failed"<<std::endl;
+		return 1;
+		}
+	std::cout<<"All LICConvolver tests passed"<<std::endl;
+	return 0;
+	}
@@ -0,0 +1,427 @@
+/***********************************************************************
+TimeSeries - Class to manage a sequence of data sets representing the
+time steps of a time-varying simulation, with asynchronous prefetching
+of neighboring time steps into a bounded pool.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include "TimeSeries.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdexcept>
+#include <iostream>
+#include <Misc/ThrowStdErr.h>
+#include <Misc/Timer.h>
+#include <Cluster/MulticastPipe.h>
+#include <Vrui/Vrui.h>
+
+#include <Abstract/DataSet.h>
+#include <Abstract/Module.h>
+
+namespace {
+
+/****************
+Helper functions:
+****************/
+
+bool substituteStepNumber(const std::string& argTemplate,int stepNumber,std::string& arg)
+	{
+	/* Copy the template and replace every %d placeholder, with optional zero padding and field width, by the step number: */
+	bool substituted=false;
+	arg.clear();
+	std::string::const_iterator aIt=argTemplate.begin();
+	while(aIt!=argTemplate.end())
+		{
+		if(*aIt=='%')
+			{
+			std::string::const_iterator pIt=aIt+1;
+			if(pIt!=argTemplate.end()&&*pIt=='%')
+				{
+				/* Unescape a literal percent sign: */
+				arg.push_back('%');
+				aIt=pIt+1;
+				continue;
+				}
+			
+			/* Parse the placeholder's flags and field width: */
+			bool zeroPad=false;
+			if(pIt!=argTemplate.end()&&*pIt=='0')
+				{
+				zeroPad=true;
+				++pIt;
+				}
+			int width=0;
+			while(pIt!=argTemplate.end()&&isdigit(*pIt))
+				{
+				width=width*10+int(*pIt-'0');
+				++pIt;
+				}
+			if(pIt!=argTemplate.end()&&*pIt=='d')
+				{
+				/* Format the step number: */
+				char number[64];
+				if(zeroPad)
+					snprintf(number,sizeof(number),"%0*d",width,stepNumber);
+				else
+					snprintf(number,sizeof(number),"%*d",width,stepNumber);
+				arg.append(number);
+				substituted=true;
+				aIt=pIt+1;
+				continue;
+				}
+			}
+		
+		arg.push_back(*aIt);
+		++aIt;
+		}
+	
+	return substituted;
+	}
+
+}
+
+/***************************************
+Methods of class TimeSeries::Statistics:
+***************************************/
+
+TimeSeries::Statistics::Statistics(void)
+	:numRequests(0),numHits(0),numPartialHits(0),numMisses(0),
+	 numLoads(0),totalLoadTime(0.0),maxLoadTime(0.0),
+	 totalWaitTime(0.0),maxWaitTime(0.0)
+	{
+	}
+
+/***************************
+Methods of class TimeSeries:
+***************************/
+
+void* TimeSeries::loaderThreadMethod(void)
+	{
+	while(true)
+		{
+		/* Wait for the next load request: */
+		int stepIndex;
+		{
+		Threads::Mutex::Lock stepLock(stepMutex);
+		while(!terminate&&loadQueue.empty())
+			loadRequestCond.wait(stepMutex);
+		
+		/* Only shut down once all queued loads are done, to keep the cluster pipe in sync: */
+		if(loadQueue.empty())
+			return 0;
+		
+		stepIndex=loadQueue.front();
+		loadQueue.pop_front();
+		}
+		
+		/* Load the time step's data set: */
+		Misc::Timer loadTimer;
+		DataSet* dataSet=0;
+		std::string error;
+		try
+			{
+			dataSet=module->load(steps[stepIndex].args,pipe);
+			if(!derivedVariables.empty())
+				dataSet->addDerivedVariables(derivedVariables.c_str());
+			if(!sliceCodec.empty())
+				dataSet->encodeSlices(sliceCodec.c_str());
+			}
+		catch(std::runtime_error err)
+			{
+			delete dataSet;
+			dataSet=0;
+			error=err.what();
+			}
+		loadTimer.elapse();
+		
+		/* Hand the data set to the main thread: */
+		{
+		Threads::Mutex::Lock stepLock(stepMutex);
+		Step& s=steps[stepIndex];
+		--s.numPendingLoads;
+		s.loadTime=loadTimer.getTime();
+		++statistics.numLoads;
+		statistics.totalLoadTime+=s.loadTime;
+		if(statistics.maxLoadTime<s.loadTime)
+			statistics.maxLoadTime=s.loadTime;
+		
+		if(dataSet!=0)
+			{
+			/* Keep the data set if the step is still in the pool and was not loaded by an earlier request: */
+			if(s.resident&&s.dataSet==0)
+				{
+				s.dataSet=dataSet;
+				s.failed=false;
+				}
+			else
+				delete dataSet;
+			}
+		else
+			{
+			s.failed=true;
+			s.error=error;
+			}
+		
+		loadCompleteCond.broadcast();
+		}
+		
+		/* Wake up the main thread to pick up the new time step: */
+		Vrui::requestUpdate();
+		}
+	
+	return 0;
+	}
+
+bool TimeSeries::makeRoom(int requestedStepIndex)
+	{
+	/* Resident flags and pins only change in response to requests that happen identically on all cluster nodes, so eviction never depends on loader progress and the load queues stay in sync. */
+	
+	/* Count the resident time steps and find the least recently used evictable one: */
+	unsigned int numResident=0;
+	int lruStepIndex=-1;
+	for(int i=0;i<int(steps.size());++i)
+		if(steps[i].resident)
+			{
+			++numResident;
+			if(i!=currentStepIndex&&i!=requestedStepIndex&&steps[i].numPins==0&&(lruStepIndex<0||steps[lruStepIndex].lastUsed>steps[i].lastUsed))
+				lruStepIndex=i;
+			}
+	
+	if(numResident<maxNumResidentSteps)
+		return true;
+	if(lruStepIndex<0)
+		return false;
+	
+	evictStep(lruStepIndex);
+	return true;
+	}
+
+void TimeSeries::evictStep(int stepIndex)
+	{
+	Threads::Mutex::Lock stepLock(stepMutex);
+	Step& s=steps[stepIndex];
+	
+	/* Remove the step from the pool; a load still in progress will drop its result: */
+	s.resident=false;
+	delete s.dataSet;
+	s.dataSet=0;
+	}
+
+void TimeSeries::queueStep(int stepIndex)
+	{
+	Threads::Mutex::Lock stepLock(stepMutex);
+	Step& s=steps[stepIndex];
+	
+	/* Add the step to the pool and append it to the load queue: */
+	s.resident=true;
+	s.failed=false;
+	++s.numPendingLoads;
+	loadQueue.push_back(stepIndex);
+	loadRequestCond.signal();
+	}
+
+TimeSeries::TimeSeries(const TimeSeries::Module* sModule,const std::vector<std::string>& argsTemplate,int firstStepNumber,int lastStepNumber,int stepNumberStride,unsigned int sMaxNumResidentSteps,const std::string& sDerivedVariables,const std::string& sSliceCodec)
+	:module(sModule),
+	 derivedVariables(sDerivedVariables),
+	 sliceCodec(sSliceCodec),
+	 maxNumResidentSteps(sMaxNumResidentSteps),
+	 accessCounter(0),
+	 currentStepIndex(-1),
+	 pipe(0),
+	 terminate(false)
+	{
+	/* Check the step range: */
+	if(stepNumberStride<=0)
+		Misc::throwStdErr("TimeSeries::TimeSeries: Invalid time step stride %d",stepNumberStride);
+	if(lastStepNumber<firstStepNumber)
+		Misc::throwStdErr("TimeSeries::TimeSeries: Empty time step range %d-%d",firstStepNumber,lastStepNumber);
+	
+	/* The pool must at least hold the current time step and both its neighbors: */
+	if(maxNumResidentSteps<3)
+		maxNumResidentSteps=3;
+	
+	/* Create the time steps' module arguments: */
+	for(int stepNumber=firstStepNumber;stepNumber<=lastStepNumber;stepNumber+=stepNumberStride)
+		{
+		Step s;
+		s.stepNumber=stepNumber;
+		bool substituted=false;
+		for(std::vector<std::string>::const_iterator atIt=argsTemplate.begin();atIt!=argsTemplate.end();++atIt)
+			{
+			std::string arg;
+			substituted=substituteStepNumber(*atIt,stepNumber,arg)||substituted;
+			s.args.push_back(arg);
+			}
+		if(!substituted)
+			Misc::throwStdErr("TimeSeries::TimeSeries: No %%d time step placeholder in data set arguments");
+		s.resident=false;
+		s.lastUsed=0;
+		s.numPins=0;
+		s.numPendingLoads=0;
+		s.dataSet=0;
+		s.failed=false;
+		s.loadTime=0.0;
+		steps.push_back(s);
+		}
+	
+	/* Open a pipe for the loader thread; loads are serialized through it in queue order: */
+	pipe=Vrui::openPipe();
+	
+	/* Start the loader thread: */
+	loaderThread.start(this,&TimeSeries::loaderThreadMethod);
+	}
+
+TimeSeries::~TimeSeries(void)
+	{
+	/* Tell the loader thread to shut down after finishing all queued loads: */
+	{
+	Threads::Mutex::Lock stepLock(stepMutex);
+	terminate=true;
+	loadRequestCond.signal();
+	}
+	loaderThread.join();
+	
+	/* Delete all loaded data sets: */
+	for(std::vector<Step>::iterator sIt=steps.begin();sIt!=steps.end();++sIt)
+		delete sIt->dataSet;
+	
+	delete pipe;
+	}
+
+TimeSeries::DataSet* TimeSeries::getDataSet(int stepIndex)
+	{
+	if(stepIndex<0||stepIndex>=int(steps.size()))
+		Misc::throwStdErr("TimeSeries::getDataSet: Invalid time step index %d",stepIndex);
+	
+	Misc::Timer waitTimer;
+	Step& s=steps[stepIndex];
+	s.lastUsed=++accessCounter;
+	
+	/* Classify the request and queue the time step if it is not in the pool: */
+	bool hit=false;
+	bool partialHit=false;
+	if(s.resident)
+		{
+		Threads::Mutex::Lock stepLock(stepMutex);
+		hit=s.dataSet!=0;
+		partialHit=!hit&&s.numPendingLoads>0;
+		}
+	else
+		{
+		/* Evict if necessary; the pool may temporarily overflow if nothing can be evicted: */
+		makeRoom(stepIndex);
+		queueStep(stepIndex);
+		}
+	
+	/* Wait until the time step is loaded or failed to load: */
+	DataSet* result;
+	std::string error;
+	{
+	Threads::Mutex::Lock stepLock(stepMutex);
+	while(s.dataSet==0&&s.numPendingLoads>0)
+		loadCompleteCond.wait(stepMutex);
+	result=s.dataSet;
+	error=s.error;
+	
+	waitTimer.elapse();
+	++statistics.numRequests;
+	if(hit)
+		++statistics.numHits;
+	else if(partialHit)
+		++statistics.numPartialHits;
+	else
+		++statistics.numMisses;
+	statistics.totalWaitTime+=waitTimer.getTime();
+	if(statistics.maxWaitTime<waitTimer.getTime())
+		statistics.maxWaitTime=waitTimer.getTime();
+	
+	if(result==0)
+		{
+		/* Drop the failed time step from the pool so that it can be requested again: */
+		s.resident=false;
+		s.failed=false;
+		}
+	}
+	
+	if(result==0)
+		Misc::throwStdErr("TimeSeries::getDataSet: Could not load time step %d due to exception %s",s.stepNumber,error.c_str());
+	
+	return result;
+	}
+
+void TimeSeries::setCurrentStep(int stepIndex)
+	{
+	if(stepIndex<0||stepIndex>=int(steps.size()))
+		Misc::throwStdErr("TimeSeries::setCurrentStep: Invalid time step index %d",stepIndex);
+	
+	/* Pin the new current time step: */
+	currentStepIndex=stepIndex;
+	steps[currentStepIndex].lastUsed=++accessCounter;
+	
+	/* Prefetch the next time step first, as it is the most likely to be requested, then the previous one: */
+	int neighbors[2]={stepIndex+1,stepIndex-1};
+	for(int i=0;i<2;++i)
+		if(neighbors[i]>=0&&neighbors[i]<int(steps.size())&&!steps[neighbors[i]].resident)
+			{
+			/* Only prefetch if there is room in the pool without evicting the current step: */
+			if(makeRoom(neighbors[i]))
+				queueStep(neighbors[i]);
+			}
+	}
+
+void TimeSeries::pinStep(int stepIndex)
+	{
+	if(stepIndex<0||stepIndex>=int(steps.size()))
+		Misc::throwStdErr("TimeSeries::pinStep: Invalid time step index %d",stepIndex);
+	
+	++steps[stepIndex].numPins;
+	}
+
+void TimeSeries::unpinStep(int stepIndex)
+	{
+	if(stepIndex<0||stepIndex>=int(steps.size()))
+		Misc::throwStdErr("TimeSeries::unpinStep: Invalid time step index %d",stepIndex);
+	
+	if(steps[stepIndex].numPins>0)
+		--steps[stepIndex].numPins;
+	}
+
+double TimeSeries::getLoadTime(int stepIndex) const
+	{
+	Threads::Mutex::Lock stepLock(stepMutex);
+	return steps[stepIndex].loadTime;
+	}
+
+TimeSeries::Statistics TimeSeries::getStatistics(void) const
+	{
+	Threads::Mutex::Lock stepLock(stepMutex);
+	return statistics;
+	}
+
+void TimeSeries::printStatistics(std::ostream& os) const
+	{
+	Statistics s=getStatistics();
+	os<<"Time series: "<<s.numRequests<<" step requests, "<<s.numHits<<" prefetch hits, "<<s.numPartialHits<<" partial hits, "<<s.numMisses<<" misses";
+	os<<" (hit rate "<<s.getHitRate()*100.0<<"%)"<<std::endl;
+	if(s.numLoads>0)
+		os<<"Time series: "<<s.numLoads<<" step loads, average load time "<<s.totalLoadTime*1000.0/double(s.numLoads)<<" ms, maximum "<<s.maxLoadTime*1000.0<<" ms"<<std::endl;
+	if(s.numRequests>0)
+		os<<"Time series: average wait time "<<s.totalWaitTime*1000.0/double(s.numRequests)<<" ms, maximum "<<s.maxWaitTime*1000.0<<" ms"<<std::endl;
+	}
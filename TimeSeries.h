@@ -0,0 +1,147 @@
+/***********************************************************************
+TimeSeries - Class to manage a sequence of data sets representing the
+time steps of a time-varying simulation, with asynchronous prefetching
+of neighboring time steps into a bounded pool.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef TIMESERIES_INCLUDED
+#define TIMESERIES_INCLUDED
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <iosfwd>
+#include <Threads/Mutex.h>
+#include <Threads/Cond.h>
+#include <Threads/Thread.h>
+
+/* Forward declarations: */
+namespace Cluster {
+class MulticastPipe;
+}
+namespace Visualization {
+namespace Abstract {
+class DataSet;
+class Module;
+}
+}
+
+class TimeSeries
+	{
+	/* Embedded classes: */
+	public:
+	typedef Visualization::Abstract::DataSet DataSet;
+	typedef Visualization::Abstract::Module Module;
+	
+	struct Statistics // Structure to report time step loading statistics
+		{
+		/* Elements: */
+		public:
+		unsigned int numRequests; // Number of time steps requested by the application
+		unsigned int numHits; // Number of requests served by already loaded time steps
+		unsigned int numPartialHits; // Number of requests for time steps that were still being prefetched
+		unsigned int numMisses; // Number of requests for time steps that were not in the pool
+		unsigned int numLoads; // Number of completed time step loads
+		double totalLoadTime; // Accumulated time spent loading time steps in seconds
+		double maxLoadTime; // Longest time spent loading a single time step in seconds
+		double totalWaitTime; // Accumulated time the application spent waiting for requested time steps in seconds
+		double maxWaitTime; // Longest time the application waited for a single time step in seconds
+		
+		/* Constructors and destructors: */
+		Statistics(void); // Creates empty statistics
+		
+		/* Methods: */
+		double getHitRate(void) const // Returns the fraction of requests served without waiting for a complete load
+			{
+			return numRequests>0?double(numHits)/double(numRequests):0.0;
+			}
+		};
+	
+	private:
+	struct Step // Structure to hold the state of a time step
+		{
+		/* Elements: */
+		public:
+		int stepNumber; // Number of the time step as substituted into the module arguments
+		std::vector<std::string> args; // Module arguments to load the time step
+		
+		unsigned int lastUsed; // Access counter value when the time step was last requested; only used by the main thread
+		unsigned int numPins; // Number of pins keeping the time step in the memory pool; only used by the main thread
+		
+		/* State shared with the loader thread, protected by the step mutex: */
+		bool resident; // Flag whether the time step is part of the memory pool; only changed by the main thread
+		unsigned int numPendingLoads; // Number of loads for this time step that are queued or in progress
+		DataSet* dataSet; // The time step's data set, or 0 if not loaded
+		bool failed; // Flag whether the most recent load failed
+		std::string error; // Error message from the most recent failed load
+		double loadTime; // Time spent loading the time step in seconds
+		};
+	
+	/* Elements: */
+	const Module* module; // Module used to load the time steps
+	std::string derivedVariables; // Definitions of derived variables to add to each loaded time step, or empty
+	std::string sliceCodec; // Name of the codec to encode each loaded time step's value slices, or empty
+	std::vector<Step> steps; // Array of time steps
+	unsigned int maxNumResidentSteps; // Maximum number of time steps kept in the memory pool
+	unsigned int accessCounter; // Counter to determine least recently used time steps
+	int currentStepIndex; // Index of the time step currently used by the application, or -1
+	Cluster::MulticastPipe* pipe; // Pipe shared by all time step loads in a cluster environment
+	mutable Threads::Mutex stepMutex; // Mutex protecting the load queue, the shared time step state, and the loading statistics
+	Threads::Cond loadRequestCond; // Condition variable for the loader thread to wait for load requests
+	Threads::Cond loadCompleteCond; // Condition variable for the main thread to wait for completed loads
+	std::deque<int> loadQueue; // Queue of time step indices to be loaded in order
+	bool terminate; // Flag to tell the loader thread to shut down once the load queue is empty
+	Threads::Thread loaderThread; // Thread loading time steps in the background
+	Statistics statistics; // Loading statistics
+	
+	/* Private methods: */
+	void* loaderThreadMethod(void); // Method loading queued time steps in the background
+	bool makeRoom(int requestedStepIndex); // Evicts the least recently used resident time step that is neither current, requested, nor pinned; returns false if there is none
+	void evictStep(int stepIndex); // Removes a time step from the memory pool
+	void queueStep(int stepIndex); // Adds a time step to the memory pool and queues it for loading
+	
+	/* Constructors and destructors: */
+	public:
+	TimeSeries(const Module* sModule,const std::vector<std::string>& argsTemplate,int firstStepNumber,int lastStepNumber,int stepNumberStride,unsigned int sMaxNumResidentSteps,const std::string& sDerivedVariables,const std::string& sSliceCodec); // Creates a time series by substituting the time step numbers into the %d placeholder in the given module arguments; adds the given derived variables to each time step and encodes its value slices with the given codec if not empty
+	~TimeSeries(void); // Waits for all outstanding loads and destroys all loaded data sets
+	
+	/* Methods: */
+	int getNumSteps(void) const // Returns the number of time steps in the series
+		{
+		return int(steps.size());
+		}
+	int getStepNumber(int stepIndex) const // Returns the number of the given time step
+		{
+		return steps[stepIndex].stepNumber;
+		}
+	int getCurrentStep(void) const // Returns the index of the current time step
+		{
+		return currentStepIndex;
+		}
+	DataSet* getDataSet(int stepIndex); // Returns the data set for the given time step; blocks until the time step is loaded and throws exception if loading failed
+	void setCurrentStep(int stepIndex); // Marks the given time step as being used by the application and prefetches its neighbors
+	void pinStep(int stepIndex); // Keeps the given resident time step in the memory pool until it is unpinned as often as it was pinned
+	void unpinStep(int stepIndex); // Releases one pin on the given time step
+	double getLoadTime(int stepIndex) const; // Returns the time it took to load the given time step in seconds, or 0 if it was never loaded
+	Statistics getStatistics(void) const; // Returns a snapshot of the current loading statistics
+	void printStatistics(std::ostream& os) const; // Prints a summary of the loading statistics to the given stream
+	};
+
+#endif
@@ -43,6 +43,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Abstract/DataSet.h>
 #include <Abstract/VariableManager.h>
+#include <Templatized/Profiler.h>
 #include <Wrappers/RenderArrow.h>
 
 #include "GLRenderState.h"
@@ -56,6 +57,7 @@ VectorEvaluationLocator::VectorEvaluationLocator(Vrui::LocatorTool* sLocatorTool
 	:EvaluationLocator(sLocatorTool,sApplication,"Vector Evaluation Dialog"),
 	 vectorExtractor(0),
 	 scalarExtractor(0),
+	 vectorVariableIndex(-1),scalarVariableIndex(-1),
 	 colorMap(application->variableManager->getCurrentColorMap()),
 	 valueValid(false),
 	 arrowLengthScale(1)
@@ -172,6 +174,8 @@ void VectorEvaluationLocator::motionCallback(Vrui::LocatorTool::MotionCallbackDa
 		if(locator->isValid())
 			{
 			valueValid=true;
+			static const unsigned int evaluateProbe=Visualization::Templatized::Profiler::registerTimer("Vector evaluation",Visualization::Templatized::Profiler::LOCATOR);
+			Visualization::Templatized::Profiler::Scope evaluateScope(evaluateProbe);
 			currentScalarValue=locator->calcScalar(scalarExtractor);
 			currentValue=locator->calcVector(vectorExtractor);
 			for(int i=0;i<3;++i)
@@ -209,6 +213,26 @@ void VectorEvaluationLocator::highlightLocator(GLRenderState& renderState) const
 		}
 	}
 
+void VectorEvaluationLocator::prepareDataSetChange(void)
+	{
+	/* Remember the evaluated variables before their extractors go away: */
+	vectorVariableIndex=application->variableManager->getVectorVariable(vectorExtractor);
+	scalarVariableIndex=application->variableManager->getScalarVariable(scalarExtractor);
+	}
+
+void VectorEvaluationLocator::dataSetChanged(void)
+	{
+	/* Call the base class method: */
+	EvaluationLocator::dataSetChanged();
+	
+	/* Get the extractors for the evaluated variables from the new data set: */
+	vectorExtractor=application->variableManager->getVectorExtractor(vectorVariableIndex);
+	scalarExtractor=application->variableManager->getScalarExtractor(scalarVariableIndex);
+	valueValid=false;
+	for(int i=0;i<3;++i)
+		values[i]->setString("");
+	}
+
 void VectorEvaluationLocator::arrowScaleCallback(GLMotif::TextFieldSlider::ValueChangedCallbackData* cbData)
 	{
 	/* Get the new slider value and convert to step size: */
@@ -48,6 +48,8 @@ class VectorEvaluationLocator:public EvaluationLocator
 	/* Elements: */
 	const VectorExtractor* vectorExtractor; // Extractor for the evaluated vector value
 	const ScalarExtractor* scalarExtractor; // Extractor for the evaluated scalar value (to color arrow rendering)
+	int vectorVariableIndex; // Index of the evaluated vector variable while the data set is being replaced
+	int scalarVariableIndex; // Index of the evaluated scalar variable while the data set is being replaced
 	const GLColorMap* colorMap; // Color map for the evaluated scalar value
 	GLMotif::TextField* values[3]; // The vector component value text field
 	bool valueValid; // Flag if the evaluation value is valid
@@ -66,6 +68,8 @@ class VectorEvaluationLocator:public EvaluationLocator
 	
 	/* Methods from class BaseLocator: */
 	virtual void highlightLocator(GLRenderState& renderState) const;
+	virtual void prepareDataSetChange(void);
+	virtual void dataSetChanged(void);
 	
 	/* New methods: */
 	void arrowScaleCallback(GLMotif::TextFieldSlider::ValueChangedCallbackData* cbData);
@@ -26,6 +26,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <string.h>
 #include <stdexcept>
 #include <vector>
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <Misc/ThrowStdErr.h>
@@ -35,6 +36,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Misc/CreateNumberedFileName.h>
 #include <Misc/StandardValueCoders.h>
 #include <Misc/ConfigurationFile.h>
+#include <Math/Math.h>
 #include <IO/File.h>
 #include <IO/OpenFile.h>
 #include <IO/ValueSource.h>
@@ -56,6 +58,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <GLMotif/TextField.h>
 #include <GLMotif/Button.h>
 #include <GLMotif/CascadeButton.h>
+#include <GLMotif/TextFieldSlider.h>
 #include <SceneGraph/GLRenderState.h>
 #include <SceneGraph/NodeCreator.h>
 #include <SceneGraph/VRMLFile.h>
@@ -74,10 +77,15 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Abstract/BinaryParametersSink.h>
 #include <Abstract/BinaryParametersSource.h>
 #include <Abstract/FileParametersSource.h>
+#include <Abstract/MemoryParametersSink.h>
+#include <Abstract/MemoryParametersSource.h>
 #include <Abstract/ConfigurationFileParametersSource.h>
 #include <Abstract/Algorithm.h>
 #include <Abstract/Element.h>
 #include <Abstract/Module.h>
+#include <Templatized/ChunkPool.h>
+#include <Templatized/DepthSorter.h>
+#include <Templatized/GridFinalizer.h>
 
 #include "CuttingPlane.h"
 #ifdef VISUALIZER_USE_COLLABORATION
@@ -86,9 +94,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include "BaseLocator.h"
 #include "CuttingPlaneLocator.h"
 #include "ScalarEvaluationLocator.h"
+#include "ScalarProbeLocator.h"
 #include "VectorEvaluationLocator.h"
 #include "ExtractorLocator.h"
 #include "ElementList.h"
+#include "TimeSeries.h"
+#include "ExtractionScheduler.h"
 #include "GLRenderState.h"
 
 #include "LICBrush.h"
@@ -195,6 +206,10 @@ GLMotif::Popup* Visualizer::createAlgorithmsMenu(void)
 		algorithms->addToggle("Evaluate Scalars");
 		++algorithmIndex;
 		
+		/* Add the scalar probe algorithm: */
+		algorithms->addToggle("Probe Scalars");
+		++algorithmIndex;
+		
 		/* Add scalar algorithms: */
 		firstScalarAlgorithmIndex=algorithmIndex;
 		for(int i=0;i<module->getNumScalarAlgorithms();++i)
@@ -328,6 +343,79 @@ GLMotif::Popup* Visualizer::createColorMenu(void)
 	return colorMenu;
 	}
 
+GLMotif::PopupWindow* Visualizer::createTimeStepDialog(void)
+	{
+	const GLMotif::StyleSheet& ss=*Vrui::getWidgetManager()->getStyleSheet();
+	
+	/* Create the time step dialog window: */
+	GLMotif::PopupWindow* timeStepDialogPopup=new GLMotif::PopupWindow("TimeStepDialogPopup",Vrui::getWidgetManager(),"Time Step");
+	timeStepDialogPopup->setResizableFlags(true,false);
+	timeStepDialogPopup->setCloseButton(true);
+	timeStepDialogPopup->getCloseCallbacks().add(this,&Visualizer::timeStepDialogClosedCallback);
+	
+	GLMotif::RowColumn* timeStepDialog=new GLMotif::RowColumn("TimeStepDialog",timeStepDialogPopup,false);
+	timeStepDialog->setOrientation(GLMotif::RowColumn::HORIZONTAL);
+	timeStepDialog->setPacking(GLMotif::RowColumn::PACK_TIGHT);
+	timeStepDialog->setNumMinorWidgets(1);
+	
+	GLMotif::Button* previousTimeStepButton=new GLMotif::Button("PreviousTimeStepButton",timeStepDialog,"<");
+	previousTimeStepButton->getSelectCallbacks().add(this,&Visualizer::previousTimeStepCallback);
+	
+	/* Create a slider to select the time step by number: */
+	int numSteps=timeSeries->getNumSteps();
+	int stepNumberStride=numSteps>1?timeSeries->getStepNumber(1)-timeSeries->getStepNumber(0):1;
+	timeStepSlider=new GLMotif::TextFieldSlider("TimeStepSlider",timeStepDialog,6,ss.fontHeight*20.0f);
+	timeStepSlider->setSliderMapping(GLMotif::TextFieldSlider::LINEAR);
+	timeStepSlider->setValueType(GLMotif::TextFieldSlider::INT);
+	timeStepSlider->setValueRange(timeSeries->getStepNumber(0),timeSeries->getStepNumber(numSteps-1),stepNumberStride);
+	timeStepSlider->setValue(timeSeries->getStepNumber(timeSeries->getCurrentStep()));
+	timeStepSlider->getValueChangedCallbacks().add(this,&Visualizer::timeStepSliderCallback);
+	
+	GLMotif::Button* nextTimeStepButton=new GLMotif::Button("NextTimeStepButton",timeStepDialog,">");
+	nextTimeStepButton->getSelectCallbacks().add(this,&Visualizer::nextTimeStepCallback);
+	
+	timeStepDialog->setColumnWeight(1,1.0f);
+	timeStepDialog->manageChild();
+	
+	return timeStepDialogPopup;
+	}
+
+GLMotif::PopupWindow* Visualizer::createProfilerDialog(void)
+	{
+	/* Create the profiler dialog window: */
+	GLMotif::PopupWindow* profilerDialogPopup=new GLMotif::PopupWindow("ProfilerDialogPopup",Vrui::getWidgetManager(),"Profiler");
+	profilerDialogPopup->setResizableFlags(false,false);
+	profilerDialogPopup->setCloseButton(true);
+	profilerDialogPopup->getCloseCallbacks().add(this,&Visualizer::profilerDialogClosedCallback);
+	
+	GLMotif::RowColumn* profilerDialog=new GLMotif::RowColumn("ProfilerDialog",profilerDialogPopup,false);
+	profilerDialog->setOrientation(GLMotif::RowColumn::VERTICAL);
+	profilerDialog->setPacking(GLMotif::RowColumn::PACK_TIGHT);
+	profilerDialog->setNumMinorWidgets(2);
+	
+	/* Show the mean frame interval: */
+	new GLMotif::Label("FrameIntervalLabel",profilerDialog,"Frame interval (ms)");
+	frameIntervalValue=new GLMotif::TextField("FrameIntervalValue",profilerDialog,8);
+	frameIntervalValue->setPrecision(3);
+	
+	/* Show the time spent in each category per frame, not counting time spent in nested timers: */
+	for(int i=0;i<Visualization::Templatized::Profiler::NUM_CATEGORIES;++i)
+		{
+		char widgetName[40];
+		snprintf(widgetName,sizeof(widgetName),"CategoryLabel%d",i);
+		std::string labelText=Visualization::Templatized::Profiler::getCategoryName(Visualization::Templatized::Profiler::Category(i));
+		labelText.append(" (ms/frame)");
+		new GLMotif::Label(widgetName,profilerDialog,labelText.c_str());
+		snprintf(widgetName,sizeof(widgetName),"CategoryTimeValue%d",i);
+		categoryTimeValues[i]=new GLMotif::TextField(widgetName,profilerDialog,8);
+		categoryTimeValues[i]->setPrecision(3);
+		}
+	
+	profilerDialog->manageChild();
+	
+	return profilerDialogPopup;
+	}
+
 GLMotif::PopupMenu* Visualizer::createMainMenu(void)
 	{
 	GLMotif::PopupMenu* mainMenu=new GLMotif::PopupMenu("MainMenuPopup",Vrui::getWidgetManager());
@@ -359,6 +447,15 @@ GLMotif::PopupMenu* Visualizer::createMainMenu(void)
 	GLMotif::CascadeButton* colorCascade=new GLMotif::CascadeButton("ColorCascade",mainMenu,"Color Maps");
 	colorCascade->setPopup(createColorMenu());
 	
+	if(timeSeries!=0&&timeSeries->getNumSteps()>1)
+		{
+		showTimeStepDialogToggle=new GLMotif::ToggleButton("ShowTimeStepDialogToggle",mainMenu,"Show Time Step Dialog");
+		showTimeStepDialogToggle->getValueChangedCallbacks().add(this,&Visualizer::showTimeStepDialogCallback);
+		}
+	
+	showProfilerDialogToggle=new GLMotif::ToggleButton("ShowProfilerDialogToggle",mainMenu,"Show Profiler");
+	showProfilerDialogToggle->getValueChangedCallbacks().add(this,&Visualizer::showProfilerDialogCallback);
+	
 	GLMotif::Button* centerDisplayButton=new GLMotif::Button("CenterDisplayButton",mainMenu,"Center Display");
 	centerDisplayButton->getSelectCallbacks().add(this,&Visualizer::centerDisplayCallback);
 	
@@ -433,6 +530,7 @@ void Visualizer::loadElements(const char* elementFileName,bool ascii)
 							}
 						
 						/* Extract the element: */
+						Visualization::Templatized::Profiler::Scope extractionScope(Visualization::Templatized::Profiler::registerTimer(algorithm->getName(),Visualization::Templatized::Profiler::EXTRACTION));
 						Element* element=algorithm->createElement(parameters);
 						
 						/* Store the element: */
@@ -507,6 +605,7 @@ void Visualizer::loadElements(const char* elementFileName,bool ascii)
 							}
 						
 						/* Extract the element: */
+						Visualization::Templatized::Profiler::Scope extractionScope(Visualization::Templatized::Profiler::registerTimer(algorithm->getName(),Visualization::Templatized::Profiler::EXTRACTION));
 						Element* element=algorithm->createElement(parameters);
 						
 						/* Store the element: */
@@ -608,10 +707,168 @@ void Visualizer::loadElements(const char* elementFileName,bool ascii)
 		}
 	}
 
+void Visualizer::setTimeStep(int newTimeStepIndex)
+	{
+	if(newTimeStepIndex<0||newTimeStepIndex>=timeSeries->getNumSteps()||newTimeStepIndex==timeSeries->getCurrentStep())
+		return;
+	
+	/* Get the new time step's data set; blocks if it has not been prefetched yet: */
+	Misc::Timer waitTimer;
+	DataSet* newDataSet;
+	try
+		{
+		newDataSet=timeSeries->getDataSet(newTimeStepIndex);
+		}
+	catch(std::runtime_error err)
+		{
+		std::cerr<<"Staying at time step "<<timeSeries->getStepNumber(timeSeries->getCurrentStep())<<" due to exception "<<err.what()<<std::endl;
+		timeStepSlider->setValue(timeSeries->getStepNumber(timeSeries->getCurrentStep()));
+		return;
+		}
+	waitTimer.elapse();
+	
+	/* Tell all locators to let go of the current data set: */
+	for(BaseLocatorList::iterator blIt=baseLocators.begin();blIt!=baseLocators.end();++blIt)
+		(*blIt)->prepareDataSetChange();
+	
+	/* Switch the variable manager to the new data set: */
+	variableManager->setDataSet(newDataSet);
+	
+	/* Replace the data set renderer, keeping the current rendering mode: */
+	int renderingMode=dataSetRenderer->getRenderingMode();
+	delete dataSetRenderer;
+	dataSetRenderer=module->getRenderer(newDataSet);
+	dataSetRenderer->setRenderingMode(renderingMode);
+	
+	/* Replace the coordinate transformer: */
+	delete coordinateTransformer;
+	coordinateTransformer=newDataSet->getCoordinateTransformer();
+	
+	dataSet=newDataSet;
+	
+	/* Let all locators bind to the new data set: */
+	for(BaseLocatorList::iterator blIt=baseLocators.begin();blIt!=baseLocators.end();++blIt)
+		(*blIt)->dataSetChanged();
+	
+	/* Keep the previous time step in the pool until all visualization elements extracted from it are replaced: */
+	int previousTimeStepIndex=timeSeries->getCurrentStep();
+	if(elementList->getNumElements()>0&&std::find(reextractionPinnedSteps.begin(),reextractionPinnedSteps.end(),previousTimeStepIndex)==reextractionPinnedSteps.end())
+		{
+		timeSeries->pinStep(previousTimeStepIndex);
+		reextractionPinnedSteps.push_back(previousTimeStepIndex);
+		}
+	
+	/* Make the new time step current and prefetch its neighbors: */
+	timeSeries->setCurrentStep(newTimeStepIndex);
+	
+	/* Re-extract all existing visualization elements over the next frames: */
+	nextReextractionIndex=0;
+	numReextractionElements=elementList->getNumElements();
+	reextractionFailed=false;
+	
+	/* Update the time step dialog: */
+	timeStepSlider->setValue(timeSeries->getStepNumber(newTimeStepIndex));
+	
+	if(Vrui::isMaster())
+		std::cout<<"Time step "<<timeSeries->getStepNumber(newTimeStepIndex)<<": loaded in "<<timeSeries->getLoadTime(newTimeStepIndex)*1000.0<<" ms, waited "<<waitTimer.getTime()*1000.0<<" ms"<<std::endl;
+	
+	Vrui::requestUpdate();
+	}
+
+void Visualizer::reextractElement(size_t elementIndex)
+	{
+	const ElementList::ListElement& le=elementList->getElement(elementIndex);
+	
+	/* Create an extractor for the element's algorithm: */
+	Cluster::MulticastPipe* algorithmPipe=Vrui::openPipe();
+	Algorithm* algorithm=module->getAlgorithm(le.name.c_str(),variableManager,algorithmPipe);
+	if(algorithm==0)
+		{
+		delete algorithmPipe;
+		return;
+		}
+	
+	if(timeStepPipe==0||timeStepPipe->isMaster())
+		{
+		Misc::Timer extractionTimer;
+		try
+			{
+			/* Carry the element's extraction parameters over to the new data set: */
+			Visualization::Abstract::MemoryParametersSink::ValueList values;
+			Visualization::Abstract::MemoryParametersSink memorySink(variableManager,values);
+			le.element->getParameters()->write(memorySink);
+			Visualization::Abstract::MemoryParametersSource memorySource(variableManager,values);
+			Parameters* parameters=algorithm->cloneParameters();
+			parameters->read(memorySource);
+			if(!parameters->isValid())
+				{
+				delete parameters;
+				Misc::throwStdErr("Visualizer::reextractElement: Extraction parameters are invalid in new time step");
+				}
+			
+			if(timeStepPipe!=0)
+				{
+				/* Send the extraction parameters to the slaves: */
+				Visualization::Abstract::BinaryParametersSink sink(variableManager,*timeStepPipe,true);
+				timeStepPipe->write<int>(1);
+				parameters->write(sink);
+				timeStepPipe->flush();
+				}
+			
+			/* Extract the element and replace the old one: */
+			Visualization::Templatized::Profiler::Scope extractionScope(Visualization::Templatized::Profiler::registerTimer(algorithm->getName(),Visualization::Templatized::Profiler::EXTRACTION));
+			elementList->replaceElement(elementIndex,algorithm->createElement(parameters));
+			
+			extractionTimer.elapse();
+			std::cout<<"Re-extracted "<<le.name<<" in "<<extractionTimer.getTime()*1000.0<<" ms"<<std::endl;
+			}
+		catch(std::runtime_error err)
+			{
+			if(timeStepPipe!=0)
+				{
+				/* Tell the slaves there was a problem: */
+				timeStepPipe->write<int>(0);
+				timeStepPipe->flush();
+				}
+			
+			std::cout<<"Keeping previous "<<le.name<<" due to exception "<<err.what()<<std::endl;
+			reextractionFailed=true;
+			}
+		}
+	else
+		{
+		/* Check if there are valid parameters: */
+		if(timeStepPipe->read<int>()==0)
+			reextractionFailed=true;
+		else
+			{
+			/* Receive the extraction parameters: */
+			Visualization::Abstract::BinaryParametersSource source(variableManager,*timeStepPipe,true);
+			Parameters* parameters=algorithm->cloneParameters();
+			parameters->read(source);
+			
+			/* Receive the element and replace the old one: */
+			Element* element=algorithm->startSlaveElement(parameters);
+			algorithm->continueSlaveElement();
+			elementList->replaceElement(elementIndex,element);
+			}
+		}
+	
+	/* Destroy the extractor: */
+	delete algorithm;
+	}
+
+void Visualizer::releaseReextractionPins(void)
+	{
+	for(std::vector<int>::iterator psIt=reextractionPinnedSteps.begin();psIt!=reextractionPinnedSteps.end();++psIt)
+		timeSeries->unpinStep(*psIt);
+	reextractionPinnedSteps.clear();
+	}
+
 Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 	:Vrui::Application(argc,argv,appDefaults),
 	 moduleManager(VISUALIZER_MODULENAMETEMPLATE),
-	 module(0),dataSet(0),variableManager(0),
+	 module(0),timeSeries(0),dataSet(0),variableManager(0),
 	 renderDataSet(true),dataSetRenderer(0),
 	 renderSceneGraphs(false),
 	 coordinateTransformer(0),
@@ -619,10 +876,17 @@ Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 	 #ifdef VISUALIZER_USE_COLLABORATION
 	 collaborationClient(0),sharedVisualizationClient(0),
 	 #endif
-	 numCuttingPlanes(0),cuttingPlanes(0),
+	 numCuttingPlanes(0),cuttingPlanes(0),clipAwareExtraction(false),
+	 extractionScheduler(0),
 	 elementList(0), mask(0),
 	 algorithm(0),
-	 mainMenu(0),
+	 timeStepPipe(0),nextReextractionIndex(0),numReextractionElements(0),reextractionFailed(false),
+	 nextChunkPoolTrimTime(0.0),
+	 profileSummaryInterval(0.0),nextProfileSummaryTime(0.0),
+	 profilerDialogPopup(0),frameIntervalValue(0),
+	 lastProfilerDialogUpdateTime(0.0),numProfiledFrames(0),
+	 timeStepDialogPopup(0),timeStepSlider(0),
+	 mainMenu(0),showTimeStepDialogToggle(0),showProfilerDialogToggle(0),
 	 inLoadPalette(false),inLoadElements(false)
 	{
 	/* Parse the command line: */
@@ -631,6 +895,18 @@ Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 	std::vector<std::string> dataSetArgs;
 	const char* argColorMapName=0;
 	std::vector<const char*> loadFileNames;
+	bool loadTimeSeries=false;
+	int firstTimeStep=0,lastTimeStep=0,timeStepStride=1;
+	unsigned int timeSeriesCacheSize=3;
+	unsigned int numExtractionThreads=0;
+	unsigned int numFinalizeThreads=0;
+	std::string locatorCacheDirectory;
+	size_t materializationBudget=0;
+	bool slicedValues=false;
+	std::string derivedVariables;
+	std::string sliceCodec;
+	bool directFileAccess=false;
+	std::string replicaDirectory;
 	for(int i=1;i<argc;++i)
 		{
 		if(argv[i][0]=='-')
@@ -668,6 +944,147 @@ Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 				else
 					std::cerr<<"Missing element file name after -load"<<std::endl;
 				}
+			else if(strcasecmp(argv[i]+1,"timeSeries")==0)
+				{
+				if(i+2<argc)
+					{
+					/* Read the time step range and optional stride: */
+					loadTimeSeries=true;
+					firstTimeStep=atoi(argv[i+1]);
+					lastTimeStep=atoi(argv[i+2]);
+					i+=2;
+					if(i+1<argc&&isdigit(argv[i+1][0]))
+						{
+						++i;
+						timeStepStride=atoi(argv[i]);
+						}
+					}
+				else
+					{
+					std::cerr<<"Missing time step range after -timeSeries"<<std::endl;
+					i=argc;
+					}
+				}
+			else if(strcasecmp(argv[i]+1,"timeSeriesCache")==0)
+				{
+				++i;
+				if(i<argc)
+					timeSeriesCacheSize=(unsigned int)(atoi(argv[i]));
+				else
+					std::cerr<<"Missing number of cached time steps after -timeSeriesCache"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"extractionThreads")==0)
+				{
+				++i;
+				if(i<argc)
+					numExtractionThreads=(unsigned int)(atoi(argv[i]));
+				else
+					std::cerr<<"Missing number of extraction threads after -extractionThreads"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"finalizeThreads")==0)
+				{
+				++i;
+				if(i<argc)
+					numFinalizeThreads=(unsigned int)(atoi(argv[i]));
+				else
+					std::cerr<<"Missing number of grid finalization threads after -finalizeThreads"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"locatorCache")==0)
+				{
+				/* Save cell center trees into the given directory and map them on later runs: */
+				++i;
+				if(i<argc)
+					locatorCacheDirectory=argv[i];
+				else
+					std::cerr<<"Missing directory name after -locatorCache"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"derive")==0)
+				{
+				++i;
+				if(i<argc)
+					{
+					/* Collect the definitions of all -derive options: */
+					if(!derivedVariables.empty())
+						derivedVariables.push_back(';');
+					derivedVariables.append(argv[i]);
+					}
+				else
+					std::cerr<<"Missing derived variable definition after -derive"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"materializeVariables")==0)
+				{
+				++i;
+				if(i<argc)
+					materializationBudget=size_t(atof(argv[i])*1024.0*1024.0);
+				else
+					std::cerr<<"Missing memory budget in MB after -materializeVariables"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"sliceCodec")==0)
+				{
+				/* Store the data set's value slices in encoded form: */
+				++i;
+				if(i<argc)
+					sliceCodec=argv[i];
+				else
+					std::cerr<<"Missing codec name after -sliceCodec"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"slicedValues")==0)
+				{
+				/* Transpose all scalar variables into per-variable slices after loading: */
+				slicedValues=true;
+				}
+			else if(strcasecmp(argv[i]+1,"directFileAccess")==0)
+				{
+				/* Let all cluster nodes read input files directly: */
+				directFileAccess=true;
+				}
+			else if(strcasecmp(argv[i]+1,"clipAwareExtraction")==0)
+				{
+				/* Don't extract geometry from cells hidden by the active cutting planes: */
+				clipAwareExtraction=true;
+				}
+			else if(strcasecmp(argv[i]+1,"profile")==0)
+				{
+				/* Record timers and counters from the start: */
+				Visualization::Templatized::Profiler::setEnabled(true);
+				}
+			else if(strcasecmp(argv[i]+1,"profileSummary")==0)
+				{
+				++i;
+				if(i<argc)
+					{
+					/* Print a profile summary at regular intervals: */
+					profileSummaryInterval=atof(argv[i]);
+					Visualization::Templatized::Profiler::setEnabled(true);
+					}
+				else
+					std::cerr<<"Missing summary interval in seconds after -profileSummary"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"profileTrace")==0)
+				{
+				++i;
+				if(i<argc)
+					{
+					/* Retain all profiler events for export at exit: */
+					profileTraceFileName=argv[i];
+					Visualization::Templatized::Profiler::setEnabled(true);
+					Visualization::Templatized::Profiler::setTraceEnabled(true);
+					}
+				else
+					std::cerr<<"Missing trace file name after -profileTrace"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"replicaDirectory")==0)
+				{
+				++i;
+				if(i<argc)
+					{
+					/* Read input files from node-local replicas: */
+					directFileAccess=true;
+					replicaDirectory=argv[i];
+					}
+				else
+					std::cerr<<"Missing replica directory after -replicaDirectory"<<std::endl;
+				}
 			else if(strcasecmp(argv[i]+1,"sceneGraph")==0)
 				{
 				++i;
@@ -741,11 +1158,19 @@ Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 							}
 						}
 					
+					/* Check if the next argument requests shared extraction: */
+					bool sharedExtraction=false;
+					if(i+1<argc&&strcasecmp(argv[i+1],"-sharedExtraction")==0)
+						{
+						++i;
+						sharedExtraction=true;
+						}
+					
 					/* Create the collaboration client: */
 					collaborationClient=new Collaboration::CollaborationClient(cfg);
 					
 					/* Register the shared Visualizer protocol: */
-					collaborationClient->registerProtocol(new SharedVisualizationClient(this));
+					collaborationClient->registerProtocol(new SharedVisualizationClient(this,sharedExtraction));
 					}
 				catch(std::runtime_error err)
 					{
@@ -808,18 +1233,56 @@ Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 	if(dataSetArgs.empty())
 		Misc::throwStdErr("Visualizer::Visualizer: no data set arguments provided");
 	
+	/* Create the worker pool shared by all extractors: */
+	extractionScheduler=new ExtractionScheduler(numExtractionThreads);
+	
+	/* Configure how data sets calculate their derived grid information: */
+	Visualization::Templatized::GridFinalizer::setNumThreads(numFinalizeThreads);
+	Visualization::Templatized::GridFinalizer::setCacheDirectory(locatorCacheDirectory.c_str());
+	
 	/* Load a visualization module and a data set: */
 	try
 		{
 		/* Load the appropriate visualization module: */
 		module=moduleManager.loadClass(moduleClassName.c_str());
 		module->setBaseDirectory(baseDirectory);
+		module->setDirectFileAccess(directFileAccess,replicaDirectory);
 		
 		/* Load a data set: */
 		Misc::Timer t;
-		Cluster::MulticastPipe* pipe=Vrui::openPipe(); // Implicit synchronization point
-		dataSet=module->load(dataSetArgs,pipe);
-		delete pipe; // Implicit synchronization point
+		if(loadTimeSeries)
+			{
+			#ifdef VISUALIZER_USE_COLLABORATION
+			if(collaborationClient!=0&&lastTimeStep!=firstTimeStep)
+				{
+				/* Remote locators are bound to a single data set; only show the first time step: */
+				std::cerr<<"Time series not supported in shared visualization; showing only time step "<<firstTimeStep<<std::endl;
+				lastTimeStep=firstTimeStep;
+				}
+			#endif
+			
+			/* Create a time series and load its first time step: */
+			timeSeries=new TimeSeries(module,dataSetArgs,firstTimeStep,lastTimeStep,timeStepStride,timeSeriesCacheSize,derivedVariables,sliceCodec);
+			dataSet=timeSeries->getDataSet(0);
+			timeSeries->setCurrentStep(0);
+			
+			/* Open a pipe to re-extract visualization elements after time step changes: */
+			timeStepPipe=Vrui::openPipe();
+			}
+		else
+			{
+			Cluster::MulticastPipe* pipe=Vrui::openPipe(); // Implicit synchronization point
+			dataSet=module->load(dataSetArgs,pipe);
+			delete pipe; // Implicit synchronization point
+			
+			/* Add the derived variables: */
+			if(!derivedVariables.empty())
+				dataSet->addDerivedVariables(derivedVariables.c_str());
+			
+			/* Encode the value slices: */
+			if(!sliceCodec.empty())
+				dataSet->encodeSlices(sliceCodec.c_str());
+			}
 		t.elapse();
 		if(Vrui::isMaster())
 			std::cout<<"Time to load data set: "<<t.getTime()*1000.0<<" ms"<<std::endl;
@@ -831,6 +1294,9 @@ Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 	
 	/* Create a variable manager: */
 	variableManager=new VariableManager(dataSet,argColorMapName);
+	variableManager->setMaterializationBudget(materializationBudget);
+	if(slicedValues)
+		variableManager->materializeAllScalarVariables();
 	variableManager->getColorBarDialog()->setCloseButton(true);
 	variableManager->getColorBarDialog()->getCloseCallbacks().add(this,&Visualizer::colorBarClosedCallback);
 	variableManager->getPaletteEditor()->setCloseButton(true);
@@ -887,14 +1353,30 @@ Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 	/* Create the main menu: */
 	mainMenu=createMainMenu();
 	Vrui::setMainMenu(mainMenu);
+	
+	/* Create the time step dialog: */
+	if(timeSeries!=0&&timeSeries->getNumSteps()>1)
+		timeStepDialogPopup=createTimeStepDialog();
+	
+	/* Create the profiler dialog: */
+	profilerDialogPopup=createProfilerDialog();
+	for(int i=0;i<Visualization::Templatized::Profiler::NUM_CATEGORIES;++i)
+		lastCategoryTimes[i]=0.0;
         
         // Initialize the LIC noise texture mask
         
 	
 	/* Create the element list: */
-	elementList=new ElementList(Vrui::getWidgetManager());
+	elementList=new ElementList(Vrui::getWidgetManager(),variableManager);
 	elementList->getElementListDialog()->setCloseButton(true);
 	elementList->getElementListDialog()->getCloseCallbacks().add(this,&Visualizer::elementListClosedCallback);
+	#ifdef VISUALIZER_USE_COLLABORATION
+	if(sharedVisualizationClient!=0)
+		{
+		/* Keep deleted elements from being handed out to clients that connect later: */
+		elementList->getElementRemovedCallbacks().add(sharedVisualizationClient,&SharedVisualizationClient::elementRemovedCallback);
+		}
+	#endif
 	
 	/* Load all element files listed on the command line: */
 	for(std::vector<const char*>::const_iterator lfnIt=loadFileNames.begin();lfnIt!=loadFileNames.end();++lfnIt)
@@ -919,6 +1401,8 @@ Visualizer::Visualizer(int& argc,char**& argv,char**& appDefaults)
 Visualizer::~Visualizer(void)
 	{
 	delete mainMenu;
+	delete timeStepDialogPopup;
+	delete profilerDialogPopup;
 	
 	/* Delete all finished visualization elements: */
 	delete elementList;
@@ -935,6 +1419,46 @@ Visualizer::~Visualizer(void)
 	delete collaborationClient;
 	#endif
 	
+	/* Shut down the extraction worker pool: */
+	if(Vrui::isMaster())
+		extractionScheduler->printStatistics(std::cout);
+	delete extractionScheduler;
+	
+	if(Visualization::Templatized::Profiler::isEnabled()&&Vrui::isMaster())
+		{
+		/* Report where the time went over the whole session: */
+		Visualization::Templatized::Profiler::collect();
+		Visualization::Templatized::Profiler::printSummary(std::cout,false);
+		if(!profileTraceFileName.empty())
+			{
+			try
+				{
+				Visualization::Templatized::Profiler::writeChromeTrace(profileTraceFileName.c_str());
+				std::cout<<"Profiler trace written to "<<profileTraceFileName<<std::endl;
+				}
+			catch(std::runtime_error err)
+				{
+				std::cerr<<"Caught exception "<<err.what()<<" while writing profiler trace"<<std::endl;
+				}
+			}
+		}
+	
+	/* Report transparent surface sorting costs: */
+	if(Vrui::isMaster())
+		{
+		Visualization::Templatized::DepthSorter::Statistics sortStats=Visualization::Templatized::DepthSorter::getStatistics();
+		if(sortStats.numSorts+sortStats.numReusedOrders>0)
+			Visualization::Templatized::DepthSorter::printStatistics(std::cout);
+		}
+	
+	/* Report how well geometry buffer chunks were recycled between extractions: */
+	if(Vrui::isMaster())
+		{
+		Visualization::Templatized::ChunkPool::Statistics poolStats=Visualization::Templatized::ChunkPool::getStatistics();
+		if(poolStats.numHits+poolStats.numMisses>0)
+			Visualization::Templatized::ChunkPool::printStatistics(std::cout);
+		}
+	
 	/* Delete the coordinate transformer: */
 	delete coordinateTransformer;
 	
@@ -944,8 +1468,20 @@ Visualizer::~Visualizer(void)
 	/* Delete the variable manager: */
 	delete variableManager;
 	
-	/* Delete the data set: */
-	delete dataSet;
+	if(timeSeries!=0)
+		{
+		if(Vrui::isMaster())
+			timeSeries->printStatistics(std::cout);
+		
+		/* Delete the time series and all its data sets: */
+		delete timeStepPipe;
+		delete timeSeries;
+		}
+	else
+		{
+		/* Delete the data set: */
+		delete dataSet;
+		}
 	}
 
 void Visualizer::toolCreationCallback(Vrui::ToolManager::ToolCreationCallbackData* cbData)
@@ -969,6 +1505,11 @@ void Visualizer::toolCreationCallback(Vrui::ToolManager::ToolCreationCallbackDat
 				/* Create a scalar evaluation locator object and associate it with the new tool: */
 				newLocator=new ScalarEvaluationLocator(locatorTool,this,cbData->cfg);
 				}
+			else if(algorithmName=="Probe Scalars")
+				{
+				/* Create a scalar probe locator object and associate it with the new tool: */
+				newLocator=new ScalarProbeLocator(locatorTool,this,cbData->cfg);
+				}
 			else if(algorithmName=="Evaluate Vectors")
 				{
 				/* Create a vector evaluation locator object and associate it with the new tool: */
@@ -1006,11 +1547,16 @@ void Visualizer::toolCreationCallback(Vrui::ToolManager::ToolCreationCallbackDat
 				/* Create a cutting plane locator object and associate it with the new tool: */
 				newLocator=new CuttingPlaneLocator(locatorTool,this);
 				}
-			else if(algorithm<firstScalarAlgorithmIndex)
+			else if(algorithm<firstScalarAlgorithmIndex-1)
 				{
 				/* Create a scalar evaluation locator object and associate it with the new tool: */
 				newLocator=new ScalarEvaluationLocator(locatorTool,this);
 				}
+			else if(algorithm<firstScalarAlgorithmIndex)
+				{
+				/* Create a scalar probe locator object and associate it with the new tool: */
+				newLocator=new ScalarProbeLocator(locatorTool,this);
+				}
 			else if(algorithm<firstScalarAlgorithmIndex+module->getNumScalarAlgorithms())
 				{
 				/* Create a data locator object and associate it with the new tool: */
@@ -1062,19 +1608,89 @@ void Visualizer::toolDestructionCallback(Vrui::ToolManager::ToolDestructionCallb
 		}
 	}
 
+void Visualizer::updateProfiler(void)
+	{
+	/* Record the most recent frame interval: */
+	static const unsigned int frameIntervalProbe=Visualization::Templatized::Profiler::registerCounter("Frame interval (s)",Visualization::Templatized::Profiler::FRAME);
+	Visualization::Templatized::Profiler::recordCounter(frameIntervalProbe,Vrui::getCurrentFrameTime());
+	++numProfiledFrames;
+	
+	/* Drain all threads' events: */
+	Visualization::Templatized::Profiler::collect();
+	
+	if(profileSummaryInterval>0.0&&Vrui::getApplicationTime()>=nextProfileSummaryTime)
+		{
+		/* Print and restart the periodic summary: */
+		if(nextProfileSummaryTime>0.0&&Vrui::isMaster())
+			Visualization::Templatized::Profiler::printSummary(std::cout,true);
+		Visualization::Templatized::Profiler::resetInterval();
+		nextProfileSummaryTime=Vrui::getApplicationTime()+profileSummaryInterval;
+		}
+	
+	if(showProfilerDialogToggle->getToggle()&&Vrui::getApplicationTime()>=lastProfilerDialogUpdateTime+1.0)
+		{
+		/* Show the mean frame interval and each category's time per frame since the last update: */
+		double elapsed=Vrui::getApplicationTime()-lastProfilerDialogUpdateTime;
+		frameIntervalValue->setValue(elapsed*1000.0/double(numProfiledFrames));
+		double categoryTimes[Visualization::Templatized::Profiler::NUM_CATEGORIES];
+		Visualization::Templatized::Profiler::getCategoryTimes(categoryTimes);
+		for(int i=0;i<Visualization::Templatized::Profiler::NUM_CATEGORIES;++i)
+			{
+			categoryTimeValues[i]->setValue((categoryTimes[i]-lastCategoryTimes[i])*1000.0/double(numProfiledFrames));
+			lastCategoryTimes[i]=categoryTimes[i];
+			}
+		lastProfilerDialogUpdateTime=Vrui::getApplicationTime();
+		numProfiledFrames=0;
+		}
+	}
+
 void Visualizer::frame(void)
 	{
+	static const unsigned int frameProbe=Visualization::Templatized::Profiler::registerTimer("Frame callback",Visualization::Templatized::Profiler::FRAME);
+	Visualization::Templatized::Profiler::Scope frameScope(frameProbe);
+	
+	if(nextReextractionIndex<numReextractionElements&&nextReextractionIndex<elementList->getNumElements())
+		{
+		/* Re-extract one visualization element per frame to keep the application responsive: */
+		reextractElement(nextReextractionIndex);
+		++nextReextractionIndex;
+		Vrui::requestUpdate();
+		}
+	else if(!reextractionPinnedSteps.empty()&&!reextractionFailed)
+		{
+		/* All visualization elements now come from the current time step; let the pool evict the earlier ones: */
+		releaseReextractionPins();
+		}
+	
+	if(Vrui::getApplicationTime()>=nextChunkPoolTrimTime)
+		{
+		/* Return buffer chunks left over from bursts of extractions to the heap: */
+		Visualization::Templatized::ChunkPool::trim();
+		nextChunkPoolTrimTime=Vrui::getApplicationTime()+5.0;
+		}
+	
+	if(Visualization::Templatized::Profiler::isEnabled())
+		updateProfiler();
+	
 	#ifdef VISUALIZER_USE_COLLABORATION
 	if(collaborationClient!=0)
 		{
 		/* Call the collaboratoin client's frame method: */
 		collaborationClient->frame();
 		}
+	if(sharedVisualizationClient!=0)
+		{
+		/* Add visualization elements received from other clients: */
+		sharedVisualizationClient->insertReceivedElements();
+		}
 	#endif
 	}
 
 void Visualizer::display(GLContextData& contextData) const
 	{
+	static const unsigned int displayProbe=Visualization::Templatized::Profiler::registerTimer("Display",Visualization::Templatized::Profiler::FRAME);
+	Visualization::Templatized::Profiler::Scope displayScope(displayProbe);
+	
 	#ifdef VISUALIZER_USE_COLLABORATION
 	if(collaborationClient!=0)
 		{
@@ -1220,6 +1836,9 @@ void Visualizer::changeScalarVariableCallback(GLMotif::RadioBox::ValueChangedCal
 		{
 		/* Set the new scalar variable: */
 		variableManager->setCurrentScalarVariable(cbData->radioBox->getToggleIndex(cbData->newSelectedToggle));
+		
+		/* Recolor all visualization elements following the current scalar variable: */
+		elementList->recolorElements(variableManager->getCurrentScalarVariable());
 		}
 	}
 
@@ -1392,6 +2011,15 @@ void Visualizer::clearElementsCallback(Misc::CallbackData*)
 	{
 	/* Delete all finished visualization elements: */
 	elementList->clear();
+	
+	/* Cancel any pending re-extraction: */
+	nextReextractionIndex=0;
+	numReextractionElements=0;
+	
+	/* No remaining element refers to an earlier time step: */
+	if(timeSeries!=0)
+		releaseReextractionPins();
+	reextractionFailed=false;
 	}
 
 void Visualizer::showClientDialogCallback(GLMotif::ToggleButton::ValueChangedCallbackData* cbData)
@@ -1426,6 +2054,64 @@ void Visualizer::centerDisplayCallback(Misc::CallbackData*)
 	Vrui::setNavigationTransformation(center,radius);
 	}
 
+void Visualizer::showTimeStepDialogCallback(GLMotif::ToggleButton::ValueChangedCallbackData* cbData)
+	{
+	/* Hide or show time step dialog based on toggle button state: */
+	if(cbData->set)
+		Vrui::popupPrimaryWidget(timeStepDialogPopup);
+	else
+		Vrui::popdownPrimaryWidget(timeStepDialogPopup);
+	}
+
+void Visualizer::timeStepDialogClosedCallback(Misc::CallbackData* cbData)
+	{
+	showTimeStepDialogToggle->setToggle(false);
+	}
+
+void Visualizer::timeStepSliderCallback(GLMotif::TextFieldSlider::ValueChangedCallbackData* cbData)
+	{
+	/* Find the time step closest to the slider's value: */
+	int closestStepIndex=0;
+	for(int i=1;i<timeSeries->getNumSteps();++i)
+		if(Math::abs(double(timeSeries->getStepNumber(i))-cbData->value)<Math::abs(double(timeSeries->getStepNumber(closestStepIndex))-cbData->value))
+			closestStepIndex=i;
+	
+	setTimeStep(closestStepIndex);
+	}
+
+void Visualizer::previousTimeStepCallback(Misc::CallbackData* cbData)
+	{
+	setTimeStep(timeSeries->getCurrentStep()-1);
+	}
+
+void Visualizer::nextTimeStepCallback(Misc::CallbackData* cbData)
+	{
+	setTimeStep(timeSeries->getCurrentStep()+1);
+	}
+
+void Visualizer::showProfilerDialogCallback(GLMotif::ToggleButton::ValueChangedCallbackData* cbData)
+	{
+	/* Hide or show profiler dialog based on toggle button state: */
+	if(cbData->set)
+		{
+		/* Start recording and measure from now on: */
+		Visualization::Templatized::Profiler::setEnabled(true);
+		Visualization::Templatized::Profiler::collect();
+		Visualization::Templatized::Profiler::getCategoryTimes(lastCategoryTimes);
+		lastProfilerDialogUpdateTime=Vrui::getApplicationTime();
+		numProfiledFrames=0;
+		
+		Vrui::popupPrimaryWidget(profilerDialogPopup);
+		}
+	else
+		Vrui::popdownPrimaryWidget(profilerDialogPopup);
+	}
+
+void Visualizer::profilerDialogClosedCallback(Misc::CallbackData* cbData)
+	{
+	showProfilerDialogToggle->setToggle(false);
+	}
+
 int main(int argc,char* argv[])
 	{
 	try
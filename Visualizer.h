@@ -31,6 +31,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <GLMotif/ToggleButton.h>
 #include <GLMotif/RadioBox.h>
 #include <GLMotif/Slider.h>
+#include <GLMotif/TextFieldSlider.h>
 #include <GLMotif/FileSelectionDialog.h>
 #include <SceneGraph/GroupNode.h>
 #include <Vrui/Geometry.h>
@@ -38,8 +39,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Vrui/Application.h>
 
 #include <LICBrushMask.h>
+#include <Templatized/Profiler.h>
 
 /* Forward declarations: */
+namespace Cluster {
+class MulticastPipe;
+}
 namespace GLMotif {
 class Widget;
 class Popup;
@@ -72,6 +77,8 @@ class SharedVisualizationClient;
 #endif
 class BaseLocator;
 class ElementList;
+class TimeSeries;
+class ExtractionScheduler;
 
 class Visualizer:public Vrui::Application
 	{
@@ -105,6 +112,7 @@ class Visualizer:public Vrui::Application
 	friend class CuttingPlaneLocator;
 	friend class EvaluationLocator;
 	friend class ScalarEvaluationLocator;
+	friend class ScalarProbeLocator;
 	friend class VectorEvaluationLocator;
 	friend class ExtractorLocator;
         
@@ -116,7 +124,8 @@ class Visualizer:public Vrui::Application
 	private:
 	ModuleManager moduleManager; // Manager to load 3D visualization modules from dynamic libraries
 	Module* module; // Visualization module
-	DataSet* dataSet; // Data set to visualize
+	TimeSeries* timeSeries; // Time series owning the data sets of a time-varying simulation, or 0 if a single data set was loaded
+	DataSet* dataSet; // Data set to visualize; data set of the current time step if a time series was loaded
 	VariableManager* variableManager; // Manager to organize data sets and scalar and vector variables
 	bool renderDataSet; // Flag whether to render the data set
 	GLColor<GLfloat,4> dataSetRenderColor; // Color to use when rendering the data set
@@ -132,15 +141,36 @@ class Visualizer:public Vrui::Application
 	#endif
 	size_t numCuttingPlanes; // Maximum number of cutting planes supported
 	CuttingPlane* cuttingPlanes; // Array of available cutting planes
+	bool clipAwareExtraction; // Flag whether extractors skip cells lying entirely outside of the cutting planes active at the time of a request
+	ExtractionScheduler* extractionScheduler; // Worker pool shared by all extractors
 	BaseLocatorList baseLocators; // List of active locators
 	ElementList* elementList; // List of previously extracted visualization elements
         LICBrushMask* mask; //a texture mask for all LIC algorithm
 	int algorithm; // The currently selected algorithm
+	Cluster::MulticastPipe* timeStepPipe; // Pipe to synchronize re-extraction of visualization elements after a time step change
+	size_t nextReextractionIndex; // Index of the next visualization element to re-extract for the current time step
+	size_t numReextractionElements; // Number of visualization elements that existed when the current time step was selected
+	std::vector<int> reextractionPinnedSteps; // Time steps kept in the memory pool because visualization elements extracted from them have not been replaced yet
+	bool reextractionFailed; // Flag whether a visualization element could not be re-extracted for the current time step and still refers to an earlier one
+	double nextChunkPoolTrimTime; // Application time at which unused buffer chunks are next returned to the heap
+	double profileSummaryInterval; // Interval between periodic profile summaries in seconds, or 0 to only print a summary at exit
+	double nextProfileSummaryTime; // Application time at which the next periodic profile summary is printed
+	std::string profileTraceFileName; // Name of the file to which the profiler's event trace is exported at exit, or empty
+	GLMotif::PopupWindow* profilerDialogPopup; // Dialog showing the time spent in each profiler category
+	GLMotif::TextField* frameIntervalValue; // Text field showing the mean frame interval
+	GLMotif::TextField* categoryTimeValues[Visualization::Templatized::Profiler::NUM_CATEGORIES]; // Text fields showing the time spent in each profiler category per frame
+	double lastCategoryTimes[Visualization::Templatized::Profiler::NUM_CATEGORIES]; // Profiler category times at the last profiler dialog update
+	double lastProfilerDialogUpdateTime; // Application time of the last profiler dialog update
+	unsigned int numProfiledFrames; // Number of frames since the last profiler dialog update
+	GLMotif::PopupWindow* timeStepDialogPopup; // Dialog to select the current time step
+	GLMotif::TextFieldSlider* timeStepSlider; // Slider to select the current time step
 	GLMotif::PopupMenu* mainMenu; // The main menu widget
 	GLMotif::ToggleButton* showColorBarToggle; // Toggle button to show the color bar
 	GLMotif::ToggleButton* showPaletteEditorToggle; // Toggle button to show the palette editor
 	GLMotif::ToggleButton* showElementListToggle; // Toggle button to show the element list dialog
 	GLMotif::ToggleButton* showClientDialogToggle; // Toggle button to show the collaboration client dialog
+	GLMotif::ToggleButton* showTimeStepDialogToggle; // Toggle button to show the time step dialog
+	GLMotif::ToggleButton* showProfilerDialogToggle; // Toggle button to show the profiler dialog
 	
 	/* Lock flags for modal dialogs: */
 	bool inLoadPalette; // Flag whether the user is currently selecting a palette to load
@@ -155,8 +185,14 @@ class Visualizer:public Vrui::Application
 	GLMotif::Popup* createStandardLuminancePalettesMenu(void);
 	GLMotif::Popup* createStandardSaturationPalettesMenu(void);
 	GLMotif::Popup* createColorMenu(void);
+	GLMotif::PopupWindow* createTimeStepDialog(void);
+	GLMotif::PopupWindow* createProfilerDialog(void);
 	GLMotif::PopupMenu* createMainMenu(void);
 	void loadElements(const char* elementFileName,bool ascii); // Loads all visualization elements defined in the given file
+	void setTimeStep(int newTimeStepIndex); // Switches to the data set of the given time step and schedules re-extraction of all visualization elements
+	void reextractElement(size_t elementIndex); // Re-extracts the given visualization element from the current data set
+	void releaseReextractionPins(void); // Lets the time series evict the time steps pinned for not yet re-extracted visualization elements
+	void updateProfiler(void); // Collects profiler events, prints periodic summaries, and updates the profiler dialog
 	
 	/* Constructors and destructors: */
 	public:
@@ -195,6 +231,13 @@ class Visualizer:public Vrui::Application
 	void showClientDialogCallback(GLMotif::ToggleButton::ValueChangedCallbackData* cbData);
 	void clientDialogClosedCallback(Misc::CallbackData* cbData);
 	void centerDisplayCallback(Misc::CallbackData* cbData);
+	void showTimeStepDialogCallback(GLMotif::ToggleButton::ValueChangedCallbackData* cbData);
+	void timeStepDialogClosedCallback(Misc::CallbackData* cbData);
+	void timeStepSliderCallback(GLMotif::TextFieldSlider::ValueChangedCallbackData* cbData);
+	void previousTimeStepCallback(Misc::CallbackData* cbData);
+	void nextTimeStepCallback(Misc::CallbackData* cbData);
+	void showProfilerDialogCallback(GLMotif::ToggleButton::ValueChangedCallbackData* cbData);
+	void profilerDialogClosedCallback(Misc::CallbackData* cbData);
 	};
 
 #endif
@@ -34,6 +34,7 @@ Software Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
 #include <GL/GLGeometryWrappers.h>
 #include <GL/GLTransformationWrappers.h>
 #include <GLTextures.h>
+#include <Templatized/Profiler.h>
 
 #include "VolumeRenderer.h"
 
@@ -167,6 +168,8 @@ void VolumeRenderer::uploadTexture2D(VolumeRenderer::DataItem* dataItem,int axis
 	if(dataItem->uploadData)
 		{
 		/* Upload a texture slice: */
+		static const unsigned int uploadProbe=Visualization::Templatized::Profiler::registerTimer("Volume renderer texture upload",Visualization::Templatized::Profiler::UPLOAD);
+		Visualization::Templatized::Profiler::Scope uploadScope(uploadProbe);
 		const Voxel* slicePtr=values+index*increments[axis];
 		switch(axis)
 			{
@@ -203,6 +206,8 @@ void VolumeRenderer::uploadTexture3D(VolumeRenderer::DataItem* dataItem) const
 	if(dataItem->uploadData)
 		{
 		/* Upload the texture block: */
+		static const unsigned int uploadProbe=Visualization::Templatized::Profiler::registerTimer("Volume renderer texture upload",Visualization::Templatized::Profiler::UPLOAD);
+		Visualization::Templatized::Profiler::Scope uploadScope(uploadProbe);
 		glPixelStorei(GL_UNPACK_ALIGNMENT,1);
 		glPixelStorei(GL_UNPACK_SKIP_PIXELS,0);
 		glPixelStorei(GL_UNPACK_ROW_LENGTH,0); // increments[1]); // Seems to be a bug in OpenGL - consistent across SGI/nVidia platforms
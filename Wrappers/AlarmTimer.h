@@ -25,6 +25,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Realtime/AlarmTimer.h>
 
+#include <Abstract/Algorithm.h>
+
 namespace Visualization {
 
 namespace Wrappers {
@@ -34,18 +36,19 @@ class AlarmTimer
 	/* Elements: */
 	private:
 	const Realtime::AlarmTimer& alarm; // The queried alarm timer
+	const Visualization::Abstract::Algorithm& algorithm; // The algorithm extracting the element, queried for cancellation
 	
 	/* Constructors and destructors: */
 	public:
-	AlarmTimer(const Realtime::AlarmTimer& sAlarm)
-		:alarm(sAlarm)
+	AlarmTimer(const Realtime::AlarmTimer& sAlarm,const Visualization::Abstract::Algorithm& sAlgorithm)
+		:alarm(sAlarm),algorithm(sAlgorithm)
 		{
 		}
 	
 	/* Methods: */
 	bool operator()(void) const
 		{
-		return !alarm.isExpired();
+		return !alarm.isExpired()&&!algorithm.isCancelled();
 		}
 	};
 
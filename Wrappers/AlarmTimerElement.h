@@ -27,6 +27,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Realtime/AlarmTimer.h>
 
+#include <Abstract/Algorithm.h>
+
 namespace Visualization {
 
 namespace Wrappers {
@@ -41,13 +43,14 @@ class AlarmTimerElement
 	/* Elements: */
 	private:
 	const Realtime::AlarmTimer& alarm; // The queried alarm timer
+	const Visualization::Abstract::Algorithm& algorithm; // The algorithm extracting the element, queried for cancellation
 	const Element& element; // The queried visualization element
 	size_t maxElementSize; // Maximum number of vertices/triangles/etc. to create
 	
 	/* Constructors and destructors: */
 	public:
-	AlarmTimerElement(const Realtime::AlarmTimer& sAlarm,const Element& sElement,size_t sMaxElementSize)
-		:alarm(sAlarm),
+	AlarmTimerElement(const Realtime::AlarmTimer& sAlarm,const Visualization::Abstract::Algorithm& sAlgorithm,const Element& sElement,size_t sMaxElementSize)
+		:alarm(sAlarm),algorithm(sAlgorithm),
 		 element(sElement),maxElementSize(sMaxElementSize)
 		{
 		}
@@ -55,7 +58,7 @@ class AlarmTimerElement
 	/* Methods: */
 	bool operator()(void) const
 		{
-		return element.getElementSize()<maxElementSize&&!alarm.isExpired();
+		return element.getElementSize()<maxElementSize&&!alarm.isExpired()&&!algorithm.isCancelled();
 		}
 	};
 
@@ -73,9 +73,11 @@ class ArrowRake:public Visualization::Abstract::Element,public GLObject
 		/* Elements: */
 		public:
 		GLuint vertexBufferId; // ID of buffer object for vertex data
+		GLuint texCoordBufferId; // ID of buffer object for per-vertex color scalar values
 		GLuint indexBufferId; // ID of buffer object for index data
 		unsigned int version; // Version number of the arrow glyphs in the buffer objects
 		Scalar scaledArrowShaftRadius; // Scaled shaft radius of arrow glyphs in the buffer objects
+		GLsizei numIndices; // Number of triangle vertex indices in the index buffer
 		
 		/* Constructors and destructors: */
 		DataItem(void);
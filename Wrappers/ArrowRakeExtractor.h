@@ -23,6 +23,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_WRAPPERS_ARROWRAKEEXTRACTOR_INCLUDED
 #define VISUALIZATION_WRAPPERS_ARROWRAKEEXTRACTOR_INCLUDED
 
+#include <vector>
 #include <Misc/Autopointer.h>
 #include <GLMotif/TextFieldSlider.h>
 
@@ -123,19 +124,39 @@ class ArrowRakeExtractor:public Visualization::Abstract::Algorithm
 		void update(Visualization::Abstract::VariableManager* variableManager,bool track); // Updates derived parameters after a read operation
 		};
 	
+	struct RowHint // Structure to remember where a rake row started in the previous evaluation
+		{
+		/* Elements: */
+		public:
+		DSL dsl; // Locator left at the row's first arrow
+		bool valid; // Flag if the row's first arrow was inside the data set's domain
+		
+		/* Constructors and destructors: */
+		RowHint(void)
+			:valid(false)
+			{
+			}
+		};
+	
+	struct RowWorker; // Structure holding the state of a rake evaluation thread
+	
 	/* Elements: */
-	private:
 	static const char* name; // Identifying name of this algorithm
 	Parameters parameters; // The arrow rake extraction parameters used by this extractor
 	Scalar baseCellSize; // Basis for cell size calculation
 	ArrowRakePointer currentArrowRake; // The currently extracted arrow rake visualization element
 	Parameters* currentParameters; // Pointer to parameter object for current extraction
+	const DS* rowHintDs; // Data set on which the row hints were created
+	std::vector<RowHint> rowHints; // Starting cells of all rake rows from the previous evaluation, to trace from while the rake is dragged
 	
 	/* UI components: */
 	GLMotif::TextFieldSlider* rakeSizeSliders[2]; // Sliders to adjust the current rake size
 	GLMotif::TextFieldSlider* cellSizeSliders[2]; // Sliders to adjust the current grid size
 	GLMotif::TextFieldSlider* lengthScaleSlider;
 	
+	/* Private methods: */
+	void evaluateRake(const Parameters* extractParameters,Rake& rake); // Calculates all arrows of the given rake using multiple threads, tracing along rake rows
+	
 	/* Constructors and destructors: */
 	public:
 	ArrowRakeExtractor(Visualization::Abstract::VariableManager* sVariableManager,Cluster::MulticastPipe* sPipe); // Creates an arrow rake extractor
@@ -25,6 +25,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_WRAPPERS_COLOREDISOSURFACE_INCLUDED
 #define VISUALIZATION_WRAPPERS_COLOREDISOSURFACE_INCLUDED
 
+#include <vector>
 #define GLVERTEX_NONSTANDARD_TEMPLATES
 #include <GL/GLVertex.h>
 
@@ -34,6 +35,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #else
 #include <Templatized/TriangleSet.h>
 #endif
+#include <Templatized/EdgeSample.h>
 
 /* Forward declarations: */
 #ifdef VISUALIZATION_USE_SHADERS
@@ -61,6 +63,8 @@ class ColoredIsosurface:public Visualization::Abstract::Element
 	#else
 	typedef Visualization::Templatized::TriangleSet<Vertex> Surface; // Data structure to represent surfaces
 	#endif
+	typedef Visualization::Templatized::EdgeSample<DS> VertexSample; // Type to remember where surface vertices lie inside the data set's cells
+	typedef std::vector<VertexSample> VertexSampleList; // Type for lists of vertex samples, in surface vertex order
 	
 	/* Elements: */
 	private:
@@ -70,6 +74,8 @@ class ColoredIsosurface:public Visualization::Abstract::Element
 	TwoSided1DTexturedSurfaceShader* shader; // Shader for the isosurface
 	#endif
 	Surface surface; // Representation of the colored isosurface
+	const DS* sampleDs; // Data set from which the colored isosurface was extracted, or 0 if the isosurface has no vertex samples
+	VertexSampleList vertexSamples; // Extraction-time samples of all isosurface vertices, used for recoloring
 	
 	/* Constructors and destructors: */
 	public:
@@ -83,6 +89,11 @@ class ColoredIsosurface:public Visualization::Abstract::Element
 	/* Methods from Visualization::Abstract::Element: */
 	virtual std::string getName(void) const;
 	virtual size_t getSize(void) const;
+	virtual size_t getGeometrySize(void) const;
+	virtual bool usesTransparency(void) const;
+	virtual void writeGeometry(IO::File& file) const;
+	virtual int getColorScalarVariable(void) const;
+	virtual void setColorScalarVariable(int newColorScalarVariableIndex);
 	virtual void glRenderAction(GLRenderState& renderState) const;
 	
 	/* New methods: */
@@ -90,6 +101,12 @@ class ColoredIsosurface:public Visualization::Abstract::Element
 		{
 		return surface;
 		}
+	VertexSampleList& startVertexSamples(const DS* newSampleDs) // Returns an empty vertex sample list to be filled while extracting the colored isosurface from the given data set
+		{
+		sampleDs=newSampleDs;
+		vertexSamples.clear();
+		return vertexSamples;
+		}
 	size_t getElementSize(void) const // Returns the number of triangles in the surface representation
 		{
 		return surface.getNumTriangles();
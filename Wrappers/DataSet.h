@@ -100,6 +100,8 @@ class DataSet:public Visualization::Abstract::DataSet
 			}
 		virtual DestScalar calcScalar(const Visualization::Abstract::ScalarExtractor* scalarExtractor) const;
 		virtual DestVector calcVector(const Visualization::Abstract::VectorExtractor* vectorExtractor) const;
+		virtual size_t calcScalars(const Visualization::Abstract::ScalarExtractor* scalarExtractor,size_t numPoints,const Point points[],DestScalar values[]);
+		virtual size_t calcVectors(const Visualization::Abstract::VectorExtractor* vectorExtractor,size_t numPoints,const Point points[],DestVector values[]);
 		};
 	
 	/* Elements: */
@@ -150,6 +152,10 @@ class DataSet:public Visualization::Abstract::DataSet
 	virtual const char* getScalarVariableName(int scalarVariableIndex) const;
 	virtual Visualization::Abstract::ScalarExtractor* getScalarExtractor(int scalarVariableIndex) const;
 	virtual DestScalarRange calcScalarValueRange(const Visualization::Abstract::ScalarExtractor* scalarExtractor) const;
+	virtual void addDerivedVariables(const char* definitions);
+	virtual void encodeSlices(const char* codecName);
+	virtual size_t materializeScalarExtractor(Visualization::Abstract::ScalarExtractor* scalarExtractor) const;
+	virtual void materializeScalarExtractors(int numScalarExtractors,Visualization::Abstract::ScalarExtractor* const scalarExtractors[],size_t sliceSizes[]) const;
 	virtual int getNumVectorVariables(void) const;
 	virtual const char* getVectorVariableName(int vectorVariableIndex) const;
 	virtual Visualization::Abstract::VectorExtractor* getVectorExtractor(int vectorVariableIndex) const;
@@ -0,0 +1,145 @@
+/***********************************************************************
+DerivedSliceVariables - Traits classes to add derived variables defined
+by compiled expressions to the value slices of sliced data sets.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_WRAPPERS_DERIVEDSLICEVARIABLES_INCLUDED
+#define VISUALIZATION_WRAPPERS_DERIVEDSLICEVARIABLES_INCLUDED
+
+#include <Misc/ThrowStdErr.h>
+#include <Templatized/SliceExpression.h>
+#include <Wrappers/SlicedScalarVectorDataValue.h>
+
+/* Forward declarations: */
+namespace Visualization {
+namespace Templatized {
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class SlicedCartesian;
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class SlicedCurvilinear;
+}
+}
+
+namespace Visualization {
+
+namespace Wrappers {
+
+template <class DSParam>
+class SliceGridDerivative // Traits class to calculate partial derivatives of value slices; by default, data sets do not have the grid structure to do so
+	{
+	/* Embedded classes: */
+	public:
+	typedef DSParam DS; // Type of data set
+	typedef typename DS::ValueScalar ValueScalar; // Type of slice values
+	
+	static const bool hasGrid=false; // Flag whether the data set supports partial derivatives
+	
+	/* Methods: */
+	static void calcDerivative(const DS& ds,int direction,const ValueScalar* values,ValueScalar* result) // Calculates the partial derivative of the given value array along the given coordinate axis
+		{
+		}
+	};
+
+template <class DSParam>
+class StructuredSliceGridDerivative // Base class for traits of data sets with a single structured grid; derivatives are central differences mapped through the grid's Jacobian
+	{
+	/* Embedded classes: */
+	public:
+	typedef DSParam DS; // Type of data set
+	typedef typename DS::ValueScalar ValueScalar; // Type of slice values
+	
+	static const bool hasGrid=true; // Flag whether the data set supports partial derivatives
+	
+	/* Methods: */
+	static void calcDerivative(const DS& ds,int direction,const ValueScalar* values,ValueScalar* result);
+	};
+
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class SliceGridDerivative<Visualization::Templatized::SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam> >
+	:public StructuredSliceGridDerivative<Visualization::Templatized::SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam> >
+	{
+	};
+
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class SliceGridDerivative<Visualization::Templatized::SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam> >
+	:public StructuredSliceGridDerivative<Visualization::Templatized::SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam> >
+	{
+	};
+
+template <class DSParam,class DataValueParam>
+class DerivedSliceVariables // Traits class to add derived variables to data sets; by default, data sets do not support derived variables
+	{
+	/* Methods: */
+	public:
+	static void addDerivedVariables(DSParam& ds,DataValueParam& dataValue,const char* definitions)
+		{
+		Misc::throwStdErr("DataSet::addDerivedVariables: Data set does not support derived variables");
+		}
+	};
+
+template <class DSParam,class VScalarParam>
+class DerivedSliceVariables<DSParam,SlicedScalarVectorDataValue<DSParam,VScalarParam> >
+	{
+	/* Embedded classes: */
+	public:
+	typedef DSParam DS; // Type of data set
+	typedef typename DS::ValueScalar ValueScalar; // Type of slice values
+	typedef SlicedScalarVectorDataValue<DS,VScalarParam> DataValue; // Type of data value descriptor
+	typedef Visualization::Templatized::SliceExpression SliceExpression;
+	
+	private:
+	class Resolver:public SliceExpression::VariableResolver // Class to resolve variable names against the data value descriptor
+		{
+		/* Elements: */
+		private:
+		const DataValue& dataValue;
+		
+		/* Constructors and destructors: */
+		public:
+		Resolver(const DataValue& sDataValue)
+			:dataValue(sDataValue)
+			{
+			}
+		
+		/* Methods from SliceExpression::VariableResolver: */
+		virtual int getNumVectorComponents(void) const;
+		virtual int getScalarVariableSlice(const char* scalarVariableName) const;
+		virtual bool getVectorVariableSlices(const char* vectorVariableName,int sliceIndices[]) const;
+		};
+	
+	/* Private methods: */
+	static void calcPositions(const DS& ds,ValueScalar* positions[]); // Calculates the components of all vertex positions in slice order
+	static int calcRadialMean(size_t numValues,const ValueScalar* const positions[],const ValueScalar* values,ValueScalar* result); // Replaces each value by the mean of all values in the same radial shell around the origin; returns the number of shells
+	static void evaluate(DS& ds,const SliceExpression& expression,ValueScalar* const positions[],const char* variableName,ValueScalar* result); // Evaluates a compiled expression into the given result array
+	
+	/* Methods: */
+	public:
+	static void addDerivedVariables(DS& ds,DataValue& dataValue,const char* definitions); // Compiles and evaluates the given semicolon-separated list of definitions and adds the results as new slices and variables
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_WRAPPERS_DERIVEDSLICEVARIABLES_IMPLEMENTATION
+#include <Wrappers/DerivedSliceVariables.icpp>
+#endif
+
+#endif
@@ -142,6 +142,11 @@ class GlobalIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 		}
 	virtual Visualization::Abstract::Element* createElement(Visualization::Abstract::Parameters* extractParameters);
 	virtual Visualization::Abstract::Element* startSlaveElement(Visualization::Abstract::Parameters* extractParameters);
+	virtual bool hasElementReader(void) const
+		{
+		return true;
+		}
+	virtual Visualization::Abstract::Element* readElement(Visualization::Abstract::Parameters* extractParameters,IO::File& file);
 	
 	/* New methods: */
 	static const char* getClassName(void) // Returns the algorithm class name
@@ -25,11 +25,13 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_WRAPPERS_MULTISTREAMLINE_INCLUDED
 #define VISUALIZATION_WRAPPERS_MULTISTREAMLINE_INCLUDED
 
+#include <vector>
 #define GLVERTEX_NONSTANDARD_TEMPLATES
 #include <GL/GLVertex.h>
 
 #include <Abstract/Element.h>
 #include <Templatized/MultiPolyline.h>
+#include <Templatized/LocatorSample.h>
 
 namespace Visualization {
 
@@ -48,11 +50,15 @@ class MultiStreamline:public Visualization::Abstract::Element
 	typedef typename DataSetWrapper::VScalar VScalar; // Scalar type of scalar extractor
 	typedef GLVertex<VScalar,1,void,0,Scalar,Scalar,dimension> Vertex; // Data type for streamline vertices
 	typedef Visualization::Templatized::MultiPolyline<Vertex> MultiPolyline; // Data structure to represent multi-streamlines
+	typedef Visualization::Templatized::LocatorSample<DS> VertexSample; // Type to remember where streamline vertices lie inside the data set's cells
+	typedef std::vector<VertexSample> VertexSampleList; // Type for lists of vertex samples, in streamline vertex order
 	
 	/* Elements: */
 	private:
 	int scalarVariableIndex; // Index of the scalar variable used to color the streamline
 	MultiPolyline multiPolyline; // Multi-streamline representations
+	const DS* sampleDs; // Data set from which the streamlines were extracted, or 0 if the streamlines have no vertex samples
+	std::vector<VertexSampleList> vertexSamples; // Extraction-time samples of the vertices of each streamline, used for recoloring
 	
 	/* Constructors and destructors: */
 	public:
@@ -66,6 +72,10 @@ class MultiStreamline:public Visualization::Abstract::Element
 	/* Methods from Visualization::Abstract::Element: */
 	virtual std::string getName(void) const;
 	virtual size_t getSize(void) const;
+	virtual size_t getGeometrySize(void) const;
+	virtual void writeGeometry(IO::File& file) const;
+	virtual int getColorScalarVariable(void) const;
+	virtual void setColorScalarVariable(int newColorScalarVariableIndex);
 	virtual void glRenderAction(GLRenderState& renderState) const;
 	
 	/* New methods: */
@@ -73,6 +83,13 @@ class MultiStreamline:public Visualization::Abstract::Element
 		{
 		return multiPolyline;
 		}
+	VertexSampleList* startVertexSamples(const DS* newSampleDs) // Returns an array of one empty vertex sample list per streamline to be filled while extracting the streamlines from the given data set
+		{
+		sampleDs=newSampleDs;
+		for(typename std::vector<VertexSampleList>::iterator vslIt=vertexSamples.begin();vslIt!=vertexSamples.end();++vslIt)
+			vslIt->clear();
+		return vertexSamples.empty()?0:&vertexSamples[0];
+		}
 	size_t getElementSize(void) const // Returns the number of vertices in the longest streamline
 		{
 		/* Return the maximum number of vertices in any polyline: */
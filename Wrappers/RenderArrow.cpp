@@ -187,6 +187,10 @@ createArrow(
 		vertices[vertexBase+numPoints*6+i].position=Position((tipBase+rTipBase).getComponents());
 		}
 	
+	/* Bail out if the caller only wants the vertices: */
+	if(indices==0)
+		return;
+	
 	/* Create a polygon to render the arrow base: */
 	GLuint* indexPtr=indices;
 	for(GLuint i=numPoints;i>0;--i,++indexPtr)
@@ -247,6 +251,41 @@ renderArrow(
 	indexPtr+=numPoints*2+2;
 	}
 
+GLuint getArrowNumTriangleIndices(GLuint numPoints)
+	{
+	return (numPoints-2+numPoints*6)*3;
+	}
+
+void createArrowTriangles(GLuint numPoints,GLuint vertexBase,GLuint* indices)
+	{
+	GLuint* indexPtr=indices;
+	
+	/* Create a triangle fan for the arrow base, in the same winding order as the base polygon: */
+	for(GLuint i=numPoints-2;i>0;--i,indexPtr+=3)
+		{
+		indexPtr[0]=vertexBase+(numPoints-1);
+		indexPtr[1]=vertexBase+i;
+		indexPtr[2]=vertexBase+(i-1);
+		}
+	
+	/* Split the quads of the arrow shaft, tip base, and tip quad strips into triangles: */
+	for(GLuint strip=1;strip<7;strip+=2)
+		{
+		GLuint a=vertexBase+numPoints*strip;
+		GLuint b=vertexBase+numPoints*(strip+1);
+		for(GLuint i=0;i<numPoints;++i,indexPtr+=6)
+			{
+			GLuint next=i<numPoints-1?i+1:0;
+			indexPtr[0]=a+i;
+			indexPtr[1]=b+i;
+			indexPtr[2]=b+next;
+			indexPtr[3]=a+i;
+			indexPtr[4]=b+next;
+			indexPtr[5]=a+next;
+			}
+		}
+	}
+
 /*********************************************
 Force instantiation of all standard functions:
 *********************************************/
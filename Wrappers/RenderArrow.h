@@ -67,10 +67,14 @@ createArrow(
 	GLuint numPoints,
 	GLVertex<GLvoid,0,GLvoid,0,ScalarParam,ScalarParam,3>* vertices,
 	GLuint vertexBase,
-	GLuint* indices); // Function to upload the vertices and indices to render an arrow glyph into vertex/index arrays
+	GLuint* indices); // Function to upload the vertices and indices to render an arrow glyph into vertex/index arrays; only uploads vertices if indices is null
 
 void renderArrow(GLuint numPoints,const GLuint* indices); // Function to render an arrow glyph from vertex/index arrays
 
+GLuint getArrowNumTriangleIndices(GLuint numPoints); // Function returning the number of index array items needed to render an arrow glyph as a set of triangles
+
+void createArrowTriangles(GLuint numPoints,GLuint vertexBase,GLuint* indices); // Function to upload the indices to render an arrow glyph created by createArrow as a set of triangles, to batch many arrows into a single draw call
+
 }
 
 }
@@ -26,6 +26,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #define VISUALIZATION_WRAPPERS_SCALAREXTRACTOR_INCLUDED
 
 #include <Abstract/ScalarExtractor.h>
+#include <Templatized/MaterializedScalarSlice.h>
 
 namespace Visualization {
 
@@ -64,10 +65,22 @@ class ScalarExtractor:public Visualization::Abstract::ScalarExtractor
 		{
 		return new ScalarExtractor(*this);
 		}
+	virtual bool isMaterialized(void) const
+		{
+		return Visualization::Templatized::ScalarExtractorMaterialization<SE>::isMaterialized(se);
+		}
+	virtual void dematerialize(void)
+		{
+		Visualization::Templatized::ScalarExtractorMaterialization<SE>::setSlice(se,typename Visualization::Templatized::ScalarExtractorMaterialization<SE>::Slice());
+		}
 	const SE& getSe(void) const // Returns the templatized scalar extractor
 		{
 		return se;
 		}
+	void setSe(const SE& newSe) // Replaces the templatized scalar extractor
+		{
+		se=newSe;
+		}
 	};
 
 }
@@ -120,6 +120,11 @@ class SeededColoredIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 			}
 		virtual void write(Visualization::Abstract::ParametersSink& sink) const;
 		virtual void read(Visualization::Abstract::ParametersSource& source);
+		virtual bool setColorScalarVariable(int newColorScalarVariableIndex)
+			{
+			colorScalarVariableIndex=newColorScalarVariableIndex;
+			return true;
+			}
 		};
 	
 	/* Elements: */
@@ -171,6 +176,11 @@ class SeededColoredIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 	virtual void finishElement(void);
 	virtual Visualization::Abstract::Element* startSlaveElement(Visualization::Abstract::Parameters* extractParameters);
 	virtual void continueSlaveElement(void);
+	virtual bool hasElementReader(void) const
+		{
+		return true;
+		}
+	virtual Visualization::Abstract::Element* readElement(Visualization::Abstract::Parameters* extractParameters,IO::File& file);
 	
 	/* New methods: */
 	static const char* getClassName(void) // Returns the algorithm class name
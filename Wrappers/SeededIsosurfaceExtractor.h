@@ -164,6 +164,11 @@ class SeededIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 	virtual void finishElement(void);
 	virtual Visualization::Abstract::Element* startSlaveElement(Visualization::Abstract::Parameters* extractParameters);
 	virtual void continueSlaveElement(void);
+	virtual bool hasElementReader(void) const
+		{
+		return true;
+		}
+	virtual Visualization::Abstract::Element* readElement(Visualization::Abstract::Parameters* extractParameters,IO::File& file);
 	
 	/* New methods: */
 	static const char* getClassName(void) // Returns the algorithm class name
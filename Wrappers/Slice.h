@@ -24,6 +24,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_WRAPPERS_SLICE_INCLUDED
 #define VISUALIZATION_WRAPPERS_SLICE_INCLUDED
 
+#include <vector>
 #include <Geometry/Plane.h>
 #define GLVERTEX_NONSTANDARD_TEMPLATES
 #include <GL/GLVertex.h>
@@ -31,6 +32,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Abstract/Element.h>
 #include <Templatized/IndexedTriangleSet.h>
+#include <Templatized/EdgeSample.h>
 
 namespace Visualization {
 
@@ -49,11 +51,15 @@ class Slice:public Visualization::Abstract::Element
 	typedef typename DataSetWrapper::VScalar VScalar; // Scalar type of scalar extractor
 	typedef GLVertex<VScalar,1,void,0,void,Scalar,dimension> Vertex; // Data type for triangle vertices
 	typedef Visualization::Templatized::IndexedTriangleSet<Vertex> Surface; // Data structure to represent surfaces
+	typedef Visualization::Templatized::EdgeSample<DS> VertexSample; // Type to remember where surface vertices lie inside the data set's cells
+	typedef std::vector<VertexSample> VertexSampleList; // Type for lists of vertex samples, in surface vertex order
 	
 	/* Elements: */
 	private:
 	int scalarVariableIndex; // Index of the scalar variable visualized by the slice
 	Surface surface; // Representation of the slice
+	const DS* sampleDs; // Data set from which the slice was extracted, or 0 if the slice has no vertex samples
+	VertexSampleList vertexSamples; // Extraction-time samples of all slice vertices, used for recoloring
 	
 	/* Constructors and destructors: */
 	public:
@@ -67,6 +73,11 @@ class Slice:public Visualization::Abstract::Element
 	/* Methods from Visualization::Abstract::Element: */
 	virtual std::string getName(void) const;
 	virtual size_t getSize(void) const;
+	virtual size_t getGeometrySize(void) const;
+	virtual bool usesTransparency(void) const;
+	virtual void writeGeometry(IO::File& file) const;
+	virtual int getColorScalarVariable(void) const;
+	virtual void setColorScalarVariable(int newColorScalarVariableIndex);
 	virtual void glRenderAction(GLRenderState& renderState) const;
 	
 	/* New methods: */
@@ -74,6 +85,12 @@ class Slice:public Visualization::Abstract::Element
 		{
 		return surface;
 		}
+	VertexSampleList& startVertexSamples(const DS* newSampleDs) // Returns an empty vertex sample list to be filled while extracting the slice from the given data set
+		{
+		sampleDs=newSampleDs;
+		vertexSamples.clear();
+		return vertexSamples;
+		}
 	size_t getElementSize(void) const // Returns the number of triangles in the surface representation
 		{
 		return surface.getNumTriangles();
@@ -0,0 +1,105 @@
+/***********************************************************************
+SliceEncoding - Traits classes to store the value slices of sliced data
+sets in encoded form.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_WRAPPERS_SLICEENCODING_INCLUDED
+#define VISUALIZATION_WRAPPERS_SLICEENCODING_INCLUDED
+
+#include <Misc/ThrowStdErr.h>
+#include <Templatized/EncodedSlice.h>
+
+/* Forward declarations: */
+namespace Visualization {
+namespace Templatized {
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class SlicedCartesian;
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class SlicedCurvilinear;
+}
+}
+
+namespace Visualization {
+
+namespace Wrappers {
+
+template <class DSParam>
+class SliceEncoding // Traits class to encode value slices; by default, data sets store all slices as value arrays
+	{
+	/* Embedded classes: */
+	public:
+	typedef DSParam DS; // Type of data set
+	typedef typename DS::ValueScalar ValueScalar; // Type of slice values
+	typedef Visualization::Templatized::EncodedSlice<ValueScalar> EncodedSlice; // Type of encoded slices
+	
+	static const bool canEncode=false; // Flag whether the data set can encode its value slices
+	
+	/* Methods: */
+	static const EncodedSlice* getEncodedSlice(const DS& ds,int sliceIndex) // Returns the encoded version of a value slice, or null if the slice is stored as a value array
+		{
+		return 0;
+		}
+	static void encodeSlices(DS& ds,Visualization::Templatized::EncodedSliceBase::Codec codec) // Encodes all value slices of the given data set with the given codec
+		{
+		Misc::throwStdErr("DataSet::encodeSlices: Data set does not support encoded slices");
+		}
+	};
+
+template <class DSParam>
+class EncodableSliceEncoding // Base class for traits of data sets that can encode their value slices
+	{
+	/* Embedded classes: */
+	public:
+	typedef DSParam DS; // Type of data set
+	typedef typename DS::ValueScalar ValueScalar; // Type of slice values
+	typedef Visualization::Templatized::EncodedSlice<ValueScalar> EncodedSlice; // Type of encoded slices
+	
+	static const bool canEncode=true; // Flag whether the data set can encode its value slices
+	
+	/* Methods: */
+	static const EncodedSlice* getEncodedSlice(const DS& ds,int sliceIndex)
+		{
+		return ds.getEncodedSlice(sliceIndex);
+		}
+	static void encodeSlices(DS& ds,Visualization::Templatized::EncodedSliceBase::Codec codec)
+		{
+		/* Encode one slice at a time to only keep one additional encoded slice in memory: */
+		for(int sliceIndex=0;sliceIndex<ds.getNumSlices();++sliceIndex)
+			ds.encodeSlice(sliceIndex,codec);
+		}
+	};
+
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class SliceEncoding<Visualization::Templatized::SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam> >
+	:public EncodableSliceEncoding<Visualization::Templatized::SlicedCartesian<ScalarParam,dimensionParam,ValueScalarParam> >
+	{
+	};
+
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class SliceEncoding<Visualization::Templatized::SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam> >
+	:public EncodableSliceEncoding<Visualization::Templatized::SlicedCurvilinear<ScalarParam,dimensionParam,ValueScalarParam> >
+	{
+	};
+
+}
+
+}
+
+#endif
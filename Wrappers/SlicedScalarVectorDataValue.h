@@ -27,6 +27,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Templatized/SlicedScalarExtractor.h>
 #include <Templatized/SlicedVectorExtractor.h>
 #include <Wrappers/DataValue.h>
+#include <Wrappers/SliceEncoding.h>
 
 namespace Visualization {
 
@@ -118,13 +119,16 @@ class SlicedScalarVectorDataValue:public SlicedScalarVectorDataValueBase,public
 	using SlicedScalarVectorDataValueBase::getVectorVariableName;
 	SE getScalarExtractor(int scalarVariableIndex) const
 		{
-		return SE(scalarVariableIndex,dataSet->getSliceArray(scalarVariableIndex));
+		return SE(scalarVariableIndex,dataSet->getSliceArray(scalarVariableIndex),SliceEncoding<DS>::getEncodedSlice(*dataSet,scalarVariableIndex));
 		}
 	VE getVectorExtractor(int vectorVariableIndex) const
 		{
 		VE result;
 		for(int i=0;i<dimension;++i)
-			result.setSlice(i,dataSet->getSliceArray(getVectorVariableScalarIndex(vectorVariableIndex,i)));
+			{
+			int sliceIndex=getVectorVariableScalarIndex(vectorVariableIndex,i);
+			result.setSlice(i,dataSet->getSliceArray(sliceIndex),SliceEncoding<DS>::getEncodedSlice(*dataSet,sliceIndex));
+			}
 		return result;
 		}
 	};
@@ -24,11 +24,13 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_WRAPPERS_STREAMLINE_INCLUDED
 #define VISUALIZATION_WRAPPERS_STREAMLINE_INCLUDED
 
+#include <vector>
 #define GLVERTEX_NONSTANDARD_TEMPLATES
 #include <GL/GLVertex.h>
 
 #include <Abstract/Element.h>
 #include <Templatized/Polyline.h>
+#include <Templatized/LocatorSample.h>
 
 namespace Visualization {
 
@@ -47,11 +49,15 @@ class Streamline:public Visualization::Abstract::Element
 	typedef typename DataSetWrapper::VScalar VScalar; // Scalar type of scalar extractor
 	typedef GLVertex<VScalar,1,void,0,Scalar,Scalar,dimension> Vertex; // Data type for streamline vertices
 	typedef Visualization::Templatized::Polyline<Vertex> Polyline; // Data structure to represent streamlines
+	typedef Visualization::Templatized::LocatorSample<DS> VertexSample; // Type to remember where streamline vertices lie inside the data set's cells
+	typedef std::vector<VertexSample> VertexSampleList; // Type for lists of vertex samples, in streamline vertex order
 	
 	/* Elements: */
 	private:
 	int scalarVariableIndex; // Index of the scalar variable used to color the streamline
 	Polyline polyline; // Representation of the streamline
+	const DS* sampleDs; // Data set from which the streamline was extracted, or 0 if the streamline has no vertex samples
+	VertexSampleList vertexSamples; // Extraction-time samples of all streamline vertices, used for recoloring
 	
 	/* Constructors and destructors: */
 	public:
@@ -65,6 +71,10 @@ class Streamline:public Visualization::Abstract::Element
 	/* Methods from Visualization::Abstract::Element: */
 	virtual std::string getName(void) const;
 	virtual size_t getSize(void) const;
+	virtual size_t getGeometrySize(void) const;
+	virtual void writeGeometry(IO::File& file) const;
+	virtual int getColorScalarVariable(void) const;
+	virtual void setColorScalarVariable(int newColorScalarVariableIndex);
 	virtual void glRenderAction(GLRenderState& renderState) const;
 	
 	/* New methods: */
@@ -72,6 +82,12 @@ class Streamline:public Visualization::Abstract::Element
 		{
 		return polyline;
 		}
+	VertexSampleList& startVertexSamples(const DS* newSampleDs) // Returns an empty vertex sample list to be filled while extracting the streamline from the given data set
+		{
+		sampleDs=newSampleDs;
+		vertexSamples.clear();
+		return vertexSamples;
+		}
 	size_t getElementSize(void) const // Returns the number of vertices in the streamline
 		{
 		return polyline.getNumVertices();
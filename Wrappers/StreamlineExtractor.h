@@ -116,6 +116,11 @@ class StreamlineExtractor:public Visualization::Abstract::Algorithm
 			}
 		virtual void write(Visualization::Abstract::ParametersSink& sink) const;
 		virtual void read(Visualization::Abstract::ParametersSource& source);
+		virtual bool setColorScalarVariable(int newColorScalarVariableIndex)
+			{
+			colorScalarVariableIndex=newColorScalarVariableIndex;
+			return true;
+			}
 		
 		/* New methods: */
 		void update(Visualization::Abstract::VariableManager* variableManager,bool track); // Updates derived parameters after a read operation
@@ -163,6 +168,11 @@ class StreamlineExtractor:public Visualization::Abstract::Algorithm
 	virtual void finishElement(void);
 	virtual Visualization::Abstract::Element* startSlaveElement(Visualization::Abstract::Parameters* extractParameters);
 	virtual void continueSlaveElement(void);
+	virtual bool hasElementReader(void) const
+		{
+		return true;
+		}
+	virtual Visualization::Abstract::Element* readElement(Visualization::Abstract::Parameters* extractParameters,IO::File& file);
 	
 	/* New methods: */
 	static const char* getClassName(void) // Returns the algorithm class name
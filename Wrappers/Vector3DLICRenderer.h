@@ -31,7 +31,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Abstract/Element.h>
 
 /* Forward declarations: */
+class Raycaster;
 class LICRaycaster;
+class SingleChannelRaycaster;
 
 namespace Visualization {
 
@@ -54,12 +56,16 @@ class Vector3DLICRenderer:public Visualization::Abstract::Element
 	
 	/* Elements: */
 	private:
-	LICRaycaster* raycaster; // A raycasting volume renderer
+	LICRaycaster* raycaster; // A raycasting volume renderer computing LIC in its shader
+	SingleChannelRaycaster* licVolumeRaycaster; // A raycasting volume renderer for LIC volumes computed on the CPU
 	
 	/* UI components: */
 	GLMotif::ToggleButton* channelEnabledToggles[3]; // Toggle buttons to enable/disable individual channels
 	GLMotif::TextFieldSlider* transparencyGammaSlider; // Slider to change current gamma correction factor for each channel
 	
+	/* Private methods: */
+	Raycaster* getRaycaster(void) const; // Returns the active raycaster
+	
 	/* Constructors and destructors: */
 	public:
 	Vector3DLICRenderer(Visualization::Abstract::Algorithm* algorithm,Visualization::Abstract::Parameters* sParameters); // Creates a volume renderer for the given extractor and parameters
@@ -27,6 +27,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Misc/Autopointer.h>
 #include <GLMotif/DropdownBox.h>
 #include <GLMotif/TextFieldSlider.h>
+#include <GLMotif/ToggleButton.h>
 
 #include <Abstract/DataSet.h>
 #include <Abstract/Parameters.h>
@@ -82,9 +83,10 @@ class Vector3DLICRendererExtractor:public Visualization::Abstract::Algorithm
 		Scalar sliceFactor; // Slice distance for texture- or raycasting-based volume rendering
                 Scalar licStepSize;
                 int fowardIteration, backwardIteration;
-                Scalar noiseFrequency;
+                Scalar noiseFrequency; // Number of noise lattice cells per voxel of the LIC volume
                 Scalar illuminScale;
 		float transparencyGamma; // Overall transparency adjustment factors for each channel
+		bool cpuLIC; // Flag whether to compute the LIC volume on the CPU and render it with a single-channel raycaster
 		
 		/* Methods from Abstract::Parameters: */
 		virtual bool isValid(void) const
@@ -106,6 +108,7 @@ class Vector3DLICRendererExtractor:public Visualization::Abstract::Algorithm
 	
 	/* UI components: */
 	GLMotif::TextFieldSlider* LICStepSizeValueSlider;
+	GLMotif::ToggleButton* cpuLICToggle; // Toggle to compute LIC volumes on the CPU
         
 	/* Constructors and destructors: */
 	public:
@@ -136,6 +139,7 @@ class Vector3DLICRendererExtractor:public Visualization::Abstract::Algorithm
 		return name;
 		}
 	void LICStepSizeValueCallback(GLMotif::TextFieldSlider::ValueChangedCallbackData* cbData);
+	void cpuLICCallback(GLMotif::ToggleButton::ValueChangedCallbackData* cbData);
 	};
 
 }
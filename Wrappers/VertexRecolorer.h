@@ -0,0 +1,108 @@
+/***********************************************************************
+VertexRecolorer - Helper class to re-evaluate the color scalar values
+of the vertices of an already extracted visualization element in
+parallel from per-vertex samples taken during extraction, without
+touching the element's geometry.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_WRAPPERS_VERTEXRECOLORER_INCLUDED
+#define VISUALIZATION_WRAPPERS_VERTEXRECOLORER_INCLUDED
+
+#include <vector>
+#include <Threads/Thread.h>
+
+#include <Templatized/VertexRange.h>
+
+/* Forward declarations: */
+namespace Visualization {
+namespace Abstract {
+class VariableManager;
+}
+}
+
+namespace Visualization {
+
+namespace Wrappers {
+
+template <class DataSetWrapperParam,class VertexParam,class VertexSampleParam>
+class VertexRecolorer
+	{
+	/* Embedded classes: */
+	public:
+	typedef DataSetWrapperParam DataSetWrapper; // Compatible data set type
+	typedef typename DataSetWrapper::DS DS; // Type of templatized data set
+	typedef typename DS::Scalar Scalar; // Scalar type of data set's domain
+	static const int dimension=DS::dimension; // Dimension of data set's domain
+	typedef typename DS::Point Point; // Type for points in data set's domain
+	typedef typename DataSetWrapper::DSL DSL; // Type of templatized locator
+	typedef typename DataSetWrapper::SE SE; // Type of templatized scalar extractor
+	typedef typename DataSetWrapper::ScalarExtractor ScalarExtractor; // Compatible scalar extractor wrapper class
+	typedef VertexParam Vertex; // Type of recolored vertices
+	typedef std::vector<Visualization::Templatized::VertexRange<Vertex> > VertexRangeList; // Type for lists of contiguous runs of vertices
+	typedef VertexSampleParam VertexSample; // Type of extraction-time vertex samples
+	typedef std::vector<VertexSample> VertexSampleList; // Type for lists of vertex samples, in vertex order
+	
+	private:
+	struct Worker // Structure holding the state of a recoloring thread
+		{
+		/* Elements: */
+		public:
+		const VertexRecolorer* recolorer; // Pointer to the recolorer
+		size_t firstVertex,lastVertex; // Half-open interval of vertex indices processed by this worker
+		Threads::Thread thread; // Thread processing the interval
+		
+		/* Methods: */
+		void* workerThreadMethod(void) // Thread method
+			{
+			recolorer->recolorVertices(firstVertex,lastVertex);
+			return 0;
+			}
+		};
+	
+	friend struct Worker;
+	
+	static const size_t minNumThreadVertices=16384; // Minimum number of vertices to warrant an additional thread
+	
+	/* Elements: */
+	const DS* ds; // Templatized data set containing the new color variable
+	const SE* se; // Templatized scalar extractor for the new color variable
+	const VertexRangeList* ranges; // List of vertex ranges currently being recolored
+	const VertexSampleList* samples; // Samples of the vertices currently being recolored, or 0 if the vertices have to be located
+	
+	/* Private methods: */
+	void recolorVertices(size_t firstVertex,size_t lastVertex) const; // Re-evaluates the color values of the given half-open interval of vertices
+	
+	/* Constructors and destructors: */
+	public:
+	VertexRecolorer(Visualization::Abstract::VariableManager* variableManager,int scalarVariableIndex); // Creates a recolorer for the given scalar variable
+	
+	/* Methods: */
+	void recolor(const VertexRangeList& newRanges,const DS* sampleDs,const VertexSampleList& newSamples); // Re-evaluates the texture coordinates of all vertices in the given ranges from the given samples taken in the given data set; locates the vertices instead if the samples do not apply
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_WRAPPERS_VERTEXRECOLORER_IMPLEMENTATION
+#include <Wrappers/VertexRecolorer.icpp>
+#endif
+
+#endif
@@ -48,7 +48,7 @@ float noiseLookup(in vec3 objPos, in float freqScale)
 	{
 	vec4 nmask = texture3D(maskSampler, objPos);
 	vec3 freqTexCoord = objPos * freqScale;
-	if(nmask.g > 0.01)
+	if(nmask.a > 0.01)
 		return texture3D(noiseSampler, freqTexCoord).a;
 	else
 		return 0.0;